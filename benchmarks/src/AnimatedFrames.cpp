@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/enums/AnimatedFrameMode.hpp"
+#include "common/Literals.hpp"
+#include "messages/Image.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QBuffer>
+#include <QFile>
+#include <QImageReader>
+
+#include <cstdlib>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+QByteArray readFixture(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+    {
+        std::exit(1);
+    }
+    return file.readAll();
+}
+
+int64_t residentBytes(const QList<detail::Frame> &frames)
+{
+    int64_t bytes = 0;
+    for (const auto &frame : frames)
+    {
+        bytes += static_cast<int64_t>(frame.image.width()) *
+                 frame.image.height() * frame.image.depth() / 8;
+    }
+    return bytes;
+}
+
+/// Loading an animated image (what happens once per image)
+void BM_AnimatedFrames_Load(benchmark::State &state, const QString &path,
+                            AnimatedFrameMode mode)
+{
+    auto data = readFixture(path);
+    int64_t bytes = 0;
+    qsizetype frameCount = 0;
+
+    for (auto _ : state)
+    {
+        QBuffer buffer;
+        buffer.setData(data);
+        QImageReader reader(&buffer);
+        auto frames = detail::readFrames(reader, {path}, mode);
+        bytes = residentBytes(frames);
+        frameCount = frames.size();
+        benchmark::DoNotOptimize(frames);
+    }
+
+    state.counters["frames"] = static_cast<double>(frameCount);
+    state.counters["resident_bytes"] = static_cast<double>(bytes);
+}
+
+/// Playing the animation once in windowed mode. This is the extra CPU time
+/// paid on the worker threads compared to keeping all frames resident.
+void BM_AnimatedFrames_WindowedPlayback(benchmark::State &state,
+                                        const QString &path)
+{
+    auto data = readFixture(path);
+
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer);
+    auto frames =
+        detail::readFrames(reader, {path}, AnimatedFrameMode::Windowed);
+    auto format = reader.format();
+
+    int64_t peakWindowBytes = 0;
+    for (auto _ : state)
+    {
+        detail::FrameDecoder decoder(data, format);
+
+        // request the frames in windows, like Frames does while playing
+        for (qsizetype start = 0; start < frames.size();
+             start += detail::Frames::WINDOW_SIZE)
+        {
+            std::vector<qsizetype> indices;
+            for (qsizetype i = start; i < frames.size() &&
+                                      i < start + detail::Frames::WINDOW_SIZE;
+                 ++i)
+            {
+                indices.push_back(i);
+            }
+
+            auto decoded = decoder.decode(indices);
+
+            int64_t windowBytes = 0;
+            for (const auto &[index, pixmap] : decoded)
+            {
+                windowBytes += static_cast<int64_t>(pixmap.width()) *
+                               pixmap.height() * pixmap.depth() / 8;
+            }
+            peakWindowBytes = std::max(peakWindowBytes, windowBytes);
+            benchmark::DoNotOptimize(decoded);
+        }
+    }
+
+    state.counters["frames"] = static_cast<double>(frames.size());
+    state.counters["window_bytes"] = static_cast<double>(peakWindowBytes);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_AnimatedFrames_Load, moving_resident,
+                  u":/examples/moving.gif"_s, AnimatedFrameMode::FullyResident);
+BENCHMARK_CAPTURE(BM_AnimatedFrames_Load, moving_windowed,
+                  u":/examples/moving.gif"_s, AnimatedFrameMode::Windowed);
+BENCHMARK_CAPTURE(BM_AnimatedFrames_Load, splitting_resident,
+                  u":/examples/splitting.gif"_s,
+                  AnimatedFrameMode::FullyResident);
+BENCHMARK_CAPTURE(BM_AnimatedFrames_Load, splitting_windowed,
+                  u":/examples/splitting.gif"_s, AnimatedFrameMode::Windowed);
+
+BENCHMARK_CAPTURE(BM_AnimatedFrames_WindowedPlayback, moving,
+                  u":/examples/moving.gif"_s);
+BENCHMARK_CAPTURE(BM_AnimatedFrames_WindowedPlayback, splitting,
+                  u":/examples/splitting.gif"_s);
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/Literals.hpp"
+#include "controllers/completion/sources/CompletionIndex.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::completion;
+using namespace literals;
+
+namespace {
+
+/// Roughly the emotes of a busy channel with cross-channel emotes
+std::vector<QString> makeNames(size_t n)
+{
+    const QString parts[] = {
+        u"Feels"_s, u"Good"_s, u"Man"_s, u"pepe"_s, u"Kappa"_s,
+        u"LUL"_s,   u"W"_s,    u"Clap"_s, u"forsen"_s, u"Pog"_s,
+    };
+
+    std::vector<QString> names;
+    names.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        names.push_back(parts[i % 10] + parts[(i / 10) % 10] +
+                        QString::number(i / 100));
+    }
+    return names;
+}
+
+const QString QUERIES[] = {
+    u"p"_s, u"pe"_s, u"pep"_s, u"pepe"_s, u"pepeC"_s, u"pepeCl"_s,
+};
+
+}  // namespace
+
+/// What completion used to do on every keystroke
+static void BM_CompletionIndex_Scan(benchmark::State &state)
+{
+    auto names = makeNames(5000);
+
+    for (auto _ : state)
+    {
+        for (const auto &query : QUERIES)
+        {
+            std::vector<uint32_t> found;
+            for (uint32_t i = 0; i < names.size(); i++)
+            {
+                if (names[i].contains(query, Qt::CaseInsensitive))
+                {
+                    found.push_back(i);
+                }
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+}
+BENCHMARK(BM_CompletionIndex_Scan);
+
+static void BM_CompletionIndex_Find(benchmark::State &state)
+{
+    CompletionIndex index(makeNames(5000), CompletionIndex::Mode::Substring);
+
+    for (auto _ : state)
+    {
+        for (const auto &query : QUERIES)
+        {
+            benchmark::DoNotOptimize(index.find(query));
+        }
+    }
+}
+BENCHMARK(BM_CompletionIndex_Find);
+
+static void BM_CompletionIndex_Build(benchmark::State &state)
+{
+    auto names = makeNames(5000);
+
+    for (auto _ : state)
+    {
+        CompletionIndex index(names, CompletionIndex::Mode::Substring);
+        benchmark::DoNotOptimize(index);
+    }
+}
+BENCHMARK(BM_CompletionIndex_Build);
@@ -4,11 +4,14 @@
 
 #include "providers/emoji/Emojis.hpp"
 
+#include "common/Literals.hpp"
+
 #include <benchmark/benchmark.h>
 #include <QDebug>
 #include <QString>
 
 using namespace chatterino;
+using namespace literals;
 
 static void BM_ShortcodeParsing(benchmark::State &state)
 {
@@ -184,3 +187,80 @@ BENCHMARK_CAPTURE(
     "😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 "
     "😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 ",
     61);
+
+namespace {
+
+/// Words as they show up in chat, most of them without any emoji
+const std::vector<QString> CHAT_CORPUS{
+    u"that"_s,
+    u"was"_s,
+    u"actually"_s,
+    u"insane"_s,
+    u"LUL"_s,
+    u"KEKW"_s,
+    u"@forsen"_s,
+    u"!play"_s,
+    u"10/10"_s,
+    u"#1"_s,
+    u"ggs"_s,
+    u"xD"_s,
+    u"https://twitch.tv/forsen"_s,
+    u"W"_s,
+    u"chat"_s,
+    u"5head"_s,
+    u"🐧"_s,
+    u"😂😂😂"_s,
+    u"nice👍"_s,
+    u"привет"_s,
+    u"こんにちは"_s,
+    u"🇸🇪"_s,
+    u"1️⃣"_s,
+    u"pog"_s,
+    u"monkaS"_s,
+    u"2024"_s,
+    u"❤️"_s,
+    u"ok"_s,
+    u"Clap"_s,
+    u"FeelsGoodMan"_s,
+};
+
+}  // namespace
+
+static void BM_EmojiParsing_ChatVector(benchmark::State &state)
+{
+    Emojis emojis;
+    emojis.load();
+
+    for (auto _ : state)
+    {
+        for (const auto &word : CHAT_CORPUS)
+        {
+            benchmark::DoNotOptimize(emojis.parse(word));
+        }
+    }
+}
+BENCHMARK(BM_EmojiParsing_ChatVector);
+
+static void BM_EmojiParsing_ChatCallback(benchmark::State &state)
+{
+    Emojis emojis;
+    emojis.load();
+
+    for (auto _ : state)
+    {
+        size_t parts = 0;
+        for (const auto &word : CHAT_CORPUS)
+        {
+            emojis.parse(
+                word,
+                [&](QStringView text) {
+                    parts += static_cast<size_t>(text.size());
+                },
+                [&](const EmotePtr & /*emote*/) {
+                    parts++;
+                });
+        }
+        benchmark::DoNotOptimize(parts);
+    }
+}
+BENCHMARK(BM_EmojiParsing_ChatCallback);
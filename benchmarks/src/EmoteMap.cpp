@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/Emote.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+EmotePtr makeEmote(const QString &name)
+{
+    return std::make_shared<const Emote>(Emote{
+        .name = {name},
+        .images = {},
+        .tooltip = {},
+        .homePage = {},
+        .zeroWidth = false,
+        .id = {name},
+        .author = {},
+        .baseName = {},
+    });
+}
+
+/// A map like a large 7TV channel emote set
+std::shared_ptr<const EmoteMap> makeMap(int64_t size)
+{
+    auto map = std::make_shared<EmoteMap>();
+    for (int64_t i = 0; i < size; i++)
+    {
+        auto name = QStringLiteral("emote%1").arg(i);
+        map->emplace(EmoteName{name}, makeEmote(name));
+    }
+    return map;
+}
+
+}  // namespace
+
+/// What a live update does: copy the published map, add an emote and
+/// publish the copy
+static void BM_EmoteMap_LiveUpdate(benchmark::State &state)
+{
+    auto published = makeMap(state.range(0));
+    auto added = makeEmote(QStringLiteral("newEmote"));
+
+    for (auto _ : state)
+    {
+        EmoteMap updated = *published;
+        updated[added->name] = added;
+        auto next = std::make_shared<EmoteMap>(std::move(updated));
+        benchmark::DoNotOptimize(next);
+    }
+}
+BENCHMARK(BM_EmoteMap_LiveUpdate)->Arg(100)->Arg(1000)->Arg(5000);
+
+static void BM_EmoteMap_Find(benchmark::State &state)
+{
+    auto map = makeMap(state.range(0));
+    std::vector<EmoteName> names;
+    for (int64_t i = 0; i < state.range(0); i += 7)
+    {
+        names.push_back({QStringLiteral("emote%1").arg(i)});
+        names.push_back({QStringLiteral("word%1").arg(i)});
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto &name : names)
+        {
+            benchmark::DoNotOptimize(map->find(name));
+        }
+    }
+}
+BENCHMARK(BM_EmoteMap_Find)->Arg(100)->Arg(1000)->Arg(5000);
+
+static void BM_EmoteMap_Iterate(benchmark::State &state)
+{
+    auto map = makeMap(state.range(0));
+
+    for (auto _ : state)
+    {
+        size_t zeroWidth = 0;
+        for (const auto &[name, emote] : *map)
+        {
+            zeroWidth += emote->zeroWidth ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(zeroWidth);
+    }
+}
+BENCHMARK(BM_EmoteMap_Iterate)->Arg(1000);
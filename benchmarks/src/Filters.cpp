@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/filters/lang/Filter.hpp"
+
+#include "common/Literals.hpp"
+#include "controllers/filters/lang/FilterContext.hpp"
+#include "messages/Message.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "mocks/TwitchIrcServer.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::filters;
+using namespace literals;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    ITwitchIrcServer *getTwitch() override
+    {
+        return &this->twitch;
+    }
+
+    mock::MockTwitchIrcServer twitch;
+};
+
+const QStringList FILTERS = {
+    u"!flags.similar && !(author.badges contains \"bot\")"_s,
+    u"author.subbed && author.sub_length >= 12"_s,
+    u"message.content match ri\"^!\\w+\" || message.length > 300"_s,
+    u"channel.name == \"forsen\" && !(message.content contains \"spoiler\")"_s,
+    u"flags.highlighted || author.badges contains \"moderator\""_s,
+};
+
+std::vector<MessagePtr> makeMessages(size_t n)
+{
+    std::vector<MessagePtr> messages;
+    messages.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        auto message = std::make_shared<Message>();
+        message->displayName = u"user"_s + QString::number(i % 97);
+        message->channelName = u"forsen"_s;
+        message->messageText =
+            (i % 5 == 0 ? u"!command "_s : u"that was a good play "_s) +
+            QString::number(i);
+        if (i % 3 == 0)
+        {
+            message->twitchBadges.emplace_back(u"subscriber"_s, u"12"_s);
+            message->twitchBadgeInfos[u"subscriber"_s] = u"14"_s;
+        }
+        if (i % 11 == 0)
+        {
+            message->twitchBadges.emplace_back(u"moderator"_s, u"1"_s);
+        }
+        messages.emplace_back(std::move(message));
+    }
+    return messages;
+}
+
+std::vector<Filter> makeFilters()
+{
+    std::vector<Filter> filters;
+    for (const auto &text : FILTERS)
+    {
+        auto result = Filter::fromString(text);
+        filters.emplace_back(std::move(std::get<Filter>(result)));
+    }
+    return filters;
+}
+
+}  // namespace
+
+/// What filtering used to do: compute every identifier, then run the filters
+static void BM_Filters_ContextMap(benchmark::State &state)
+{
+    MockApplication app;
+    auto messages = makeMessages(1000);
+    auto filters = makeFilters();
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            auto context = buildContextMap(message, nullptr);
+            for (const auto &filter : filters)
+            {
+                benchmark::DoNotOptimize(filter.execute(context));
+            }
+        }
+    }
+}
+BENCHMARK(BM_Filters_ContextMap);
+
+static void BM_Filters_Lazy(benchmark::State &state)
+{
+    MockApplication app;
+    auto messages = makeMessages(1000);
+    auto filters = makeFilters();
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            FilterContext context(*message, nullptr);
+            for (const auto &filter : filters)
+            {
+                benchmark::DoNotOptimize(filter.execute(context));
+            }
+        }
+    }
+}
+BENCHMARK(BM_Filters_Lazy);
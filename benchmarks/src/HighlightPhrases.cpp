@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/Literals.hpp"
+#include "controllers/highlights/HighlightPhrase.hpp"
+#include "util/MultiPatternMatcher.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+std::vector<HighlightPhrase> makePhrases(size_t n)
+{
+    std::vector<HighlightPhrase> phrases;
+    phrases.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        auto word = u"phrase"_s + QString::number(i);
+        bool isRegex = i % 4 == 0;
+        if (isRegex)
+        {
+            word = uR"(\b)"_s + word + uR"(s?\b)"_s;
+        }
+        phrases.emplace_back(word, false, false, false, isRegex, i % 3 == 0,
+                             QString(), QColor());
+    }
+    return phrases;
+}
+
+std::vector<QString> makeMessages(size_t n)
+{
+    std::vector<QString> messages;
+    messages.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        messages.emplace_back(
+            u"this is a pretty normal chat message number "_s +
+            QString::number(i) +
+            (i % 20 == 0 ? u" with phrase42 in it"_s : u" LUL"_s));
+    }
+    return messages;
+}
+
+}  // namespace
+
+/// What highlight checks used to do: run the regex of every phrase
+static void BM_HighlightPhrases_Regex(benchmark::State &state)
+{
+    auto phrases = makePhrases(150);
+    auto messages = makeMessages(100);
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            for (const auto &phrase : phrases)
+            {
+                benchmark::DoNotOptimize(phrase.isMatch(message));
+            }
+        }
+    }
+}
+BENCHMARK(BM_HighlightPhrases_Regex);
+
+static void BM_HighlightPhrases_Matcher(benchmark::State &state)
+{
+    auto phrases = makePhrases(150);
+    auto messages = makeMessages(100);
+
+    std::vector<MultiPatternMatcher::Pattern> patterns;
+    for (const auto &phrase : phrases)
+    {
+        auto caseSensitivity =
+            phrase.isCaseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        patterns.push_back({
+            .literal = requiredLiteral(phrase.getPattern(), phrase.isRegex(),
+                                       caseSensitivity),
+            .caseSensitivity = caseSensitivity,
+        });
+    }
+    MultiPatternMatcher matcher(patterns);
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            auto candidates = matcher.find(message);
+            for (size_t i = 0; i < phrases.size(); i++)
+            {
+                benchmark::DoNotOptimize(candidates[i] &&
+                                         phrases[i].isMatch(message));
+            }
+        }
+    }
+}
+BENCHMARK(BM_HighlightPhrases_Matcher);
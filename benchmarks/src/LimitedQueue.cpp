@@ -4,6 +4,9 @@
 
 #include "messages/LimitedQueue.hpp"
 
+#include "common/Channel.hpp"
+#include "messages/Message.hpp"
+
 #include <benchmark/benchmark.h>
 
 #include <memory>
@@ -111,6 +114,160 @@ void BM_LimitedQueue_Find(benchmark::State &state)
     }
 }
 
+constexpr size_t MESSAGE_LIMIT = 10000;
+
+std::vector<MessagePtr> makeMessages(size_t n, size_t firstID = 0)
+{
+    std::vector<MessagePtr> messages;
+    messages.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        auto msg = std::make_shared<Message>();
+        msg->id = QString::number(firstID + i);
+        messages.emplace_back(std::move(msg));
+    }
+    return messages;
+}
+
+using MessageQueue = LimitedQueue<MessagePtr, MessageIdIndexer>;
+
+void fillMessageQueue(MessageQueue &queue)
+{
+    for (const auto &msg : makeMessages(queue.limit()))
+    {
+        queue.pushBack(msg);
+    }
+}
+
+void BM_LimitedQueue_Messages_FindByKey(benchmark::State &state)
+{
+    MessageQueue queue(MESSAGE_LIMIT);
+    fillMessageQueue(queue);
+    QString id = QString::number(MESSAGE_LIMIT / 2);
+
+    for (auto _ : state)
+    {
+        auto res = queue.findByKey(id);
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+// What Channel::findMessageByID did before the queue was indexed
+void BM_LimitedQueue_Messages_RFindID(benchmark::State &state)
+{
+    MessageQueue queue(MESSAGE_LIMIT);
+    fillMessageQueue(queue);
+    QString id = QString::number(MESSAGE_LIMIT / 2);
+
+    for (auto _ : state)
+    {
+        auto res = queue.rfind([&](const MessagePtr &msg) {
+            return msg->id == id;
+        });
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void BM_LimitedQueue_Messages_PushBack(benchmark::State &state)
+{
+    MessageQueue queue(MESSAGE_LIMIT);
+    fillMessageQueue(queue);
+    // Twice the limit, so a message is evicted before it's pushed again
+    auto messages = makeMessages(MESSAGE_LIMIT * 2, MESSAGE_LIMIT);
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        queue.pushBack(messages[i]);
+        i = (i + 1) % messages.size();
+    }
+}
+
+void BM_LimitedQueue_Messages_InsertBefore(benchmark::State &state)
+{
+    MessageQueue queue(MESSAGE_LIMIT);
+    fillMessageQueue(queue);
+    auto last = *queue.last();
+    auto messages = makeMessages(MESSAGE_LIMIT * 2, MESSAGE_LIMIT);
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        // like filling in a message that was missed shortly before
+        queue.insertBefore(last, messages[i]);
+        i = (i + 1) % messages.size();
+    }
+}
+
+void BM_LimitedQueue_Read(benchmark::State &state)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue.pushBack(std::make_shared<int>(i));
+    }
+
+    for (auto _ : state)
+    {
+        auto view = queue.read();
+        benchmark::DoNotOptimize(view.size());
+    }
+}
+
+/// The first thread writes to `queue`, all others read the last 10 items
+/// with `read`.
+void contendedQueue(benchmark::State &state, auto &&read)
+{
+    static LimitedQueue<std::shared_ptr<int>> queue(1000);
+    if (state.thread_index() == 0)
+    {
+        queue.clear();
+        for (int i = 0; i < 1000; ++i)
+        {
+            queue.pushBack(std::make_shared<int>(i));
+        }
+    }
+    auto item = std::make_shared<int>(42);
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            queue.pushBack(item);
+        }
+        else
+        {
+            benchmark::DoNotOptimize(read(queue));
+        }
+    }
+}
+
+void BM_LimitedQueue_Contended_Snapshot(benchmark::State &state)
+{
+    contendedQueue(state, [](const auto &queue) {
+        auto snapshot = queue.getSnapshot();
+        int sum = 0;
+        for (size_t i = snapshot.size() - 10; i < snapshot.size(); i++)
+        {
+            sum += *snapshot[i];
+        }
+        return sum;
+    });
+}
+
+void BM_LimitedQueue_Contended_Read(benchmark::State &state)
+{
+    contendedQueue(state, [](const auto &queue) {
+        auto view = queue.read();
+        int sum = 0;
+        for (size_t i = view.size() - 10; i < view.size(); i++)
+        {
+            sum += *view[i];
+        }
+        return sum;
+    });
+}
+
 BENCHMARK(BM_LimitedQueue_PushBack);
 BENCHMARK(BM_LimitedQueue_PushFront_One);
 BENCHMARK(BM_LimitedQueue_PushFront_Many);
@@ -118,3 +275,10 @@ BENCHMARK(BM_LimitedQueue_Replace);
 BENCHMARK(BM_LimitedQueue_Snapshot);
 BENCHMARK(BM_LimitedQueue_Snapshot_ExpensiveCopy);
 BENCHMARK(BM_LimitedQueue_Find);
+BENCHMARK(BM_LimitedQueue_Read);
+BENCHMARK(BM_LimitedQueue_Contended_Snapshot)->Threads(2)->Threads(4);
+BENCHMARK(BM_LimitedQueue_Contended_Read)->Threads(2)->Threads(4);
+BENCHMARK(BM_LimitedQueue_Messages_FindByKey);
+BENCHMARK(BM_LimitedQueue_Messages_RFindID);
+BENCHMARK(BM_LimitedQueue_Messages_PushBack);
+BENCHMARK(BM_LimitedQueue_Messages_InsertBefore);
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/Literals.hpp"
+#include "providers/liveupdates/JsonMessage.hpp"
+#include "providers/seventv/eventapi/Dispatch.hpp"
+#include "providers/seventv/eventapi/Message.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::liveupdates;
+using namespace chatterino::seventv::eventapi;
+using namespace literals;
+
+namespace {
+
+/// Builds an emote_set.update dispatch for every emote of a captured emote set,
+/// like the ones received when emotes are added to a channel
+std::vector<QByteArray> makeDispatches()
+{
+    QFile file(u":/bench/seventvemotes-nymn.json"_s);
+    if (!file.open(QFile::ReadOnly))
+    {
+        std::exit(1);
+    }
+    auto emoteSet = QJsonDocument::fromJson(file.readAll())
+                        .object()["emote_set"_L1]
+                        .toObject();
+    auto emoteSetID = emoteSet["id"_L1].toString();
+
+    std::vector<QByteArray> dispatches;
+    int index = 0;
+    for (const auto &emote : emoteSet["emotes"_L1].toArray())
+    {
+        QJsonObject body{
+            {u"id"_s, emoteSetID},
+            {u"actor"_s, QJsonObject{{u"display_name"_s, u"nerixyz"_s}}},
+            {u"pushed"_s, QJsonArray{QJsonObject{
+                              {u"key"_s, u"emotes"_s},
+                              {u"index"_s, index++},
+                              {u"value"_s, emote},
+                          }}},
+        };
+        QJsonObject message{
+            {u"op"_s, 0},
+            {u"d"_s, QJsonObject{{u"type"_s, u"emote_set.update"_s},
+                                 {u"body"_s, body}}},
+        };
+        dispatches.push_back(
+            QJsonDocument(message).toJson(QJsonDocument::Compact));
+    }
+    return dispatches;
+}
+
+}  // namespace
+
+/// How dispatches used to be decoded
+static void BM_SeventvDispatch_QJson(benchmark::State &state)
+{
+    auto dispatches = makeDispatches();
+
+    for (auto _ : state)
+    {
+        for (const auto &dispatch : dispatches)
+        {
+            auto root = QJsonDocument::fromJson(dispatch).object();
+            auto data = root["d"_L1].toObject();
+            auto body = data["body"_L1].toObject();
+            auto id = body["id"_L1].toString();
+            auto actorName =
+                body["actor"_L1].toObject()["display_name"_L1].toString();
+            for (const auto &pushed : body["pushed"_L1].toArray())
+            {
+                auto emote = pushed.toObject()["value"_L1].toObject();
+                auto emoteID = emote["id"_L1].toString();
+                benchmark::DoNotOptimize(emote);
+                benchmark::DoNotOptimize(emoteID);
+            }
+            benchmark::DoNotOptimize(id);
+            benchmark::DoNotOptimize(actorName);
+        }
+    }
+}
+BENCHMARK(BM_SeventvDispatch_QJson);
+
+static void BM_SeventvDispatch_JsonMessage(benchmark::State &state)
+{
+    auto dispatches = makeDispatches();
+
+    for (auto _ : state)
+    {
+        for (const auto &data : dispatches)
+        {
+            JsonMessage json(data);
+            auto message = parseBaseMessage(json);
+            auto dispatch = message->toInner<Dispatch>();
+            for (const auto &pushed :
+                 jsonArray(jsonMember(dispatch->body, "pushed")))
+            {
+                EmoteAddDispatch add(*dispatch, jsonMember(pushed, "value"));
+                benchmark::DoNotOptimize(add);
+            }
+        }
+    }
+}
+BENCHMARK(BM_SeventvDispatch_JsonMessage);
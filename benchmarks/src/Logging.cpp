@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/Literals.hpp"
+#include "messages/Message.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "singletons/helper/LoggingChannel.hpp"
+#include "singletons/Logging.hpp"
+#include "singletons/Settings.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QDateTime>
+#include <QTemporaryDir>
+
+#include <memory>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+MessagePtr makeMessage()
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = u"forsen"_s;
+    message->displayName = u"forsen"_s;
+    message->channelName = u"pajlada"_s;
+    message->messageText =
+        u"Kappa 123 this is a message of average length pajaW"_s;
+    message->serverReceivedTime = QDateTime::currentDateTime();
+    return message;
+}
+
+/// Formats and writes messages directly to one log file
+///
+/// With a threshold of 0, every message is written and flushed immediately.
+/// That's what used to happen on the GUI thread for every logged message.
+void BM_LoggingChannel_AddMessage(benchmark::State &state)
+{
+    QTemporaryDir dir;
+    LoggingOptions options{
+        .baseDirectory = dir.path(),
+        .timestampFormat = u"hh:mm:ss"_s,
+        .flushThreshold = static_cast<qsizetype>(state.range(0)),
+    };
+    LoggingChannel channel(u"pajlada"_s, u"twitch"_s, dir.path());
+
+    LoggedMessage logged{
+        .message = makeMessage(),
+        .receivedAt = QDateTime::currentMSecsSinceEpoch(),
+    };
+
+    for (auto _ : state)
+    {
+        channel.addMessage(logged, options);
+    }
+}
+
+/// The cost of logging a message on the calling (GUI) thread
+void BM_Logging_AddMessage(benchmark::State &state)
+{
+    mock::BaseApplication app;
+    QTemporaryDir dir;
+    app.settings.logPath = dir.path();
+    app.settings.enableLogging = true;
+    app.settings.onlyLogListedChannels = false;
+
+    Logging logging(app.settings);
+    auto message = makeMessage();
+
+    for (auto _ : state)
+    {
+        logging.addMessage(u"pajlada"_s, message, u"twitch"_s, {});
+    }
+
+    // ~Logging waits for the writer to finish (outside of the timed loop)
+}
+
+}  // namespace
+
+BENCHMARK(BM_LoggingChannel_AddMessage)->Arg(0)->Arg(64 * 1024);
+BENCHMARK(BM_Logging_AddMessage);
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/layouts/MessageLayout.hpp"
+
+#include "common/Literals.hpp"
+#include "controllers/accounts/AccountController.hpp"
+#include "messages/layouts/MessageLayoutContext.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/MessageElement.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "singletons/Fonts.hpp"
+#include "singletons/Theme.hpp"
+#include "singletons/WindowManager.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication()
+        : windowManager(this->args, this->paths_, this->settings, this->theme,
+                        this->fonts)
+    {
+    }
+
+    WindowManager *getWindows() override
+    {
+        return &this->windowManager;
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    AccountController accounts;
+    WindowManager windowManager;
+};
+
+const QStringList LINES = {
+    u"LUL"_s,
+    u"that was a good play"_s,
+    u"@someone did you see the last stream? it was really good, I watched "
+    u"the whole thing"_s,
+    u"KEKW KEKW KEKW KEKW"_s,
+    u"what game is this"_s,
+    u"first time chatter, love the stream <3"_s,
+    u"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"_s,
+    u"I'm not saying it was aliens, but the RNG in this run has been so "
+    u"absurdly good that I refuse to believe it's just luck. Clip it and ship "
+    u"it, this is going in the compilation."_s,
+};
+
+std::vector<std::unique_ptr<MessageLayout>> makeLayouts(size_t n)
+{
+    std::vector<std::unique_ptr<MessageLayout>> layouts;
+    layouts.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        MessageBuilder builder;
+        builder.emplace<TextElement>(u"user%1:"_s.arg(i % 50),
+                                     MessageElementFlag::Username,
+                                     MessageColor::Text,
+                                     FontStyle::ChatMediumBold);
+        builder.emplace<TextElement>(
+            LINES[static_cast<qsizetype>(i) % LINES.size()],
+            MessageElementFlag::Text);
+        layouts.emplace_back(
+            std::make_unique<MessageLayout>(builder.release()));
+    }
+    return layouts;
+}
+
+}  // namespace
+
+/// Lays out 2000 messages at alternating widths around the argument, like
+/// resizing a split does
+static void BM_MessageLayout_Relayout(benchmark::State &state)
+{
+    MockApplication app;
+    auto layouts = makeLayouts(2000);
+    MessageColors colors;
+
+    bool odd = false;
+    for (auto _ : state)
+    {
+        odd = !odd;
+        MessageLayoutContext ctx{
+            .messageColors = colors,
+            .flags = {MessageElementFlag::Text, MessageElementFlag::Username},
+            .width = static_cast<int>(state.range(0)) + (odd ? 1 : 0),
+            .scale = 1,
+            .imageScale = 1,
+        };
+        for (auto &layout : layouts)
+        {
+            benchmark::DoNotOptimize(layout->layout(ctx, false));
+        }
+    }
+}
+BENCHMARK(BM_MessageLayout_Relayout)->Arg(150)->Arg(300)->Arg(600)->Arg(1200);
@@ -26,6 +26,7 @@
 #include "singletons/Resources.hpp"
 
 #include <benchmark/benchmark.h>
+#include <IrcMessage>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -264,9 +265,79 @@ public:
                 parsed, &this->chan);
             benchmark::DoNotOptimize(built);
         }
+        // reported as messages per second
+        state.SetItemsProcessed(state.iterations() *
+                                static_cast<int64_t>(parsed.size()));
     }
 };
 
+class ResolveEmotes : public RecentMessages
+{
+public:
+    explicit ResolveEmotes(const QString &name_)
+        : RecentMessages(name_)
+    {
+        auto parsed = recentmessages::detail::parseRecentMessages(
+            this->messages.object());
+        for (auto *message : parsed)
+        {
+            auto *privmsg = dynamic_cast<Communi::IrcPrivateMessage *>(message);
+            if (privmsg)
+            {
+                this->words.append(
+                    privmsg->content().split(u' ', Qt::SkipEmptyParts));
+            }
+            delete message;
+        }
+    }
+
+    /// A single lookup in the channel's emote index per word
+    void run(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            size_t found = 0;
+            for (const auto &word : this->words)
+            {
+                if (this->chan.thirdPartyEmote(word))
+                {
+                    found++;
+                }
+            }
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * this->words.size());
+    }
+
+    /// Probing every provider in order (what parseEmote used to do)
+    void runPerProvider(benchmark::State &state)
+    {
+        const auto *ffz = this->app.getFfzEmotes();
+        const auto *bttv = this->app.getBttvEmotes();
+        const auto *seventv = this->app.getSeventvEmotes();
+
+        for (auto _ : state)
+        {
+            size_t found = 0;
+            for (const auto &word : this->words)
+            {
+                EmoteName name{word};
+                if (this->chan.ffzEmote(name) || this->chan.bttvEmote(name) ||
+                    this->chan.seventvEmote(name) || ffz->emote(name) ||
+                    bttv->emote(name) || seventv->globalEmote(name))
+                {
+                    found++;
+                }
+            }
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * this->words.size());
+    }
+
+private:
+    QStringList words;
+};
+
 void BM_ParseRecentMessages(benchmark::State &state, const QString &name)
 {
     ParseRecentMessages bench(name);
@@ -279,7 +350,21 @@ void BM_BuildRecentMessages(benchmark::State &state, const QString &name)
     bench.run(state);
 }
 
+void BM_ResolveEmotesIndexed(benchmark::State &state, const QString &name)
+{
+    ResolveEmotes bench(name);
+    bench.run(state);
+}
+
+void BM_ResolveEmotesPerProvider(benchmark::State &state, const QString &name)
+{
+    ResolveEmotes bench(name);
+    bench.runPerProvider(state);
+}
+
 }  // namespace
 
 BENCHMARK_CAPTURE(BM_ParseRecentMessages, nymn, u"nymn"_s);
 BENCHMARK_CAPTURE(BM_BuildRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_ResolveEmotesIndexed, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_ResolveEmotesPerProvider, nymn, u"nymn"_s);
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/Similarity.hpp"
+
+#include "common/Literals.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+const QStringList COPYPASTAS = {
+    u"What the heck did you just say about me, you little chatter? I'll have "
+    u"you know I graduated top of my class in the Chatterino academy, and "
+    u"I've been involved in numerous secret raids on forsen's chat, and I "
+    u"have over 300 confirmed bans. I am trained in emote warfare and I'm the "
+    u"top sniper in the entire Twitch armed forces."_s,
+    u"Hey guys, did you know that in terms of male human and female Pokémon "
+    u"breeding, Vaporeon is the most compatible Pokémon for humans? Not only "
+    u"are they in the field egg group, which is mostly comprised of mammals, "
+    u"Vaporeon are an average of 3\"03' tall and 63.9 pounds."_s,
+    u"⣿⣿⣿⣿⣿⣿⣿⣿⡿⠿⠛⠛⠛⠋⠉⠈⠉⠉⠉⠉⠛⠻⢿⣿⣿⣿⣿⣿⣿⣿ ⣿⣿⣿⣿⣿⡿⠋⠁⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄"
+    u"⠄⠉⠛⢿⣿⣿⣿⣿ ⣿⣿⣿⣿⡏⣀⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠄⠹⣿⣿⣿ ⣿⣿⣿⢏⣴⣿⣷⠄⠄⠄"_s,
+    u"I'm not saying it was aliens, but the RNG in this run has been so "
+    u"absurdly good that I refuse to believe it's just luck. Clip it and ship "
+    u"it, this is going in the compilation. PogChamp PogChamp PogChamp"_s,
+};
+
+const QStringList CHAT = {
+    u"LUL"_s,
+    u"that was a good play"_s,
+    u"@someone did you see the last stream?"_s,
+    u"KEKW KEKW KEKW"_s,
+    u"what game is this"_s,
+    u"first time chatter, love the stream <3"_s,
+};
+
+/// Like a spam wave: copypastas with a few characters changed to get around
+/// Twitch's duplicate message check
+std::vector<QString> makeSpam(size_t n)
+{
+    std::vector<QString> messages;
+    messages.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        auto text = COPYPASTAS[static_cast<qsizetype>(i) % COPYPASTAS.size()];
+        text.append(u' ').append(QString::number(i));
+        text[static_cast<qsizetype>(i * 7) % text.size()] = u'.';
+        messages.emplace_back(std::move(text));
+    }
+    return messages;
+}
+
+/// Chat with copypastas mixed in between
+std::vector<QString> makeMixedChat(size_t n)
+{
+    auto spam = makeSpam(n);
+    std::vector<QString> messages;
+    messages.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        if (i % 4 == 0)
+        {
+            messages.push_back(spam[i]);
+        }
+        else
+        {
+            messages.push_back(CHAT[static_cast<qsizetype>(i) % CHAT.size()]);
+        }
+    }
+    return messages;
+}
+
+/// Checks each message against the previous `nPrevious` messages like the
+/// "hide similar messages" setting does
+void checkMessages(benchmark::State &state,
+                   const std::vector<QString> &messages)
+{
+    constexpr size_t nPrevious = 3;
+    constexpr float threshold = 0.9F;
+
+    std::vector<similarity::Fingerprint> fingerprints;
+    fingerprints.reserve(messages.size());
+    for (const auto &msg : messages)
+    {
+        fingerprints.push_back(similarity::Fingerprint::of(msg));
+    }
+
+    for (auto _ : state)
+    {
+        size_t nSimilar = 0;
+        for (size_t i = nPrevious; i < messages.size(); i++)
+        {
+            for (size_t j = i - nPrevious; j < i; j++)
+            {
+                if (similarity::isSimilar(messages[i], fingerprints[i],
+                                          messages[j], fingerprints[j],
+                                          threshold))
+                {
+                    nSimilar++;
+                    break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(nSimilar);
+    }
+}
+
+void BM_Similarity_CopypastaSpam(benchmark::State &state)
+{
+    checkMessages(state, makeSpam(1000));
+}
+
+void BM_Similarity_MixedChat(benchmark::State &state)
+{
+    checkMessages(state, makeMixedChat(1000));
+}
+
+void BM_Similarity_LongestCommonSubstring(benchmark::State &state)
+{
+    // two variations of the same copypasta
+    auto spam = makeSpam(COPYPASTAS.size() + 1);
+    const auto &a = spam.front();
+    const auto &b = spam.back();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(similarity::longestCommonSubstring(a, b));
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_Similarity_CopypastaSpam);
+BENCHMARK(BM_Similarity_MixedChat);
+BENCHMARK(BM_Similarity_LongestCommonSubstring);
@@ -6,6 +6,7 @@
 #include <QFile>
 
 #include <memory>
+#include <vector>
 
 namespace {
 
@@ -187,6 +188,57 @@ void BM_ParseAndHandleMessages(benchmark::State &state)
     }
 }
 
+/// How messages were parsed before: copy to a string, parse it into a DOM
+/// using the default allocator
+void BM_ParseMessagesCopy(benchmark::State &state)
+{
+    auto messages = readMessages();
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            boost::system::error_code ec;
+            auto jv = boost::json::parse(
+                boost::beast::buffers_to_string(msg.data()), ec);
+            assert(!ec);
+            benchmark::DoNotOptimize(jv);
+        }
+    }
+}
+
+/// How Session parses messages: in place, reusing the parser and the memory
+/// of the previous message
+void BM_ParseMessagesArena(benchmark::State &state)
+{
+    auto messages = readMessages();
+
+    std::vector<unsigned char> arenaBuffer(32 * 1024);
+    boost::json::monotonic_resource arena(arenaBuffer.data(),
+                                          arenaBuffer.size());
+    boost::json::parser parser;
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            {
+                boost::system::error_code ec;
+                auto data = msg.data();
+                parser.reset(&arena);
+                parser.write(static_cast<const char *>(data.data()),
+                             data.size(), ec);
+                assert(!ec);
+                auto jv = parser.release();
+                benchmark::DoNotOptimize(jv);
+            }
+            arena.release();
+        }
+    }
+}
+
 }  // namespace
 
 BENCHMARK(BM_ParseAndHandleMessages);
+BENCHMARK(BM_ParseMessagesCopy);
+BENCHMARK(BM_ParseMessagesArena);
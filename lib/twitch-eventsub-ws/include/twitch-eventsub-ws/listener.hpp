@@ -27,6 +27,9 @@ public:
         const messages::Metadata &metadata,
         const payload::session_welcome::Payload &payload) = 0;
 
+    /// `jv` is only valid for the duration of the call. Its memory belongs to
+    /// the session and is reused for the next message, so copies that outlive
+    /// the call need their own storage (e.g. `boost::json::value(jv, {})`).
     virtual void onNotification(const messages::Metadata &metadata,
                                 const boost::json::value &jv) = 0;
 
@@ -9,6 +9,8 @@
 #include <boost/beast/websocket/ssl.hpp>
 #include <boost/json.hpp>
 
+#include <array>
+
 namespace chatterino::eventsub::lib::messages {
 
 struct Metadata;
@@ -58,6 +60,10 @@ private:
 
     void fail(boost::beast::error_code ec, std::string_view op);
 
+    boost::json::value parseMessage(const boost::beast::flat_buffer &buffer,
+                                    boost::system::error_code &ec);
+    boost::system::error_code handleMessage(const boost::json::value &jv);
+
     boost::system::error_code onSessionWelcome(
         const messages::Metadata &metadata, const boost::json::value &jv);
     boost::system::error_code onSessionReconnect(const boost::json::value &jv);
@@ -78,6 +84,17 @@ private:
     std::string userAgent;
     std::unique_ptr<Listener> listener;
 
+    /// Size of the memory parsed messages are stored in before falling back
+    /// to the heap. Most notifications are a few kilobytes.
+    static constexpr size_t JSON_ARENA_SIZE = 32 * 1024;
+
+    /// The JSON of the message being handled is allocated from jsonArena,
+    /// which is cleared after every message. The parser is reused too, so
+    /// handling a message usually doesn't allocate while parsing.
+    std::array<unsigned char, JSON_ARENA_SIZE> jsonArenaBuffer{};
+    boost::json::monotonic_resource jsonArena;
+    boost::json::parser jsonParser;
+
     std::chrono::seconds keepaliveTimeout{0};
     bool receivedMessage = false;
     std::unique_ptr<boost::asio::system_timer> keepaliveTimer;
@@ -249,6 +249,7 @@ Session::Session(boost::asio::io_context &ioc, boost::asio::ssl::context &ctx,
     , resolver(boost::asio::make_strand(ioc))
     , ws(boost::asio::make_strand(ioc), ctx)
     , listener(std::move(listener))
+    , jsonArena(this->jsonArenaBuffer.data(), this->jsonArenaBuffer.size())
     , closeTimeout(this->ws.get_executor())
 {
 }
@@ -472,15 +473,43 @@ void Session::fail(beast::error_code ec, std::string_view op)
 boost::system::error_code Session::handleMessage(
     const beast::flat_buffer &buffer)
 {
-    boost::system::error_code parseError;
-    auto jv =
-        boost::json::parse(beast::buffers_to_string(buffer.data()), parseError);
-    if (parseError)
+    boost::system::error_code ec;
+    {
+        auto jv = this->parseMessage(buffer, ec);
+        if (!ec)
+        {
+            ec = this->handleMessage(jv);
+        }
+    }
+
+    // Nothing parsed from the message is alive anymore, so the next message
+    // can reuse its memory
+    this->jsonArena.release();
+
+    return ec;
+}
+
+boost::json::value Session::parseMessage(const beast::flat_buffer &buffer,
+                                         boost::system::error_code &ec)
+{
+    // A flat_buffer is contiguous, so the message is parsed where it is
+    // instead of being copied to a string first
+    auto data = buffer.data();
+
+    this->jsonParser.reset(&this->jsonArena);
+    this->jsonParser.write(static_cast<const char *>(data.data()), data.size(),
+                           ec);
+    if (ec)
     {
         // TODO: wrap error?
-        return parseError;
+        return nullptr;
     }
 
+    return this->jsonParser.release();
+}
+
+boost::system::error_code Session::handleMessage(const boost::json::value &jv)
+{
     const auto *jvObject = jv.if_object();
     if (jvObject == nullptr)
     {
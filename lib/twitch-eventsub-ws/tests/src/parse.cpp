@@ -166,3 +166,33 @@ TEST_P(TestHandleMessageP, Run)
 
 INSTANTIATE_TEST_SUITE_P(HandleMessage, TestHandleMessageP,
                          testing::ValuesIn(discover()));
+
+TEST(HandleMessage, ReuseSession)
+{
+    auto log = std::make_shared<NullLogger>();
+    std::unique_ptr<Listener> listener = std::make_unique<NoOpListener>();
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context ssl(
+        boost::asio::ssl::context::method::tls_client);
+    auto sess = std::make_shared<Session>(ioc, ssl, std::move(listener), log);
+
+    boost::beast::flat_buffer invalid;
+    auto inner = invalid.prepare(3);
+    std::memcpy(inner.data(), "{\"a", inner.size());
+    invalid.commit(inner.size());
+
+    // the memory of previous messages is reused for the following ones
+    for (int i = 0; i < 2; i++)
+    {
+        for (const auto &name : discover())
+        {
+            auto buf = readToFlatBuffer(filePath(name + ".json"));
+            auto ec = sess->handleMessage(buf);
+            ASSERT_FALSE(ec.failed())
+                << name << ec.what() << ec.message()
+                << ec.location().to_string();
+        }
+
+        ASSERT_TRUE(sess->handleMessage(invalid).failed());
+    }
+}
@@ -14,7 +14,8 @@ public:
     LinkResolver() = default;
     ~LinkResolver() override = default;
 
-    MOCK_METHOD(void, resolve, (LinkInfo * info), (override));
+    MOCK_METHOD(void, resolve, (LinkInfo * info, Priority priority),
+                (override));
 };
 
 class EmptyLinkResolver : public ILinkResolver
@@ -23,7 +24,7 @@ public:
     EmptyLinkResolver() = default;
     ~EmptyLinkResolver() override = default;
 
-    void resolve(LinkInfo *info) override
+    void resolve(LinkInfo *info, Priority priority) override
     {
         //
     }
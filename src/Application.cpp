@@ -2390,7 +2390,7 @@ Fonts *Application::getFonts()
 
 EmoteController *Application::getEmotes()
 {
-    assertInGuiThread();
+    // Twitch emotes and emojis handle their own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->emotes);
 
     return this->emotes.get();
@@ -2398,7 +2398,7 @@ EmoteController *Application::getEmotes()
 
 AccountController *Application::getAccounts()
 {
-    assertInGuiThread();
+    // The current Twitch account can be accessed from any thread, so we don't need to assert that this is called in the GUI thread
     assert(this->accounts);
 
     return this->accounts.get();
@@ -2454,7 +2454,7 @@ NotificationController *Application::getNotifications()
 
 HighlightController *Application::getHighlights()
 {
-    assertInGuiThread();
+    // HighlightController handles its own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->highlights);
 
     return this->highlights.get();
@@ -2462,7 +2462,7 @@ HighlightController *Application::getHighlights()
 
 FfzBadges *Application::getFfzBadges()
 {
-    assertInGuiThread();
+    // FfzBadges handles its own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->ffzBadges);
 
     return this->ffzBadges.get();
@@ -2486,7 +2486,7 @@ SeventvBadges *Application::getSeventvBadges()
 
 IUserDataController *Application::getUserData()
 {
-    assertInGuiThread();
+    // UserDataController handles its own locks, so we don't need to assert that this is called in the GUI thread
 
     return this->userData.get();
 }
@@ -2508,7 +2508,7 @@ ITwitchLiveController *Application::getTwitchLiveController()
 
 TwitchBadges *Application::getTwitchBadges()
 {
-    assertInGuiThread();
+    // TwitchBadges handles its own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->twitchBadges);
 
     return this->twitchBadges.get();
@@ -2516,7 +2516,7 @@ TwitchBadges *Application::getTwitchBadges()
 
 IChatterinoBadges *Application::getChatterinoBadges()
 {
-    assertInGuiThread();
+    // ChatterinoBadges handles its own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->chatterinoBadges);
 
     return this->chatterinoBadges.get();
@@ -2597,7 +2597,7 @@ ITwitchUsers *Application::getTwitchUsers()
 
 BttvEmotes *Application::getBttvEmotes()
 {
-    assertInGuiThread();
+    // BttvEmotes handles its own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->bttvEmotes);
 
     return this->bttvEmotes.get();
@@ -2613,7 +2613,7 @@ BttvLiveUpdates *Application::getBttvLiveUpdates()
 
 FfzEmotes *Application::getFfzEmotes()
 {
-    assertInGuiThread();
+    // FfzEmotes handles its own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->ffzEmotes);
 
     return this->ffzEmotes.get();
@@ -2621,7 +2621,7 @@ FfzEmotes *Application::getFfzEmotes()
 
 SeventvEmotes *Application::getSeventvEmotes()
 {
-    assertInGuiThread();
+    // SeventvEmotes handles its own locks, so we don't need to assert that this is called in the GUI thread
     assert(this->seventvEmotes);
 
     return this->seventvEmotes.get();
@@ -2670,6 +2670,9 @@ void Application::aboutToQuit()
     this->hotkeys->save();
     this->windows->save();
 
+    // Get the buffered log lines on disk in case we don't exit cleanly
+    this->logging->flush();
+
     this->windows->closeAll();
 }
 
@@ -7,6 +7,7 @@
 #include "Application.hpp"
 #include "common/Args.hpp"
 #include "common/Modes.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/QLogging.hpp"
 #include "singletons/CrashHandler.hpp"
@@ -271,6 +272,10 @@ void runGui(QApplication &a, const Paths &paths, Settings &settings,
         });
     });
 
+    settings.cacheMaxSize.connect([](const int &maxSize) {
+        NetworkCache::setGlobalMaxBytes(qint64{maxSize} * 1024 * 1024);
+    });
+
     chatterino::NetworkManager::init();
     updates.checkForUpdates();
 
@@ -289,6 +294,7 @@ void runGui(QApplication &a, const Paths &paths, Settings &settings,
     app.initialize(settings, paths);
     app.run();
 
+    NetworkCache::closeGlobal();
     chatterino::NetworkManager::deinit();
 
 #ifdef USEWINSDK
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 
@@ -40,6 +41,7 @@ public:
         std::lock_guard<std::mutex> guard(this->mutex_);
 
         this->value_ = val;
+        this->version_.fetch_add(1, std::memory_order_release);
     }
 
     void set(T &&val)
@@ -47,11 +49,20 @@ public:
         std::lock_guard<std::mutex> guard(this->mutex_);
 
         this->value_ = std::move(val);
+        this->version_.fetch_add(1, std::memory_order_release);
+    }
+
+    /// Incremented on every set(). This is cheaper than get() to check if
+    /// the value changed.
+    uint64_t version() const
+    {
+        return this->version_.load(std::memory_order_acquire);
     }
 
 private:
     mutable std::mutex mutex_;
     T value_;
+    std::atomic<uint64_t> version_{0};
 };
 
 #if defined(__cpp_lib_atomic_shared_ptr) && defined(__cpp_concepts)
@@ -94,25 +105,37 @@ public:
     void set(const T &val)
     {
         this->value_.store(std::make_shared<T>(val));
+        this->version_.fetch_add(1, std::memory_order_release);
     }
 
     void set(T &&val)
     {
         this->value_.store(std::make_shared<T>(std::move(val)));
+        this->version_.fetch_add(1, std::memory_order_release);
     }
 
     void set(const std::shared_ptr<T> &val)
     {
         this->value_.store(val);
+        this->version_.fetch_add(1, std::memory_order_release);
     }
 
     void set(std::shared_ptr<T> &&val)
     {
         this->value_.store(std::move(val));
+        this->version_.fetch_add(1, std::memory_order_release);
+    }
+
+    /// Incremented on every set(). This is cheaper than get() to check if
+    /// the value changed.
+    uint64_t version() const
+    {
+        return this->version_.load(std::memory_order_acquire);
     }
 
 private:
     std::atomic<std::shared_ptr<T>> value_;
+    std::atomic<uint64_t> version_{0};
 };
 
 #endif
@@ -12,8 +12,19 @@
 #include "singletons/Settings.hpp"
 #include "util/ChannelHelpers.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
 namespace chatterino {
 
+const QString &MessageIdIndexer::key(const MessagePtr &message)
+{
+    return message->id;
+}
+
 //
 // Channel
 //
@@ -28,6 +39,12 @@ Channel::Channel(const QString &name, Type type)
     {
         this->platform_ = "twitch";
     }
+
+    this->appendFlushTimer_.setSingleShot(true);
+    this->appendFlushTimer_.setInterval(0);
+    QObject::connect(&this->appendFlushTimer_, &QTimer::timeout, [this] {
+        this->flushAppendedMessages();
+    });
 }
 
 Channel::~Channel()
@@ -108,6 +125,40 @@ MessagePtr Channel::getLastMessage() const
 
 void Channel::addMessage(MessagePtr message, MessageContext context,
                          std::optional<MessageFlags> overridingFlags)
+{
+    this->appendMessage(message, context, overridingFlags);
+
+    this->pendingAppends_.push_back({
+        .message = std::move(message),
+        .overridingFlags = overridingFlags,
+    });
+    if (!this->appendFlushTimer_.isActive())
+    {
+        this->appendFlushTimer_.start();
+    }
+}
+
+void Channel::addMessages(std::span<const AppendedMessage> messages,
+                          MessageContext context)
+{
+    if (messages.empty())
+    {
+        return;
+    }
+
+    this->flushAppendedMessages();
+
+    for (const auto &appended : messages)
+    {
+        this->appendMessage(appended.message, context,
+                            appended.overridingFlags);
+    }
+
+    this->messagesAppended.invoke(messages);
+}
+
+void Channel::appendMessage(const MessagePtr &message, MessageContext context,
+                            std::optional<MessageFlags> overridingFlags)
 {
     message->freeze();
 
@@ -132,10 +183,27 @@ void Channel::addMessage(MessagePtr message, MessageContext context,
 
     if (this->messages_.pushBack(message, deleted))
     {
+        this->userIndex_.access()->popFront(deleted);
         this->messageRemovedFromStart(deleted);
     }
+    this->userIndex_.access()->pushBack(message);
 
-    this->messageAppended.invoke(message, overridingFlags);
+    // messageAppended takes a mutable reference
+    auto messageRef = message;
+    this->messageAppended.invoke(messageRef, overridingFlags);
+}
+
+void Channel::flushAppendedMessages()
+{
+    this->appendFlushTimer_.stop();
+    if (this->pendingAppends_.empty())
+    {
+        return;
+    }
+
+    // A listener might add more messages, those end up in the next batch
+    auto batch = std::exchange(this->pendingAppends_, {});
+    this->messagesAppended.invoke(batch);
 }
 
 void Channel::addSystemMessage(const QString &contents)
@@ -146,15 +214,45 @@ void Channel::addSystemMessage(const QString &contents)
 
 void Channel::addOrReplaceTimeout(MessagePtr message, const QDateTime &now)
 {
-    addOrReplaceChannelTimeout(
-        this->getMessageSnapshot(), std::move(message), now,
-        [this](auto /*idx*/, auto msg, auto replacement) {
-            this->replaceMessage(msg, replacement);
-        },
-        [this](auto msg) {
-            this->addMessage(msg, MessageContext::Original);
-        },
-        true);
+    // The queue can't be modified while we're looking at it, so the
+    // modifications are applied afterwards. At most one of them happens.
+    auto timeoutUser = message->timeoutUser;
+    std::optional<std::pair<MessagePtr, MessagePtr>> replacement;
+    MessagePtr added;
+    {
+        auto messages = this->messages_.read();
+        addOrReplaceChannelTimeout(
+            messages, std::move(message), now,
+            [&](auto /*idx*/, auto msg, auto replacementMsg) {
+                replacement.emplace(std::move(msg), std::move(replacementMsg));
+            },
+            [&](auto msg) {
+                added = std::move(msg);
+            },
+            false);
+    }
+
+    // Disable the messages from the user. addOrReplaceChannelTimeout would
+    // look at every message for this.
+    for (const auto &msg : this->getMessagesByUsers({timeoutUser}))
+    {
+        if (msg->loginName == timeoutUser &&
+            msg->flags.hasNone(
+                {MessageFlag::ModerationAction, MessageFlag::Whisper}))
+        {
+            msg->flags.set(MessageFlag::Disabled);
+            msg->flags.set(MessageFlag::InvalidReplyTarget);
+        }
+    }
+
+    if (replacement)
+    {
+        this->replaceMessage(replacement->first, replacement->second);
+    }
+    if (added)
+    {
+        this->addMessage(added, MessageContext::Original);
+    }
 }
 
 void Channel::addOrReplaceClearChat(MessagePtr message, const QDateTime &now)
@@ -185,6 +283,8 @@ void Channel::disableAllMessages()
 
 void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
 {
+    this->flushAppendedMessages();
+
     for (const auto &msg : _messages)
     {
         msg->freeze();
@@ -192,6 +292,7 @@ void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
 
     std::vector<MessagePtr> addedMessages =
         this->messages_.pushFront(_messages);
+    this->userIndex_.access()->pushFront(addedMessages);
 
     if (addedMessages.size() != 0)
     {
@@ -205,6 +306,7 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
     {
         return;
     }
+    this->flushAppendedMessages();
     for (const auto &msg : messages)
     {
         msg->freeze();
@@ -215,24 +317,20 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
     {
         // There are no messages in this channel yet so we can just insert them
         // at the front in order
-        this->messages_.pushFront(messages);
+        this->userIndex_.access()->pushFront(
+            this->messages_.pushFront(messages));
         this->filledInMessages.invoke(messages);
         return;
     }
 
-    std::unordered_set<QString> existingMessageIds;
-    existingMessageIds.reserve(snapshot.size());
-
-    // First, collect the ids of every message already present in the channel
-    for (const auto &msg : snapshot)
-    {
-        if (msg->flags.has(MessageFlag::System) || msg->id.isEmpty())
-        {
-            continue;
-        }
-
-        existingMessageIds.insert(msg->id);
-    }
+    // The messages already in the channel ordered by serverReceivedTime. We
+    // binary search these for the insertion point of each message.
+    std::vector<MessagePtr> ordered;
+    ordered.reserve(snapshot.size());
+    std::ranges::copy_if(snapshot, std::back_inserter(ordered),
+                         [](const auto &msg) {
+                             return !msg->flags.has(MessageFlag::System);
+                         });
 
     bool anyInserted = false;
 
@@ -244,7 +342,7 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
     for (const auto &msg : messages)
     {
         // check if message already exists
-        if (existingMessageIds.count(msg->id) != 0)
+        if (!msg->id.isEmpty() && this->messages_.findByKey(msg->id))
         {
             continue;
         }
@@ -252,27 +350,19 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
         // If we get to this point, we know we'll be inserting a message
         anyInserted = true;
 
-        bool insertedFlag = false;
-        for (const auto &snapshotMsg : snapshot)
+        // Find the first message that comes after the current message.
+        // Therefore, we can put the current message directly before. We
+        // assume that the messages we are filling in are in ascending
+        // order by serverReceivedTime.
+        auto next = std::ranges::upper_bound(ordered, msg->serverReceivedTime,
+                                             std::less<>{}, [](const auto &m) {
+                                                 return m->serverReceivedTime;
+                                             });
+        if (next != ordered.end())
         {
-            if (snapshotMsg->flags.has(MessageFlag::System))
-            {
-                continue;
-            }
-
-            if (msg->serverReceivedTime < snapshotMsg->serverReceivedTime)
-            {
-                // We found the first message that comes after the current message.
-                // Therefore, we can put the current message directly before. We
-                // assume that the messages we are filling in are in ascending
-                // order by serverReceivedTime.
-                this->messages_.insertBefore(snapshotMsg, msg);
-                insertedFlag = true;
-                break;
-            }
+            this->messages_.insertBefore(*next, msg);
         }
-
-        if (!insertedFlag)
+        else
         {
             // We never found a message already in the channel that came after
             // the current message. Put it at the end and make sure to update
@@ -284,6 +374,9 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
 
     if (anyInserted)
     {
+        // Messages were inserted in the middle, so the positions changed
+        this->userIndex_.access()->rebuild(this->getMessageSnapshot());
+
         // We only invoke a signal once at the end of filling all messages to
         // prevent doing any unnecessary repaints.
         this->filledInMessages.invoke(messages);
@@ -293,22 +386,27 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
 void Channel::replaceMessage(const MessagePtr &message,
                              const MessagePtr &replacement)
 {
+    this->flushAppendedMessages();
     replacement->freeze();
     int index = this->messages_.replaceItem(message, replacement);
 
     if (index >= 0)
     {
+        this->userIndex_.access()->replace(static_cast<size_t>(index), message,
+                                           replacement);
         this->messageReplaced.invoke((size_t)index, message, replacement);
     }
 }
 
 void Channel::replaceMessage(size_t index, const MessagePtr &replacement)
 {
+    this->flushAppendedMessages();
     replacement->freeze();
 
     MessagePtr prev;
     if (this->messages_.replaceItem(index, replacement, &prev))
     {
+        this->userIndex_.access()->replace(index, prev, replacement);
         this->messageReplaced.invoke(index, prev, replacement);
     }
 }
@@ -316,11 +414,14 @@ void Channel::replaceMessage(size_t index, const MessagePtr &replacement)
 void Channel::replaceMessage(size_t hint, const MessagePtr &message,
                              const MessagePtr &replacement)
 {
+    this->flushAppendedMessages();
     replacement->freeze();
 
     auto index = this->messages_.replaceItem(hint, message, replacement);
     if (index >= 0)
     {
+        this->userIndex_.access()->replace(static_cast<size_t>(index), message,
+                                           replacement);
         this->messageReplaced.invoke(hint, message, replacement);
     }
 }
@@ -336,28 +437,33 @@ void Channel::disableMessage(const QString &messageID)
 
 void Channel::clearMessages()
 {
+    // The pending messages are cleared too, there's no need to show them
+    this->pendingAppends_.clear();
+    this->appendFlushTimer_.stop();
     this->messages_.clear();
+    this->userIndex_.access()->clear();
     this->messagesCleared.invoke();
 }
 
-MessagePtr Channel::findMessageByID(QStringView messageID)
+std::vector<MessagePtr> Channel::getMessagesByUsers(
+    const QStringList &userNames) const
 {
-    MessagePtr res;
+    return this->userIndex_.accessConst()->find(userNames);
+}
 
-    if (auto msg = this->messages_.rfind([messageID](const MessagePtr &msg) {
-            return msg->id == messageID;
-        });
-        msg)
+MessagePtr Channel::findMessageByID(QStringView messageID)
+{
+    if (messageID.isEmpty())
     {
-        res = *msg;
+        return nullptr;
     }
 
-    return res;
+    return this->messages_.findByKey(messageID).value_or(nullptr);
 }
 
 void Channel::applySimilarityFilters(const MessagePtr &message) const
 {
-    setSimilarityFlags(message, this->messages_.getSnapshot());
+    setSimilarityFlags(message, this->messages_.read());
 }
 
 MessageSinkTraits Channel::sinkTraits() const
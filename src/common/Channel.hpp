@@ -5,19 +5,26 @@
 #pragma once
 
 #include "common/enums/MessageContext.hpp"
+#include "common/UniqueAccess.hpp"
 #include "controllers/completion/TabCompletionModel.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/MessageFlag.hpp"
 #include "messages/MessageSink.hpp"
+#include "messages/UserMessageIndex.hpp"
 
 #include <magic_enum/magic_enum.hpp>
 #include <pajlada/signals/signal.hpp>
 #include <QDate>
+#include <QHashFunctions>
 #include <QString>
+#include <QStringList>
+#include <QStringView>
 #include <QTimer>
 
 #include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace chatterino {
 
@@ -25,6 +32,28 @@ struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 using MessagePtrMut = std::shared_ptr<Message>;
 
+/// A message that was appended to a channel, see Channel::messagesAppended
+struct AppendedMessage {
+    MessagePtr message;
+    std::optional<MessageFlags> overridingFlags;
+};
+
+/// Indexes the messages of a channel by their ID, see LimitedQueue
+struct MessageIdIndexer {
+    using Key = QString;
+
+    struct Hash {
+        using is_transparent = void;
+
+        size_t operator()(QStringView id) const noexcept
+        {
+            return qHash(id);
+        }
+    };
+
+    static const QString &key(const MessagePtr &message);
+};
+
 class Channel : public std::enable_shared_from_this<Channel>, public MessageSink
 {
 public:
@@ -63,6 +92,14 @@ public:
     // SIGNALS
     pajlada::Signals::Signal<MessagePtr &, std::optional<MessageFlags>>
         messageAppended;
+    /// Invoked with all messages appended since the last event loop iteration.
+    ///
+    /// Unlike #messageAppended, this is invoked at most once per event loop
+    /// iteration for messages added with #addMessage, so a burst of messages
+    /// can be handled in a single pass. Messages added with #addMessages are
+    /// forwarded right away as one batch.
+    pajlada::Signals::Signal<std::span<const AppendedMessage>>
+        messagesAppended;
     pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAddedAtStart;
     /// (index, prev-message, replacement)
     pajlada::Signals::Signal<size_t, const MessagePtr &, const MessagePtr &>
@@ -99,8 +136,20 @@ public:
     void addMessage(
         MessagePtr message, MessageContext context,
         std::optional<MessageFlags> overridingFlags = std::nullopt) final;
+    /// Appends all `messages` and invokes #messagesAppended once with them.
+    /// Messages that are still pending from #addMessage are flushed first.
+    void addMessages(std::span<const AppendedMessage> messages,
+                     MessageContext context);
     void addMessagesAtStart(const std::vector<MessagePtr> &messages_);
 
+    /// Invokes #messagesAppended with the pending messages (if any).
+    ///
+    /// This is called before any other modification is signalled, so
+    /// listeners see the modifications in the order they happened. Call it
+    /// before copying the messages of this channel when you're going to
+    /// listen to #messagesAppended as well.
+    void flushAppendedMessages();
+
     void addSystemMessage(const QString &contents);
 
     /// Inserts the given messages in order by Message::serverReceivedTime.
@@ -121,6 +170,14 @@ public:
 
     MessagePtr findMessageByID(QStringView messageID) final;
 
+    /// Returns the messages sent by or about any of the users, in order.
+    ///
+    /// This is a lookup in an index (see UserMessageIndex) and returns a
+    /// superset of the messages from the users - filter them further if
+    /// needed.
+    std::vector<MessagePtr> getMessagesByUsers(
+        const QStringList &userNames) const;
+
     bool hasMessages() const;
 
     size_t countMessages() const;
@@ -155,11 +212,23 @@ protected:
     QString platform_;
 
 private:
+    /// Logs and pushes `message` and invokes #messageAppended
+    void appendMessage(const MessagePtr &message, MessageContext context,
+                       std::optional<MessageFlags> overridingFlags);
+
     const QString name_;
-    LimitedQueue<MessagePtr> messages_;
+    LimitedQueue<MessagePtr, MessageIdIndexer> messages_;
+    UniqueAccess<UserMessageIndex> userIndex_;
     Type type_;
     bool anythingLogged_ = false;
     QTimer clearCompletionModelTimer_;
+
+    /// Messages added with #addMessage that weren't passed to
+    /// #messagesAppended yet
+    std::vector<AppendedMessage> pendingAppends_;
+    /// Single-shot zero timer that flushes #pendingAppends_ on the next event
+    /// loop iteration
+    QTimer appendFlushTimer_;
 };
 
 using ChannelPtr = std::shared_ptr<Channel>;
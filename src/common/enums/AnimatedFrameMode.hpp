@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace chatterino {
+
+/// Controls how the frames of animated images are kept in memory
+enum class AnimatedFrameMode : std::uint8_t {
+    /// All frames are decoded once and kept in memory
+    FullyResident,
+
+    /// Only the compressed image and a few frames around the current one are
+    /// kept in memory. Upcoming frames are decoded on a worker thread.
+    Windowed,
+};
+
+constexpr std::optional<std::string_view> qmagicenumDisplayName(
+    AnimatedFrameMode value) noexcept
+{
+    switch (value)
+    {
+        case AnimatedFrameMode::FullyResident:
+            return "Keep all frames (more memory)";
+        case AnimatedFrameMode::Windowed:
+            return "Decode frames as needed (more CPU)";
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,871 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/network/NetworkCache.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr quint32 INDEX_MAGIC = 0x43324843;  // "C2HC"
+constexpr quint32 INDEX_VERSION = 1;
+
+/// Write the index after this many changes (in addition to flush() and the
+/// destructor)
+constexpr size_t INDEX_WRITE_INTERVAL = 256;
+
+/// Once evicting, evict until the cache is at this fraction of its budget
+constexpr double EVICTION_TARGET = 0.9;
+
+/// Segments with less live data than this fraction get compacted
+constexpr double COMPACTION_THRESHOLD = 0.5;
+
+const QString INDEX_FILE_NAME = QStringLiteral("index");
+const QString SEGMENT_PREFIX = QStringLiteral("seg-");
+
+std::atomic<qint64> globalMaxBytes{qint64{1024} * 1024 * 1024};
+
+std::mutex globalMutex;
+std::shared_ptr<NetworkCache> globalCache;
+QString globalDirectory;
+
+qint64 nowMs()
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+void removeFiles(const std::vector<QString> &paths)
+{
+    for (const auto &path : paths)
+    {
+        QFile::remove(path);
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+NetworkCache::NetworkCache(QString directory, qint64 maxBytes,
+                           QString legacyDirectory)
+    : directory_(std::move(directory))
+    , legacyDirectory_(std::move(legacyDirectory))
+    , maxBytes_(maxBytes)
+{
+    QDir().mkpath(this->directory_);
+    this->loadIndex();
+}
+
+NetworkCache::~NetworkCache()
+{
+    this->writeIndex(1);
+}
+
+std::shared_ptr<NetworkCache> NetworkCache::forDirectory(
+    const QString &cacheDirectory)
+{
+    std::lock_guard lock(globalMutex);
+    if (!globalCache || globalDirectory != cacheDirectory)
+    {
+        // Reset first, so the old index is written before the new one is read
+        globalCache.reset();
+        globalDirectory = cacheDirectory;
+        globalCache = std::make_shared<NetworkCache>(
+            cacheDirectory + "/http", globalMaxBytes.load(), cacheDirectory);
+    }
+    return globalCache;
+}
+
+void NetworkCache::setGlobalMaxBytes(qint64 maxBytes)
+{
+    globalMaxBytes = maxBytes;
+
+    std::shared_ptr<NetworkCache> cache;
+    {
+        std::lock_guard lock(globalMutex);
+        cache = globalCache;
+    }
+    if (cache)
+    {
+        cache->setMaxBytes(maxBytes);
+    }
+}
+
+void NetworkCache::closeGlobal()
+{
+    std::shared_ptr<NetworkCache> cache;
+    {
+        std::lock_guard lock(globalMutex);
+        cache = std::move(globalCache);
+        globalDirectory.clear();
+    }
+    // pending requests might still hold a reference, but they'll be the last
+    // ones to use this cache
+    if (cache)
+    {
+        cache->flush();
+    }
+}
+
+std::optional<NetworkCache::Hit> NetworkCache::get(const QString &key)
+{
+    bool found = false;
+    Entry entry;
+    std::shared_ptr<SegmentReader> reader;
+    {
+        std::lock_guard lock(this->mutex_);
+
+        auto it = this->entries_.find(key);
+        if (it != this->entries_.end())
+        {
+            found = true;
+            entry = it->second;
+            reader = this->segmentReader(entry.segment);
+        }
+    }
+    if (!found)
+    {
+        return this->importLegacy(key);
+    }
+
+    auto data = this->readEntry(key, entry, reader.get());
+
+    auto now = nowMs();
+    std::vector<QString> unusedFiles;
+    {
+        std::lock_guard lock(this->mutex_);
+
+        // The entry might have been replaced or evicted while we read it
+        auto it = this->entries_.find(key);
+        bool current = it != this->entries_.end() &&
+                       it->second.segment == entry.segment &&
+                       it->second.offset == entry.offset &&
+                       it->second.size == entry.size;
+        if (!data && current)
+        {
+            qCDebug(chatterinoCache)
+                << "Dropping unreadable cache entry" << key;
+            this->dropEntry(key, it->second, unusedFiles);
+            this->entries_.erase(it);
+            this->changesSinceFlush_++;
+        }
+        else if (current)
+        {
+            // Access times aren't worth an index write on their own. They're
+            // written with the next change.
+            it->second.lastAccess = now;
+        }
+    }
+    removeFiles(unusedFiles);
+
+    if (!data)
+    {
+        return std::nullopt;
+    }
+
+    auto maxAge = std::chrono::milliseconds(MAX_FRESH_AGE).count();
+    return Hit{
+        .data = std::move(*data),
+        .validators = std::move(entry.validators),
+        .stale = now - entry.storedAt > maxAge,
+    };
+}
+
+void NetworkCache::put(const QString &key, const QByteArray &data,
+                       const Validators &validators)
+{
+    auto now = nowMs();
+    bool stored = this->store(key, data,
+                              {
+                                  .storedAt = now,
+                                  .lastAccess = now,
+                                  .validators = validators,
+                              });
+    if (!stored)
+    {
+        qCWarning(chatterinoCache) << "Failed to write cache entry" << key;
+    }
+
+    this->compactSegments();
+    this->writeIndex(INDEX_WRITE_INTERVAL);
+}
+
+void NetworkCache::markRevalidated(const QString &key)
+{
+    {
+        std::lock_guard lock(this->mutex_);
+
+        auto it = this->entries_.find(key);
+        if (it == this->entries_.end())
+        {
+            return;
+        }
+
+        auto now = nowMs();
+        it->second.storedAt = now;
+        it->second.lastAccess = now;
+        this->changesSinceFlush_++;
+    }
+    this->writeIndex(INDEX_WRITE_INTERVAL);
+}
+
+void NetworkCache::remove(const QString &key)
+{
+    std::vector<QString> unusedFiles;
+    {
+        std::lock_guard lock(this->mutex_);
+
+        auto it = this->entries_.find(key);
+        if (it == this->entries_.end())
+        {
+            return;
+        }
+
+        this->dropEntry(key, it->second, unusedFiles);
+        this->entries_.erase(it);
+        this->changesSinceFlush_++;
+    }
+    removeFiles(unusedFiles);
+    this->writeIndex(INDEX_WRITE_INTERVAL);
+}
+
+void NetworkCache::setMaxBytes(qint64 maxBytes)
+{
+    std::vector<QString> unusedFiles;
+    {
+        std::lock_guard lock(this->mutex_);
+        this->maxBytes_ = maxBytes;
+        this->evict(unusedFiles);
+    }
+    removeFiles(unusedFiles);
+
+    this->compactSegments();
+    this->writeIndex(INDEX_WRITE_INTERVAL);
+}
+
+qint64 NetworkCache::diskBytes() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->usedBytes();
+}
+
+size_t NetworkCache::size() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->entries_.size();
+}
+
+void NetworkCache::flush()
+{
+    this->writeIndex(0);
+}
+
+QString NetworkCache::segmentPath(qint32 segment) const
+{
+    return this->directory_ + '/' + SEGMENT_PREFIX + QString::number(segment);
+}
+
+QString NetworkCache::entryPath(const QString &key) const
+{
+    return this->directory_ + '/' + key;
+}
+
+void NetworkCache::loadIndex()
+{
+    QFile file(this->directory_ + '/' + INDEX_FILE_NAME);
+    if (file.open(QIODevice::ReadOnly))
+    {
+        QDataStream stream(&file);
+
+        quint32 magic = 0;
+        quint32 version = 0;
+        quint32 count = 0;
+        stream >> magic >> version;
+        if (magic == INDEX_MAGIC && version == INDEX_VERSION)
+        {
+            stream >> count;
+            this->entries_.reserve(count);
+            for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok;
+                 i++)
+            {
+                QString key;
+                Entry entry;
+                stream >> key >> entry.segment >> entry.offset >> entry.size >>
+                    entry.storedAt >> entry.lastAccess >>
+                    entry.validators.etag >> entry.validators.lastModified;
+                if (stream.status() == QDataStream::Ok)
+                {
+                    this->entries_.emplace(std::move(key), std::move(entry));
+                }
+            }
+        }
+        else
+        {
+            qCDebug(chatterinoCache)
+                << "Ignoring cache index with unknown version" << version;
+        }
+    }
+
+    // Check the entries against the files that actually exist. If we
+    // crashed, the index might be out of date.
+    QDir dir(this->directory_);
+    for (const auto &name : dir.entryList(QDir::Files))
+    {
+        if (!name.startsWith(SEGMENT_PREFIX))
+        {
+            continue;
+        }
+        bool ok = false;
+        auto id = name.mid(SEGMENT_PREFIX.size()).toInt(&ok);
+        if (ok)
+        {
+            this->segments_[id].fileSize =
+                QFileInfo(dir.filePath(name)).size();
+        }
+    }
+
+    for (auto it = this->entries_.begin(); it != this->entries_.end();)
+    {
+        const auto &entry = it->second;
+        bool valid = false;
+        if (entry.segment < 0)
+        {
+            QFileInfo info(this->entryPath(it->first));
+            valid = info.exists() && info.size() == entry.size;
+            if (valid)
+            {
+                this->standaloneBytes_ += entry.size;
+            }
+        }
+        else
+        {
+            auto segment = this->segments_.find(entry.segment);
+            valid = segment != this->segments_.end() &&
+                    entry.offset + entry.size <= segment->second.fileSize;
+            if (valid)
+            {
+                segment->second.liveBytes += entry.size;
+            }
+        }
+
+        if (valid)
+        {
+            ++it;
+        }
+        else
+        {
+            it = this->entries_.erase(it);
+            this->changesSinceFlush_++;
+        }
+    }
+
+    // Remove files nothing points to anymore
+    for (const auto &name : dir.entryList(QDir::Files))
+    {
+        if (name == INDEX_FILE_NAME || this->entries_.contains(name))
+        {
+            continue;
+        }
+        if (name.startsWith(SEGMENT_PREFIX))
+        {
+            auto id = name.mid(SEGMENT_PREFIX.size()).toInt();
+            auto segment = this->segments_.find(id);
+            if (segment == this->segments_.end() ||
+                segment->second.liveBytes > 0)
+            {
+                continue;
+            }
+            this->segments_.erase(segment);
+        }
+        dir.remove(name);
+    }
+
+    if (!this->segments_.empty())
+    {
+        const auto &[lastId, last] = *this->segments_.rbegin();
+        this->activeSegment_ =
+            last.fileSize < MAX_SEGMENT_SIZE ? lastId : lastId + 1;
+    }
+
+    qCDebug(chatterinoCache)
+        << "Loaded HTTP cache index with" << this->entries_.size()
+        << "entries from" << this->directory_;
+}
+
+void NetworkCache::writeIndex(size_t minChanges)
+{
+    std::lock_guard indexLock(this->indexMutex_);
+
+    std::unordered_map<QString, Entry> entries;
+    size_t changes = 0;
+    {
+        std::lock_guard lock(this->mutex_);
+        if (this->changesSinceFlush_ < minChanges)
+        {
+            return;
+        }
+        entries = this->entries_;
+        changes = std::exchange(this->changesSinceFlush_, 0);
+    }
+
+    auto failed = [&](const QString &error) {
+        qCWarning(chatterinoCache) << "Failed to write cache index" << error;
+        std::lock_guard lock(this->mutex_);
+        this->changesSinceFlush_ += changes;
+    };
+
+    QSaveFile file(this->directory_ + '/' + INDEX_FILE_NAME);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        failed(file.errorString());
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << INDEX_MAGIC << INDEX_VERSION
+           << static_cast<quint32>(entries.size());
+    for (const auto &[key, entry] : entries)
+    {
+        stream << key << entry.segment << entry.offset << entry.size
+               << entry.storedAt << entry.lastAccess << entry.validators.etag
+               << entry.validators.lastModified;
+    }
+
+    if (!file.commit())
+    {
+        failed(file.errorString());
+    }
+}
+
+std::shared_ptr<NetworkCache::SegmentReader> NetworkCache::segmentReader(
+    qint32 segment)
+{
+    auto it = this->segments_.find(segment);
+    if (it == this->segments_.end())
+    {
+        return nullptr;
+    }
+
+    auto &reader = it->second.reader;
+    if (!reader)
+    {
+        // opened on the first read
+        reader = std::make_shared<SegmentReader>();
+        reader->file.setFileName(this->segmentPath(segment));
+    }
+    return reader;
+}
+
+std::optional<QByteArray> NetworkCache::readEntry(const QString &key,
+                                                  const Entry &entry,
+                                                  SegmentReader *reader) const
+{
+    if (entry.segment < 0)
+    {
+        QFile file(this->entryPath(key));
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return std::nullopt;
+        }
+        auto data = file.readAll();
+        if (data.size() != entry.size)
+        {
+            return std::nullopt;
+        }
+        return data;
+    }
+
+    if (!reader)
+    {
+        return std::nullopt;
+    }
+
+    std::lock_guard lock(reader->mutex);
+    if (!reader->file.isOpen() &&
+        !reader->file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+    {
+        return std::nullopt;
+    }
+
+    if (!reader->file.seek(entry.offset))
+    {
+        return std::nullopt;
+    }
+    auto data = reader->file.read(entry.size);
+    if (data.size() != entry.size)
+    {
+        return std::nullopt;
+    }
+    return data;
+}
+
+bool NetworkCache::store(const QString &key, const QByteArray &data,
+                         Entry entry)
+{
+    entry.size = data.size();
+
+    std::vector<QString> unusedFiles;
+    auto updateIndex = [&](bool stored) {
+        // mutex_ is held
+        auto it = this->entries_.find(key);
+        if (it != this->entries_.end())
+        {
+            if (stored && entry.segment < 0 && it->second.segment < 0)
+            {
+                // the new file already took the place of the old one
+                this->standaloneBytes_ -= it->second.size;
+            }
+            else
+            {
+                this->dropEntry(key, it->second, unusedFiles);
+            }
+            this->entries_.erase(it);
+        }
+        this->changesSinceFlush_++;
+
+        if (stored)
+        {
+            if (entry.segment < 0)
+            {
+                this->standaloneBytes_ += entry.size;
+            }
+            else
+            {
+                this->segments_[entry.segment].liveBytes += entry.size;
+            }
+            this->entries_.emplace(key, std::move(entry));
+            this->evict(unusedFiles);
+        }
+    };
+
+    bool stored = false;
+    if (data.size() > MAX_SEGMENT_ENTRY_SIZE)
+    {
+        QSaveFile file(this->entryPath(key));
+        stored = file.open(QIODevice::WriteOnly) &&
+                 file.write(data) == data.size() && file.commit();
+        entry.segment = -1;
+
+        std::lock_guard lock(this->mutex_);
+        updateIndex(stored);
+    }
+    else
+    {
+        // Compaction must not pick the segment before the entry is indexed
+        std::lock_guard writeLock(this->writeMutex_);
+        auto location = this->appendToSegment(data);
+        if (location)
+        {
+            stored = true;
+            entry.segment = location->first;
+            entry.offset = location->second;
+        }
+
+        std::lock_guard lock(this->mutex_);
+        updateIndex(stored);
+    }
+
+    removeFiles(unusedFiles);
+    return stored;
+}
+
+std::optional<std::pair<qint32, qint64>> NetworkCache::appendToSegment(
+    const QByteArray &data)
+{
+    if (this->activeWriter_ && this->activeSize_ >= MAX_SEGMENT_SIZE)
+    {
+        this->activeWriter_.reset();
+        this->activeSegment_++;
+    }
+
+    if (!this->activeWriter_)
+    {
+        auto writer =
+            std::make_unique<QFile>(this->segmentPath(this->activeSegment_));
+        if (!writer->open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            return std::nullopt;
+        }
+        this->activeSize_ = writer->size();
+        this->activeWriter_ = std::move(writer);
+    }
+
+    auto offset = this->activeSize_;
+    auto written = this->activeWriter_->write(data);
+    // make the data visible to the readers
+    this->activeWriter_->flush();
+    if (written > 0)
+    {
+        this->activeSize_ += written;
+    }
+
+    {
+        std::lock_guard lock(this->mutex_);
+        this->segments_[this->activeSegment_].fileSize = this->activeSize_;
+    }
+
+    if (written != data.size())
+    {
+        // the partially written data is dead space now
+        return std::nullopt;
+    }
+    return std::pair{this->activeSegment_, offset};
+}
+
+void NetworkCache::dropEntry(const QString &key, const Entry &entry,
+                             std::vector<QString> &unusedFiles)
+{
+    if (entry.segment < 0)
+    {
+        unusedFiles.push_back(this->entryPath(key));
+        this->standaloneBytes_ -= entry.size;
+        return;
+    }
+
+    auto segment = this->segments_.find(entry.segment);
+    if (segment != this->segments_.end())
+    {
+        segment->second.liveBytes -= entry.size;
+    }
+}
+
+std::optional<NetworkCache::Hit> NetworkCache::importLegacy(const QString &key)
+{
+    if (this->legacyDirectory_.isEmpty())
+    {
+        return std::nullopt;
+    }
+
+    QFile file(this->legacyDirectory_ + '/' + key);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return std::nullopt;
+    }
+    auto data = file.readAll();
+    auto modified = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+    file.close();
+    file.remove();
+
+    // keep the age of the old file, so it gets refreshed eventually
+    auto now = nowMs();
+    bool stored = this->store(key, data,
+                              {
+                                  .storedAt = modified,
+                                  .lastAccess = now,
+                              });
+    // Compaction is left to the next put(), lookups only evict
+    this->writeIndex(INDEX_WRITE_INTERVAL);
+
+    auto maxAge = std::chrono::milliseconds(MAX_FRESH_AGE).count();
+    return Hit{
+        .data = std::move(data),
+        .stale = !stored || now - modified > maxAge,
+    };
+}
+
+qint64 NetworkCache::usedBytes() const
+{
+    qint64 bytes = this->standaloneBytes_;
+    for (const auto &[id, segment] : this->segments_)
+    {
+        bytes += segment.fileSize;
+    }
+    return bytes;
+}
+
+void NetworkCache::evict(std::vector<QString> &unusedFiles)
+{
+    if (this->maxBytes_ <= 0 || this->usedBytes() <= this->maxBytes_)
+    {
+        return;
+    }
+
+    qint64 liveBytes = this->standaloneBytes_;
+    for (const auto &[id, segment] : this->segments_)
+    {
+        liveBytes += segment.liveBytes;
+    }
+
+    auto target = static_cast<qint64>(
+        static_cast<double>(this->maxBytes_) * EVICTION_TARGET);
+    if (liveBytes <= target)
+    {
+        return;
+    }
+
+    std::vector<std::pair<qint64, QString>> byAge;
+    byAge.reserve(this->entries_.size());
+    for (const auto &[key, entry] : this->entries_)
+    {
+        byAge.emplace_back(entry.lastAccess, key);
+    }
+    std::ranges::sort(byAge);
+
+    size_t evicted = 0;
+    for (const auto &[lastAccess, key] : byAge)
+    {
+        if (liveBytes <= target)
+        {
+            break;
+        }
+        auto it = this->entries_.find(key);
+        liveBytes -= it->second.size;
+        this->dropEntry(key, it->second, unusedFiles);
+        this->entries_.erase(it);
+        evicted++;
+    }
+
+    qCDebug(chatterinoCache)
+        << "Evicted" << evicted << "entries from the HTTP cache";
+    this->changesSinceFlush_ += evicted;
+}
+
+void NetworkCache::compactSegments()
+{
+    // A second compaction would move the same entries
+    std::unique_lock compactLock(this->compactMutex_, std::try_to_lock);
+    if (!compactLock.owns_lock())
+    {
+        return;
+    }
+
+    std::vector<qint32> sparse;
+    std::map<qint32, std::shared_ptr<SegmentReader>> readers;
+    std::vector<std::pair<QString, Entry>> moving;
+    {
+        // Nothing gets appended to the segments we're about to remove
+        std::lock_guard writeLock(this->writeMutex_);
+        std::lock_guard lock(this->mutex_);
+
+        if (this->maxBytes_ <= 0)
+        {
+            return;
+        }
+        auto excessBytes = this->usedBytes() - this->maxBytes_;
+        if (excessBytes <= 0)
+        {
+            return;
+        }
+
+        // Compact the segments with the most unused space first
+        std::vector<std::pair<qint64, qint32>> byDeadBytes;
+        for (const auto &[id, segment] : this->segments_)
+        {
+            auto deadBytes = segment.fileSize - segment.liveBytes;
+            if (deadBytes > 0)
+            {
+                byDeadBytes.emplace_back(deadBytes, id);
+            }
+        }
+        std::ranges::sort(byDeadBytes, std::greater{});
+
+        for (const auto &[deadBytes, id] : byDeadBytes)
+        {
+            const auto &segment = this->segments_[id];
+            bool isSparse =
+                static_cast<double>(segment.liveBytes) <
+                static_cast<double>(segment.fileSize) * COMPACTION_THRESHOLD;
+            if (!isSparse && excessBytes <= 0)
+            {
+                continue;
+            }
+            sparse.push_back(id);
+            readers.emplace(id, this->segmentReader(id));
+            excessBytes -= deadBytes;
+        }
+
+        if (sparse.empty())
+        {
+            return;
+        }
+
+        if (readers.contains(this->activeSegment_))
+        {
+            // Compacted entries are moved into a fresh segment
+            this->activeWriter_.reset();
+            this->activeSegment_ = this->segments_.rbegin()->first + 1;
+        }
+
+        for (const auto &[key, entry] : this->entries_)
+        {
+            if (readers.contains(entry.segment))
+            {
+                moving.emplace_back(key, entry);
+            }
+        }
+    }
+
+    // Lookups and writes continue while the data is copied
+    std::vector<std::optional<std::pair<qint32, qint64>>> moved;
+    moved.reserve(moving.size());
+    for (const auto &[key, entry] : moving)
+    {
+        auto data =
+            this->readEntry(key, entry, readers[entry.segment].get());
+        if (!data)
+        {
+            moved.emplace_back();
+            continue;
+        }
+        std::lock_guard writeLock(this->writeMutex_);
+        moved.push_back(this->appendToSegment(*data));
+    }
+
+    std::vector<QString> unusedFiles;
+    {
+        std::lock_guard lock(this->mutex_);
+
+        for (size_t i = 0; i < moving.size(); i++)
+        {
+            const auto &[key, old] = moving[i];
+            // Entries that were replaced or evicted in the meantime leave
+            // their copy as dead space
+            auto it = this->entries_.find(key);
+            if (it == this->entries_.end() ||
+                it->second.segment != old.segment ||
+                it->second.offset != old.offset)
+            {
+                continue;
+            }
+
+            if (!moved[i])
+            {
+                this->entries_.erase(it);
+                continue;
+            }
+            it->second.segment = moved[i]->first;
+            it->second.offset = moved[i]->second;
+            this->segments_[moved[i]->first].liveBytes += it->second.size;
+        }
+
+        for (auto id : sparse)
+        {
+            this->segments_.erase(id);
+            unusedFiles.push_back(this->segmentPath(id));
+        }
+        this->changesSinceFlush_++;
+    }
+
+    // The old segments are removed, so the index has to point to the new
+    // locations first. Readers that still hold an old segment keep reading
+    // it until they're done (or it's cleaned up with the next start).
+    this->writeIndex(0);
+    removeFiles(unusedFiles);
+}
+
+}  // namespace chatterino
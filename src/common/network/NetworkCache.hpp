@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// @brief A size-bounded on-disk cache for HTTP responses.
+///
+/// All entries are described by a single index file, which is read once when
+/// the cache is opened. Small entries are appended to shared segment files,
+/// larger ones get their own file. Once the cache grows past its budget, the
+/// least recently used entries are evicted and sparse segments are compacted.
+///
+/// Entries older than `MAX_FRESH_AGE` are reported as stale. If the server
+/// sent an ETag or Last-Modified header, they can be revalidated with a
+/// conditional request.
+///
+/// All methods are thread safe. The index is only locked to look up and
+/// update entries, files are read and written outside of that lock.
+class NetworkCache
+{
+public:
+    /// Entries older than this should be revalidated before they're used
+    static constexpr std::chrono::hours MAX_FRESH_AGE{24 * 7};
+    /// Entries up to this size are packed into segment files
+    static constexpr qint64 MAX_SEGMENT_ENTRY_SIZE = 64 * 1024;
+    /// A new segment is started once the current one exceeds this size
+    static constexpr qint64 MAX_SEGMENT_SIZE = 16 * 1024 * 1024;
+
+    struct Validators {
+        QByteArray etag;
+        QByteArray lastModified;
+
+        bool empty() const
+        {
+            return this->etag.isEmpty() && this->lastModified.isEmpty();
+        }
+    };
+
+    struct Hit {
+        QByteArray data;
+        Validators validators;
+        /// Set if the entry is older than MAX_FRESH_AGE
+        bool stale = false;
+    };
+
+    /// Opens (or creates) the cache in `directory`.
+    /// `legacyDirectory` is checked for files written by older versions,
+    /// which are moved into the cache when they're requested.
+    NetworkCache(QString directory, qint64 maxBytes,
+                 QString legacyDirectory = {});
+    /// Writes the index
+    ~NetworkCache();
+
+    NetworkCache(const NetworkCache &) = delete;
+    NetworkCache &operator=(const NetworkCache &) = delete;
+    NetworkCache(NetworkCache &&) = delete;
+    NetworkCache &operator=(NetworkCache &&) = delete;
+
+    /// Returns the cache for the given cache directory (the HTTP cache lives
+    /// in its `http` subdirectory). If the directory changed since the last
+    /// call, the previous cache is closed.
+    static std::shared_ptr<NetworkCache> forDirectory(
+        const QString &cacheDirectory);
+
+    /// Sets the budget of all caches returned by forDirectory
+    static void setGlobalMaxBytes(qint64 maxBytes);
+
+    /// Closes the cache returned by forDirectory (e.g. before deleting it)
+    static void closeGlobal();
+
+    std::optional<Hit> get(const QString &key);
+    void put(const QString &key, const QByteArray &data,
+             const Validators &validators);
+    /// Marks an entry as fresh again (after a "304 Not Modified")
+    void markRevalidated(const QString &key);
+    void remove(const QString &key);
+
+    void setMaxBytes(qint64 maxBytes);
+
+    /// The bytes used on disk (including unused space in segments)
+    qint64 diskBytes() const;
+    /// The number of entries in the cache
+    size_t size() const;
+
+    /// Writes the index to disk
+    void flush();
+
+private:
+    struct Entry {
+        /// The segment containing the data or -1 if it's in its own file
+        qint32 segment = -1;
+        qint64 offset = 0;
+        qint64 size = 0;
+        /// Milliseconds since epoch
+        qint64 storedAt = 0;
+        qint64 lastAccess = 0;
+        Validators validators;
+    };
+
+    /// A segment file opened for reading. Reads of different segments don't
+    /// wait for each other. Readers keep it open while the segment is removed.
+    struct SegmentReader {
+        std::mutex mutex;
+        QFile file;
+    };
+
+    struct Segment {
+        qint64 fileSize = 0;
+        qint64 liveBytes = 0;
+        std::shared_ptr<SegmentReader> reader;
+    };
+
+    QString segmentPath(qint32 segment) const;
+    QString entryPath(const QString &key) const;
+
+    void loadIndex();
+    /// Writes the index if at least `minChanges` were made since the last
+    /// write. `mutex_` must not be held.
+    void writeIndex(size_t minChanges);
+
+    /// Returns the reader for `segment`. `mutex_` must be held.
+    std::shared_ptr<SegmentReader> segmentReader(qint32 segment);
+    /// Reads the data of `entry`. `mutex_` must not be held.
+    std::optional<QByteArray> readEntry(const QString &key, const Entry &entry,
+                                        SegmentReader *reader) const;
+
+    /// Writes `data` and adds it to the index as the entry of `key`.
+    /// `mutex_` must not be held.
+    bool store(const QString &key, const QByteArray &data, Entry entry);
+    /// Appends `data` to the active segment and returns the segment and the
+    /// offset it was written to. `writeMutex_` must be held.
+    std::optional<std::pair<qint32, qint64>> appendToSegment(
+        const QByteArray &data);
+    /// Removes `entry` from the accounting. Files that aren't used anymore
+    /// are added to `unusedFiles`. `mutex_` must be held.
+    void dropEntry(const QString &key, const Entry &entry,
+                   std::vector<QString> &unusedFiles);
+
+    std::optional<Hit> importLegacy(const QString &key);
+
+    /// The bytes used on disk. `mutex_` must be held.
+    qint64 usedBytes() const;
+    /// Evicts entries until the cache is within its budget.
+    /// `mutex_` must be held.
+    void evict(std::vector<QString> &unusedFiles);
+    /// Moves the live entries of sparse segments into a new one until the
+    /// cache is within its budget. `mutex_` and `writeMutex_` must not be
+    /// held.
+    void compactSegments();
+
+    /// Guards the index (everything below except the active segment)
+    mutable std::mutex mutex_;
+    /// Guards the active segment. Taken before `mutex_` if both are needed.
+    std::mutex writeMutex_;
+    /// Only one thread compacts at a time
+    std::mutex compactMutex_;
+    /// Keeps index writes in order. Taken before `mutex_`.
+    std::mutex indexMutex_;
+
+    const QString directory_;
+    const QString legacyDirectory_;
+    qint64 maxBytes_;
+
+    std::unordered_map<QString, Entry> entries_;
+    std::map<qint32, Segment> segments_;
+
+    qint32 activeSegment_ = 0;
+    std::unique_ptr<QFile> activeWriter_;
+    qint64 activeSize_ = 0;
+
+    /// Bytes in standalone files
+    qint64 standaloneBytes_ = 0;
+    size_t changesSinceFlush_ = 0;
+};
+
+}  // namespace chatterino
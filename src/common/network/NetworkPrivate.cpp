@@ -5,10 +5,12 @@
 #include "common/network/NetworkPrivate.hpp"
 
 #include "Application.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/network/NetworkTask.hpp"
 #include "common/QLogging.hpp"
+#include "common/UniqueAccess.hpp"
 #include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
@@ -18,10 +20,12 @@
 #include <magic_enum/magic_enum.hpp>
 #include <QCryptographicHash>
 #include <QElapsedTimer>
-#include <QFile>
 #include <QNetworkReply>
 #include <QtConcurrent>
 
+#include <unordered_map>
+#include <vector>
+
 #ifdef NDEBUG
 constexpr qsizetype SLOW_HTTP_THRESHOLD = 30;
 #else
@@ -34,6 +38,13 @@ namespace {
 
 using namespace chatterino;
 
+/// GET requests that are currently loading, by their coalescing key. Each one
+/// holds the requests that are waiting for its result.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+UniqueAccess<
+    std::unordered_map<QString, std::vector<std::shared_ptr<NetworkData>>>>
+    IN_FLIGHT;
+
 void runCallback(bool concurrent, auto &&fn)
 {
     if (concurrent)
@@ -80,22 +91,45 @@ void loadCached(std::shared_ptr<NetworkData> &&data)
         return;
     }
 
-    QFile cachedFile(app->getPaths().cacheDirectory() + "/" + data->getHash());
+    // The hash must be computed before any conditional headers are added
+    auto key = data->getHash();
+    auto cache = NetworkCache::forDirectory(app->getPaths().cacheDirectory());
+    auto hit = cache->get(key);
 
-    if (!cachedFile.exists() || !cachedFile.open(QIODevice::ReadOnly))
+    if (!hit)
     {
         loadUncached(std::move(data));
         return;
     }
 
-    // XXX: check if bytes is empty?
-    QByteArray bytes = cachedFile.readAll();
+    if (hit->stale)
+    {
+        if (hit->validators.empty())
+        {
+            loadUncached(std::move(data));
+            return;
+        }
+
+        // Ask the server whether our copy is still up to date
+        if (!hit->validators.etag.isEmpty())
+        {
+            data->request.setRawHeader("If-None-Match", hit->validators.etag);
+        }
+        if (!hit->validators.lastModified.isEmpty())
+        {
+            data->request.setRawHeader("If-Modified-Since",
+                                       hit->validators.lastModified);
+        }
+        data->staleCacheData = std::move(hit->data);
+        loadUncached(std::move(data));
+        return;
+    }
 
     qCDebug(chatterinoHTTP).noquote() << data->typeString() << "[CACHED] 200"
                                       << data->request.url().toString();
 
     data->emitSuccess(
-        {NetworkResult::NetworkError::NoError, QVariant(200), bytes});
+        {NetworkResult::NetworkError::NoError, QVariant(200), hit->data});
     data->emitFinally();
 }
 
@@ -111,6 +145,9 @@ NetworkData::NetworkData()
 NetworkData::~NetworkData()
 {
     DebugCount::decrease(DebugObject::NetworkData);
+
+    // We finished without a result (e.g. because the app is quitting)
+    this->cancelCoalesced();
 }
 
 QString NetworkData::getHash()
@@ -135,8 +172,99 @@ QString NetworkData::getHash()
     return this->hash_;
 }
 
+bool NetworkData::coalesce(const std::shared_ptr<NetworkData> &data)
+{
+    if (data->requestType != NetworkRequestType::Get)
+    {
+        return false;
+    }
+
+    // Requests that would behave differently can't share a transfer. Unlike
+    // getHash(), this includes the header values (e.g. the credentials).
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(data->request.url().toString().toUtf8());
+    for (const auto &header : data->request.rawHeaderList())
+    {
+        hash.addData(header);
+        hash.addData(": ");
+        hash.addData(data->request.rawHeader(header));
+        hash.addData("\n");
+    }
+    auto key = QString::fromLatin1(hash.result().toHex());
+    if (data->cache)
+    {
+        key += u":cache";
+    }
+    if (data->timeout)
+    {
+        key += u':' + QString::number(data->timeout->count());
+    }
+
+    {
+        auto inFlight = IN_FLIGHT.access();
+        auto it = inFlight->find(key);
+        if (it != inFlight->end())
+        {
+            if (it->second.empty())
+            {
+                DebugCount::increase(DebugObject::HTTPRequestShared);
+            }
+            it->second.push_back(data);
+            DebugCount::increase(DebugObject::HTTPRequestCoalesced);
+            return true;
+        }
+
+        inFlight->emplace(key, std::vector<std::shared_ptr<NetworkData>>{});
+    }
+
+    data->coalescingKey_ = std::move(key);
+    return false;
+}
+
+void NetworkData::settleCoalesced(const NetworkResult &result, bool success)
+{
+    if (this->coalescingKey_.isEmpty())
+    {
+        return;
+    }
+
+    std::vector<std::shared_ptr<NetworkData>> waiting;
+    {
+        auto inFlight = IN_FLIGHT.access();
+        auto it = inFlight->find(this->coalescingKey_);
+        if (it != inFlight->end())
+        {
+            waiting = std::move(it->second);
+            inFlight->erase(it);
+        }
+    }
+    this->coalescingKey_.clear();
+
+    for (const auto &data : waiting)
+    {
+        auto copy = result;
+        if (success)
+        {
+            data->emitSuccess(std::move(copy));
+        }
+        else
+        {
+            data->emitError(std::move(copy));
+        }
+        data->emitFinally();
+    }
+}
+
+void NetworkData::cancelCoalesced()
+{
+    this->settleCoalesced(
+        {NetworkResult::NetworkError::OperationCanceledError, {}, {}}, false);
+}
+
 void NetworkData::emitSuccess(NetworkResult &&result)
 {
+    this->settleCoalesced(result, true);
+
     if (!this->onSuccess)
     {
         return;
@@ -174,6 +302,8 @@ void NetworkData::emitSuccess(NetworkResult &&result)
 
 void NetworkData::emitError(NetworkResult &&result)
 {
+    this->settleCoalesced(result, false);
+
     if (!this->onError)
     {
         return;
@@ -234,6 +364,11 @@ QString NetworkData::typeString() const
 
 void load(std::shared_ptr<NetworkData> &&data)
 {
+    if (NetworkData::coalesce(data))
+    {
+        return;
+    }
+
     if (data->cache)
     {
         std::ignore = QtConcurrent::run([data = std::move(data)]() mutable {
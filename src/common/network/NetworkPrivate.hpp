@@ -58,12 +58,28 @@ public:
     /// By default, there's no explicit timeout for the request.
     /// To set a timeout, use NetworkRequest's timeout method
     std::optional<std::chrono::milliseconds> timeout{};
+
+    /// Set while a stale cache entry is revalidated with a conditional
+    /// request. Used if the server responds with "304 Not Modified".
+    std::optional<QByteArray> staleCacheData;
+
 #ifndef NDEBUG
     bool ignoreSslErrors = false;  // for local eventsub
 #endif
 
     QString getHash();
 
+    /// Attaches `data` to an identical GET request that's already in flight.
+    /// Once that request finishes, its result is passed on to `data`'s
+    /// callbacks as well.
+    ///
+    /// Returns true if `data` was attached and must not be loaded.
+    static bool coalesce(const std::shared_ptr<NetworkData> &data);
+
+    /// Fails all requests that were coalesced with this one. Used if this
+    /// request won't emit a result.
+    void cancelCoalesced();
+
     void emitSuccess(NetworkResult &&result);
     void emitError(NetworkResult &&result);
     void emitFinally();
@@ -71,7 +87,12 @@ public:
     QString typeString() const;
 
 private:
+    /// Emits `result` to all requests that were coalesced with this one
+    void settleCoalesced(const NetworkResult &result, bool success);
+
     QString hash_;
+    /// Set while other requests can be coalesced with this one
+    QString coalescingKey_;
 };
 
 void load(std::shared_ptr<NetworkData> &&data);
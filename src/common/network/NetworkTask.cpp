@@ -5,6 +5,7 @@
 #include "common/network/NetworkTask.hpp"
 
 #include "Application.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
@@ -13,7 +14,6 @@
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
 
-#include <QFile>
 #include <QNetworkReply>
 #include <QtConcurrent>
 
@@ -37,6 +37,7 @@ void NetworkTask::run()
     this->reply_ = this->createReply();
     if (!this->reply_)
     {
+        this->data_->cancelCoalesced();
         this->deleteLater();
         return;
     }
@@ -159,34 +160,95 @@ void NetworkTask::logReply()
     }
 }
 
+std::shared_ptr<NetworkCache> NetworkTask::cache() const
+{
+    if (isAppAboutToQuit())
+    {
+        qCDebug(chatterinoHTTP)
+            << "Skipping cache access for" << this->data_->request.url()
+            << "because app is about to quit";
+        return nullptr;
+    }
+
+    auto *app = tryGetApp();
+    if (!app)
+    {
+        qCDebug(chatterinoHTTP)
+            << "Skipping cache access for" << this->data_->request.url()
+            << "because app is null";
+        return nullptr;
+    }
+
+    return NetworkCache::forDirectory(app->getPaths().cacheDirectory());
+}
+
 void NetworkTask::writeToCache(const QByteArray &bytes) const
 {
-    std::ignore = QtConcurrent::run([data = this->data_, bytes] {
-        if (isAppAboutToQuit())
-        {
-            qCDebug(chatterinoHTTP)
-                << "Skipping cache write for" << data->request.url()
-                << "because app is about to quit";
-            return;
-        }
+    auto cache = this->cache();
+    if (!cache)
+    {
+        return;
+    }
 
-        auto *app = tryGetApp();
-        if (!app)
+    NetworkCache::Validators validators{
+        .etag = this->reply_->rawHeader("ETag"),
+        .lastModified = this->reply_->rawHeader("Last-Modified"),
+    };
+
+    std::ignore = QtConcurrent::run([cache = std::move(cache),
+                                     key = this->data_->getHash(), bytes,
+                                     validators = std::move(validators)] {
+        cache->put(key, bytes, validators);
+    });
+}
+
+void NetworkTask::finishRevalidation(const QVariant &status)
+{
+    auto *reply = this->reply_;
+    auto cache = this->cache();
+
+    auto statusCode = status.toInt();
+    if (reply->error() != QNetworkReply::NoError &&
+        (statusCode == 404 || statusCode == 410))
+    {
+        // The server doesn't want us to have this anymore
+        if (cache)
         {
-            qCDebug(chatterinoHTTP)
-                << "Skipping cache write for" << data->request.url()
-                << "because app is null";
-            return;
+            std::ignore =
+                QtConcurrent::run([cache, key = this->data_->getHash()] {
+                    cache->remove(key);
+                });
         }
+        this->logReply();
+        this->data_->emitError({reply->error(), status, reply->readAll()});
+        this->data_->emitFinally();
+        return;
+    }
 
-        QFile cachedFile(app->getPaths().cacheDirectory() + "/" +
-                         data->getHash());
-
-        if (cachedFile.open(QIODevice::WriteOnly))
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        // We couldn't reach the server or it had a temporary problem (e.g. a
+        // 5xx or 429), so the stale copy is the best we have
+        qCDebug(chatterinoHTTP).noquote()
+            << this->data_->typeString() << "[STALE]" << reply->error()
+            << status << this->data_->request.url().toString();
+    }
+    else
+    {
+        this->logReply();
+        if (cache)
         {
-            cachedFile.write(bytes);
+            std::ignore =
+                QtConcurrent::run([cache, key = this->data_->getHash()] {
+                    cache->markRevalidated(key);
+                });
         }
-    });
+    }
+
+    DebugCount::increase(DebugObject::HTTPRequestSuccess);
+    this->data_->emitSuccess({QNetworkReply::NoError, QVariant(200),
+                              std::move(*this->data_->staleCacheData)});
+    this->data_->emitFinally();
 }
 
 void NetworkTask::timeout()
@@ -224,6 +286,15 @@ void NetworkTask::finished()
         qCDebug(chatterinoHTTP).noquote()
             << this->data_->typeString() << "[cancelled]"
             << this->data_->request.url().toString();
+        // After a timeout, they already got the error
+        this->data_->cancelCoalesced();
+        return;
+    }
+
+    if (this->data_->staleCacheData &&
+        (status.toInt() == 304 || reply->error() != QNetworkReply::NoError))
+    {
+        this->finishRevalidation(status);
         return;
     }
 
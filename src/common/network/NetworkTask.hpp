@@ -6,6 +6,7 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QVariant>
 
 #include <memory>
 
@@ -13,6 +14,7 @@ class QNetworkReply;
 
 namespace chatterino {
 
+class NetworkCache;
 class NetworkData;
 
 }  // namespace chatterino
@@ -40,7 +42,11 @@ private:
     QNetworkReply *createReply();
 
     void logReply();
+    /// Returns nullptr if the app is about to quit
+    std::shared_ptr<NetworkCache> cache() const;
     void writeToCache(const QByteArray &bytes) const;
+    /// Finishes a conditional request for a stale cache entry
+    void finishRevalidation(const QVariant &status);
 
     std::shared_ptr<NetworkData> data_;
     QNetworkReply *reply_{};  // parent: default (accessManager)
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/completion/sources/CompletionIndex.hpp"
+
+#include <algorithm>
+
+namespace {
+
+/// Case folds `str` one code point at a time, like case-insensitive
+/// comparisons of QStrings do
+void appendCaseFolded(QString &out, QStringView str)
+{
+    for (auto codePoint : str.toUcs4())
+    {
+        auto folded = QChar::toCaseFolded(codePoint);
+        if (QChar::requiresSurrogates(folded))
+        {
+            out.append(QChar(QChar::highSurrogate(folded)));
+            out.append(QChar(QChar::lowSurrogate(folded)));
+        }
+        else
+        {
+            out.append(QChar(static_cast<char16_t>(folded)));
+        }
+    }
+}
+
+bool containsSurrogates(QStringView str)
+{
+    return std::ranges::any_of(str, [](QChar c) {
+        return c.isSurrogate();
+    });
+}
+
+}  // namespace
+
+namespace chatterino::completion {
+
+CompletionIndex::CompletionIndex(const std::vector<QString> &names, Mode mode)
+    : size_(names.size())
+{
+    for (uint32_t i = 0; i < names.size(); i++)
+    {
+        auto start = static_cast<uint32_t>(this->text_.size());
+        appendCaseFolded(this->text_, names[i]);
+        auto end = static_cast<uint32_t>(this->text_.size());
+
+        if (mode == Mode::Prefix)
+        {
+            this->entries_.push_back({start, end, i});
+            continue;
+        }
+
+        for (auto offset = start; offset < end; offset++)
+        {
+            // suffixes only start at code points
+            if (!this->text_.at(offset).isLowSurrogate())
+            {
+                this->entries_.push_back({offset, end, i});
+            }
+        }
+    }
+
+    std::ranges::sort(this->entries_,
+                      [this](const Entry &a, const Entry &b) {
+                          return this->suffix(a).compare(this->suffix(b)) < 0;
+                      });
+}
+
+std::optional<std::vector<uint32_t>> CompletionIndex::find(
+    QStringView query) const
+{
+    // Folding these per code point might not agree with how QString compares
+    // them, so don't try to be clever
+    if (query.isEmpty() || containsSurrogates(query))
+    {
+        return std::nullopt;
+    }
+
+    QString folded;
+    appendCaseFolded(folded, query);
+
+    auto it = std::ranges::lower_bound(
+        this->entries_, QStringView(folded), [](QStringView a, QStringView b) {
+            return a.compare(b) < 0;
+        },
+        [this](const Entry &entry) {
+            return this->suffix(entry);
+        });
+
+    std::vector<uint32_t> names;
+    for (; it != this->entries_.end() && this->suffix(*it).startsWith(folded);
+         it++)
+    {
+        names.push_back(it->name);
+    }
+
+    std::ranges::sort(names);
+    auto [first, last] = std::ranges::unique(names);
+    names.erase(first, last);
+
+    return names;
+}
+
+size_t CompletionIndex::size() const
+{
+    return this->size_;
+}
+
+QStringView CompletionIndex::suffix(const Entry &entry) const
+{
+    return QStringView(this->text_).mid(entry.offset, entry.end - entry.offset);
+}
+
+}  // namespace chatterino::completion
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace chatterino::completion {
+
+/// @brief Finds the names that start with or contain a query without looking
+///        at every name.
+///
+/// Names are case folded and either the names themselves (prefix mode) or
+/// all of their suffixes (substring mode) are kept sorted, so a query is a
+/// binary search followed by a walk over the matching range.
+///
+/// Results are candidates: every name that case-insensitively starts with or
+/// contains the query is returned, but callers still have to apply their
+/// exact comparison. The index is immutable once built.
+class CompletionIndex
+{
+public:
+    enum class Mode : uint8_t {
+        Prefix,
+        Substring,
+    };
+
+    CompletionIndex() = default;
+    CompletionIndex(const std::vector<QString> &names, Mode mode);
+
+    /// @brief Returns the indices of the candidate names in ascending order.
+    ///
+    /// std::nullopt is returned if the index can't narrow down the names for
+    /// this query, in which case every name is a candidate.
+    std::optional<std::vector<uint32_t>> find(QStringView query) const;
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        /// Start of the suffix in text_
+        uint32_t offset;
+        /// End of the name in text_
+        uint32_t end;
+        uint32_t name;
+    };
+
+    QStringView suffix(const Entry &entry) const;
+
+    size_t size_ = 0;
+    /// All case folded names, one after another
+    QString text_;
+    /// Sorted by suffix
+    std::vector<Entry> entries_;
+};
+
+}  // namespace chatterino::completion
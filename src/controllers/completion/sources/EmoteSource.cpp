@@ -6,6 +6,7 @@
 
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/completion/sources/CompletionIndex.hpp"
 #include "controllers/completion/sources/Helpers.hpp"
 #include "controllers/emotes/EmoteController.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
@@ -20,31 +21,118 @@
 
 #include <QSet>
 
+#include <map>
+#include <mutex>
+
 namespace chatterino::completion {
 
+/// The completion items of one emote map or the emojis
+struct EmoteSegment {
+    std::vector<EmoteItem> items;
+    /// Index over the search names of the items
+    CompletionIndex index;
+};
+
 namespace {
 
-void addEmotes(std::vector<EmoteItem> &out, const EmoteMap &map,
-               const QString &providerName)
+std::shared_ptr<const EmoteSegment> makeSegment(std::vector<EmoteItem> items)
 {
-    for (auto &&emote : map)
+    std::vector<QString> names;
+    names.reserve(items.size());
+    for (const auto &item : items)
     {
-        out.push_back({.emote = emote.second,
-                       .searchName = emote.first.string,
-                       .tabCompletionName = emote.first.string,
-                       .displayName = emote.second->name.string,
-                       .providerName = providerName,
-                       .isEmoji = false});
+        names.push_back(item.searchName);
     }
+
+    return std::make_shared<const EmoteSegment>(EmoteSegment{
+        .items = std::move(items),
+        .index = CompletionIndex(names, CompletionIndex::Mode::Substring),
+    });
 }
 
-void addEmojis(std::vector<EmoteItem> &out, const std::vector<EmojiPtr> &map)
+/// Returns the segment for an emote map. Segments are cached for as long as
+/// their map is alive, so only maps that changed since the last completion
+/// have to be indexed again.
+std::shared_ptr<const EmoteSegment> emoteSegment(
+    const std::shared_ptr<const EmoteMap> &map, const QString &providerName)
 {
-    for (const auto &emoji : map)
+    struct CachedSegment {
+        std::weak_ptr<const EmoteMap> map;
+        std::shared_ptr<const EmoteSegment> segment;
+    };
+
+    static std::mutex mutex;
+    static std::map<std::pair<const EmoteMap *, QString>, CachedSegment> cache;
+
+    std::lock_guard lock(mutex);
+    std::erase_if(cache, [](const auto &entry) {
+        return entry.second.map.expired();
+    });
+
+    auto key = std::make_pair(map.get(), providerName);
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+        return it->second.segment;
+    }
+
+    std::vector<EmoteItem> items;
+    items.reserve(map->size());
+    for (auto &&emote : *map)
+    {
+        items.push_back({.emote = emote.second,
+                         .searchName = emote.first.string,
+                         .tabCompletionName = emote.first.string,
+                         .displayName = emote.second->name.string,
+                         .providerName = providerName,
+                         .isEmoji = false});
+    }
+
+    auto segment = makeSegment(std::move(items));
+    cache.emplace(key, CachedSegment{map, segment});
+    return segment;
+}
+
+/// Returns the segment for all emoji short codes. It's rebuilt when the
+/// emoji set changes the emotes of the emojis.
+std::shared_ptr<const EmoteSegment> emojiSegment(
+    const std::vector<EmojiPtr> &emojis)
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const EmoteSegment> cache;
+
+    std::lock_guard lock(mutex);
+
+    auto isCurrent = [&] {
+        if (!cache)
+        {
+            return false;
+        }
+        size_t i = 0;
+        for (const auto &emoji : emojis)
+        {
+            for (size_t j = 0; j < emoji->shortCodes.size(); j++, i++)
+            {
+                if (i >= cache->items.size() ||
+                    cache->items[i].emote != emoji->emote)
+                {
+                    return false;
+                }
+            }
+        }
+        return i == cache->items.size();
+    };
+    if (isCurrent())
+    {
+        return cache;
+    }
+
+    std::vector<EmoteItem> items;
+    for (const auto &emoji : emojis)
     {
         for (auto &&shortCode : emoji->shortCodes)
         {
-            out.push_back(
+            items.push_back(
                 {.emote = emoji->emote,
                  .searchName = shortCode,
                  .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
@@ -52,7 +140,10 @@ void addEmojis(std::vector<EmoteItem> &out, const std::vector<EmojiPtr> &map)
                  .providerName = "Emoji",
                  .isEmoji = true});
         }
-    };
+    }
+
+    cache = makeSegment(std::move(items));
+    return cache;
 }
 
 QString normalizeChannelName(QString name)
@@ -111,10 +202,39 @@ EmoteSource::EmoteSource(const Channel *channel,
 void EmoteSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (!this->strategy_)
+    {
+        return;
+    }
+
+    // Every strategy only completes emotes whose name contains the query
+    // without its leading ':' and '~', so only those are passed on
+    QStringView required = query;
+    if (required.startsWith(':'))
+    {
+        required = required.mid(1);
+    }
+    if (required.startsWith('~'))
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        required = required.mid(1);
     }
+
+    std::vector<EmoteItem> candidates;
+    for (const auto &segment : this->segments_)
+    {
+        auto found = segment->index.find(required);
+        if (!found)
+        {
+            this->strategy_->apply(this->items_, this->output_, query);
+            return;
+        }
+        for (auto i : *found)
+        {
+            candidates.push_back(segment->items[i]);
+        }
+    }
+
+    this->strategy_->apply(candidates, this->output_, query);
 }
 
 void EmoteSource::addToListModel(GenericListModel &model, size_t maxCount) const
@@ -139,7 +259,6 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
 {
     auto *app = getApp();
 
-    std::vector<EmoteItem> emotes;
     const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
     // returns true also for special Twitch channels (/live, /mentions, /whispers, etc.)
     if (channel->isTwitchChannel())
@@ -148,24 +267,24 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
         {
             if (auto twitch = tc->localTwitchEmotes())
             {
-                addEmotes(emotes, *twitch, "Local Twitch Emotes");
+                this->addSegment(twitch, "Local Twitch Emotes");
             }
 
             auto user = getApp()->getAccounts()->twitch.getCurrent();
-            addEmotes(emotes, **user->accessEmotes(), "Twitch Emote");
+            this->addSegment(*user->accessEmotes(), "Twitch Emote");
 
             // TODO extract "Channel {BetterTTV,7TV,FrankerFaceZ}" text into a #define.
             if (auto bttv = tc->bttvEmotes())
             {
-                addEmotes(emotes, *bttv, "Channel BetterTTV");
+                this->addSegment(bttv, "Channel BetterTTV");
             }
             if (auto ffz = tc->ffzEmotes())
             {
-                addEmotes(emotes, *ffz, "Channel FrankerFaceZ");
+                this->addSegment(ffz, "Channel FrankerFaceZ");
             }
             if (auto seventv = tc->seventvEmotes())
             {
-                addEmotes(emotes, *seventv, "Channel 7TV");
+                this->addSegment(seventv, "Channel 7TV");
             }
         }
 
@@ -206,42 +325,53 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
 
                 if (auto bttv = other->bttvEmotes())
                 {
-                    addEmotes(emotes, *bttv,
-                              QString("Cross-channel BetterTTV (%1)")
-                                  .arg(sourceChannelName));
+                    this->addSegment(bttv,
+                                     QString("Cross-channel BetterTTV (%1)")
+                                         .arg(sourceChannelName));
                 }
                 if (auto ffz = other->ffzEmotes())
                 {
-                    addEmotes(emotes, *ffz,
-                              QString("Cross-channel FrankerFaceZ (%1)")
-                                  .arg(sourceChannelName));
+                    this->addSegment(ffz,
+                                     QString("Cross-channel FrankerFaceZ (%1)")
+                                         .arg(sourceChannelName));
                 }
                 if (auto seventv = other->seventvEmotes())
                 {
-                    addEmotes(emotes, *seventv,
-                              QString("Cross-channel 7TV (%1)")
-                                  .arg(sourceChannelName));
+                    this->addSegment(seventv,
+                                     QString("Cross-channel 7TV (%1)")
+                                         .arg(sourceChannelName));
                 }
             });
         }
 
         if (auto bttvG = app->getBttvEmotes()->emotes())
         {
-            addEmotes(emotes, *bttvG, "Global BetterTTV");
+            this->addSegment(bttvG, "Global BetterTTV");
         }
         if (auto ffzG = app->getFfzEmotes()->emotes())
         {
-            addEmotes(emotes, *ffzG, "Global FrankerFaceZ");
+            this->addSegment(ffzG, "Global FrankerFaceZ");
         }
         if (auto seventvG = app->getSeventvEmotes()->globalEmotes())
         {
-            addEmotes(emotes, *seventvG, "Global 7TV");
+            this->addSegment(seventvG, "Global 7TV");
         }
     }
 
-    addEmojis(emotes, app->getEmotes()->getEmojis()->getEmojis());
+    this->segments_.push_back(
+        emojiSegment(app->getEmotes()->getEmojis()->getEmojis()));
+
+    for (const auto &segment : this->segments_)
+    {
+        this->items_.insert(this->items_.end(), segment->items.begin(),
+                            segment->items.end());
+    }
+}
 
-    this->items_ = std::move(emotes);
+void EmoteSource::addSegment(const std::shared_ptr<const EmoteMap> &map,
+                             const QString &providerName)
+{
+    this->segments_.push_back(emoteSegment(map, providerName));
 }
 
 const std::vector<EmoteItem> &EmoteSource::output() const
@@ -32,6 +32,8 @@ struct EmoteItem {
     bool isEmoji{};
 };
 
+struct EmoteSegment;
+
 class EmoteSource : public Source
 {
 public:
@@ -56,10 +58,16 @@ public:
 
 private:
     void initializeFromChannel(const Channel *channel);
+    void addSegment(const std::shared_ptr<const EmoteMap> &map,
+                    const QString &providerName);
 
     std::unique_ptr<EmoteStrategy> strategy_;
     ActionCallback callback_;
 
+    /// Items of each emote map, indexed by name. Segments are shared between
+    /// sources and only rebuilt when their emote map changes.
+    std::vector<std::shared_ptr<const EmoteSegment>> segments_{};
+    /// All items of the segments, in the same order
     std::vector<EmoteItem> items_{};
     std::vector<EmoteItem> output_{};
 };
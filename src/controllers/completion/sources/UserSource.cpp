@@ -25,10 +25,32 @@ UserSource::UserSource(const Channel *channel,
 void UserSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (!this->strategy_)
+    {
+        return;
+    }
+
+    // User names are completed by their lowercase prefix without the '@'
+    QString prefix = query.toLower();
+    if (prefix.startsWith('@'))
+    {
+        prefix = prefix.mid(1);
+    }
+
+    auto found = this->index_.find(prefix);
+    if (!found)
     {
         this->strategy_->apply(this->items_, this->output_, query);
+        return;
+    }
+
+    std::vector<UserItem> candidates;
+    candidates.reserve(found->size());
+    for (auto i : *found)
+    {
+        candidates.push_back(this->items_[i]);
     }
+    this->strategy_->apply(candidates, this->output_, query);
 }
 
 void UserSource::addToListModel(GenericListModel &model, size_t maxCount) const
@@ -77,6 +99,14 @@ void UserSource::initializeFromChannel(const Channel *channel)
             this->items_.emplace_back(tc->getName(), tc->getDisplayName());
         }
     }
+
+    std::vector<QString> names;
+    names.reserve(this->items_.size());
+    for (const auto &user : this->items_)
+    {
+        names.push_back(user.first);
+    }
+    this->index_ = CompletionIndex(names, CompletionIndex::Mode::Prefix);
 }
 
 const std::vector<UserItem> &UserSource::output() const
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "common/Channel.hpp"
+#include "controllers/completion/sources/CompletionIndex.hpp"
 #include "controllers/completion/sources/Source.hpp"
 #include "controllers/completion/strategies/Strategy.hpp"
 
@@ -51,6 +52,8 @@ private:
     bool prependAt_;
 
     std::vector<UserItem> items_{};
+    /// Index over the lowercase names of items_
+    CompletionIndex index_{};
     std::vector<UserItem> output_{};
 };
 
@@ -76,7 +76,8 @@ int costOfEmote(QStringView query, QStringView emote, bool prioritizeUpper)
 void completeEmotes(
     const std::vector<EmoteItem> &items, std::vector<EmoteItem> &output,
     QStringView query, bool ignoreColonForCost, bool ignoreTildeForCost,
-    const std::function<bool(EmoteItem, Qt::CaseSensitivity)> &matchingFunction)
+    const std::function<bool(const EmoteItem &, Qt::CaseSensitivity)>
+        &matchingFunction)
 {
     // Given these emotes: pajaW, PAJAW
     // There are a few cases of input:
@@ -32,7 +32,7 @@ public:
 
     bool valid() const;
 
-    bool filter(const filters::ContextMap &context) const;
+    bool filter(const filters::FilterContext &context) const;
 
     bool operator==(const FilterRecord &other) const;
 
@@ -5,6 +5,7 @@
 #include "controllers/filters/FilterSet.hpp"
 
 #include "controllers/filters/FilterRecord.hpp"
+#include "controllers/filters/lang/FilterContext.hpp"
 #include "singletons/Settings.hpp"
 
 namespace chatterino {
@@ -46,7 +47,8 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
-    filters::ContextMap context = filters::buildContextMap(m, channel.get());
+    // identifiers are computed once the first filter uses them
+    filters::FilterContext context(*m, channel.get());
     for (const auto &f : this->filters_.values())
     {
         if (!f->valid() || !f->filter(context))
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "controllers/filters/lang/expressions/Expression.hpp"
+#include "controllers/filters/lang/Program.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
 #include <QString>
@@ -28,8 +29,12 @@ namespace chatterino::filters {
 // i.e. if all the variables and operators being used have compatible types.
 extern const QMap<QString, Type> MESSAGE_TYPING_CONTEXT;
 
+/// Computes the value of every identifier. Filtering only computes the ones
+/// a filter uses (see FilterContext).
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel);
 
+class FilterContext;
+
 class Filter;
 struct FilterError {
     QString message;
@@ -43,6 +48,7 @@ public:
     static FilterResult fromString(const QString &str);
 
     Type returnType() const;
+    QVariant execute(const FilterContext &context) const;
     QVariant execute(const ContextMap &context) const;
 
     QString filterString() const;
@@ -53,6 +59,7 @@ private:
 
     ExpressionPtr expression_;
     Type returnType_;
+    Program program_;
 };
 
 }  // namespace chatterino::filters
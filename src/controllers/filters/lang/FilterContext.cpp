@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/filters/lang/FilterContext.hpp"
+
+#include "Application.hpp"
+#include "common/Channel.hpp"
+#include "common/Literals.hpp"
+#include "messages/Message.hpp"
+#include "providers/twitch/ChannelPointReward.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+#include "providers/twitch/TwitchIrcServer.hpp"
+
+#include <QHash>
+
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+using namespace chatterino::filters;
+using namespace literals;
+
+struct Subscription {
+    bool subscribed = false;
+    int length = 0;
+};
+
+Subscription subscription(const Message &m)
+{
+    Subscription sub;
+    for (const auto &subBadge : {u"subscriber"_s, u"founder"_s})
+    {
+        bool hasBadge = std::ranges::any_of(m.twitchBadges, [&](const auto &e) {
+            return e.key_ == subBadge;
+        });
+        if (!hasBadge)
+        {
+            continue;
+        }
+        sub.subscribed = true;
+        auto it = m.twitchBadgeInfos.find(subBadge);
+        if (it != m.twitchBadgeInfos.end())
+        {
+            sub.length = it->second.toInt();
+        }
+    }
+    return sub;
+}
+
+template <MessageFlag flag>
+QVariant hasFlag(const Message &m, Channel * /*channel*/)
+{
+    return m.flags.has(flag);
+}
+
+}  // namespace
+
+namespace chatterino::filters {
+
+std::span<const Identifier, IDENTIFIER_COUNT> identifiers()
+{
+    /*
+     * Looking to add a new identifier to filters? Here's what to do:
+     *  1. Update VALID_IDENTIFIERS_MAP in Tokenizer.cpp
+     *  2. Add the identifier, its type and how to compute it to the list below
+     *  3. Update IDENTIFIER_COUNT in FilterContext.hpp
+     */
+    static const std::array<Identifier, IDENTIFIER_COUNT> IDENTIFIERS{{
+        {
+            u"author.badges"_s,
+            Type::StringList,
+            [](const Message &m, Channel *) -> QVariant {
+                QStringList badges;
+                badges.reserve(static_cast<qsizetype>(m.twitchBadges.size()));
+                for (const auto &e : m.twitchBadges)
+                {
+                    badges << e.key_;
+                }
+                return badges;
+            },
+        },
+        {
+            u"author.external_badges"_s,
+            Type::StringList,
+            [](const Message &m, Channel *) -> QVariant {
+                return m.externalBadges;
+            },
+        },
+        {
+            u"author.color"_s,
+            Type::Color,
+            [](const Message &m, Channel *) -> QVariant {
+                return m.usernameColor;
+            },
+        },
+        {
+            u"author.name"_s,
+            Type::String,
+            [](const Message &m, Channel *) -> QVariant {
+                return m.displayName;
+            },
+        },
+        {
+            u"author.user_id"_s,
+            Type::String,
+            [](const Message &m, Channel *) -> QVariant {
+                return m.userID;
+            },
+        },
+        {
+            u"author.no_color"_s,
+            Type::Bool,
+            [](const Message &m, Channel *) -> QVariant {
+                return !m.usernameColor.isValid();
+            },
+        },
+        {
+            u"author.subbed"_s,
+            Type::Bool,
+            [](const Message &m, Channel *) -> QVariant {
+                return subscription(m).subscribed;
+            },
+        },
+        {
+            u"author.sub_length"_s,
+            Type::Int,
+            [](const Message &m, Channel *) -> QVariant {
+                return subscription(m).length;
+            },
+        },
+        {
+            u"channel.name"_s,
+            Type::String,
+            [](const Message &m, Channel *) -> QVariant {
+                return m.channelName;
+            },
+        },
+        {
+            u"channel.watching"_s,
+            Type::Bool,
+            [](const Message &m, Channel *) -> QVariant {
+                const auto &watching =
+                    getApp()->getTwitch()->getWatchingChannel().get();
+                return !watching->getName().isEmpty() &&
+                       watching->getName().compare(
+                           m.channelName, Qt::CaseInsensitive) == 0;
+            },
+        },
+        {
+            u"channel.live"_s,
+            Type::Bool,
+            [](const Message & /*m*/, Channel *channel) -> QVariant {
+                auto *tc = dynamic_cast<TwitchChannel *>(channel);
+                if (channel && !channel->isEmpty() && tc)
+                {
+                    return tc->isLive();
+                }
+                return false;
+            },
+        },
+        {u"flags.action"_s, Type::Bool, hasFlag<MessageFlag::Action>},
+        {u"flags.highlighted"_s, Type::Bool, hasFlag<MessageFlag::Highlighted>},
+        {
+            u"flags.points_redeemed"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::RedeemedHighlight>,
+        },
+        {
+            u"flags.sub_message"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::Subscription>,
+        },
+        {u"flags.system_message"_s, Type::Bool, hasFlag<MessageFlag::System>},
+        {
+            u"flags.reward_message"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::RedeemedChannelPointReward>,
+        },
+        {
+            u"flags.first_message"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::FirstMessage>,
+        },
+        {
+            u"flags.elevated_message"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::ElevatedMessage>,
+        },
+        {
+            u"flags.hype_chat"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::ElevatedMessage>,
+        },
+        {
+            u"flags.cheer_message"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::CheerMessage>,
+        },
+        {u"flags.whisper"_s, Type::Bool, hasFlag<MessageFlag::Whisper>},
+        {u"flags.reply"_s, Type::Bool, hasFlag<MessageFlag::ReplyMessage>},
+        {u"flags.automod"_s, Type::Bool, hasFlag<MessageFlag::AutoMod>},
+        {
+            u"flags.restricted"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::RestrictedMessage>,
+        },
+        {
+            u"flags.monitored"_s,
+            Type::Bool,
+            hasFlag<MessageFlag::MonitoredMessage>,
+        },
+        {u"flags.shared"_s, Type::Bool, hasFlag<MessageFlag::SharedMessage>},
+        {u"flags.similar"_s, Type::Bool, hasFlag<MessageFlag::Similar>},
+        {
+            u"message.content"_s,
+            Type::String,
+            [](const Message &m, Channel *) -> QVariant {
+                return m.messageText;
+            },
+        },
+        {
+            u"message.length"_s,
+            Type::Int,
+            [](const Message &m, Channel *) -> QVariant {
+                return m.messageText.length();
+            },
+        },
+        {
+            u"reward.title"_s,
+            Type::String,
+            [](const Message &m, Channel *) -> QVariant {
+                if (m.reward != nullptr)
+                {
+                    return m.reward->title;
+                }
+                return "";
+            },
+        },
+        {
+            u"reward.cost"_s,
+            Type::Int,
+            [](const Message &m, Channel *) -> QVariant {
+                if (m.reward != nullptr)
+                {
+                    return m.reward->cost;
+                }
+                return -1;
+            },
+        },
+        {
+            u"reward.id"_s,
+            Type::String,
+            [](const Message &m, Channel *) -> QVariant {
+                if (m.reward != nullptr)
+                {
+                    return m.reward->id;
+                }
+                return "";
+            },
+        },
+    }};
+
+    return IDENTIFIERS;
+}
+
+std::optional<size_t> findIdentifier(const QString &name)
+{
+    static const auto indices = [] {
+        QHash<QString, size_t> map;
+        for (size_t i = 0; i < IDENTIFIER_COUNT; i++)
+        {
+            map.insert(identifiers()[i].name, i);
+        }
+        return map;
+    }();
+
+    auto it = indices.find(name);
+    if (it == indices.end())
+    {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+FilterContext::FilterContext(const Message &message, Channel *channel)
+    : message_(&message)
+    , channel_(channel)
+{
+}
+
+FilterContext::FilterContext(const ContextMap &map)
+    : map_(&map)
+{
+}
+
+const QVariant &FilterContext::value(size_t index) const
+{
+    auto &value = this->values_.at(index);
+    if (!value)
+    {
+        if (this->map_ != nullptr)
+        {
+            value = this->map_->value(identifiers()[index].name);
+        }
+        else
+        {
+            value =
+                identifiers()[index].resolve(*this->message_, this->channel_);
+        }
+    }
+    return *value;
+}
+
+}  // namespace chatterino::filters
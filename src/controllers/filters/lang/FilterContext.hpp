@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "controllers/filters/lang/Types.hpp"
+
+#include <QString>
+#include <QVariant>
+
+#include <array>
+#include <optional>
+#include <span>
+
+namespace chatterino {
+
+class Channel;
+struct Message;
+
+}  // namespace chatterino
+
+namespace chatterino::filters {
+
+/// An identifier filters can use (e.g. author.name)
+struct Identifier {
+    QString name;
+    Type type;
+    /// Computes the value of the identifier for a message
+    QVariant (*resolve)(const Message &message, Channel *channel);
+};
+
+constexpr size_t IDENTIFIER_COUNT = 33;
+
+/// All identifiers, see the comment in FilterContext.cpp on how to add one
+std::span<const Identifier, IDENTIFIER_COUNT> identifiers();
+
+/// Returns the index of the identifier called `name` in identifiers()
+std::optional<size_t> findIdentifier(const QString &name);
+
+/// @brief The values of identifiers while a message is filtered.
+///
+/// Values are only computed when a filter uses them. They're cached, so the
+/// other filters of a set don't compute them again.
+class FilterContext
+{
+public:
+    FilterContext(const Message &message, Channel *channel);
+
+    /// Takes the values from `map`. Identifiers missing from it are null.
+    explicit FilterContext(const ContextMap &map);
+
+    /// Returns the value of the identifier at `index` in identifiers()
+    const QVariant &value(size_t index) const;
+
+private:
+    const Message *message_ = nullptr;
+    Channel *channel_ = nullptr;
+    const ContextMap *map_ = nullptr;
+
+    mutable std::array<std::optional<QVariant>, IDENTIFIER_COUNT> values_;
+};
+
+}  // namespace chatterino::filters
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/filters/lang/Program.hpp"
+
+#include "controllers/filters/lang/expressions/BinaryOperation.hpp"
+#include "controllers/filters/lang/expressions/Expression.hpp"
+#include "controllers/filters/lang/expressions/ListExpression.hpp"
+#include "controllers/filters/lang/expressions/UnaryOperation.hpp"
+#include "controllers/filters/lang/FilterContext.hpp"
+#include "controllers/filters/lang/Types.hpp"
+
+#include <QVarLengthArray>
+
+#include <cassert>
+
+namespace chatterino::filters {
+
+Program Program::compile(const Expression &expression)
+{
+    Compiler compiler;
+    auto result = expression.compile(compiler);
+    return compiler.finish(result);
+}
+
+QVariant Program::execute(const FilterContext &context) const
+{
+    QVarLengthArray<QVariant, 16> registers(this->registerCount_);
+
+    auto load = [&](Operand operand) -> const QVariant & {
+        if (operand.kind == Operand::Kind::Register)
+        {
+            return registers[operand.index];
+        }
+        if (operand.kind == Operand::Kind::Identifier)
+        {
+            return context.value(operand.index);
+        }
+        return this->constants_[operand.index];
+    };
+
+    for (size_t pc = 0; pc < this->instructions_.size(); pc++)
+    {
+        const auto &instruction = this->instructions_[pc];
+        switch (instruction.code)
+        {
+            case Instruction::Code::Unary:
+                registers[instruction.dest] = UnaryOperation::evaluate(
+                    instruction.op, load(instruction.a));
+                break;
+
+            case Instruction::Code::Binary:
+                registers[instruction.dest] = BinaryOperation::evaluate(
+                    instruction.op, load(instruction.a), load(instruction.b));
+                break;
+
+            case Instruction::Code::List: {
+                QList<QVariant> elements;
+                elements.reserve(instruction.count);
+                for (size_t i = instruction.first;
+                     i < instruction.first + instruction.count; i++)
+                {
+                    elements.append(load(this->listOperands_[i]));
+                }
+                registers[instruction.dest] =
+                    ListExpression::evaluate(elements);
+            }
+            break;
+
+            case Instruction::Code::SkipIfFalse: {
+                const auto &value = load(instruction.a);
+                if (variantIs(value, QMetaType::Bool) && !value.toBool())
+                {
+                    registers[instruction.dest] = false;
+                    // the loop increments pc
+                    pc = instruction.first - 1;
+                }
+            }
+            break;
+        }
+    }
+
+    return load(this->result_);
+}
+
+size_t Program::size() const
+{
+    return this->instructions_.size();
+}
+
+Operand Compiler::constant(QVariant value)
+{
+    this->program_.constants_.push_back(std::move(value));
+    return {
+        .kind = Operand::Kind::Constant,
+        .index =
+            static_cast<uint16_t>(this->program_.constants_.size() - 1),
+    };
+}
+
+Operand Compiler::identifier(const QString &name)
+{
+    auto index = findIdentifier(name);
+    if (!index)
+    {
+        // unknown identifiers evaluate to null
+        return this->constant({});
+    }
+
+    return {
+        .kind = Operand::Kind::Identifier,
+        .index = static_cast<uint16_t>(*index),
+    };
+}
+
+Operand Compiler::unary(TokenType op, Operand operand)
+{
+    if (const auto *value = this->constantValue(operand))
+    {
+        return this->constant(UnaryOperation::evaluate(op, *value));
+    }
+
+    auto dest = this->allocateRegister();
+    this->program_.instructions_.push_back({
+        .code = Program::Instruction::Code::Unary,
+        .op = op,
+        .dest = dest,
+        .a = operand,
+    });
+    return {.kind = Operand::Kind::Register, .index = dest};
+}
+
+Operand Compiler::binary(TokenType op, Operand left, Operand right)
+{
+    const auto *leftValue = this->constantValue(left);
+    const auto *rightValue = this->constantValue(right);
+    if (leftValue && rightValue)
+    {
+        return this->constant(
+            BinaryOperation::evaluate(op, *leftValue, *rightValue));
+    }
+
+    auto dest = this->allocateRegister();
+    this->program_.instructions_.push_back({
+        .code = Program::Instruction::Code::Binary,
+        .op = op,
+        .dest = dest,
+        .a = left,
+        .b = right,
+    });
+    return {.kind = Operand::Kind::Register, .index = dest};
+}
+
+Operand Compiler::list(const std::vector<Operand> &elements)
+{
+    bool allConstant = true;
+    QList<QVariant> values;
+    for (const auto &element : elements)
+    {
+        const auto *value = this->constantValue(element);
+        if (!value)
+        {
+            allConstant = false;
+            break;
+        }
+        values.append(*value);
+    }
+    if (allConstant)
+    {
+        return this->constant(ListExpression::evaluate(values));
+    }
+
+    auto &operands = this->program_.listOperands_;
+    auto first = static_cast<uint16_t>(operands.size());
+    operands.insert(operands.end(), elements.begin(), elements.end());
+
+    auto dest = this->allocateRegister();
+    this->program_.instructions_.push_back({
+        .code = Program::Instruction::Code::List,
+        .dest = dest,
+        .first = first,
+        .count = static_cast<uint16_t>(elements.size()),
+    });
+    return {.kind = Operand::Kind::Register, .index = dest};
+}
+
+Operand Compiler::logicalAnd(const Expression &left, const Expression &right)
+{
+    auto lhs = left.compile(*this);
+    if (const auto *value = this->constantValue(lhs))
+    {
+        if (variantIs(*value, QMetaType::Bool) && !value->toBool())
+        {
+            // false && x is false for any x
+            return this->constant(false);
+        }
+        return this->binary(AND, lhs, right.compile(*this));
+    }
+
+    auto dest = this->allocateRegister();
+    auto skip = this->program_.instructions_.size();
+    this->program_.instructions_.push_back({
+        .code = Program::Instruction::Code::SkipIfFalse,
+        .dest = dest,
+        .a = lhs,
+    });
+
+    auto rhs = right.compile(*this);
+    this->program_.instructions_.push_back({
+        .code = Program::Instruction::Code::Binary,
+        .op = AND,
+        .dest = dest,
+        .a = lhs,
+        .b = rhs,
+    });
+    this->program_.instructions_[skip].first =
+        static_cast<uint16_t>(this->program_.instructions_.size());
+
+    return {.kind = Operand::Kind::Register, .index = dest};
+}
+
+Program Compiler::finish(Operand result)
+{
+    this->program_.result_ = result;
+    return std::move(this->program_);
+}
+
+const QVariant *Compiler::constantValue(Operand operand) const
+{
+    if (operand.kind != Operand::Kind::Constant)
+    {
+        return nullptr;
+    }
+    return &this->program_.constants_[operand.index];
+}
+
+uint16_t Compiler::allocateRegister()
+{
+    assert(this->program_.registerCount_ < UINT16_MAX);
+    return this->program_.registerCount_++;
+}
+
+}  // namespace chatterino::filters
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "controllers/filters/lang/Tokenizer.hpp"
+
+#include <QVariant>
+
+#include <cstdint>
+#include <vector>
+
+namespace chatterino::filters {
+
+class Expression;
+class FilterContext;
+
+/// An input of an instruction
+struct Operand {
+    enum class Kind : uint8_t {
+        /// Index into the constants of the program
+        Constant,
+        /// Index of a register written by an earlier instruction
+        Register,
+        /// Index into identifiers(), resolved from the context
+        Identifier,
+    };
+
+    Kind kind = Kind::Constant;
+    uint16_t index = 0;
+};
+
+/// @brief A filter expression lowered to a flat list of instructions.
+///
+/// Every instruction writes its result to its own register. Subexpressions
+/// without identifiers are evaluated when compiling, and `&&` skips its right
+/// side if the left one is false. The operations themselves are the ones of
+/// the expression tree, so results are the same as evaluating the tree.
+class Program
+{
+public:
+    /// Compiles a well-typed expression
+    static Program compile(const Expression &expression);
+
+    QVariant execute(const FilterContext &context) const;
+
+    /// Number of instructions run when nothing is skipped
+    size_t size() const;
+
+private:
+    struct Instruction {
+        enum class Code : uint8_t {
+            /// dest = op a
+            Unary,
+            /// dest = a op b
+            Binary,
+            /// dest = the list of listOperands_[first, first + count)
+            List,
+            /// if a is false: dest = false, continue at `first`
+            SkipIfFalse,
+        };
+
+        Code code;
+        TokenType op = NONE;
+        uint16_t dest = 0;
+        Operand a;
+        Operand b;
+        /// List: index of the first element, SkipIfFalse: jump target
+        uint16_t first = 0;
+        uint16_t count = 0;
+    };
+
+    std::vector<Instruction> instructions_;
+    std::vector<QVariant> constants_;
+    std::vector<Operand> listOperands_;
+    uint16_t registerCount_ = 0;
+    Operand result_;
+
+    friend class Compiler;
+};
+
+/// Builds a Program, used by Expression::compile
+class Compiler
+{
+public:
+    Operand constant(QVariant value);
+    Operand identifier(const QString &name);
+
+    Operand unary(TokenType op, Operand operand);
+    Operand binary(TokenType op, Operand left, Operand right);
+    Operand list(const std::vector<Operand> &elements);
+
+    /// Compiles `left && right`, skipping `right` if `left` is false
+    Operand logicalAnd(const Expression &left, const Expression &right);
+
+    Program finish(Operand result);
+
+private:
+    const QVariant *constantValue(Operand operand) const;
+    uint16_t allocateRegister();
+
+    Program program_;
+};
+
+}  // namespace chatterino::filters
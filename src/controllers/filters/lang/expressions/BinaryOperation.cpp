@@ -4,6 +4,8 @@
 
 #include "controllers/filters/lang/expressions/BinaryOperation.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
 #include <QRegularExpression>
 
 namespace {
@@ -53,11 +55,21 @@ BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
 {
 }
 
-QVariant BinaryOperation::execute(const ContextMap &context) const
+Operand BinaryOperation::compile(Compiler &compiler) const
 {
-    auto left = this->left_->execute(context);
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    if (this->op_ == AND)
+    {
+        return compiler.logicalAnd(*this->left_, *this->right_);
+    }
+
+    auto left = this->left_->compile(compiler);
+    auto right = this->right_->compile(compiler);
+    return compiler.binary(this->op_, left, right);
+}
+
+QVariant BinaryOperation::evaluate(TokenType op, QVariant left, QVariant right)
+{
+    switch (op)
     {
         case PLUS:
             if (variantIs(left, QMetaType::QString) &&
@@ -14,7 +14,10 @@ class BinaryOperation : public Expression
 public:
     BinaryOperation(TokenType op, ExpressionPtr left, ExpressionPtr right);
 
-    QVariant execute(const ContextMap &context) const override;
+    /// Applies `op` to already evaluated operands
+    static QVariant evaluate(TokenType op, QVariant left, QVariant right);
+
+    Operand compile(Compiler &compiler) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
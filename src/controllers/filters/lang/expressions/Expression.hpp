@@ -15,12 +15,17 @@
 
 namespace chatterino::filters {
 
+class Compiler;
+struct Operand;
+
 class Expression
 {
 public:
     virtual ~Expression() = default;
 
-    virtual QVariant execute(const ContextMap &context) const = 0;
+    /// Lowers this expression into the program built by `compiler` and
+    /// returns where its value ends up
+    virtual Operand compile(Compiler &compiler) const = 0;
     virtual PossibleType synthesizeType(const TypingContext &context) const = 0;
     virtual QString debug(const TypingContext &context) const = 0;
     virtual QString filterString() const = 0;
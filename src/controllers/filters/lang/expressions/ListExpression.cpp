@@ -4,38 +4,45 @@
 
 #include "controllers/filters/lang/expressions/ListExpression.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
+#include <algorithm>
+
 namespace chatterino::filters {
 
 ListExpression::ListExpression(ExpressionList &&list)
     : list_(std::move(list)) {};
 
-QVariant ListExpression::execute(const ContextMap &context) const
+Operand ListExpression::compile(Compiler &compiler) const
 {
-    QList<QVariant> results;
-    bool allStrings = true;
+    std::vector<Operand> elements;
+    elements.reserve(this->list_.size());
     for (const auto &exp : this->list_)
     {
-        auto res = exp->execute(context);
-        if (allStrings && variantIsNot(res, QMetaType::QString))
-        {
-            allStrings = false;
-        }
-        results.append(res);
+        elements.push_back(exp->compile(compiler));
     }
+    return compiler.list(elements);
+}
+
+QVariant ListExpression::evaluate(const QList<QVariant> &elements)
+{
+    bool allStrings = std::ranges::all_of(elements, [](const auto &res) {
+        return variantIs(res, QMetaType::QString);
+    });
 
     // if everything is a string return a QStringList for case-insensitive comparison
     if (allStrings)
     {
         QStringList strings;
-        strings.reserve(results.size());
-        for (const auto &val : results)
+        strings.reserve(elements.size());
+        for (const auto &val : elements)
         {
             strings << val.toString();
         }
         return strings;
     }
 
-    return results;
+    return elements;
 }
 
 PossibleType ListExpression::synthesizeType(const TypingContext &context) const
@@ -14,7 +14,10 @@ class ListExpression : public Expression
 public:
     ListExpression(ExpressionList &&list);
 
-    QVariant execute(const ContextMap &context) const override;
+    /// Builds the value of a list from its evaluated elements
+    static QVariant evaluate(const QList<QVariant> &elements);
+
+    Operand compile(Compiler &compiler) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
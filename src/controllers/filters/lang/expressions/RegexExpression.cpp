@@ -4,6 +4,8 @@
 
 #include "controllers/filters/lang/expressions/RegexExpression.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
 namespace chatterino::filters {
 
 RegexExpression::RegexExpression(const QString &regex, bool caseInsensitive)
@@ -13,9 +15,12 @@ RegexExpression::RegexExpression(const QString &regex, bool caseInsensitive)
           regex, caseInsensitive ? QRegularExpression::CaseInsensitiveOption
                                  : QRegularExpression::NoPatternOption)) {};
 
-QVariant RegexExpression::execute(const ContextMap & /*context*/) const
+Operand RegexExpression::compile(Compiler &compiler) const
 {
-    return this->regex_;
+    // compile the pattern now instead of on the first match
+    auto regex = this->regex_;
+    regex.optimize();
+    return compiler.constant(regex);
 }
 
 PossibleType RegexExpression::synthesizeType(
@@ -4,6 +4,8 @@
 
 #include "controllers/filters/lang/expressions/UnaryOperation.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
 namespace chatterino::filters {
 
 UnaryOperation::UnaryOperation(TokenType op, ExpressionPtr right)
@@ -12,10 +14,14 @@ UnaryOperation::UnaryOperation(TokenType op, ExpressionPtr right)
 {
 }
 
-QVariant UnaryOperation::execute(const ContextMap &context) const
+Operand UnaryOperation::compile(Compiler &compiler) const
 {
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    return compiler.unary(this->op_, this->right_->compile(compiler));
+}
+
+QVariant UnaryOperation::evaluate(TokenType op, const QVariant &right)
+{
+    switch (op)
     {
         case NOT:
             return right.canConvert<bool>() && !right.toBool();
@@ -14,7 +14,10 @@ class UnaryOperation : public Expression
 public:
     UnaryOperation(TokenType op, ExpressionPtr right);
 
-    QVariant execute(const ContextMap &context) const override;
+    /// Applies `op` to an already evaluated operand
+    static QVariant evaluate(TokenType op, const QVariant &right);
+
+    Operand compile(Compiler &compiler) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
@@ -4,6 +4,7 @@
 
 #include "controllers/filters/lang/expressions/ValueExpression.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 
 namespace chatterino::filters {
@@ -14,13 +15,13 @@ ValueExpression::ValueExpression(QVariant value, TokenType type)
 {
 }
 
-QVariant ValueExpression::execute(const ContextMap &context) const
+Operand ValueExpression::compile(Compiler &compiler) const
 {
     if (this->type_ == TokenType::IDENTIFIER)
     {
-        return context.value(this->value_.toString());
+        return compiler.identifier(this->value_.toString());
     }
-    return this->value_;
+    return compiler.constant(this->value_);
 }
 
 PossibleType ValueExpression::synthesizeType(const TypingContext &context) const
@@ -15,7 +15,7 @@ public:
     ValueExpression(QVariant value, TokenType type);
     TokenType type();
 
-    QVariant execute(const ContextMap &context) const override;
+    Operand compile(Compiler &compiler) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
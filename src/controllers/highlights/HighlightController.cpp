@@ -17,45 +17,130 @@
 #include "providers/twitch/TwitchAccount.hpp"  // IWYU pragma: keep
 #include "providers/twitch/TwitchBadge.hpp"
 #include "singletons/Settings.hpp"
+#include "util/MultiPatternMatcher.hpp"
 
 namespace {
 
 using namespace chatterino;
 
-auto highlightPhraseCheck(const HighlightPhrase &highlight) -> HighlightCheck
+HighlightResult highlightPhraseResult(const HighlightPhrase &highlight)
 {
-    return HighlightCheck{
-        [highlight](const auto &args, const auto &twitchBadges,
-                    const auto &senderName, const auto &originalMessage,
-                    const auto &flags,
-                    const auto self) -> std::optional<HighlightResult> {
-            (void)args;          // unused
-            (void)twitchBadges;  // unused
-            (void)senderName;    // unused
-            (void)flags;         // unused
+    std::optional<QUrl> highlightSoundUrl;
+    if (highlight.hasCustomSound())
+    {
+        highlightSoundUrl = highlight.getSoundUrl();
+    }
+
+    return HighlightResult{
+        highlight.hasAlert(),       highlight.hasSound(),
+        highlightSoundUrl,          highlight.getColor(),
+        highlight.showInMentions(),
+    };
+}
+
+/// Adds the side-effects of `checkResult` which aren't set in `result` yet
+void mergeHighlightResult(HighlightResult &result,
+                          const HighlightResult &checkResult)
+{
+    if (checkResult.alert)
+    {
+        if (!result.alert)
+        {
+            result.alert = checkResult.alert;
+        }
+    }
+
+    if (checkResult.playSound)
+    {
+        if (!result.playSound)
+        {
+            result.playSound = checkResult.playSound;
+        }
+    }
+
+    if (checkResult.customSoundUrl)
+    {
+        if (!result.customSoundUrl)
+        {
+            result.customSoundUrl = checkResult.customSoundUrl;
+        }
+    }
+
+    if (checkResult.color)
+    {
+        if (!result.color)
+        {
+            result.color = checkResult.color;
+        }
+    }
 
+    if (checkResult.showInMentions)
+    {
+        if (!result.showInMentions)
+        {
+            result.showInMentions = checkResult.showInMentions;
+        }
+    }
+}
+
+/// @brief Checks all message phrases in one go.
+///
+/// The literals the phrases require are searched for in a single pass, and
+/// only the phrases whose literal was found run their regex. The results of
+/// matching phrases are merged in order, like separate checks would be.
+auto highlightPhrasesCheck(std::vector<HighlightPhrase> highlights)
+    -> HighlightCheck
+{
+    std::vector<MultiPatternMatcher::Pattern> patterns;
+    patterns.reserve(highlights.size());
+    for (const auto &highlight : highlights)
+    {
+        auto caseSensitivity = highlight.isCaseSensitive()
+                                   ? Qt::CaseSensitive
+                                   : Qt::CaseInsensitive;
+        patterns.push_back({
+            .literal = requiredLiteral(highlight.getPattern(),
+                                       highlight.isRegex(), caseSensitivity),
+            .caseSensitivity = caseSensitivity,
+        });
+    }
+    auto matcher = std::make_shared<const MultiPatternMatcher>(patterns);
+
+    return HighlightCheck{
+        [highlights = std::move(highlights), matcher](
+            const auto & /*args*/, const auto & /*twitchBadges*/,
+            const auto & /*senderName*/, const auto &originalMessage,
+            const auto & /*flags*/,
+            const auto self) -> std::optional<HighlightResult> {
             if (self)
             {
                 // Phrase checks should ignore highlights from the user
                 return std::nullopt;
             }
 
-            if (!highlight.isMatch(originalMessage))
-            {
-                return std::nullopt;
-            }
+            auto candidates = matcher->find(originalMessage);
 
-            std::optional<QUrl> highlightSoundUrl;
-            if (highlight.hasCustomSound())
+            std::optional<HighlightResult> result;
+            for (size_t i = 0; i < highlights.size(); i++)
             {
-                highlightSoundUrl = highlight.getSoundUrl();
+                if (!candidates[i] || !highlights[i].isMatch(originalMessage))
+                {
+                    continue;
+                }
+
+                if (!result)
+                {
+                    result = HighlightResult::emptyResult();
+                }
+                mergeHighlightResult(*result,
+                                     highlightPhraseResult(highlights[i]));
+                if (result->full())
+                {
+                    break;
+                }
             }
 
-            return HighlightResult{
-                highlight.hasAlert(),       highlight.hasSound(),
-                highlightSoundUrl,          highlight.getColor(),
-                highlight.showInMentions(),
-            };
+            return result;
         }};
 }
 
@@ -193,23 +278,26 @@ void rebuildMessageHighlights(Settings &settings,
     auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
     QString currentUsername = currentUser->getUserName();
 
+    std::vector<HighlightPhrase> highlights;
+
     if (settings.enableSelfHighlight && !currentUsername.isEmpty() &&
         !currentUser->isAnon())
     {
-        HighlightPhrase highlight(
+        highlights.emplace_back(
             currentUsername, settings.showSelfHighlightInMentions,
             settings.enableSelfHighlightTaskbar,
             settings.enableSelfHighlightSound, false, false,
             settings.selfHighlightSoundUrl.getValue(),
             ColorProvider::instance().color(ColorType::SelfHighlight));
-
-        checks.emplace_back(highlightPhraseCheck(highlight));
     }
 
     auto messageHighlights = settings.highlightedMessages.readOnly();
-    for (const auto &highlight : *messageHighlights)
+    highlights.insert(highlights.end(), messageHighlights->begin(),
+                      messageHighlights->end());
+
+    if (!highlights.empty())
     {
-        checks.emplace_back(highlightPhraseCheck(highlight));
+        checks.emplace_back(highlightPhrasesCheck(std::move(highlights)));
     }
 
     if (settings.enableAutomodHighlight)
@@ -493,46 +581,7 @@ std::pair<bool, HighlightResult> HighlightController::check(
             checkResult)
         {
             highlighted = true;
-
-            if (checkResult->alert)
-            {
-                if (!result.alert)
-                {
-                    result.alert = checkResult->alert;
-                }
-            }
-
-            if (checkResult->playSound)
-            {
-                if (!result.playSound)
-                {
-                    result.playSound = checkResult->playSound;
-                }
-            }
-
-            if (checkResult->customSoundUrl)
-            {
-                if (!result.customSoundUrl)
-                {
-                    result.customSoundUrl = checkResult->customSoundUrl;
-                }
-            }
-
-            if (checkResult->color)
-            {
-                if (!result.color)
-                {
-                    result.color = checkResult->color;
-                }
-            }
-
-            if (checkResult->showInMentions)
-            {
-                if (!result.showInMentions)
-                {
-                    result.showInMentions = checkResult->showInMentions;
-                }
-            }
+            mergeHighlightResult(result, *checkResult);
 
             if (result.full())
             {
@@ -12,9 +12,15 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
 #include "singletons/Settings.hpp"
+#include "util/MultiPatternMatcher.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace {
 
+using namespace chatterino;
 using namespace chatterino::literals;
 
 /**
@@ -131,6 +137,50 @@ QString makeRegexReplacement(QStringView source,
     return dst;
 }
 
+/// The block phrases of a snapshot of the ignored phrases
+struct BlockPhrases {
+    std::shared_ptr<const std::vector<IgnorePhrase>> source;
+    std::vector<const IgnorePhrase *> phrases;
+    /// Finds the phrases which can match a message
+    MultiPatternMatcher matcher;
+};
+
+/// Returns the block phrases of `source`, which are only collected again when
+/// the ignored phrases change
+std::shared_ptr<const BlockPhrases> blockPhrases(
+    std::shared_ptr<const std::vector<IgnorePhrase>> source)
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const BlockPhrases> cached;
+
+    std::lock_guard lock(mutex);
+    if (cached && cached->source == source)
+    {
+        return cached;
+    }
+
+    auto blocks = std::make_shared<BlockPhrases>();
+    std::vector<MultiPatternMatcher::Pattern> patterns;
+    for (const auto &phrase : *source)
+    {
+        if (!phrase.isBlock())
+        {
+            continue;
+        }
+        blocks->phrases.push_back(&phrase);
+        patterns.push_back({
+            .literal = requiredLiteral(phrase.getPattern(), phrase.isRegex(),
+                                       phrase.caseSensitivity()),
+            .caseSensitivity = phrase.caseSensitivity(),
+        });
+    }
+    blocks->matcher = MultiPatternMatcher(patterns);
+    blocks->source = std::move(source);
+
+    cached = blocks;
+    return cached;
+}
+
 }  // namespace
 
 namespace chatterino {
@@ -139,11 +189,12 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
 {
     if (!params.message.isEmpty())
     {
-        // TODO(pajlada): Do we need to check if the phrase is valid first?
-        auto phrases = getSettings()->ignoredMessages.readOnly();
-        for (const auto &phrase : *phrases)
+        auto blocks = blockPhrases(getSettings()->ignoredMessages.readOnly());
+        auto candidates = blocks->matcher.find(params.message);
+        for (size_t i = 0; i < blocks->phrases.size(); i++)
         {
-            if (phrase.isBlock() && phrase.isMatch(params.message))
+            const auto &phrase = *blocks->phrases[i];
+            if (candidates[i] && phrase.isMatch(params.message))
             {
                 qCDebug(chatterinoMessage)
                     << "Blocking message because it contains ignored phrase"
@@ -162,16 +213,14 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
             isBlocked = getApp()
                             ->getAccounts()
                             ->twitch.getCurrent()
-                            ->blockedUserIds()
-                            .contains(params.twitchUserID);
+                            ->isBlockedUserId(params.twitchUserID);
         }
         else if (!params.twitchUserLogin.isEmpty())
         {
             isBlocked = getApp()
                             ->getAccounts()
                             ->twitch.getCurrent()
-                            ->blockedUserLogins()
-                            .contains(params.twitchUserLogin);
+                            ->isBlockedUserLogin(params.twitchUserLogin);
         }
 
         if (isBlocked)
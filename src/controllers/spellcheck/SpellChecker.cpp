@@ -6,14 +6,29 @@
 
 #include "Application.hpp"
 #include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "util/CombinePath.hpp"
 #include "util/FilesystemHelpers.hpp"
+#include "util/PostToThread.hpp"
+#include "util/QStringHash.hpp"
+#include "util/RenameThread.hpp"
 #include "util/XDGDirectory.hpp"
 
 #ifdef CHATTERINO_WITH_SPELLCHECK
 #    include <hunspell/hunspell.hxx>
+#    include <lrucache/lrucache.hpp>
+#    include <QObject>
+#    include <QPointer>
+
+#    include <algorithm>
+#    include <condition_variable>
+#    include <deque>
+#    include <iterator>
+#    include <mutex>
+#    include <thread>
+#    include <unordered_set>
 #endif
 
 namespace chatterino {
@@ -83,11 +98,53 @@ public:
     static std::unique_ptr<SpellCheckerPrivate> tryLoad(
         const QString &path = {});
 
-    /// NOTE: To support multiple dictionaries at the same time, it seems like we need to store a list of Hunspell instances, each supporting a single dictionary, and then during the spell checking process check each hunspell instance.
-    Hunspell hunspell;
+    ~SpellCheckerPrivate();
+    SpellCheckerPrivate(const SpellCheckerPrivate &) = delete;
+    SpellCheckerPrivate(SpellCheckerPrivate &&) = delete;
+    SpellCheckerPrivate &operator=(const SpellCheckerPrivate &) = delete;
+    SpellCheckerPrivate &operator=(SpellCheckerPrivate &&) = delete;
+
+    /// Starts the spell checking thread, which reports to @a owner
+    void start(SpellChecker *owner);
+
+    void pushCheck(const QString &word);
+    void pushSuggestions(
+        const QString &word, QObject *caller,
+        std::function<void(std::vector<QString> suggestions)> callback);
+
+    // Only accessed from the GUI thread
+    cache::lru_cache<QString, bool> cache{SpellChecker::MAX_CACHED_WORDS};
+    /// Words that are queued for the spell checking thread
+    std::unordered_set<QString> pending;
 
 private:
+    struct SuggestionsJob {
+        QString word;
+        QPointer<QObject> caller;
+        std::function<void(std::vector<QString> suggestions)> callback;
+    };
+
     SpellCheckerPrivate(const char *affpath, const char *dpath);
+
+    void run();
+
+    /// NOTE: To support multiple dictionaries at the same time, it seems like we need to store a list of Hunspell instances, each supporting a single dictionary, and then during the spell checking process check each hunspell instance.
+    /// Only accessed from the spell checking thread
+    Hunspell hunspell;
+
+    SpellChecker *owner = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<QString> checkQueue;
+    /// Suggestions are looked up before any queued check, as the user is
+    /// waiting for them
+    std::deque<SuggestionsJob> suggestionsQueue;
+    bool stopping = false;
+
+    /// Drops results that arrive after the spell checker is destroyed
+    QObject lifetimeGuard;
+    std::unique_ptr<std::thread> thread;
 };
 
 std::unique_ptr<SpellCheckerPrivate> SpellCheckerPrivate::tryLoad(
@@ -136,10 +193,140 @@ SpellCheckerPrivate::SpellCheckerPrivate(const char *affpath, const char *dpath)
 {
 }
 
+SpellCheckerPrivate::~SpellCheckerPrivate()
+{
+    if (!this->thread)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(this->mutex);
+        this->stopping = true;
+    }
+    this->condition.notify_one();
+    this->thread->join();
+}
+
+void SpellCheckerPrivate::start(SpellChecker *owner)
+{
+    this->owner = owner;
+    this->thread = std::make_unique<std::thread>([this] {
+        this->run();
+    });
+    renameThread(*this->thread, "C2SpellCheck");
+}
+
+void SpellCheckerPrivate::pushCheck(const QString &word)
+{
+    {
+        std::lock_guard lock(this->mutex);
+        this->checkQueue.push_back(word);
+    }
+    this->condition.notify_one();
+}
+
+void SpellCheckerPrivate::pushSuggestions(
+    const QString &word, QObject *caller,
+    std::function<void(std::vector<QString> suggestions)> callback)
+{
+    {
+        std::lock_guard lock(this->mutex);
+        this->suggestionsQueue.push_back({
+            .word = word,
+            .caller = caller,
+            .callback = std::move(callback),
+        });
+    }
+    this->condition.notify_one();
+}
+
+void SpellCheckerPrivate::run()
+{
+    while (true)
+    {
+        std::optional<SuggestionsJob> suggestionsJob;
+        std::vector<QString> words;
+        {
+            std::unique_lock lock(this->mutex);
+            this->condition.wait(lock, [this] {
+                return this->stopping || !this->suggestionsQueue.empty() ||
+                       !this->checkQueue.empty();
+            });
+            if (this->stopping)
+            {
+                return;
+            }
+
+            if (!this->suggestionsQueue.empty())
+            {
+                suggestionsJob = std::move(this->suggestionsQueue.front());
+                this->suggestionsQueue.pop_front();
+            }
+            else
+            {
+                // Check words in small batches, so the first results show up
+                // while a long text is still being checked
+                auto n = std::min(this->checkQueue.size(),
+                                  SpellChecker::CHECK_BATCH_SIZE);
+                words.assign(std::make_move_iterator(this->checkQueue.begin()),
+                             std::make_move_iterator(
+                                 this->checkQueue.begin() +
+                                 static_cast<std::ptrdiff_t>(n)));
+                this->checkQueue.erase(
+                    this->checkQueue.begin(),
+                    this->checkQueue.begin() + static_cast<std::ptrdiff_t>(n));
+            }
+        }
+
+        if (suggestionsJob)
+        {
+            std::vector<QString> suggestions;
+            auto stdWord = suggestionsJob->word.toStdString();
+            if (!this->hunspell.spell(stdWord))
+            {
+                for (const auto &suggestion : this->hunspell.suggest(stdWord))
+                {
+                    suggestions.emplace_back(QString::fromStdString(suggestion));
+                }
+            }
+
+            postToThread(
+                [job = std::move(*suggestionsJob),
+                 suggestions = std::move(suggestions)]() mutable {
+                    if (job.caller)
+                    {
+                        job.callback(std::move(suggestions));
+                    }
+                },
+                &this->lifetimeGuard);
+            continue;
+        }
+
+        std::vector<std::pair<QString, bool>> results;
+        results.reserve(words.size());
+        for (auto &word : words)
+        {
+            bool correct = this->hunspell.spell(word.toStdString());
+            results.emplace_back(std::move(word), correct);
+        }
+
+        postToThread(
+            [owner = this->owner, results = std::move(results)] {
+                owner->applyResults(results);
+            },
+            &this->lifetimeGuard);
+    }
+}
+
 SpellChecker::SpellChecker()
     : private_(SpellCheckerPrivate::tryLoad(
           getSettings()->spellCheckingDefaultDictionary))
 {
+    if (this->private_)
+    {
+        this->private_->start(this);
+    }
 }
 #else
 class SpellCheckerPrivate
@@ -156,7 +343,7 @@ bool SpellChecker::isLoaded() const
 }
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-bool SpellChecker::check(const QString &word)
+std::optional<bool> SpellChecker::cachedCheck(const QString &word)
 {
 #ifdef CHATTERINO_WITH_SPELLCHECK
     if (!this->private_)
@@ -164,7 +351,13 @@ bool SpellChecker::check(const QString &word)
         return true;
     }
 
-    return this->private_->hunspell.spell(word.toStdString());
+    assertInGuiThread();
+    auto &cache = this->private_->cache;
+    if (!cache.exists(word))
+    {
+        return std::nullopt;
+    }
+    return cache.get(word);
 #else
     (void)word;
     return true;
@@ -172,24 +365,63 @@ bool SpellChecker::check(const QString &word)
 }
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-std::vector<std::string> SpellChecker::suggestions(const QString &word)
+void SpellChecker::checkAsync(const QString &word)
 {
 #ifdef CHATTERINO_WITH_SPELLCHECK
     if (!this->private_)
     {
-        return {};
+        return;
     }
 
-    auto stdWord = word.toStdString();
-    if (this->private_->hunspell.spell(stdWord))
+    assertInGuiThread();
+    if (this->private_->cache.exists(word) ||
+        !this->private_->pending.insert(word).second)
     {
-        return {};
+        return;
+    }
+    this->private_->pushCheck(word);
+#else
+    (void)word;
+#endif
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+void SpellChecker::suggestionsAsync(
+    const QString &word, QObject *caller,
+    std::function<void(std::vector<QString> suggestions)> callback)
+{
+#ifdef CHATTERINO_WITH_SPELLCHECK
+    if (!this->private_)
+    {
+        return;
     }
 
-    return this->private_->hunspell.suggest(stdWord);
+    assertInGuiThread();
+    this->private_->pushSuggestions(word, caller, std::move(callback));
 #else
     (void)word;
-    return {};
+    (void)caller;
+    (void)callback;
+#endif
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+void SpellChecker::applyResults(
+    const std::vector<std::pair<QString, bool>> &results)
+{
+#ifdef CHATTERINO_WITH_SPELLCHECK
+    std::vector<QString> words;
+    words.reserve(results.size());
+    for (const auto &[word, correct] : results)
+    {
+        this->private_->cache.put(word, correct);
+        this->private_->pending.erase(word);
+        words.emplace_back(word);
+    }
+
+    this->wordsChecked.invoke(words);
+#else
+    (void)results;
 #endif
 }
 
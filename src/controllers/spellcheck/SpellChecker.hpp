@@ -4,12 +4,18 @@
 
 #pragma once
 
+#include <pajlada/signals/signal.hpp>
 #include <QString>
 
+#include <cstddef>
+#include <functional>
 #include <memory>
-#include <string>
+#include <optional>
+#include <utility>
 #include <vector>
 
+class QObject;
+
 namespace chatterino {
 
 class Channel;
@@ -31,16 +37,49 @@ struct DictionaryInfo {
 };
 
 class SpellCheckerPrivate;
+
+/// Checks words against the default dictionary.
+///
+/// Hunspell only runs on a dedicated thread, so the GUI thread never waits for
+/// it. Results are kept in an LRU cache that belongs to the loaded dictionary.
+/// All public functions must be called from the GUI thread.
 class SpellChecker
 {
 public:
+    /// Maximum number of words whose result is cached
+    static constexpr size_t MAX_CACHED_WORDS = 10000;
+    /// Maximum number of words checked before their results are sent to the
+    /// GUI thread
+    static constexpr size_t CHECK_BATCH_SIZE = 32;
+
     SpellChecker();
     ~SpellChecker();
+    SpellChecker(const SpellChecker &) = delete;
+    SpellChecker(SpellChecker &&) = delete;
+    SpellChecker &operator=(const SpellChecker &) = delete;
+    SpellChecker &operator=(SpellChecker &&) = delete;
 
     bool isLoaded() const;
 
-    bool check(const QString &word);
-    std::vector<std::string> suggestions(const QString &word);
+    /// @brief Returns whether the word is spelled correctly if that's known
+    ///
+    /// Returns std::nullopt if the word wasn't checked yet (see #checkAsync()).
+    /// If no dictionary is loaded, all words are correct.
+    std::optional<bool> cachedCheck(const QString &word);
+
+    /// @brief Checks the word on the spell checking thread
+    ///
+    /// Once it's checked, the result is cached and #wordsChecked is emitted.
+    /// Words that are already cached or queued are skipped.
+    void checkAsync(const QString &word);
+
+    /// @brief Looks up suggestions for a misspelled word
+    ///
+    /// @a callback is called on the GUI thread, unless @a caller was destroyed
+    /// in the meantime. Correctly spelled words don't have any suggestions.
+    void suggestionsAsync(
+        const QString &word, QObject *caller,
+        std::function<void(std::vector<QString> suggestions)> callback);
 
     /// Get a list of dictionaries from the Chatterino Dictionaries directory
     /// and the system directories if supported.
@@ -48,7 +87,14 @@ public:
     /// System-dictionary loading is currently only implemented on Linux.
     std::vector<DictionaryInfo> getAvailableDictionaries() const;
 
+    /// Emitted with words whose result was added to the cache
+    pajlada::Signals::Signal<const std::vector<QString> &> wordsChecked;
+
 private:
+    friend SpellCheckerPrivate;
+
+    void applyResults(const std::vector<std::pair<QString, bool>> &results);
+
     std::unique_ptr<SpellCheckerPrivate> private_;
 };
 
@@ -6,6 +6,7 @@
 
 #include "common/Aliases.hpp"
 #include "messages/ImageSet.hpp"
+#include "util/PersistentHashMap.hpp"
 
 #include <functional>
 #include <memory>
@@ -45,9 +46,15 @@ bool operator!=(const Emote &a, const Emote &b);
 
 using EmotePtr = std::shared_ptr<const Emote>;
 
-class EmoteMap : public std::unordered_map<EmoteName, EmotePtr>
+/// Maps emote names to emotes.
+///
+/// Copies share their nodes (see PersistentHashMap), so a live update of a
+/// large emote set copies O(log n) nodes instead of the whole map.
+class EmoteMap : public PersistentHashMap<EmoteName, EmotePtr>
 {
 public:
+    using PersistentHashMap::PersistentHashMap;
+
     /**
      * Finds an emote by it's id with a hint to it's name.
      *
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/EmoteIndex.hpp"
+
+#include "messages/Emote.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+bool EmoteIndex::isOutdated(const Versions &versions) const
+{
+    std::shared_lock lock(this->mutex_);
+    return this->versions_ != versions;
+}
+
+void EmoteIndex::update(const Versions &versions, const Maps &maps)
+{
+    std::unique_lock lock(this->mutex_);
+    if (this->versions_ == versions)
+    {
+        // another thread was faster
+        return;
+    }
+
+    // Names that were added, removed or changed in any of the maps
+    std::vector<QString> changed;
+    for (size_t i = 0; i < SOURCE_COUNT; i++)
+    {
+        const auto &oldMap = this->maps_[i];
+        const auto &newMap = maps[i];
+        if (oldMap == newMap)
+        {
+            continue;
+        }
+
+        // Only the paths that differ are compared, so this is cheap for
+        // live updates
+        const auto &oldRef = oldMap ? *oldMap : *EMPTY_EMOTE_MAP;
+        const auto &newRef = newMap ? *newMap : *EMPTY_EMOTE_MAP;
+        oldRef.diff(newRef, [&](const EmoteName &name) {
+            changed.push_back(name.string);
+        });
+
+        this->maps_[i] = newMap;
+    }
+    this->versions_ = versions;
+
+    for (const auto &name : changed)
+    {
+        this->resolve(name);
+    }
+}
+
+EmotePtr EmoteIndex::find(QStringView name) const
+{
+    std::shared_lock lock(this->mutex_);
+
+    auto it = this->entries_.find(name);
+    if (it == this->entries_.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+size_t EmoteIndex::size() const
+{
+    std::shared_lock lock(this->mutex_);
+    return this->entries_.size();
+}
+
+void EmoteIndex::resolve(const QString &name)
+{
+    EmoteName key{name};
+    for (const auto &map : this->maps_)
+    {
+        if (!map)
+        {
+            continue;
+        }
+
+        auto it = map->find(key);
+        if (it != map->end())
+        {
+            this->entries_.insert_or_assign(name, it->second);
+            return;
+        }
+    }
+
+    this->entries_.erase(name);
+}
+
+}  // namespace chatterino
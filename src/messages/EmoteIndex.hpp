@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QHashFunctions>
+#include <QString>
+#include <QStringView>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+class EmoteMap;
+
+/// @brief A flattened view over multiple emote maps.
+///
+/// Each name resolves to the emote of the first map (in order of precedence)
+/// that contains it, so a lookup is a single hash probe. When some of the
+/// maps change, only the names that changed in those maps are resolved again.
+///
+/// All methods are thread safe.
+class EmoteIndex
+{
+public:
+    /// The maps of a TwitchChannel in order of precedence
+    static constexpr size_t SOURCE_COUNT = 6;
+
+    using Versions = std::array<uint64_t, SOURCE_COUNT>;
+    using Maps = std::array<std::shared_ptr<const EmoteMap>, SOURCE_COUNT>;
+
+    /// Returns true if the index wasn't built from maps with these versions
+    bool isOutdated(const Versions &versions) const;
+
+    /// Updates the index to `maps`. Only maps that differ from the previous
+    /// ones are looked at.
+    ///
+    /// @param versions The versions of the maps, see Atomic::version()
+    void update(const Versions &versions, const Maps &maps);
+
+    /// Returns the emote with this name or nullptr if there's none
+    EmotePtr find(QStringView name) const;
+
+    size_t size() const;
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+
+        size_t operator()(QStringView name) const noexcept
+        {
+            // qHash(QString) hashes the same as qHash(QStringView)
+            return qHash(name);
+        }
+    };
+
+    /// Finds the emote with the highest precedence for `name`
+    void resolve(const QString &name);
+
+    mutable std::shared_mutex mutex_;
+
+    std::unordered_map<QString, EmotePtr, NameHash, std::equal_to<>> entries_;
+    Maps maps_;
+    /// No map has this version, so the index starts out outdated
+    Versions versions_ = [] {
+        Versions versions;
+        versions.fill(UINT64_MAX);
+        return versions;
+    }();
+};
+
+}  // namespace chatterino
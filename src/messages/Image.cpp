@@ -13,6 +13,7 @@
 #include "debug/AssertInGuiThread.hpp"
 #include "debug/Benchmark.hpp"
 #include "singletons/helper/GifTimer.hpp"
+#include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
@@ -23,24 +24,331 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QThreadPool>
 #include <QTimer>
 
+#ifdef Q_OS_WIN
+// clang-format off
+#    include <Windows.h>
+#    include <Psapi.h>
+// clang-format on
+#else
+#    include <sys/resource.h>
+#endif
+
+#include <algorithm>
 #include <atomic>
+#include <optional>
+#include <utility>
+#include <vector>
 
 // Duration between each check of every Image instance
 const auto IMAGE_POOL_CLEANUP_INTERVAL = std::chrono::minutes(1);
 // Duration since last usage of Image pixmap before expiration of frames
 const auto IMAGE_POOL_IMAGE_LIFETIME = std::chrono::minutes(10);
+// Images used within this duration are never expired to stay within the
+// memory budget. They're most likely visible and would be reloaded right away.
+const auto IMAGE_POOL_BUDGET_GRACE_PERIOD = std::chrono::seconds(5);
+
+namespace {
+
+using namespace chatterino;
+
+/// The configured budget for decoded frames in bytes (0 if there's none)
+int64_t imageMemoryBudget()
+{
+    auto mebibytes = getSettings()->imageMemoryBudget.getValue();
+    if (mebibytes <= 0)
+    {
+        return 0;
+    }
+    return static_cast<int64_t>(mebibytes) * 1024 * 1024;
+}
+
+/// The bytes used by a decoded pixmap
+int64_t pixmapMemoryUsage(const QPixmap &pixmap)
+{
+    auto sz = pixmap.size();
+    auto area = sz.width() * sz.height();
+    return area * pixmap.depth() / 8;
+}
+
+/// The peak resident set size of this process in bytes
+int64_t peakResidentSetSize()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                             sizeof(counters)) == 0)
+    {
+        return 0;
+    }
+    return static_cast<int64_t>(counters.PeakWorkingSetSize);
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#    ifdef Q_OS_MACOS
+    // macOS reports bytes
+    return static_cast<int64_t>(usage.ru_maxrss);
+#    else
+    // Linux and the BSDs report kilobytes
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#    endif
+#endif
+}
+
+/// Chrome's and Firefox's duration for a frame with the given delay.
+/// They use 100 ms for any frames that specify a duration of <= 10 ms.
+/// See http://webkit.org/b/36082 for more information.
+/// https://github.com/SevenTV/chatterino7/issues/46#issuecomment-1010595231
+int frameDuration(int delay)
+{
+    if (delay <= 10)
+    {
+        delay = 100;
+    }
+    return std::max(20, delay);
+}
+
+/// Reads the frame delays (in ms) of a GIF from its graphic control
+/// extensions without decoding any frames
+std::optional<std::vector<int>> scanGifDelays(const QByteArray &data)
+{
+    auto byteAt = [&](qsizetype pos) {
+        return static_cast<uint8_t>(data[pos]);
+    };
+    // Color tables follow a block if the high bit of its flags is set
+    auto colorTableSize = [](uint8_t flags) -> qsizetype {
+        if ((flags & 0x80) == 0)
+        {
+            return 0;
+        }
+        return 3 * (qsizetype{2} << (flags & 0x07));
+    };
+
+    // "GIF89a", the logical screen descriptor and the global color table
+    if (data.size() < 13 || !data.startsWith("GIF"))
+    {
+        return std::nullopt;
+    }
+    qsizetype pos = 13 + colorTableSize(byteAt(10));
+
+    // Skips a sequence of sub-blocks, returns false if it's truncated
+    auto skipSubBlocks = [&] {
+        while (pos < data.size())
+        {
+            auto size = byteAt(pos);
+            pos += 1 + size;
+            if (size == 0)
+            {
+                return pos <= data.size();
+            }
+        }
+        return false;
+    };
+
+    std::vector<int> delays;
+    int nextDelay = 0;
+    while (pos < data.size())
+    {
+        switch (byteAt(pos))
+        {
+            case 0x21: {  // extension
+                if (pos + 2 >= data.size())
+                {
+                    return std::nullopt;
+                }
+                // graphic control extension: size, flags, delay (1/100s)
+                if (byteAt(pos + 1) == 0xF9 && byteAt(pos + 2) >= 4 &&
+                    pos + 5 < data.size())
+                {
+                    nextDelay = (byteAt(pos + 4) | (byteAt(pos + 5) << 8)) * 10;
+                }
+                pos += 2;
+                if (!skipSubBlocks())
+                {
+                    return std::nullopt;
+                }
+            }
+            break;
+
+            case 0x2C: {  // image descriptor
+                if (pos + 10 >= data.size())
+                {
+                    return std::nullopt;
+                }
+                // descriptor, local color table and the LZW code size
+                pos += 10 + colorTableSize(byteAt(pos + 9)) + 1;
+                if (!skipSubBlocks())
+                {
+                    return std::nullopt;
+                }
+                delays.push_back(nextDelay);
+                nextDelay = 0;
+            }
+            break;
+
+            case 0x3B:  // trailer
+                return delays;
+
+            default:
+                return std::nullopt;
+        }
+    }
+
+    // Some GIFs are missing the trailer
+    return delays;
+}
+
+/// Reads the frame durations (in ms) of an animated WebP from its ANMF
+/// chunks without decoding any frames
+std::optional<std::vector<int>> scanWebpDelays(const QByteArray &data)
+{
+    auto readLittleEndian = [&](qsizetype pos, int nBytes) {
+        qsizetype value = 0;
+        for (int i = nBytes - 1; i >= 0; i--)
+        {
+            value = (value << 8) | static_cast<uint8_t>(data[pos + i]);
+        }
+        return value;
+    };
+
+    if (data.size() < 12 || !data.startsWith("RIFF") ||
+        data.sliced(8, 4) != "WEBP")
+    {
+        return std::nullopt;
+    }
+
+    std::vector<int> delays;
+    qsizetype pos = 12;
+    while (pos + 8 <= data.size())
+    {
+        auto fourcc = data.sliced(pos, 4);
+        auto size = readLittleEndian(pos + 4, 4);
+        pos += 8;
+        if (size > data.size() - pos)
+        {
+            return std::nullopt;
+        }
+
+        // X, Y, width and height (24 bits each), then the duration
+        if (fourcc == "ANMF" && size >= 15)
+        {
+            delays.push_back(static_cast<int>(readLittleEndian(pos + 12, 3)));
+        }
+
+        // Chunks are padded to an even size
+        pos += size + (size & 1);
+    }
+
+    if (delays.empty())
+    {
+        return std::nullopt;
+    }
+    return delays;
+}
+
+/// Reads the frame delays of the image `reader` reads without decoding it.
+/// Returns std::nullopt if the format isn't supported.
+std::optional<std::vector<int>> scanFrameDelays(QImageReader &reader)
+{
+    auto *device = reader.device();
+    if (device == nullptr || device->isSequential())
+    {
+        return std::nullopt;
+    }
+
+    auto position = device->pos();
+    device->seek(0);
+    auto data = device->readAll();
+    device->seek(position);
+
+    auto format = reader.format();
+    if (format == "gif")
+    {
+        return scanGifDelays(data);
+    }
+    if (format == "webp")
+    {
+        return scanWebpDelays(data);
+    }
+    return std::nullopt;
+}
+
+}  // namespace
 
 namespace chatterino::detail {
 
+FrameDecoder::FrameDecoder(QByteArray data, QByteArray format)
+    : data_(std::move(data))
+    , format_(std::move(format))
+{
+}
+
+FrameDecoder::~FrameDecoder() = default;
+
+std::vector<std::pair<qsizetype, QPixmap>> FrameDecoder::decode(
+    const std::vector<qsizetype> &indices)
+{
+    std::lock_guard lock(this->mutex_);
+
+    std::vector<std::pair<qsizetype, QPixmap>> decoded;
+    decoded.reserve(indices.size());
+
+    for (auto index : indices)
+    {
+        if (!this->reader_ || index < this->nextIndex_)
+        {
+            this->restart();
+        }
+
+        // Frames can only be read in order, skip ahead if necessary
+        QImage image;
+        while (this->nextIndex_ <= index)
+        {
+            image = this->reader_->read();
+            this->nextIndex_++;
+            if (image.isNull())
+            {
+                break;
+            }
+        }
+
+        if (image.isNull())
+        {
+            decoded.emplace_back(index, QPixmap());
+        }
+        else
+        {
+            decoded.emplace_back(index, QPixmap::fromImage(std::move(image)));
+        }
+    }
+
+    return decoded;
+}
+
+void FrameDecoder::restart()
+{
+    this->reader_.reset();
+    this->buffer_ = std::make_unique<QBuffer>();
+    this->buffer_->setData(this->data_);
+    this->buffer_->open(QIODevice::ReadOnly);
+    this->reader_ =
+        std::make_unique<QImageReader>(this->buffer_.get(), this->format_);
+    this->nextIndex_ = 0;
+}
+
 Frames::Frames()
 {
     DebugCount::increase(DebugObject::Image);
 }
 
-Frames::Frames(QList<Frame> &&frames)
+Frames::Frames(QList<Frame> &&frames, std::shared_ptr<FrameDecoder> decoder)
     : items_(std::move(frames))
+    , decoder_(std::move(decoder))
 {
     assertInGuiThread();
     auto *app = tryGetApp();
@@ -87,6 +395,12 @@ Frames::Frames(QList<Frame> &&frames)
 
     DebugCount::increase(DebugObject::BytesImageCurrent, this->memoryUsage());
     DebugCount::increase(DebugObject::BytesImageLoaded, this->memoryUsage());
+
+    if (this->decoder_)
+    {
+        this->decoder_->owner = this;
+        this->updateWindow(0);
+    }
 }
 
 Frames::~Frames()
@@ -106,6 +420,11 @@ Frames::~Frames()
     DebugCount::increase(DebugObject::BytesImageUnloaded, this->memoryUsage());
 
     this->gifTimerConnection_.disconnect();
+
+    if (this->decoder_)
+    {
+        this->decoder_->owner = nullptr;
+    }
 }
 
 int64_t Frames::memoryUsage() const
@@ -113,19 +432,166 @@ int64_t Frames::memoryUsage() const
     int64_t usage = 0;
     for (const auto &frame : this->items_)
     {
-        auto sz = frame.image.size();
-        auto area = sz.width() * sz.height();
-        auto memory = area * frame.image.depth() / 8;
-
-        usage += memory;
+        usage += pixmapMemoryUsage(frame.image);
     }
     return usage;
 }
 
 void Frames::advance()
 {
+    auto previousIndex = this->index_;
+
     this->durationOffset_ += GIF_FRAME_LENGTH;
     this->processOffset();
+
+    if (this->decoder_ && previousIndex != this->index_)
+    {
+        this->updateWindow(previousIndex);
+    }
+}
+
+bool Frames::isInWindow(QList<Frame>::size_type index) const
+{
+    // The first frame is always kept, as it's used to determine the size
+    if (index == 0)
+    {
+        return true;
+    }
+
+    auto count = this->items_.size();
+    auto distance = (index - this->index_ + count) % count;
+    return distance <= WINDOW_SIZE;
+}
+
+bool Frames::isIdle() const
+{
+    return std::chrono::steady_clock::now() - this->lastPainted_ >
+           DECODE_IDLE_TIMEOUT;
+}
+
+void Frames::updateWindow(QList<Frame>::size_type previousIndex)
+{
+    assert(this->decoder_);
+
+    auto count = this->items_.size();
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Release the frames we moved past
+    bool released = false;
+    for (auto i = previousIndex; i != this->index_; i = (i + 1) % count)
+    {
+        auto &frame = this->items_[i];
+        if (!frame.image.isNull() && !this->isInWindow(i))
+        {
+            auto bytes = pixmapMemoryUsage(frame.image);
+            DebugCount::decrease(DebugObject::BytesImageCurrent, bytes);
+            DebugCount::increase(DebugObject::BytesImageUnloaded, bytes);
+            frame.image = QPixmap();
+            released = true;
+        }
+    }
+    if (released && this->memoryUsageChanged)
+    {
+        this->memoryUsageChanged();
+    }
+
+    if (!this->items_[this->index_].image.isNull())
+    {
+        this->lastShown_ = this->items_[this->index_].image;
+    }
+
+    // Images that aren't visible keep showing their last frame
+    if (this->decodePending_ || this->isIdle())
+    {
+        return;
+    }
+
+    std::vector<qsizetype> missing;
+    for (qsizetype offset = 0; offset <= WINDOW_SIZE && offset < count;
+         ++offset)
+    {
+        auto i = (this->index_ + offset) % count;
+        if (this->items_[i].image.isNull())
+        {
+            missing.push_back(i);
+        }
+    }
+    if (missing.empty())
+    {
+        return;
+    }
+
+    auto *threadPool = QThreadPool::globalInstance();
+    if (threadPool == nullptr)
+    {
+        // Must be exiting - do nothing
+        return;
+    }
+
+    this->decodePending_ = true;
+    threadPool->start([weakDecoder = std::weak_ptr(this->decoder_),
+                       missing = std::move(missing)]() mutable {
+        auto decoder = weakDecoder.lock();
+        if (!decoder)
+        {
+            return;
+        }
+
+        auto decoded = decoder->decode(missing);
+        decoder.reset();
+
+        postToThread([weakDecoder = std::move(weakDecoder),
+                      decoded = std::move(decoded)]() mutable {
+            auto decoder = weakDecoder.lock();
+            if (!decoder || decoder->owner == nullptr)
+            {
+                return;
+            }
+            decoder->owner->adoptDecodedFrames(std::move(decoded));
+        });
+    });
+}
+
+void Frames::adoptDecodedFrames(
+    std::vector<std::pair<qsizetype, QPixmap>> &&decoded)
+{
+    assertInGuiThread();
+    this->decodePending_ = false;
+
+    bool adopted = false;
+    for (auto &[index, pixmap] : decoded)
+    {
+        if (index >= this->items_.size() || pixmap.isNull())
+        {
+            continue;
+        }
+
+        auto &frame = this->items_[index];
+        if (!frame.image.isNull() || !this->isInWindow(index))
+        {
+            // Already decoded or we moved past it in the meantime
+            continue;
+        }
+
+        auto bytes = pixmapMemoryUsage(pixmap);
+        DebugCount::increase(DebugObject::BytesImageCurrent, bytes);
+        DebugCount::increase(DebugObject::BytesImageLoaded, bytes);
+        frame.image = std::move(pixmap);
+        adopted = true;
+    }
+
+    if (!this->items_.empty() && this->lastShown_.isNull())
+    {
+        this->lastShown_ = this->items_[this->index_].image;
+    }
+
+    if (adopted && this->memoryUsageChanged)
+    {
+        this->memoryUsageChanged();
+    }
 }
 
 void Frames::processOffset()
@@ -165,6 +631,14 @@ void Frames::clear()
     this->index_ = 0;
     this->durationOffset_ = 0;
     this->gifTimerConnection_.disconnect();
+
+    if (this->decoder_)
+    {
+        this->decoder_->owner = nullptr;
+        this->decoder_.reset();
+    }
+    this->decodePending_ = false;
+    this->lastShown_ = QPixmap();
 }
 
 bool Frames::empty() const
@@ -184,7 +658,33 @@ std::optional<QPixmap> Frames::current() const
         return std::nullopt;
     }
 
-    return this->items_[this->index_].image;
+    const auto &image = this->items_[this->index_].image;
+    if (image.isNull() && this->decoder_)
+    {
+        // The decoder fell behind - keep showing what we showed before
+        if (!this->lastShown_.isNull())
+        {
+            return this->lastShown_;
+        }
+        return this->items_.front().image;
+    }
+
+    return image;
+}
+
+std::optional<QPixmap> Frames::paint()
+{
+    if (this->decoder_)
+    {
+        bool wasIdle = this->isIdle();
+        this->lastPainted_ = std::chrono::steady_clock::now();
+        if (wasIdle)
+        {
+            this->updateWindow(this->index_);
+        }
+    }
+
+    return this->current();
 }
 
 std::optional<QPixmap> Frames::first() const
@@ -197,23 +697,57 @@ std::optional<QPixmap> Frames::first() const
     return this->items_.front().image;
 }
 
-QList<Frame> readFrames(QImageReader &reader, const Url &url)
+QList<Frame> readFrames(QImageReader &reader, const Url &url,
+                        AnimatedFrameMode mode)
 {
     QList<Frame> frames;
     constexpr int MAX_FRAME_COUNT = 300;
     frames.reserve(1);
     int64_t bytesLoaded = 0;
 
+    bool scanned = false;
     for (int index = 0; index < MAX_FRAME_COUNT; ++index)
     {
+        // In windowed mode, we only need the durations of the frames past the
+        // initial window. They're decoded when they're about to be shown.
+        if (mode == AnimatedFrameMode::Windowed &&
+            index > Frames::WINDOW_SIZE && !scanned)
+        {
+            scanned = true;
+            auto delays = scanFrameDelays(reader);
+            if (delays && std::cmp_greater_equal(delays->size(), index))
+            {
+                auto count =
+                    std::min<qsizetype>(delays->size(), MAX_FRAME_COUNT);
+                for (auto i = frames.size(); i < count; i++)
+                {
+                    frames.append(Frame{
+                        .image = {},
+                        .duration =
+                            frameDuration((*delays)[static_cast<size_t>(i)]),
+                    });
+                }
+                break;
+            }
+        }
+
         auto pixmap = QPixmap::fromImageReader(&reader);
         if (pixmap.isNull())
         {
             break;
         }
 
-        bytesLoaded += static_cast<int64_t>(pixmap.width()) *
-                       static_cast<int64_t>(pixmap.height()) * 4;
+        // If the format can't be scanned, the frames are decoded and dropped
+        if (mode == AnimatedFrameMode::Windowed &&
+            index > Frames::WINDOW_SIZE)
+        {
+            pixmap = QPixmap();
+        }
+        else
+        {
+            bytesLoaded += static_cast<int64_t>(pixmap.width()) *
+                           static_cast<int64_t>(pixmap.height()) * 4;
+        }
         if (bytesLoaded > Image::maxBytesRam)
         {
             qCDebug(chatterinoImage)
@@ -223,20 +757,9 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
             break;
         }
 
-        // It seems that browsers have special logic for fast animations.
-        // This implements Chrome and Firefox's behavior which uses
-        // a duration of 100 ms for any frames that specify a duration of <= 10 ms.
-        // See http://webkit.org/b/36082 for more information.
-        // https://github.com/SevenTV/chatterino7/issues/46#issuecomment-1010595231
-        int duration = reader.nextImageDelay();
-        if (duration <= 10)
-        {
-            duration = 100;
-        }
-        duration = std::max(20, duration);
         frames.append(Frame{
             .image = std::move(pixmap),
-            .duration = duration,
+            .duration = frameDuration(reader.nextImageDelay()),
         });
 
         if (!reader.supportsAnimation())
@@ -261,17 +784,64 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
     return frames;
 }
 
-void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed)
+std::shared_ptr<FrameDecoder> makeFrameDecoder(const QList<Frame> &frames,
+                                               QByteArray data,
+                                               QByteArray format)
+{
+    bool allDecoded = std::ranges::all_of(frames, [](const auto &frame) {
+        return !frame.image.isNull();
+    });
+    if (allDecoded)
+    {
+        return nullptr;
+    }
+
+    return std::make_shared<FrameDecoder>(std::move(data), std::move(format));
+}
+
+void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed,
+                  std::shared_ptr<FrameDecoder> decoder)
 {
     static bool isPushQueued;
 
-    auto cb = [parsed = std::move(parsed), weak = std::move(weak)]() mutable {
+    auto cb = [parsed = std::move(parsed), weak = std::move(weak),
+               decoder = std::move(decoder)]() mutable {
         auto shared = weak.lock();
         if (!shared)
         {
             return;
         }
-        shared->frames_ = std::make_unique<detail::Frames>(std::move(parsed));
+        shared->frames_ = std::make_unique<detail::Frames>(std::move(parsed),
+                                                           std::move(decoder));
+        // The image was requested to be painted. Without this, the pool
+        // would consider the frames as unused and evict them right away.
+        shared->lastUsed_ = std::chrono::steady_clock::now();
+#ifndef DISABLE_IMAGE_EXPIRATION_POOL
+        ImageExpirationPool::instance().updateImageBytes(
+            shared.get(), shared->frames_->memoryUsage());
+
+        // In windowed mode, frames are decoded and released while the image
+        // is animating. The pool might expire the frames that report the
+        // change, so the update is posted, once per event loop iteration.
+        shared->frames_->memoryUsageChanged =
+            [weak, queued = std::make_shared<bool>(false)] {
+                if (*queued)
+                {
+                    return;
+                }
+                *queued = true;
+                postToThread([weak, queued] {
+                    *queued = false;
+                    auto image = weak.lock();
+                    if (!image)
+                    {
+                        return;
+                    }
+                    ImageExpirationPool::instance().updateImageBytes(
+                        image.get(), image->frames_->memoryUsage());
+                });
+            };
+#endif
 
         // Avoid too many layouts in one event-loop iteration
         //
@@ -459,7 +1029,7 @@ std::optional<QPixmap> Image::pixmapOrLoad() const
 
     this->load();
 
-    return this->frames_->current();
+    return this->frames_->paint();
 }
 
 void Image::load() const
@@ -536,10 +1106,11 @@ QSizeF Image::size() const
 void Image::actuallyLoad()
 {
     auto weak = weakOf(this);
+    auto frameMode = getSettings()->animatedFrameMode.getEnum();
     NetworkRequest(this->url().string)
         .concurrent()
         .cache()
-        .onSuccess([weak](auto result) {
+        .onSuccess([weak, frameMode](auto result) {
             auto shared = weak.lock();
             if (!shared)
             {
@@ -548,8 +1119,9 @@ void Image::actuallyLoad()
 
             assert(!isAppAboutToQuit());
 
+            const auto &data = result.getData();
             QBuffer buffer;
-            buffer.setData(result.getData());
+            buffer.setData(data);
             QImageReader reader(&buffer);
 
             if (!reader.canRead())
@@ -577,9 +1149,11 @@ void Image::actuallyLoad()
                 return;
             }
 
-            auto parsed = detail::readFrames(reader, shared->url());
+            auto parsed = detail::readFrames(reader, shared->url(), frameMode);
+            auto decoder =
+                detail::makeFrameDecoder(parsed, data, reader.format());
 
-            assignFrames(shared, parsed);
+            assignFrames(shared, std::move(parsed), std::move(decoder));
         })
         .onError([weak](auto /*result*/) {
             auto shared = weak.lock();
@@ -635,13 +1209,19 @@ ImageExpirationPool &ImageExpirationPool::instance()
 void ImageExpirationPool::addImagePtr(ImagePtr imgPtr)
 {
     std::lock_guard<std::mutex> lock(this->mutex_);
-    this->allImages_.emplace(imgPtr.get(), std::weak_ptr<Image>(imgPtr));
+    this->allImages_.emplace(imgPtr.get(), Entry{.image = imgPtr});
 }
 
 void ImageExpirationPool::removeImagePtr(Image *rawPtr)
 {
     std::lock_guard<std::mutex> lock(this->mutex_);
-    this->allImages_.erase(rawPtr);
+    auto it = this->allImages_.find(rawPtr);
+    if (it == this->allImages_.end())
+    {
+        return;
+    }
+    this->currentBytes_ -= it->second.bytes;
+    this->allImages_.erase(it);
 }
 
 void ImageExpirationPool::freeAll()
@@ -650,25 +1230,132 @@ void ImageExpirationPool::freeAll()
         std::lock_guard<std::mutex> lock(this->mutex_);
         for (auto it = this->allImages_.begin(); it != this->allImages_.end();)
         {
-            auto img = it->second.lock();
+            auto img = it->second.image.lock();
             img->expireFrames();
             it = this->allImages_.erase(it);
         }
+        this->currentBytes_ = 0;
     }
     this->freeOld();
 }
 
-void ImageExpirationPool::freeOld()
+void ImageExpirationPool::updateImageBytes(Image *rawPtr, int64_t bytes)
 {
+    assertInGuiThread();
+
+    int64_t budget = imageMemoryBudget();
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        auto it = this->allImages_.find(rawPtr);
+        if (it == this->allImages_.end())
+        {
+            return;
+        }
+
+        this->currentBytes_ += bytes - it->second.bytes;
+        it->second.bytes = bytes;
+
+        if (this->currentBytes_ > this->peakBytes_)
+        {
+            this->peakBytes_ = this->currentBytes_;
+            DebugCount::set(DebugObject::BytesImagePeak, this->peakBytes_);
+        }
+
+        if (budget == 0 || this->currentBytes_ <= budget)
+        {
+            return;
+        }
+    }
+
+    this->enforceBudget(budget);
+}
+
+void ImageExpirationPool::enforceBudget(int64_t budget)
+{
+    assertInGuiThread();
+
+    // Declared before the lock, so the images are released after the mutex
+    // is unlocked (~Image locks it in removeImagePtr).
+    std::vector<std::pair<ImagePtr, int64_t>> candidates;
+
     std::lock_guard<std::mutex> lock(this->mutex_);
+    if (this->currentBytes_ <= budget)
+    {
+        return;
+    }
+
+    auto graceStart =
+        std::chrono::steady_clock::now() - IMAGE_POOL_BUDGET_GRACE_PERIOD;
+    for (const auto &[rawPtr, entry] : this->allImages_)
+    {
+        if (entry.bytes <= 0)
+        {
+            continue;
+        }
+        auto img = entry.image.lock();
+        if (!img || img->lastUsed_ > graceStart)
+        {
+            continue;
+        }
+        candidates.emplace_back(std::move(img), entry.bytes);
+    }
+
+    std::ranges::sort(candidates, [](const auto &a, const auto &b) {
+        return a.first->lastUsed_ < b.first->lastUsed_;
+    });
+
+    int64_t numEvicted = 0;
+    int64_t bytesEvicted = 0;
+    for (const auto &[img, bytes] : candidates)
+    {
+        if (this->currentBytes_ <= budget)
+        {
+            break;
+        }
+
+        img->expireFrames();
+        this->allImages_.erase(img.get());
+        this->currentBytes_ -= bytes;
 
+        ++numEvicted;
+        bytesEvicted += bytes;
+    }
+
+    if (numEvicted > 0)
+    {
+        qCDebug(chatterinoImage)
+            << "evicted" << numEvicted << "images to stay within the budget";
+        DebugCount::increase(DebugObject::ImageBudgetEvicted, numEvicted);
+        DebugCount::increase(DebugObject::BytesImageBudgetEvicted,
+                             bytesEvicted);
+        DebugCount::set(DebugObject::BytesProcessPeak, peakResidentSetSize());
+    }
+}
+
+void ImageExpirationPool::freeOld()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->expireUnused();
+    }
+
+    if (auto budget = imageMemoryBudget(); budget > 0)
+    {
+        this->enforceBudget(budget);
+    }
+
+    DebugCount::set(DebugObject::BytesProcessPeak, peakResidentSetSize());
+}
+
+void ImageExpirationPool::expireUnused()
+{
     size_t numExpired = 0;
     size_t eligible = 0;
 
     auto now = std::chrono::steady_clock::now();
     for (auto it = this->allImages_.begin(); it != this->allImages_.end();)
     {
-        auto img = it->second.lock();
+        auto img = it->second.image.lock();
         if (!img)
         {
             // This can only really happen from a race condition because ~Image
@@ -692,6 +1379,7 @@ void ImageExpirationPool::freeOld()
         {
             ++numExpired;
             img->expireFrames();
+            this->currentBytes_ -= it->second.bytes;
             // erase without mutex locking issue
             it = this->allImages_.erase(it);
             continue;
@@ -5,10 +5,12 @@
 #pragma once
 
 #include "common/Aliases.hpp"
+#include "common/enums/AnimatedFrameMode.hpp"
 #include "util/DebugCount.hpp"
 
 #include <boost/variant.hpp>
 #include <pajlada/signals/signal.hpp>
+#include <QByteArray>
 #include <QList>
 #include <QPixmap>
 #include <QString>
@@ -17,10 +19,16 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <utility>
+#include <vector>
+
+class QBuffer;
+class QImageReader;
 
 namespace chatterino {
 
@@ -31,15 +39,64 @@ class Image;
 namespace chatterino::detail {
 
 struct Frame {
+    /// Null if the frame isn't decoded (only in windowed mode)
     QPixmap image;
     int duration;
 };
 
+class Frames;
+
+/// @brief Decodes the frames of an animated image on demand.
+///
+/// Keeps the compressed image data around and decodes frames sequentially
+/// (GIF and WebP frames can depend on the previous ones).
+/// `decode` is thread safe and meant to be called from a worker thread.
+class FrameDecoder
+{
+public:
+    FrameDecoder(QByteArray data, QByteArray format);
+    ~FrameDecoder();
+
+    FrameDecoder(const FrameDecoder &) = delete;
+    FrameDecoder &operator=(const FrameDecoder &) = delete;
+    FrameDecoder(FrameDecoder &&) = delete;
+    FrameDecoder &operator=(FrameDecoder &&) = delete;
+
+    /// Decodes the frames at `indices` (in order).
+    /// Frames that can't be decoded are returned as a null pixmap.
+    std::vector<std::pair<qsizetype, QPixmap>> decode(
+        const std::vector<qsizetype> &indices);
+
+    /// The frames this decoder is feeding (GUI thread only)
+    Frames *owner = nullptr;
+
+private:
+    void restart();
+
+    std::mutex mutex_;
+    const QByteArray data_;
+    const QByteArray format_;
+    std::unique_ptr<QBuffer> buffer_;
+    std::unique_ptr<QImageReader> reader_;
+    /// The index of the frame the next read will return
+    qsizetype nextIndex_ = 0;
+};
+
 class Frames
 {
 public:
+    /// The number of frames ahead of the current one that are kept decoded
+    /// in windowed mode
+    static constexpr qsizetype WINDOW_SIZE = 8;
+    /// In windowed mode, no frames are decoded for images that weren't
+    /// painted for this long
+    static constexpr std::chrono::milliseconds DECODE_IDLE_TIMEOUT{1000};
+
     Frames();
-    Frames(QList<Frame> &&frames);
+    /// @param decoder If set, only some frames in `frames` are decoded and
+    ///                the remaining ones are decoded by this on demand.
+    Frames(QList<Frame> &&frames,
+           std::shared_ptr<FrameDecoder> decoder = nullptr);
     ~Frames();
 
     Frames(const Frames &) = delete;
@@ -55,17 +112,57 @@ public:
     std::optional<QPixmap> current() const;
     std::optional<QPixmap> first() const;
 
-private:
+    /// Returns the current frame to paint it. In windowed mode, this resumes
+    /// decoding if the image wasn't painted recently.
+    std::optional<QPixmap> paint();
+
+    /// The number of bytes used by the decoded frames
     int64_t memoryUsage() const;
+
+    /// Called when frames were decoded or released in windowed mode, so the
+    /// owner can account for the new #memoryUsage(). It's called while the
+    /// frames are being updated, so it must not modify them right away.
+    std::function<void()> memoryUsageChanged;
+
+private:
     void processOffset();
+
+    /// Releases frames that fell out of the window and requests the
+    /// upcoming ones from the decoder (windowed mode only)
+    void updateWindow(QList<Frame>::size_type previousIndex);
+    bool isInWindow(QList<Frame>::size_type index) const;
+    bool isIdle() const;
+    void adoptDecodedFrames(
+        std::vector<std::pair<qsizetype, QPixmap>> &&decoded);
+
     QList<Frame> items_;
     QList<Frame>::size_type index_{0};
     int durationOffset_{0};
     pajlada::Signals::Connection gifTimerConnection_;
+
+    // windowed mode
+    std::shared_ptr<FrameDecoder> decoder_;
+    bool decodePending_ = false;
+    /// The last decoded frame that was current - shown if decoding falls behind
+    QPixmap lastShown_;
+    std::chrono::steady_clock::time_point lastPainted_;
 };
 
-QList<Frame> readFrames(QImageReader &reader, const Url &url);
-void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed);
+/// @brief Reads the frames of an image.
+///
+/// @param mode In windowed mode, only the first few frames of animated images
+///             are kept decoded. Use makeFrameDecoder to decode the rest.
+QList<Frame> readFrames(
+    QImageReader &reader, const Url &url,
+    AnimatedFrameMode mode = AnimatedFrameMode::FullyResident);
+
+/// Returns a decoder for `frames` if any of them aren't decoded
+std::shared_ptr<FrameDecoder> makeFrameDecoder(const QList<Frame> &frames,
+                                               QByteArray data,
+                                               QByteArray format);
+
+void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed,
+                  std::shared_ptr<FrameDecoder> decoder = nullptr);
 
 }  // namespace chatterino::detail
 
@@ -137,7 +234,8 @@ private:
 
     friend class ImageExpirationPool;
     friend void detail::assignFrames(std::weak_ptr<Image>,
-                                     QList<detail::Frame>);
+                                     QList<detail::Frame>,
+                                     std::shared_ptr<detail::FrameDecoder>);
 };
 
 // forward-declarable function that calls Image::getEmpty() under the hood.
@@ -168,9 +266,40 @@ public:
      */
     void freeAll();
 
+    /// Expires images that weren't used for a while. mutex_ must be held.
+    void expireUnused();
+
+    /**
+     * @brief Records the size of the decoded frames of an image in the pool.
+     *
+     * If a memory budget is configured (see Settings::imageMemoryBudget) and
+     * the pool exceeds it, the least recently used images are expired
+     * immediately instead of waiting for the next freeOld().
+     * Must be ran in the GUI thread.
+     */
+    void updateImageBytes(Image *rawPtr, int64_t bytes);
+
+    /**
+     * @brief Expires the least recently used images until at most `budget`
+     * bytes of decoded frames are left.
+     *
+     * Images that were used very recently are never expired, as they're
+     * likely still on screen. Must be ran in the GUI thread.
+     */
+    void enforceBudget(int64_t budget);
+
+    struct Entry {
+        std::weak_ptr<Image> image;
+        /// The bytes used by the image's frames (as of the last update)
+        int64_t bytes = 0;
+    };
+
     // Timer to periodically run freeOld()
     QTimer *freeTimer_;
-    std::map<Image *, std::weak_ptr<Image>> allImages_;
+    std::map<Image *, Entry> allImages_;
+    /// Sum of `Entry::bytes` in allImages_
+    int64_t currentBytes_ = 0;
+    int64_t peakBytes_ = 0;
     std::mutex mutex_;
 };
 
@@ -6,18 +6,176 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace chatterino {
 
+namespace detail {
+
+    /// Maps the keys of the items in a LimitedQueue to their position.
+    ///
+    /// Positions are absolute: the item at buffer index `i` has the position
+    /// `offset + i`. Removing an item from the front increments `offset`, so
+    /// pushing to the back and evicting doesn't require touching other keys.
+    template <typename Indexer>
+    struct LimitedQueueIndex {
+        std::unordered_map<typename Indexer::Key, int64_t,
+                           typename Indexer::Hash, std::equal_to<>>
+            positions;
+        int64_t offset = 0;
+    };
+
+    template <>
+    struct LimitedQueueIndex<void> {
+    };
+
+}  // namespace detail
+
+/// @brief A read-only view of the items of a LimitedQueue
+///
+/// The view doesn't copy the items. It holds a shared lock on the queue, so
+/// the queue can't be modified while the view exists - keep it short-lived
+/// and don't modify the queue from the same thread while holding it.
 template <typename T>
+class LimitedQueueView
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        Iterator() = default;
+
+        reference operator*() const
+        {
+            return (*this->view_)[this->index_];
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        Iterator &operator++()
+        {
+            ++this->index_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++this->index_;
+            return copy;
+        }
+
+        Iterator &operator--()
+        {
+            --this->index_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --this->index_;
+            return copy;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return this->index_ == other.index_;
+        }
+
+    private:
+        friend LimitedQueueView;
+
+        Iterator(const LimitedQueueView *view, size_t index)
+            : view_(view)
+            , index_(index)
+        {
+        }
+
+        const LimitedQueueView *view_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    LimitedQueueView(std::shared_lock<std::shared_mutex> lock,
+                     std::span<const T> first, std::span<const T> second)
+        : lock_(std::move(lock))
+        , first_(first)
+        , second_(second)
+    {
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return this->first_.size() + this->second_.size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return this->size() == 0;
+    }
+
+    const T &operator[](size_t index) const
+    {
+        assert(index < this->size());
+
+        if (index < this->first_.size())
+        {
+            return this->first_[index];
+        }
+        return this->second_[index - this->first_.size()];
+    }
+
+    [[nodiscard]] Iterator begin() const
+    {
+        return {this, 0};
+    }
+
+    [[nodiscard]] Iterator end() const
+    {
+        return {this, this->size()};
+    }
+
+private:
+    std::shared_lock<std::shared_mutex> lock_;
+    // The ring buffer is stored as (up to) two contiguous arrays
+    std::span<const T> first_;
+    std::span<const T> second_;
+};
+
+/// @brief A thread safe ring buffer
+///
+/// @tparam Indexer Optionally indexes the items by a key for findByKey(). It
+///                 must provide a `Key` type, a transparent `Hash`, and a
+///                 `static const Key &key(const T &)` that returns an empty
+///                 key for items that shouldn't be indexed. If multiple items have the
+///                 same key, the last one is found.
+template <typename T, typename Indexer = void>
 class LimitedQueue
 {
+    static constexpr bool HAS_INDEX = !std::is_void_v<Indexer>;
+
 public:
     LimitedQueue(size_t limit = 1000)
         : limit_(limit)
@@ -127,6 +285,12 @@ public:
         std::unique_lock lock(this->mutex_);
 
         this->buffer_.clear();
+        this->epoch_++;
+        if constexpr (HAS_INDEX)
+        {
+            this->index_.positions.clear();
+            this->index_.offset = 0;
+        }
     }
 
     /**
@@ -144,8 +308,11 @@ public:
         if (full)
         {
             deleted = this->buffer_.front();
+            this->unindexFront();
         }
         this->buffer_.push_back(item);
+        this->epoch_++;
+        this->indexItem(this->buffer_.size() - 1);
         return full;
     }
 
@@ -160,7 +327,13 @@ public:
         std::unique_lock lock(this->mutex_);
 
         bool full = this->buffer_.full();
+        if (full)
+        {
+            this->unindexFront();
+        }
         this->buffer_.push_back(item);
+        this->epoch_++;
+        this->indexItem(this->buffer_.size() - 1);
         return full;
     }
 
@@ -187,6 +360,12 @@ public:
         for (; f < items.size(); ++f, --b)
         {
             this->buffer_.push_front(items[b]);
+            this->epoch_++;
+            if constexpr (HAS_INDEX)
+            {
+                this->index_.offset--;
+            }
+            this->indexItem(0);
             pushed.push_back(items[f]);
         }
 
@@ -207,11 +386,17 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
+        if (auto i = this->indexOf(needle); i && eq(this->buffer_[*i], needle))
+        {
+            this->replaceAt(*i, replacement);
+            return static_cast<int>(*i);
+        }
+
         for (size_t i = 0; i < this->buffer_.size(); ++i)
         {
             if (eq(this->buffer_[i], needle))
             {
-                this->buffer_[i] = replacement;
+                this->replaceAt(i, replacement);
                 return static_cast<int>(i);
             }
         }
@@ -237,12 +422,9 @@ public:
 
         if (prev)
         {
-            *prev = std::exchange(this->buffer_[index], replacement);
-        }
-        else
-        {
-            this->buffer_[index] = replacement;
+            *prev = this->buffer_[index];
         }
+        this->replaceAt(index, replacement);
         return true;
     }
 
@@ -260,7 +442,7 @@ public:
 
         if (hint < this->buffer_.size() && this->buffer_[hint] == needle)
         {
-            this->buffer_[hint] = replacement;
+            this->replaceAt(hint, replacement);
             return static_cast<int>(hint);
         }
 
@@ -268,7 +450,7 @@ public:
         {
             if (this->buffer_[i] == needle)
             {
-                this->buffer_[i] = replacement;
+                this->replaceAt(i, replacement);
                 return static_cast<int>(i);
             }
         }
@@ -289,11 +471,17 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        if (auto i = this->indexOf(needle); i && eq(this->buffer_[*i], needle))
         {
-            if (eq(*it, needle))
+            this->insertAt(*i, item);
+            return true;
+        }
+
+        for (size_t i = 0; i < this->buffer_.size(); ++i)
+        {
+            if (eq(this->buffer_[i], needle))
             {
-                this->buffer_.insert(it, item);
+                this->insertAt(i, item);
                 return true;
             }
         }
@@ -315,12 +503,17 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        if (auto i = this->indexOf(needle); i && eq(this->buffer_[*i], needle))
+        {
+            this->insertAt(*i + 1, item);
+            return true;
+        }
+
+        for (size_t i = 0; i < this->buffer_.size(); ++i)
         {
-            if (eq(*it, needle))
+            if (eq(this->buffer_[i], needle))
             {
-                ++it;  // advance to insert after it
-                this->buffer_.insert(it, item);
+                this->insertAt(i + 1, item);  // insert after it
                 return true;
             }
         }
@@ -328,6 +521,36 @@ public:
         return false;
     }
 
+    /**
+     * @brief Returns a view of the items without copying them
+     *
+     * Prefer this over getSnapshot() if the items are only looked at
+     * briefly. See LimitedQueueView for the constraints.
+     */
+    [[nodiscard]] LimitedQueueView<T> read() const
+    {
+        std::shared_lock lock(this->mutex_);
+
+        auto one = this->buffer_.array_one();
+        auto two = this->buffer_.array_two();
+        return {
+            std::move(lock),
+            {one.first, one.second},
+            {two.first, two.second},
+        };
+    }
+
+    /**
+     * @brief Returns a counter that changes whenever the queue is modified
+     *
+     * Can be used to skip taking a snapshot if nothing changed since the
+     * last one.
+     */
+    [[nodiscard]] uint64_t epoch() const
+    {
+        return this->epoch_.load(std::memory_order_acquire);
+    }
+
     [[nodiscard]] std::vector<T> getSnapshot() const
     {
         std::shared_lock lock(this->mutex_);
@@ -446,11 +669,200 @@ public:
         return std::nullopt;
     }
 
+    /**
+     * @brief Returns the last item with the given key
+     *
+     * This is a single hash lookup. Only available if the queue has an
+     * Indexer.
+     *
+     * @param[in] key the key to look for (must not be empty)
+     * @return the item or std::nullopt if there's no item with this key
+     */
+    template <typename K>
+    [[nodiscard]] std::optional<T> findByKey(const K &key) const
+        requires HAS_INDEX
+    {
+        std::shared_lock lock(this->mutex_);
+
+        auto it = this->index_.positions.find(key);
+        if (it == this->index_.positions.end())
+        {
+            return std::nullopt;
+        }
+
+        auto i = static_cast<size_t>(it->second - this->index_.offset);
+        assert(i < this->buffer_.size());
+        return this->buffer_[i];
+    }
+
 private:
+    // All of these expect the lock to be held
+
+    /// Returns the position of the item at buffer index `i`
+    int64_t positionOf(size_t i) const
+        requires HAS_INDEX
+    {
+        return this->index_.offset + static_cast<int64_t>(i);
+    }
+
+    /// Returns the index of the last item with the same key as `item` (if
+    /// it's indexed).
+    std::optional<size_t> indexOf(const T &item) const
+    {
+        if constexpr (HAS_INDEX)
+        {
+            const auto &key = Indexer::key(item);
+            if (key.empty())
+            {
+                return std::nullopt;
+            }
+            auto it = this->index_.positions.find(key);
+            if (it == this->index_.positions.end())
+            {
+                return std::nullopt;
+            }
+            return static_cast<size_t>(it->second - this->index_.offset);
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    /// Adds the item at buffer index `i` to the index unless a later item
+    /// has the same key
+    void indexItem(size_t i)
+    {
+        if constexpr (HAS_INDEX)
+        {
+            const auto &key = Indexer::key(this->buffer_[i]);
+            if (key.empty())
+            {
+                return;
+            }
+
+            auto pos = this->positionOf(i);
+            auto it = this->index_.positions.find(key);
+            if (it == this->index_.positions.end())
+            {
+                this->index_.positions.emplace(key, pos);
+            }
+            else if (it->second < pos)
+            {
+                it->second = pos;
+            }
+        }
+    }
+
+    /// Removes the item at buffer index `i` from the index. If an earlier
+    /// item has the same key, that one is indexed instead.
+    void unindexItem(size_t i)
+    {
+        if constexpr (HAS_INDEX)
+        {
+            const auto &key = Indexer::key(this->buffer_[i]);
+            if (key.empty())
+            {
+                return;
+            }
+
+            auto it = this->index_.positions.find(key);
+            if (it == this->index_.positions.end() ||
+                it->second != this->positionOf(i))
+            {
+                return;
+            }
+
+            for (size_t j = i; j > 0; j--)
+            {
+                if (Indexer::key(this->buffer_[j - 1]) == key)
+                {
+                    it->second = this->positionOf(j - 1);
+                    return;
+                }
+            }
+            this->index_.positions.erase(it);
+        }
+    }
+
+    /// Removes the first item from the index before it's evicted
+    void unindexFront()
+    {
+        if constexpr (HAS_INDEX)
+        {
+            // there can't be an earlier item with the same key
+            this->unindexItem(0);
+            this->index_.offset++;
+        }
+    }
+
+    void replaceAt(size_t i, const T &replacement)
+    {
+        if constexpr (HAS_INDEX)
+        {
+            if (Indexer::key(this->buffer_[i]) != Indexer::key(replacement))
+            {
+                this->unindexItem(i);
+                this->buffer_[i] = replacement;
+                this->epoch_++;
+                this->indexItem(i);
+                return;
+            }
+        }
+        this->buffer_[i] = replacement;
+        this->epoch_++;
+    }
+
+    /// Inserts `item` before buffer index `i`. If the buffer is full, the
+    /// first item is removed to make room.
+    void insertAt(size_t i, const T &item)
+    {
+        if (!this->buffer_.full())
+        {
+            this->buffer_.insert(this->buffer_.begin() + i, item);
+        }
+        else if (i == 0)
+        {
+            // The item would be evicted right away
+            return;
+        }
+        else
+        {
+            this->unindexFront();
+            // boost::circular_buffer drops the first item for us
+            this->buffer_.insert(this->buffer_.begin() + i, item);
+            i--;
+        }
+        this->epoch_++;
+
+        if constexpr (HAS_INDEX)
+        {
+            // Everything after the new item moved back by one position
+            for (size_t j = i + 1; j < this->buffer_.size(); j++)
+            {
+                const auto &key = Indexer::key(this->buffer_[j]);
+                if (key.empty())
+                {
+                    continue;
+                }
+                auto it = this->index_.positions.find(key);
+                if (it != this->index_.positions.end() &&
+                    it->second == this->positionOf(j) - 1)
+                {
+                    it->second = this->positionOf(j);
+                }
+            }
+            this->indexItem(i);
+        }
+    }
+
     mutable std::shared_mutex mutex_;
 
     const size_t limit_;
     boost::circular_buffer<T> buffer_;
+    /// Incremented on every modification, see epoch()
+    std::atomic<uint64_t> epoch_ = 0;
+    [[no_unique_address]] detail::LimitedQueueIndex<Indexer> index_;
 };
 
 }  // namespace chatterino
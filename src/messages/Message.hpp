@@ -8,12 +8,14 @@
 #include "providers/twitch/ChannelPointReward.hpp"
 #include "util/DebugCount.hpp"
 #include "util/QStringHash.hpp"
+#include "util/Similarity.hpp"
 
 #include <QColor>
 #include <QTime>
 
 #include <cinttypes>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -122,6 +124,12 @@ struct Message {
     /// true.
     mutable bool frozen = false;
 
+    /// Fingerprint of #messageText, computed on first use by the similarity
+    /// filter (see MessageSimilarity.cpp). Like #flags, it's only modified
+    /// from the thread that owns the message (the GUI thread once the message
+    /// was added to a channel).
+    mutable std::optional<similarity::Fingerprint> similarityFingerprint;
+
     std::vector<std::unique_ptr<MessageElement>> elements;
 
     ScrollbarHighlight getScrollBarHighlight() const;
@@ -5,6 +5,7 @@
 #include "messages/MessageBuilder.hpp"
 
 #include "Application.hpp"
+#include "common/Atomic.hpp"
 #include "common/LinkParser.hpp"
 #include "common/Literals.hpp"
 #include "common/QLogging.hpp"
@@ -15,6 +16,7 @@
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "controllers/userdata/UserDataController.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/Message.hpp"
@@ -50,7 +52,6 @@
 #include "util/Helpers.hpp"
 #include "util/IrcHelpers.hpp"
 #include "util/QStringHash.hpp"
-#include "util/Variant.hpp"
 #include "widgets/Window.hpp"
 
 #include <boost/variant.hpp>
@@ -66,6 +67,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <memory>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -1547,9 +1549,11 @@ struct CrossChannelEmoteCache {
     qint64 builtAtMs = 0;
 };
 
-CrossChannelEmoteCache &crossChannelEmoteCache()
+/// Messages are built on worker threads too, so the cache is replaced as a
+/// whole instead of being modified
+Atomic<std::shared_ptr<const CrossChannelEmoteCache>> &crossChannelEmoteCache()
 {
-    static CrossChannelEmoteCache cache;
+    static Atomic<std::shared_ptr<const CrossChannelEmoteCache>> cache;
     return cache;
 }
 
@@ -1566,30 +1570,8 @@ QString crossChannelEmoteCacheSignature()
         .arg(settings->openEmoteCrossChannelEmotesBlockChannels.getValue());
 }
 
-CrossChannelEmoteCache &getCrossChannelEmoteCache()
+void collectCrossChannelEmotes(CrossChannelEmoteCache &cache)
 {
-    constexpr qint64 TTL_MS = 5000;
-
-    auto &cache = crossChannelEmoteCache();
-    const auto signature = crossChannelEmoteCacheSignature();
-    const auto now = QDateTime::currentMSecsSinceEpoch();
-
-    if (cache.signature == signature && (now - cache.builtAtMs) < TTL_MS)
-    {
-        return cache;
-    }
-
-    cache.bttv.clear();
-    cache.ffz.clear();
-    cache.seventv.clear();
-    cache.signature = signature;
-    cache.builtAtMs = now;
-
-    if (!getSettings()->openEmoteEnableCrossChannelEmotes.getValue())
-    {
-        return cache;
-    }
-
     const bool allowlistOnly =
         getSettings()->openEmoteCrossChannelEmotesAllowlistMode.getValue();
     const auto allowChannels = parseCrossChannelSet(
@@ -1635,8 +1617,36 @@ CrossChannelEmoteCache &getCrossChannelEmoteCache()
             mergeInto(*seventv, cache.seventv);
         }
     });
+}
 
-    return cache;
+std::shared_ptr<const CrossChannelEmoteCache> getCrossChannelEmoteCache()
+{
+    constexpr qint64 TTL_MS = 5000;
+
+    const auto signature = crossChannelEmoteCacheSignature();
+    const auto now = QDateTime::currentMSecsSinceEpoch();
+
+    if (auto current = crossChannelEmoteCache().get();
+        current && current->signature == signature &&
+        (now - current->builtAtMs) < TTL_MS)
+    {
+        return current;
+    }
+
+    auto rebuilt = std::make_shared<CrossChannelEmoteCache>();
+    auto &cache = *rebuilt;
+    cache.signature = signature;
+    cache.builtAtMs = now;
+
+    if (getSettings()->openEmoteEnableCrossChannelEmotes.getValue())
+    {
+        collectCrossChannelEmotes(cache);
+    }
+
+    // Threads that rebuild at the same time each publish their own snapshot
+    std::shared_ptr<const CrossChannelEmoteCache> snapshot = std::move(rebuilt);
+    crossChannelEmoteCache().set(snapshot);
+    return snapshot;
 }
 
 EmotePtr parseEmote(TwitchChannel *twitchChannel, const EmoteName &name)
@@ -1649,73 +1659,55 @@ EmotePtr parseEmote(TwitchChannel *twitchChannel, const EmoteName &name)
     //  - BetterTTV Global
     //  - 7TV Global
 
-    const auto *globalFfzEmotes = getApp()->getFfzEmotes();
-    const auto *globalBttvEmotes = getApp()->getBttvEmotes();
-    const auto *globalSeventvEmotes = getApp()->getSeventvEmotes();
-
-    std::optional<EmotePtr> emote{};
-
     if (twitchChannel != nullptr)
     {
-        // Check for channel emotes
+        // The channel keeps an index of all of the above
+        if (auto emote = twitchChannel->thirdPartyEmote(name.string))
+        {
+            return emote;
+        }
+    }
+    else
+    {
+        std::optional<EmotePtr> emote{};
 
-        emote = twitchChannel->ffzEmote(name);
+        emote = getApp()->getFfzEmotes()->emote(name);
         if (emote)
         {
             return *emote;
         }
 
-        emote = twitchChannel->bttvEmote(name);
+        emote = getApp()->getBttvEmotes()->emote(name);
         if (emote)
         {
             return *emote;
         }
 
-        emote = twitchChannel->seventvEmote(name);
+        emote = getApp()->getSeventvEmotes()->globalEmote(name);
         if (emote)
         {
             return *emote;
         }
     }
 
-    // Check for global emotes
-
-    emote = globalFfzEmotes->emote(name);
-    if (emote)
-    {
-        return *emote;
-    }
-
-    emote = globalBttvEmotes->emote(name);
-    if (emote)
-    {
-        return *emote;
-    }
-
-    emote = globalSeventvEmotes->globalEmote(name);
-    if (emote)
-    {
-        return *emote;
-    }
-
     if (getSettings()->openEmoteEnableCrossChannelEmotes.getValue())
     {
-        const auto &crossCache = getCrossChannelEmoteCache();
+        const auto crossCache = getCrossChannelEmoteCache();
 
-        const auto ffzIt = crossCache.ffz.constFind(name.string);
-        if (ffzIt != crossCache.ffz.cend())
+        const auto ffzIt = crossCache->ffz.constFind(name.string);
+        if (ffzIt != crossCache->ffz.cend())
         {
             return ffzIt.value();
         }
 
-        const auto bttvIt = crossCache.bttv.constFind(name.string);
-        if (bttvIt != crossCache.bttv.cend())
+        const auto bttvIt = crossCache->bttv.constFind(name.string);
+        if (bttvIt != crossCache->bttv.cend())
         {
             return bttvIt.value();
         }
 
-        const auto seventvIt = crossCache.seventv.constFind(name.string);
-        if (seventvIt != crossCache.seventv.cend())
+        const auto seventvIt = crossCache->seventv.constFind(name.string);
+        if (seventvIt != crossCache->seventv.cend())
         {
             return seventvIt.value();
         }
@@ -2257,7 +2249,17 @@ void MessageBuilder::addLink(const linkparser::Parsed &parsedLink,
                                    MessageElementFlag::Text, this->textColor_);
     }
 
-    getApp()->getLinkResolver()->resolve(el->linkInfo());
+    if (isGuiThread())
+    {
+        getApp()->getLinkResolver()->resolve(
+            el->linkInfo(), ILinkResolver::Priority::Background);
+    }
+    else
+    {
+        // The link is resolved once the message reaches the GUI thread (see
+        // resolveLinks())
+        el->linkInfo()->moveToThread(QCoreApplication::instance()->thread());
+    }
 }
 
 bool MessageBuilder::isIgnored(const QString &originalMessage,
@@ -2758,6 +2760,20 @@ MessagePtrMut MessageBuilder::makeClearChatMessage(const QDateTime &now,
     return builder.release();
 }
 
+void MessageBuilder::resolveLinks(const Message &message)
+{
+    assertInGuiThread();
+
+    for (const auto &element : message.elements)
+    {
+        if (auto *link = dynamic_cast<LinkElement *>(element.get()))
+        {
+            getApp()->getLinkResolver()->resolve(
+                link->linkInfo(), ILinkResolver::Priority::Background);
+        }
+    }
+}
+
 std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
     /* mutable */ Channel *channel, const Communi::IrcMessage *ircMessage,
     const MessageParseArgs &args, /* mutable */ QString content,
@@ -3102,6 +3118,20 @@ void MessageBuilder::addEmoji(const EmotePtr &emote)
     this->emplace<EmoteElement>(emote, MessageElementFlag::EmojiAll);
 }
 
+void MessageBuilder::addTextAndEmojis(TextState &state, const QString &word)
+{
+    getApp()->getEmotes()->getEmojis()->parse(
+        word,
+        [&](QStringView text) {
+            // Words without emojis are the common case, don't copy them
+            this->addTextOrEmote(
+                state, text.size() == word.size() ? word : text.toString());
+        },
+        [&](const EmotePtr &emote) {
+            this->addEmoji(emote);
+        });
+}
+
 void MessageBuilder::addTextOrEmote(TextState &state, QString string)
 {
     if (state.hasBits && this->tryAppendCheermote(state, string))
@@ -3763,19 +3793,7 @@ void MessageBuilder::addWords(
 
             // 1. Add text before the emote
             QString preText = word.left(currentTwitchEmote.start - cursor);
-            for (auto variant :
-                 getApp()->getEmotes()->getEmojis()->parse(preText))
-            {
-                std::visit(variant::Overloaded{
-                               [&](const EmotePtr &emote) {
-                                   this->addEmoji(emote);
-                               },
-                               [&](QStringView text) {
-                                   this->addTextOrEmote(state, text.toString());
-                               },
-                           },
-                           variant);
-            }
+            this->addTextAndEmojis(state, preText);
 
             cursor += preText.size();
 
@@ -3788,18 +3806,7 @@ void MessageBuilder::addWords(
         }
 
         // split words
-        for (auto variant : getApp()->getEmotes()->getEmojis()->parse(word))
-        {
-            std::visit(variant::Overloaded{
-                           [&](const EmotePtr &emote) {
-                               this->addEmoji(emote);
-                           },
-                           [&](QStringView text) {
-                               this->addTextOrEmote(state, text.toString());
-                           },
-                       },
-                       variant);
-        }
+        this->addTextAndEmojis(state, word);
 
         cursor += word.size() + 1;
     }
@@ -231,6 +231,11 @@ public:
     /// @returns The built message and a highlight result. If the message is
     ///          ignored (e.g. from a blocked user), then the returned pointer
     ///          will be en empty `shared_ptr`.
+    ///
+    /// This can be called from a worker thread if the room ID of `channel` is
+    /// known, the message wasn't sent from another room (shared chat), and
+    /// `thread` and `parent` are empty. Links in messages built outside the
+    /// GUI thread have to be resolved with resolveLinks().
     static std::pair<MessagePtrMut, HighlightAlert> makeIrcMessage(
         Channel *channel, const Communi::IrcMessage *ircMessage,
         const MessageParseArgs &args, QString content,
@@ -238,6 +243,10 @@ public:
         const std::shared_ptr<MessageThread> &thread = {},
         const MessagePtr &parent = {});
 
+    /// Starts loading the link info of all links in `message`.
+    /// Links in messages built in the GUI thread are already loading.
+    static void resolveLinks(const Message &message);
+
     static MessagePtrMut makeSystemMessageWithUser(
         const QString &text, const QString &loginName,
         const QString &displayName, const MessageColor &userColor,
@@ -266,6 +275,8 @@ private:
     };
     void addEmoji(const EmotePtr &emote);
     void addTextOrEmote(TextState &state, QString string);
+    /// Splits `word` into emojis and text, adding text with addTextOrEmote
+    void addTextAndEmojis(TextState &state, const QString &word);
 
     Outcome tryAppendCheermote(TextState &state, const QString &string);
     Outcome tryAppendEmote(TwitchChannel *twitchChannel, const EmoteName &name);
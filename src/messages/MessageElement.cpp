@@ -666,8 +666,9 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
 
     if (ctx.flags.hasAny(this->getFlags()))
     {
-        auto metrics =
-            app->getFonts()->getFontMetrics(this->style_, container.getScale());
+        auto &measure =
+            app->getFonts()->getTextMeasure(this->style_, container.getScale());
+        const auto &metrics = measure.metrics();
 
         for (const auto &word : this->words_)
         {
@@ -688,7 +689,7 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 return e;
             };
 
-            auto width = metrics.horizontalAdvance(word);
+            auto width = measure.horizontalAdvance(word);
 
             // see if the text fits in the current line
             if (container.fitsInLine(width))
@@ -805,7 +806,7 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
 
                 auto charWidth = isSurrogate
                                      ? metrics.horizontalAdvance(word.mid(i, 2))
-                                     : metrics.horizontalAdvance(word[i]);
+                                     : measure.horizontalAdvance(word[i]);
 
                 if (!container.fitsInLine(width + charWidth))
                 {
@@ -915,8 +916,9 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
 
     if (ctx.flags.hasAny(this->getFlags()))
     {
-        auto metrics =
-            app->getFonts()->getFontMetrics(this->style_, container.getScale());
+        auto &measure =
+            app->getFonts()->getTextMeasure(this->style_, container.getScale());
+        const auto &metrics = measure.metrics();
 
         auto getTextLayoutElement = [&](QString text, qreal width,
                                         bool hasTrailingSpace) {
@@ -978,7 +980,7 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
                         auto emoteScale = getSettings()->emoteScale.getValue();
 
                         auto currentWidth =
-                            metrics.horizontalAdvance(currentText);
+                            measure.horizontalAdvance(currentText);
                         auto emoteSize =
                             image->size() * emoteScale * container.getScale();
 
@@ -1012,7 +1014,7 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
         // Add the last of the pending message text to the container.
         if (!currentText.isEmpty())
         {
-            auto width = metrics.horizontalAdvance(currentText);
+            auto width = measure.horizontalAdvance(currentText);
             container.addElementNoLineBreak(
                 getTextLayoutElement(currentText, width, false));
         }
@@ -6,63 +6,29 @@
 
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "messages/LimitedQueue.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "singletons/Settings.hpp"
-
-#include <algorithm>
-#include <vector>
+#include "util/Similarity.hpp"
 
 namespace {
 
 using namespace chatterino;
 
-float relativeSimilarity(QStringView str1, QStringView str2)
+const similarity::Fingerprint &fingerprintOf(const Message &message)
 {
-    using SizeType = QStringView::size_type;
-
-    // Longest Common Substring Problem
-    std::vector<std::vector<int>> tree(str1.size(),
-                                       std::vector<int>(str2.size(), 0));
-    int z = 0;
-
-    for (SizeType i = 0; i < str1.size(); ++i)
-    {
-        for (SizeType j = 0; j < str2.size(); ++j)
-        {
-            if (str1[i] == str2[j])
-            {
-                if (i == 0 || j == 0)
-                {
-                    tree[i][j] = 1;
-                }
-                else
-                {
-                    tree[i][j] = tree[i - 1][j - 1] + 1;
-                }
-                z = std::max(tree[i][j], z);
-            }
-            else
-            {
-                tree[i][j] = 0;
-            }
-        }
-    }
-
-    // ensure that no div by 0
-    if (z == 0)
+    if (!message.similarityFingerprint)
     {
-        return 0.F;
+        message.similarityFingerprint =
+            similarity::Fingerprint::of(message.messageText);
     }
-
-    auto div = std::max<>({static_cast<SizeType>(1), str1.size(), str2.size()});
-
-    return float(z) / float(div);
+    return *message.similarityFingerprint;
 }
 
 template <std::ranges::bidirectional_range T>
-float inMessages(const MessagePtr &msg, const T &messages)
+bool inMessages(const MessagePtr &msg, const T &messages, float threshold)
 {
-    float similarityPercent = 0.0F;
+    const auto &fingerprint = fingerprintOf(*msg);
 
     for (const auto &prevMsg :
          messages | std::views::reverse |
@@ -78,12 +44,15 @@ float inMessages(const MessagePtr &msg, const T &messages)
         {
             continue;
         }
-        similarityPercent = std::max(
-            similarityPercent,
-            relativeSimilarity(msg->messageText, prevMsg->messageText));
+        if (similarity::isSimilar(msg->messageText, fingerprint,
+                                  prevMsg->messageText, fingerprintOf(*prevMsg),
+                                  threshold))
+        {
+            return true;
+        }
     }
 
-    return similarityPercent;
+    return false;
 }
 
 }  // namespace
@@ -105,7 +74,8 @@ void setSimilarityFlags(const MessagePtr &message, const T &messages)
             return;
         }
 
-        if (inMessages(message, messages) > getSettings()->similarityPercentage)
+        if (inMessages(message, messages,
+                       getSettings()->similarityPercentage.getValue()))
         {
             message->flags.set(MessageFlag::Similar);
             if (getSettings()->colorSimilarDisabled)
@@ -118,5 +88,7 @@ void setSimilarityFlags(const MessagePtr &message, const T &messages)
 
 template void setSimilarityFlags<std::vector<MessagePtr>>(
     const MessagePtr &msg, const std::vector<MessagePtr> &messages);
+template void setSimilarityFlags<LimitedQueueView<MessagePtr>>(
+    const MessagePtr &msg, const LimitedQueueView<MessagePtr> &messages);
 
 }  // namespace chatterino
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/UserMessageIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <algorithm>
+
+namespace {
+
+void addKey(std::vector<QString> &keys, const QString &name)
+{
+    if (name.isEmpty())
+    {
+        return;
+    }
+
+    auto key = name.isLower() ? name : name.toLower();
+    if (std::ranges::find(keys, key) == keys.end())
+    {
+        keys.emplace_back(std::move(key));
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void UserMessageIndex::pushBack(const MessagePtr &message)
+{
+    auto position = this->back_++;
+    for (const auto &key : keysOf(*message))
+    {
+        // This is always the last entry
+        this->entries_[key].push_back({position, message});
+    }
+}
+
+void UserMessageIndex::popFront(const MessagePtr &message)
+{
+    auto position = this->front_++;
+    for (const auto &key : keysOf(*message))
+    {
+        this->erase(key, position);
+    }
+}
+
+void UserMessageIndex::pushFront(const std::vector<MessagePtr> &messages)
+{
+    for (auto it = messages.rbegin(); it != messages.rend(); ++it)
+    {
+        auto position = --this->front_;
+        for (const auto &key : keysOf(**it))
+        {
+            this->insert(key, {position, *it});
+        }
+    }
+}
+
+void UserMessageIndex::replace(size_t index, const MessagePtr &prev,
+                               const MessagePtr &replacement)
+{
+    auto position = this->front_ + static_cast<int64_t>(index);
+    for (const auto &key : keysOf(*prev))
+    {
+        this->erase(key, position);
+    }
+    for (const auto &key : keysOf(*replacement))
+    {
+        this->insert(key, {position, replacement});
+    }
+}
+
+void UserMessageIndex::rebuild(const std::vector<MessagePtr> &messages)
+{
+    this->clear();
+    for (const auto &message : messages)
+    {
+        this->pushBack(message);
+    }
+}
+
+void UserMessageIndex::clear()
+{
+    this->entries_.clear();
+    this->front_ = 0;
+    this->back_ = 0;
+}
+
+std::vector<MessagePtr> UserMessageIndex::find(const QStringList &users) const
+{
+    std::vector<Entry> found;
+    std::vector<QString> keys;
+    for (const auto &user : users)
+    {
+        addKey(keys, user);
+    }
+    for (const auto &key : keys)
+    {
+        auto it = this->entries_.find(key);
+        if (it != this->entries_.end())
+        {
+            found.insert(found.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    if (keys.size() > 1)
+    {
+        // A message can be indexed under multiple of the keys
+        std::ranges::sort(found, {}, &Entry::position);
+        auto [first, last] = std::ranges::unique(found, {}, &Entry::position);
+        found.erase(first, last);
+    }
+
+    std::vector<MessagePtr> messages;
+    messages.reserve(found.size());
+    for (auto &entry : found)
+    {
+        messages.emplace_back(std::move(entry.message));
+    }
+    return messages;
+}
+
+std::vector<QString> UserMessageIndex::keysOf(const Message &message)
+{
+    std::vector<QString> keys;
+    addKey(keys, message.loginName);
+    addKey(keys, message.displayName);
+    addKey(keys, message.timeoutUser);
+    if (message.loginName.isEmpty() &&
+        message.flags.has(MessageFlag::Subscription))
+    {
+        // e.g. "forsen subscribed at Tier 1"
+        addKey(keys, message.messageText.section(u' ', 0, 0));
+    }
+    return keys;
+}
+
+void UserMessageIndex::insert(const QString &key, Entry entry)
+{
+    auto &list = this->entries_[key];
+    auto it = std::ranges::lower_bound(list, entry.position, {},
+                                       &Entry::position);
+    list.insert(it, std::move(entry));
+}
+
+void UserMessageIndex::erase(const QString &key, int64_t position)
+{
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        return;
+    }
+
+    auto &list = it->second;
+    auto entry =
+        std::ranges::lower_bound(list, position, {}, &Entry::position);
+    if (entry != list.end() && entry->position == position)
+    {
+        list.erase(entry);
+    }
+    if (list.empty())
+    {
+        this->entries_.erase(it);
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// @brief Maps user names to the messages of a channel that involve them.
+///
+/// A message is indexed under (case insensitive):
+///  - its login name and display name,
+///  - the user targeted by a moderation action (Message::timeoutUser),
+///  - the user of a subscription message without a login name.
+///
+/// Lookups return candidates in channel order. Callers are expected to filter
+/// them further if they need an exact criterion.
+///
+/// The index mirrors the LimitedQueue of a channel: every modification of the
+/// queue has to be applied here as well. Like in the queue, positions are
+/// absolute, so evicting a message only touches the keys of that message.
+class UserMessageIndex
+{
+public:
+    /// A message was appended
+    void pushBack(const MessagePtr &message);
+    /// The first message was evicted
+    void popFront(const MessagePtr &message);
+    /// Messages were added to the start (in channel order)
+    void pushFront(const std::vector<MessagePtr> &messages);
+    /// The message at `index` (in the queue) was replaced
+    void replace(size_t index, const MessagePtr &prev,
+                 const MessagePtr &replacement);
+    /// Resets the index to `messages` (in channel order)
+    void rebuild(const std::vector<MessagePtr> &messages);
+    void clear();
+
+    /// Returns the messages indexed under any of `users`, in channel order
+    std::vector<MessagePtr> find(const QStringList &users) const;
+
+    /// Returns the (lowercase) keys a message is indexed under
+    static std::vector<QString> keysOf(const Message &message);
+
+private:
+    struct Entry {
+        int64_t position;
+        MessagePtr message;
+    };
+
+    void insert(const QString &key, Entry entry);
+    void erase(const QString &key, int64_t position);
+
+    std::unordered_map<QString, std::vector<Entry>> entries_;
+    /// Position of the first message
+    int64_t front_ = 0;
+    /// Position after the last message
+    int64_t back_ = 0;
+};
+
+}  // namespace chatterino
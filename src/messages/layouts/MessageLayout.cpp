@@ -5,6 +5,7 @@
 #include "messages/layouts/MessageLayout.hpp"
 
 #include "Application.hpp"
+#include "messages/layouts/MessageLayoutCache.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
@@ -19,6 +20,7 @@
 
 #include <QApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QPainter>
 #include <QtGlobal>
 #include <QThread>
@@ -62,12 +64,12 @@ const MessagePtr &MessageLayout::getMessagePtr() const
 // Height
 int MessageLayout::getHeight() const
 {
-    return static_cast<int>(this->container_.getHeight());
+    return static_cast<int>(this->container().getHeight());
 }
 
 int MessageLayout::getWidth() const
 {
-    return static_cast<int>(this->container_.getWidth());
+    return static_cast<int>(this->container().getWidth());
 }
 
 // Layout
@@ -77,37 +79,21 @@ bool MessageLayout::layout(const MessageLayoutContext &ctx,
 {
     //    BenchmarkGuard benchmark("MessageLayout::layout()");
 
-    bool layoutRequired = false;
-
-    // check if width changed
-    bool widthChanged = ctx.width != this->currentLayoutWidth_;
-    layoutRequired |= widthChanged;
-    this->currentLayoutWidth_ = ctx.width;
-
-    // check if layout state changed
-    const auto layoutGeneration = getApp()->getWindows()->getGeneration();
-    if (this->layoutState_ != layoutGeneration)
-    {
-        layoutRequired = true;
-        this->flags.set(MessageLayoutFlag::RequiresBufferUpdate);
-        this->layoutState_ = layoutGeneration;
-    }
-
-    // check if work mask changed
-    layoutRequired |= this->currentWordFlags_ != ctx.flags;
-    this->currentWordFlags_ = ctx.flags;  // getSettings()->getWordTypeMask();
+    MessageLayoutKey key{
+        .width = ctx.width,
+        .scale = ctx.scale,
+        .imageScale = ctx.imageScale,
+        .elementFlags = ctx.flags,
+        .generation = getApp()->getWindows()->getGeneration(),
+        .expanded = this->flags.has(MessageLayoutFlag::Expanded),
+        .colors = ctx.messageColors,
+    };
 
     // check if layout was requested manually
-    layoutRequired |= this->flags.has(MessageLayoutFlag::RequiresLayout);
+    bool layoutForced = this->flags.has(MessageLayoutFlag::RequiresLayout);
     this->flags.unset(MessageLayoutFlag::RequiresLayout);
 
-    // check if dpi changed
-    layoutRequired |= this->scale_ != ctx.scale;
-    this->scale_ = ctx.scale;
-    layoutRequired |= this->imageScale_ != ctx.imageScale;
-    this->imageScale_ = ctx.imageScale;
-
-    if (!layoutRequired)
+    if (!layoutForced && this->layout_ && this->layout_->key() == key)
     {
         if (shouldInvalidateBuffer)
         {
@@ -117,18 +103,53 @@ bool MessageLayout::layout(const MessageLayoutContext &ctx,
         return false;
     }
 
-    qreal oldHeight = this->container_.getHeight();
-    this->actuallyLayout(ctx);
-    if (widthChanged || this->container_.getHeight() != oldHeight)
+    if (!this->layout_ || this->layout_->key().generation != key.generation)
+    {
+        this->flags.set(MessageLayoutFlag::RequiresBufferUpdate);
+    }
+
+    auto &cache = MessageLayoutCache::instance();
+    std::shared_ptr<SharedMessageLayout> layout;
+    if (!layoutForced)
+    {
+        // another view might have laid out this message already
+        layout = cache.find(this->message_.get(), key);
+    }
+
+    if (layout)
     {
-        this->deleteBuffer();
+        DebugCount::increase(DebugObject::MessageLayoutShared);
+    }
+    else
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        layout = std::make_shared<SharedMessageLayout>(this->message_,
+                                                       std::move(key));
+        this->actuallyLayout(layout->container(), ctx);
+        cache.insert(*layout);
+
+        DebugCount::increase(DebugObject::MessageLayoutTime,
+                             timer.nsecsElapsed() / 1000);
+    }
+
+    // buffers belong to a layout
+    this->deleteBuffer();
+    this->layout_ = std::move(layout);
+
+    // collapsed state
+    this->flags.unset(MessageLayoutFlag::Collapsed);
+    if (this->layout_->container().isCollapsed())
+    {
+        this->flags.set(MessageLayoutFlag::Collapsed);
     }
-    this->invalidateBuffer();
 
     return true;
 }
 
-void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
+void MessageLayout::actuallyLayout(MessageLayoutContainer &container,
+                                   const MessageLayoutContext &ctx)
 {
 #ifdef FOURTF
     this->layoutCount_++;
@@ -151,9 +172,7 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
     bool hideSimilar = getSettings()->hideSimilar;
     bool hideReplies = !ctx.flags.has(MessageElementFlag::RepliedMessage);
 
-    this->container_.beginLayout(ctx.width, this->scale_, this->imageScale_,
-                                 messageFlags);
-
+    container.beginLayout(ctx.width, ctx.scale, ctx.imageScale, messageFlags);
     for (const auto &element : this->message_->elements)
     {
         if (hideModerated && this->message_->flags.has(MessageFlag::Disabled))
@@ -203,23 +222,10 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
             continue;
         }
 
-        element->addToContainer(this->container_, ctx);
-    }
-
-    if (this->height_ != this->container_.getHeight())
-    {
-        this->deleteBuffer();
+        element->addToContainer(container, ctx);
     }
 
-    this->container_.endLayout();
-    this->height_ = this->container_.getHeight();
-
-    // collapsed state
-    this->flags.unset(MessageLayoutFlag::Collapsed);
-    if (this->container_.isCollapsed())
-    {
-        this->flags.set(MessageLayoutFlag::Collapsed);
-    }
+    container.endLayout();
 }
 
 // Painting
@@ -227,24 +233,33 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 {
     MessagePaintResult result;
 
-    QPixmap *pixmap = this->ensureBuffer(ctx.painter, ctx.canvasWidth,
-                                         ctx.messageColors.hasTransparency);
+    if (!this->layout_)
+    {
+        // not laid out yet
+        return result;
+    }
+
+    auto &buffer = this->ensureBuffer(ctx);
+    QPixmap *pixmap = &buffer.pixmap;
 
-    if (!this->bufferValid_)
+    if (!buffer.valid)
     {
         if (ctx.messageColors.hasTransparency)
         {
             pixmap->fill(Qt::transparent);
         }
         this->updateBuffer(pixmap, ctx);
+        buffer.valid = true;
     }
 
     // draw on buffer
     ctx.painter.drawPixmap(QPoint{0, ctx.y}, *pixmap);
 
+    const auto &container = this->layout_->container();
+
     // draw gif emotes
     result.hasAnimatedElements =
-        this->container_.paintAnimatedElements(ctx.painter, ctx.y);
+        container.paintAnimatedElements(ctx.painter, ctx.y);
 
     // draw disabled
     if (this->message_->flags.has(MessageFlag::Disabled))
@@ -281,7 +296,7 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
             QRect{
                 0,
                 ctx.y,
-                static_cast<int>(this->scale_ * 4),
+                static_cast<int>(container.getScale() * 4),
                 pixmap->height(),
             },
             *ColorProvider::instance().color(ColorType::RedeemedHighlight));
@@ -290,8 +305,8 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
     // draw selection
     if (!ctx.selection.isEmpty())
     {
-        this->container_.paintSelection(ctx.painter, ctx.messageIndex,
-                                        ctx.selection, ctx.y);
+        container.paintSelection(ctx.painter, ctx.messageIndex, ctx.selection,
+                                 ctx.y);
     }
 
     // draw message seperation line
@@ -301,7 +316,7 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
             QRectF{
                 0.0,
                 static_cast<qreal>(ctx.y),
-                this->container_.getWidth() + 64,
+                container.getWidth() + 64,
                 1.0,
             },
             ctx.messageColors.messageSeperator);
@@ -327,40 +342,58 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
         ctx.painter.fillRect(
             QRectF{
                 0,
-                ctx.y + this->container_.getHeight() - 1,
+                ctx.y + container.getHeight() - 1,
                 static_cast<qreal>(pixmap->width()),
                 1,
             },
             brush);
     }
 
-    this->bufferValid_ = true;
-
     return result;
 }
 
-QPixmap *MessageLayout::ensureBuffer(QPainter &painter, qreal width, bool clear)
+MessageDrawingBuffer &MessageLayout::ensureBuffer(
+    const MessagePaintContext &ctx)
 {
+    MessageBufferKey key{
+        .canvasWidth = ctx.canvasWidth,
+        .devicePixelRatio = ctx.painter.device()->devicePixelRatioF(),
+        .alternateBackground =
+            ctx.preferences.alternateMessages &&
+            this->flags.has(MessageLayoutFlag::AlternateBackground),
+        .ignoreHighlights =
+            this->flags.has(MessageLayoutFlag::IgnoreHighlights),
+        .colors = ctx.messageColors,
+    };
+
+    if (this->buffer_ != nullptr && this->buffer_->key == key)
+    {
+        return *this->buffer_;
+    }
+
+    this->buffer_ = this->layout_->findBuffer(key);
     if (this->buffer_ != nullptr)
     {
-        return this->buffer_.get();
+        DebugCount::increase(DebugObject::MessageDrawingBufferShared);
+        return *this->buffer_;
     }
 
     // Create new buffer
-    this->buffer_ = std::make_unique<QPixmap>(
-        static_cast<int>(width * painter.device()->devicePixelRatioF()),
-        static_cast<int>(this->container_.getHeight() *
-                         painter.device()->devicePixelRatioF()));
-    this->buffer_->setDevicePixelRatio(painter.device()->devicePixelRatioF());
+    QPixmap pixmap(
+        static_cast<int>(key.canvasWidth * key.devicePixelRatio),
+        static_cast<int>(this->layout_->container().getHeight() *
+                         key.devicePixelRatio));
+    pixmap.setDevicePixelRatio(key.devicePixelRatio);
 
-    if (clear)
+    if (key.colors.hasTransparency)
     {
-        this->buffer_->fill(Qt::transparent);
+        pixmap.fill(Qt::transparent);
     }
 
-    this->bufferValid_ = false;
-    DebugCount::increase(DebugObject::MessageDrawingBuffer);
-    return this->buffer_.get();
+    this->buffer_ = std::make_shared<MessageDrawingBuffer>(std::move(key),
+                                                           std::move(pixmap));
+    this->layout_->addBuffer(this->buffer_);
+    return *this->buffer_;
 }
 
 void MessageLayout::updateBuffer(QPixmap *buffer,
@@ -460,7 +493,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     painter.fillRect(buffer->rect(), backgroundColor);
 
     // draw message
-    this->container_.paintElements(painter, ctx);
+    this->layout_->container().paintElements(painter, ctx);
 
 #ifdef FOURTF
     // debug
@@ -471,7 +504,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     QTextOption option;
     option.setAlignment(Qt::AlignRight | Qt::AlignTop);
 
-    painter.drawText(QRectF(1, 1, this->container_.getWidth() - 3, 1000),
+    painter.drawText(QRectF(1, 1, this->container().getWidth() - 3, 1000),
                      QString::number(this->layoutCount_) + ", " +
                          QString::number(++this->bufferUpdatedCount_),
                      option);
@@ -480,26 +513,32 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
 
 void MessageLayout::invalidateBuffer()
 {
-    this->bufferValid_ = false;
+    // other views using the buffer have to redraw it as well
+    if (this->buffer_ != nullptr)
+    {
+        this->buffer_->valid = false;
+    }
 }
 
 void MessageLayout::deleteBuffer()
 {
-    if (this->buffer_ != nullptr)
-    {
-        DebugCount::decrease(DebugObject::MessageDrawingBuffer);
-
-        this->buffer_ = nullptr;
-    }
+    this->buffer_ = nullptr;
 }
 
 void MessageLayout::deleteCache()
 {
     this->deleteBuffer();
+    this->layout_ = nullptr;
+}
 
-#ifdef XD
-    this->container_.clear();
-#endif
+const MessageLayoutContainer &MessageLayout::container() const
+{
+    if (this->layout_ == nullptr)
+    {
+        static const MessageLayoutContainer empty;
+        return empty;
+    }
+    return this->layout_->container();
 }
 
 // Elements
@@ -511,7 +550,7 @@ void MessageLayout::deleteCache()
 const MessageLayoutElement *MessageLayout::getElementAt(QPointF point) const
 {
     // go through all words and return the first one that contains the point.
-    return this->container_.getElementAt(point);
+    return this->container().getElementAt(point);
 }
 
 std::pair<int, int> MessageLayout::getWordBounds(
@@ -521,7 +560,7 @@ std::pair<int, int> MessageLayout::getWordBounds(
     // elements in the container
     if (hoveredElement->getWordId() != -1)
     {
-        return this->container_.getWordBounds(hoveredElement);
+        return this->container().getWordBounds(hoveredElement);
     }
 
     const auto wordStart = this->getSelectionIndex(relativePos) -
@@ -535,23 +574,23 @@ std::pair<int, int> MessageLayout::getWordBounds(
 
 size_t MessageLayout::getLastCharacterIndex() const
 {
-    return this->container_.getLastCharacterIndex();
+    return this->container().getLastCharacterIndex();
 }
 
 size_t MessageLayout::getFirstMessageCharacterIndex() const
 {
-    return this->container_.getFirstMessageCharacterIndex();
+    return this->container().getFirstMessageCharacterIndex();
 }
 
 size_t MessageLayout::getSelectionIndex(QPointF position) const
 {
-    return this->container_.getSelectionIndex(position);
+    return this->container().getSelectionIndex(position);
 }
 
 void MessageLayout::addSelectionText(QString &str, uint32_t from, uint32_t to,
                                      CopyMode copymode)
 {
-    this->container_.addSelectionText(str, from, to, copymode);
+    this->container().addSelectionText(str, from, to, copymode);
 }
 
 }  // namespace chatterino
@@ -20,6 +20,8 @@ using MessagePtr = std::shared_ptr<const Message>;
 
 struct Selection;
 struct MessageLayoutContainer;
+class SharedMessageLayout;
+struct MessageDrawingBuffer;
 class MessageLayoutElement;
 struct MessagePaintContext;
 struct MessageLayoutContext;
@@ -68,7 +70,10 @@ public:
     // Painting
     MessagePaintResult paint(const MessagePaintContext &ctx);
     void invalidateBuffer();
+    /// Drops this view's reference to the drawing buffer. The pixmap is freed
+    /// once no other view uses it.
     void deleteBuffer();
+    /// Drops the drawing buffer and the layout
     void deleteCache();
 
     /**
@@ -117,24 +122,22 @@ public:
 
 private:
     // methods
-    void actuallyLayout(const MessageLayoutContext &ctx);
+    void actuallyLayout(MessageLayoutContainer &container,
+                        const MessageLayoutContext &ctx);
     void updateBuffer(QPixmap *buffer, const MessagePaintContext &ctx);
 
-    // Create new buffer if required, returning the buffer
-    QPixmap *ensureBuffer(QPainter &painter, qreal width, bool clear);
+    // Get the buffer for the current paint parameters, creating it (or taking
+    // it from another view) if required
+    MessageDrawingBuffer &ensureBuffer(const MessagePaintContext &ctx);
+
+    const MessageLayoutContainer &container() const;
 
     // variables
     const MessagePtr message_;
-    MessageLayoutContainer container_;
-    std::unique_ptr<QPixmap> buffer_;
-    bool bufferValid_ = false;
-
-    qreal height_ = 0;
-    int currentLayoutWidth_ = -1;
-    int layoutState_ = -1;
-    float scale_ = -1;
-    float imageScale_ = -1.F;
-    MessageElementFlags currentWordFlags_;
+    /// Shared with other views that lay out this message the same way
+    std::shared_ptr<SharedMessageLayout> layout_;
+    /// Shared with other views that draw this layout the same way
+    std::shared_ptr<MessageDrawingBuffer> buffer_;
 
 #ifdef FOURTF
     // Debug counters
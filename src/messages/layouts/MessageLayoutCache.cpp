@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/layouts/MessageLayoutCache.hpp"
+
+#include "messages/Message.hpp"
+#include "util/DebugCount.hpp"
+
+#include <algorithm>
+
+namespace {
+
+int64_t pixmapBytes(const QPixmap &pixmap)
+{
+    return static_cast<int64_t>(pixmap.width()) * pixmap.height() *
+           pixmap.depth() / 8;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+MessageDrawingBuffer::MessageDrawingBuffer(MessageBufferKey key,
+                                           QPixmap pixmap)
+    : key(std::move(key))
+    , pixmap(std::move(pixmap))
+{
+    DebugCount::increase(DebugObject::MessageDrawingBuffer);
+    DebugCount::increase(DebugObject::BytesMessageDrawingBuffer,
+                         pixmapBytes(this->pixmap));
+}
+
+MessageDrawingBuffer::~MessageDrawingBuffer()
+{
+    DebugCount::decrease(DebugObject::MessageDrawingBuffer);
+    DebugCount::decrease(DebugObject::BytesMessageDrawingBuffer,
+                         pixmapBytes(this->pixmap));
+}
+
+SharedMessageLayout::SharedMessageLayout(MessagePtr message,
+                                         MessageLayoutKey key)
+    : message_(std::move(message))
+    , key_(std::move(key))
+{
+    DebugCount::increase(DebugObject::SharedMessageLayout);
+}
+
+SharedMessageLayout::~SharedMessageLayout()
+{
+    MessageLayoutCache::instance().remove(*this);
+    DebugCount::decrease(DebugObject::SharedMessageLayout);
+}
+
+const MessagePtr &SharedMessageLayout::message() const
+{
+    return this->message_;
+}
+
+const MessageLayoutKey &SharedMessageLayout::key() const
+{
+    return this->key_;
+}
+
+MessageLayoutContainer &SharedMessageLayout::container()
+{
+    return this->container_;
+}
+
+const MessageLayoutContainer &SharedMessageLayout::container() const
+{
+    return this->container_;
+}
+
+std::shared_ptr<MessageDrawingBuffer> SharedMessageLayout::findBuffer(
+    const MessageBufferKey &key)
+{
+    std::erase_if(this->buffers_, [](const auto &buffer) {
+        return buffer.expired();
+    });
+
+    for (const auto &weak : this->buffers_)
+    {
+        auto buffer = weak.lock();
+        if (buffer && buffer->key == key)
+        {
+            return buffer;
+        }
+    }
+    return nullptr;
+}
+
+void SharedMessageLayout::addBuffer(
+    const std::shared_ptr<MessageDrawingBuffer> &buffer)
+{
+    this->buffers_.emplace_back(buffer);
+}
+
+MessageLayoutCache &MessageLayoutCache::instance()
+{
+    // Never destroyed, layouts might still be released after static
+    // destructors ran
+    static auto *instance = new MessageLayoutCache;
+    return *instance;
+}
+
+std::shared_ptr<SharedMessageLayout> MessageLayoutCache::find(
+    const Message *message, const MessageLayoutKey &key) const
+{
+    auto it = this->layouts_.find(message);
+    if (it == this->layouts_.end())
+    {
+        return nullptr;
+    }
+
+    for (auto *layout : it->second)
+    {
+        if (layout->key() == key)
+        {
+            return layout->shared_from_this();
+        }
+    }
+    return nullptr;
+}
+
+void MessageLayoutCache::insert(SharedMessageLayout &layout)
+{
+    auto &layouts = this->layouts_[layout.message().get()];
+    for (auto *&other : layouts)
+    {
+        if (other->key() == layout.key())
+        {
+            other = &layout;
+            return;
+        }
+    }
+    layouts.push_back(&layout);
+}
+
+size_t MessageLayoutCache::size() const
+{
+    return this->layouts_.size();
+}
+
+void MessageLayoutCache::remove(SharedMessageLayout &layout)
+{
+    auto it = this->layouts_.find(layout.message().get());
+    if (it == this->layouts_.end())
+    {
+        return;
+    }
+
+    // layouts that were replaced by a newer one aren't in the list anymore
+    std::erase(it->second, &layout);
+    if (it->second.empty())
+    {
+        this->layouts_.erase(it);
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "messages/layouts/MessageLayoutContainer.hpp"
+#include "messages/layouts/MessageLayoutContext.hpp"
+
+#include <QPixmap>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// Everything a laid out message depends on besides the message itself.
+/// Settings that change the layout bump the layout generation.
+struct MessageLayoutKey {
+    int width = 0;
+    float scale = 0;
+    float imageScale = 0;
+    MessageElementFlags elementFlags;
+    int generation = -1;
+    bool expanded = false;
+    MessageColors colors;
+
+    bool operator==(const MessageLayoutKey &other) const = default;
+};
+
+/// Everything the drawing buffer of a laid out message depends on
+struct MessageBufferKey {
+    int canvasWidth = 0;
+    qreal devicePixelRatio = 1;
+    bool alternateBackground = false;
+    bool ignoreHighlights = false;
+    MessageColors colors;
+
+    bool operator==(const MessageBufferKey &other) const = default;
+};
+
+/// A pixmap a laid out message is drawn to. Views with the same buffer key
+/// share one, it's freed once the last view dropped it.
+struct MessageDrawingBuffer {
+    MessageDrawingBuffer(MessageBufferKey key, QPixmap pixmap);
+    ~MessageDrawingBuffer();
+
+    MessageDrawingBuffer(const MessageDrawingBuffer &) = delete;
+    MessageDrawingBuffer &operator=(const MessageDrawingBuffer &) = delete;
+    MessageDrawingBuffer(MessageDrawingBuffer &&) = delete;
+    MessageDrawingBuffer &operator=(MessageDrawingBuffer &&) = delete;
+
+    const MessageBufferKey key;
+    QPixmap pixmap;
+    /// False if the pixmap has to be redrawn before it's shown
+    bool valid = false;
+};
+
+/// @brief A message laid out with a specific key.
+///
+/// The container isn't changed after it has been laid out. A new layout is
+/// created instead, so views that still use this one aren't affected.
+class SharedMessageLayout
+    : public std::enable_shared_from_this<SharedMessageLayout>
+{
+public:
+    SharedMessageLayout(MessagePtr message, MessageLayoutKey key);
+    /// Removes this layout from the cache
+    ~SharedMessageLayout();
+
+    SharedMessageLayout(const SharedMessageLayout &) = delete;
+    SharedMessageLayout &operator=(const SharedMessageLayout &) = delete;
+    SharedMessageLayout(SharedMessageLayout &&) = delete;
+    SharedMessageLayout &operator=(SharedMessageLayout &&) = delete;
+
+    const MessagePtr &message() const;
+    const MessageLayoutKey &key() const;
+
+    MessageLayoutContainer &container();
+    const MessageLayoutContainer &container() const;
+
+    /// Returns the buffer with `key` if some view still uses it
+    std::shared_ptr<MessageDrawingBuffer> findBuffer(
+        const MessageBufferKey &key);
+    void addBuffer(const std::shared_ptr<MessageDrawingBuffer> &buffer);
+
+private:
+    const MessagePtr message_;
+    const MessageLayoutKey key_;
+    MessageLayoutContainer container_;
+
+    std::vector<std::weak_ptr<MessageDrawingBuffer>> buffers_;
+};
+
+/// @brief Message layouts shared by all views.
+///
+/// Splits showing the same channel lay out the same messages with the same
+/// parameters. The first view lays out a message, the others find its layout
+/// here. The cache doesn't own the layouts, they're removed once the last view
+/// dropped them.
+///
+/// Must only be used from the GUI thread.
+class MessageLayoutCache
+{
+public:
+    static MessageLayoutCache &instance();
+
+    /// Returns the layout of `message` with `key` if some view has one
+    std::shared_ptr<SharedMessageLayout> find(
+        const Message *message, const MessageLayoutKey &key) const;
+
+    /// Makes `layout` available to other views. An older layout with the same
+    /// key is replaced.
+    void insert(SharedMessageLayout &layout);
+
+    /// Number of messages with at least one layout
+    size_t size() const;
+
+private:
+    MessageLayoutCache() = default;
+
+    void remove(SharedMessageLayout &layout);
+
+    std::unordered_map<const Message *, std::vector<SharedMessageLayout *>>
+        layouts_;
+
+    friend SharedMessageLayout;
+};
+
+}  // namespace chatterino
@@ -56,11 +56,11 @@ void MessageLayoutContainer::beginLayout(qreal width, float scale,
     this->scale_ = scale;
     this->imageScale_ = imageScale;
     this->flags_ = flags;
-    auto mediumFontMetrics =
-        getApp()->getFonts()->getFontMetrics(FontStyle::ChatMedium, scale);
-    this->textLineHeight_ = mediumFontMetrics.height();
-    this->spaceWidth_ = mediumFontMetrics.horizontalAdvance(' ');
-    this->dotdotdotWidth_ = mediumFontMetrics.horizontalAdvance("...");
+    auto &mediumFont =
+        getApp()->getFonts()->getTextMeasure(FontStyle::ChatMedium, scale);
+    this->textLineHeight_ = mediumFont.metrics().height();
+    this->spaceWidth_ = mediumFont.horizontalAdvance(QChar(u' '));
+    this->dotdotdotWidth_ = mediumFont.horizontalAdvance(QStringLiteral("..."));
     this->currentWordId_ = 0;
     this->canAddMessages_ = true;
     this->isCollapsed_ = false;
@@ -43,6 +43,8 @@ struct MessageColors {
     QColor unfocusedLastMessageLine;
 
     void applyTheme(Theme *theme, bool isOverlay, int backgroundOpacity);
+
+    bool operator==(const MessageColors &other) const = default;
 };
 
 // TODO: Explore if we can let settings own this
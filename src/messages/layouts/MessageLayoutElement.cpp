@@ -595,13 +595,13 @@ int TextLayoutElement::getMouseOverIndex(QPointF abs) const
 
     auto *app = getApp();
 
-    auto metrics = app->getFonts()->getFontMetrics(this->style_, this->scale_);
+    auto &measure = app->getFonts()->getTextMeasure(this->style_, this->scale_);
     auto x = this->getRect().left();
 
     for (auto i = 0; i < this->getText().size(); i++)
     {
         auto &&text = this->getText();
-        auto width = metrics.horizontalAdvance(this->getText()[i]);
+        auto width = measure.horizontalAdvance(this->getText()[i]);
 
         // accept mouse to be at only 50%+ of character width to increase index
         if (x + (width * 0.5) > abs.x())
@@ -630,7 +630,7 @@ qreal TextLayoutElement::getXFromIndex(size_t index)
 {
     auto *app = getApp();
 
-    auto metrics = app->getFonts()->getFontMetrics(this->style_, this->scale_);
+    auto &measure = app->getFonts()->getTextMeasure(this->style_, this->scale_);
 
     if (index <= 0)
     {
@@ -641,7 +641,7 @@ qreal TextLayoutElement::getXFromIndex(size_t index)
         qreal x = 0;
         for (size_t i = 0; i < index; i++)
         {
-            x += metrics.horizontalAdvance(
+            x += measure.horizontalAdvance(
                 this->getText()[static_cast<QString::size_type>(i)]);
         }
         return x + this->getRect().left();
@@ -28,6 +28,12 @@ public:
      */
     AuthorPredicate(const QString &authors, bool negate);
 
+    /// Returns the user names that are searched for
+    const QStringList &authors() const
+    {
+        return this->authors_;
+    }
+
 protected:
     /**
      * @brief Checks whether the message is authored by any of the users passed
@@ -42,6 +42,12 @@ public:
         return result;
     }
 
+    /// Returns true if this predicate excludes the messages it matches
+    bool isNegated() const
+    {
+        return this->isNegated_;
+    }
+
 protected:
     explicit MessagePredicate(bool negate)
         : isNegated_(negate)
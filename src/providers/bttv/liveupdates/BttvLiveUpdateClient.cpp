@@ -8,14 +8,16 @@
 #include "providers/bttv/BttvBadges.hpp"
 #include "providers/bttv/BttvLiveUpdates.hpp"
 #include "providers/bttv/liveupdates/BttvLiveUpdateMessages.hpp"
+#include "providers/liveupdates/JsonMessage.hpp"
 
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QJsonValue>
 #include <QStringBuilder>
 
 namespace chatterino {
 
+using namespace liveupdates;
+
 BttvLiveUpdateClient::BttvLiveUpdateClient(BttvLiveUpdates &manager)
     : BasicPubSubClient(100)
     , manager(manager)
@@ -24,17 +26,16 @@ BttvLiveUpdateClient::BttvLiveUpdateClient(BttvLiveUpdates &manager)
 
 void BttvLiveUpdateClient::onMessage(const QByteArray &msg)
 {
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(msg));
+    JsonMessage json(msg);
 
-    if (jsonDoc.isNull())
+    if (!json.isValid())
     {
         qCDebug(chatterinoBttv) << "Failed to parse live update JSON";
         return;
     }
-    auto json = jsonDoc.object();
 
-    auto eventType = json["name"].toString();
-    auto eventData = json["data"].toObject();
+    const auto &eventType = jsonMember(json.root(), "name");
+    const auto &eventData = jsonMember(json.root(), "data");
 
     if (eventType == "emote_create")
     {
@@ -42,7 +43,7 @@ void BttvLiveUpdateClient::onMessage(const QByteArray &msg)
 
         if (!message.validate())
         {
-            qCDebug(chatterinoBttv) << "Invalid add message" << json;
+            qCDebug(chatterinoBttv) << "Invalid add message" << msg;
             return;
         }
 
@@ -54,7 +55,7 @@ void BttvLiveUpdateClient::onMessage(const QByteArray &msg)
 
         if (!message.validate())
         {
-            qCDebug(chatterinoBttv) << "Invalid update message" << json;
+            qCDebug(chatterinoBttv) << "Invalid update message" << msg;
             return;
         }
 
@@ -66,7 +67,7 @@ void BttvLiveUpdateClient::onMessage(const QByteArray &msg)
 
         if (!message.validate())
         {
-            qCDebug(chatterinoBttv) << "Invalid deletion message" << json;
+            qCDebug(chatterinoBttv) << "Invalid deletion message" << msg;
             return;
         }
 
@@ -77,7 +78,7 @@ void BttvLiveUpdateClient::onMessage(const QByteArray &msg)
         auto message = BttvLiveUpdateUserUpdateMessage(eventData);
         if (!message.validate())
         {
-            qCDebug(chatterinoBttv) << "Invalid user update message" << json;
+            qCDebug(chatterinoBttv) << "Invalid user update message" << msg;
             return;
         }
 
@@ -96,7 +97,7 @@ void BttvLiveUpdateClient::onMessage(const QByteArray &msg)
     }
     else
     {
-        qCDebug(chatterinoBttv) << "Unhandled event:" << json;
+        qCDebug(chatterinoBttv) << "Unhandled event:" << msg;
     }
 }
 
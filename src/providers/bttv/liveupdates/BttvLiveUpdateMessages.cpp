@@ -4,9 +4,9 @@
 
 #include "providers/bttv/liveupdates/BttvLiveUpdateMessages.hpp"
 
-namespace {
+#include "providers/liveupdates/JsonMessage.hpp"
 
-using namespace Qt::Literals;
+namespace {
 
 bool tryParseChannelId(QString &channelId)
 {
@@ -23,10 +23,12 @@ bool tryParseChannelId(QString &channelId)
 
 namespace chatterino {
 
+using namespace liveupdates;
+
 BttvLiveUpdateEmoteUpdateAddMessage::BttvLiveUpdateEmoteUpdateAddMessage(
-    const QJsonObject &json)
-    : channelID(json["channel"].toString())
-    , jsonEmote(json["emote"].toObject())
+    const rapidjson::Value &json)
+    : channelID(jsonString(jsonMember(json, "channel")))
+    , jsonEmote(toQJsonObject(jsonMember(json, "emote")))
     , emoteName(this->jsonEmote["code"].toString())
     , emoteID(this->jsonEmote["id"].toString())
     , badChannelID_(!tryParseChannelId(this->channelID))
@@ -42,9 +44,9 @@ bool BttvLiveUpdateEmoteUpdateAddMessage::validate() const
 }
 
 BttvLiveUpdateEmoteRemoveMessage::BttvLiveUpdateEmoteRemoveMessage(
-    const QJsonObject &json)
-    : channelID(json["channel"].toString())
-    , emoteID(json["emoteId"].toString())
+    const rapidjson::Value &json)
+    : channelID(jsonString(jsonMember(json, "channel")))
+    , emoteID(jsonString(jsonMember(json, "emoteId")))
     , badChannelID_(!tryParseChannelId(this->channelID))
 {
 }
@@ -56,9 +58,9 @@ bool BttvLiveUpdateEmoteRemoveMessage::validate() const
 }
 
 BttvLiveUpdateUserUpdateMessage::BttvLiveUpdateUserUpdateMessage(
-    const QJsonObject &json)
-    : userID(json["providerId"_L1].toString())
-    , badgeObject(json["badge"_L1].toObject())
+    const rapidjson::Value &json)
+    : userID(jsonString(jsonMember(json, "providerId")))
+    , badgeObject(toQJsonObject(jsonMember(json, "badge")))
 {
 }
 
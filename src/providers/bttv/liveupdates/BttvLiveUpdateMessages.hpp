@@ -5,11 +5,12 @@
 #pragma once
 
 #include <QJsonObject>
+#include <rapidjson/document.h>
 
 namespace chatterino {
 
 struct BttvLiveUpdateEmoteUpdateAddMessage {
-    BttvLiveUpdateEmoteUpdateAddMessage(const QJsonObject &json);
+    BttvLiveUpdateEmoteUpdateAddMessage(const rapidjson::Value &json);
 
     QString channelID;
 
@@ -26,7 +27,7 @@ private:
 };
 
 struct BttvLiveUpdateEmoteRemoveMessage {
-    BttvLiveUpdateEmoteRemoveMessage(const QJsonObject &json);
+    BttvLiveUpdateEmoteRemoveMessage(const rapidjson::Value &json);
 
     QString channelID;
     QString emoteID;
@@ -40,7 +41,7 @@ private:
 };
 
 struct BttvLiveUpdateUserUpdateMessage {
-    BttvLiveUpdateUserUpdateMessage(const QJsonObject &json);
+    BttvLiveUpdateUserUpdateMessage(const rapidjson::Value &json);
 
     QString userID;
     QJsonObject badgeObject;
@@ -18,6 +18,7 @@
 #include <rapidjson/error/error.h>
 #include <rapidjson/rapidjson.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 
@@ -171,6 +172,8 @@ void Emojis::load()
 
     this->sortEmojis();
 
+    this->buildTrie();
+
     this->loadEmojiSet();
 }
 
@@ -208,8 +211,6 @@ void Emojis::loadEmojis()
             this->shortCodes.emplace_back(shortCode);
         }
 
-        this->emojiFirstByte_[emojiData->value.at(0)].append(emojiData);
-
         this->emojis.push_back(emojiData);
 
         if (unparsedEmoji.HasMember("skin_variations"))
@@ -233,9 +234,6 @@ void Emojis::loadEmojis()
                     variationEmojiData->shortCodes[0], variationEmojiData);
                 this->shortCodes.push_back(variationEmojiData->shortCodes[0]);
 
-                this->emojiFirstByte_[variationEmojiData->value.at(0)].append(
-                    variationEmojiData);
-
                 this->emojis.push_back(variationEmojiData);
             }
         }
@@ -244,14 +242,6 @@ void Emojis::loadEmojis()
 
 void Emojis::sortEmojis()
 {
-    for (auto &p : this->emojiFirstByte_)
-    {
-        std::stable_sort(p.begin(), p.end(),
-                         [](const auto &lhs, const auto &rhs) {
-                             return lhs->value.length() > rhs->value.length();
-                         });
-    }
-
     auto &p = this->shortCodes;
     std::stable_sort(p.begin(), p.end(), [](const auto &lhs, const auto &rhs) {
         return lhs < rhs;
@@ -316,105 +306,183 @@ void Emojis::loadEmojiSet()
     });
 }
 
-std::vector<std::variant<EmotePtr, QStringView>> Emojis::parse(
-    QStringView text) const
+void Emojis::buildTrie()
 {
-    auto result = std::vector<std::variant<EmotePtr, QStringView>>();
-    QString::size_type lastParsedEmojiEndIndex = 0;
-
-    for (qsizetype i = 0; i < text.length(); ++i)
+    // Emojis with longer strings are tried first, in the order of the file
+    std::vector<const EmojiData *> byLength;
+    byLength.reserve(this->emojis.size());
+    for (const auto &emoji : this->emojis)
     {
-        const QChar character = text.at(i);
+        byLength.push_back(emoji.get());
+    }
+    std::ranges::stable_sort(byLength, [](const auto *lhs, const auto *rhs) {
+        return lhs->value.length() > rhs->value.length();
+    });
 
-        if (character.isLowSurrogate())
+    std::vector<std::map<char16_t, uint32_t>> children(1);
+    this->trieNodes_.assign(1, {});
+
+    auto insert = [&](const QString &string, const EmojiData *emoji,
+                      uint32_t rank) {
+        uint32_t node = 0;
+        for (QChar c : string)
         {
-            continue;
+            auto [it, inserted] = children[node].try_emplace(
+                c.unicode(), static_cast<uint32_t>(children.size()));
+            if (inserted)
+            {
+                children.emplace_back();
+                this->trieNodes_.emplace_back();
+            }
+            node = it->second;
         }
 
-        auto it = this->emojiFirstByte_.find(character);
-        if (it == this->emojiFirstByte_.end())
+        auto &end = this->trieNodes_[node];
+        if (rank < end.rank)
+        {
+            end.emoji = emoji;
+            end.rank = rank;
+        }
+    };
+
+    for (uint32_t i = 0; i < byLength.size(); i++)
+    {
+        const auto *emoji = byLength[i];
+        if (emoji->value.isEmpty())
         {
-            // No emoji starts with this character
             continue;
         }
+        // The qualified string is tried before the non-qualified one
+        insert(emoji->value, emoji, 2 * i);
+        if (!emoji->nonQualified.isEmpty())
+        {
+            insert(emoji->nonQualified, emoji, (2 * i) + 1);
+        }
+    }
 
-        const auto &possibleEmojis = it.value();
+    this->trieEdges_.clear();
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        auto &node = this->trieNodes_[i];
+        node.firstEdge = static_cast<uint32_t>(this->trieEdges_.size());
+        node.edgeCount = static_cast<uint32_t>(children[i].size());
+        for (const auto &[codeUnit, target] : children[i])
+        {
+            this->trieEdges_.push_back({codeUnit, target});
+        }
+    }
 
-        auto remainingCharacters = text.length() - i - 1;
+    this->asciiRoots_.fill(0);
+    for (const auto &[codeUnit, target] : children[0])
+    {
+        if (codeUnit < this->asciiRoots_.size())
+        {
+            this->asciiRoots_[codeUnit] = target;
+        }
+    }
+}
 
-        std::shared_ptr<EmojiData> matchedEmoji;
+uint32_t Emojis::trieChild(uint32_t node, char16_t codeUnit) const
+{
+    if (node == 0 && codeUnit < this->asciiRoots_.size())
+    {
+        return this->asciiRoots_[codeUnit];
+    }
 
-        QString::size_type matchedEmojiLength = 0;
+    const auto &current = this->trieNodes_[node];
+    auto begin = this->trieEdges_.begin() + current.firstEdge;
+    auto end = begin + current.edgeCount;
+    auto it =
+        std::ranges::lower_bound(begin, end, codeUnit, {}, &TrieEdge::codeUnit);
+    if (it == end || it->codeUnit != codeUnit)
+    {
+        return 0;
+    }
+    return it->target;
+}
 
-        for (const std::shared_ptr<EmojiData> &emoji : possibleEmojis)
+void Emojis::parse(QStringView text, FunctionRef<void(QStringView)> onText,
+                   FunctionRef<void(const EmotePtr &)> onEmoji) const
+{
+    if (this->trieNodes_.empty())
+    {
+        // not loaded
+        if (!text.isEmpty())
         {
-            auto emojiNonQualifiedExtraCharacters =
-                emoji->nonQualified.length() - 1;
-            auto emojiExtraCharacters = emoji->value.length() - 1;
-            if (remainingCharacters >= emojiExtraCharacters)
-            {
-                // look in emoji->value
-                bool match = QStringView{emoji->value}.mid(1) ==
-                             text.mid(i + 1, emojiExtraCharacters);
+            onText(text);
+        }
+        return;
+    }
 
-                if (match)
-                {
-                    matchedEmoji = emoji;
-                    matchedEmojiLength = emoji->value.length();
+    qsizetype textStart = 0;
+    qsizetype i = 0;
+    while (i < text.size())
+    {
+        auto node = this->trieChild(0, text[i].unicode());
+        if (node == 0)
+        {
+            // No emoji starts with this character
+            ++i;
+            continue;
+        }
 
-                    break;
-                }
+        // Walk down as far as the text goes and keep the best emoji on the way
+        const EmojiData *matchedEmoji = nullptr;
+        uint32_t matchedRank = UINT32_MAX;
+        qsizetype matchedLength = 0;
+        for (auto j = i; node != 0;)
+        {
+            const auto &current = this->trieNodes_[node];
+            ++j;
+            if (current.emoji != nullptr && current.rank < matchedRank)
+            {
+                matchedEmoji = current.emoji;
+                matchedRank = current.rank;
+                matchedLength = j - i;
             }
-            if (!emoji->nonQualified.isNull() &&
-                remainingCharacters >= emojiNonQualifiedExtraCharacters)
+            if (j >= text.size())
             {
-                // This checking here relies on the fact that the nonQualified string
-                // always starts with the same byte as value (the unified string)
-                bool match = QStringView{emoji->nonQualified}.mid(1) ==
-                             text.mid(i + 1, emojiNonQualifiedExtraCharacters);
-
-                if (match)
-                {
-                    matchedEmoji = emoji;
-                    matchedEmojiLength = emoji->nonQualified.length();
-
-                    break;
-                }
+                break;
             }
+            node = this->trieChild(node, text[j].unicode());
         }
 
-        if (matchedEmojiLength == 0)
+        if (matchedEmoji == nullptr)
         {
+            ++i;
             continue;
         }
 
-        auto currentParsedEmojiFirstIndex = i;
-        auto currentParsedEmojiEndIndex = i + (matchedEmojiLength);
-
-        auto charactersFromLastParsedEmoji =
-            currentParsedEmojiFirstIndex - lastParsedEmojiEndIndex;
-
-        if (charactersFromLastParsedEmoji > 0)
+        if (i > textStart)
         {
             // Add characters inbetween emojis
-            result.emplace_back(text.mid(lastParsedEmojiEndIndex,
-                                         charactersFromLastParsedEmoji));
+            onText(text.mid(textStart, i - textStart));
         }
+        onEmoji(matchedEmoji->emote);
 
-        // Push the emoji as a word to parsedWords
-        result.emplace_back(matchedEmoji->emote);
-
-        lastParsedEmojiEndIndex = currentParsedEmojiEndIndex;
-
-        i += matchedEmojiLength - 1;
+        i += matchedLength;
+        textStart = i;
     }
 
-    if (lastParsedEmojiEndIndex < text.length())
+    if (textStart < text.size())
     {
         // Add remaining characters
-        result.emplace_back(text.mid(lastParsedEmojiEndIndex));
+        onText(text.mid(textStart));
     }
+}
 
+std::vector<std::variant<EmotePtr, QStringView>> IEmojis::parse(
+    QStringView text) const
+{
+    std::vector<std::variant<EmotePtr, QStringView>> result;
+    this->parse(
+        text,
+        [&](QStringView part) {
+            result.emplace_back(part);
+        },
+        [&](const EmotePtr &emote) {
+            result.emplace_back(emote);
+        });
     return result;
 }
 
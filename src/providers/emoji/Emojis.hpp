@@ -6,11 +6,14 @@
 
 #include "common/FlagsEnum.hpp"
 #include "providers/emoji/EmojiStyle.hpp"
+#include "util/FunctionRef.hpp"
 
 #include <QMap>
 #include <QRegularExpression>
-#include <QVector>
+#include <QStringView>
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <variant>
 #include <vector>
@@ -54,8 +57,19 @@ class IEmojis
 public:
     virtual ~IEmojis() = default;
 
-    virtual std::vector<std::variant<EmotePtr, QStringView>> parse(
-        QStringView text) const = 0;
+    /// @brief Splits `text` into emojis and the text between them.
+    ///
+    /// The parts are passed to `onText` and `onEmoji` in order. Nothing is
+    /// allocated, so text without emojis results in a single `onText` call
+    /// with all of `text`.
+    virtual void parse(QStringView text,
+                       FunctionRef<void(QStringView)> onText,
+                       FunctionRef<void(const EmotePtr &)> onEmoji) const = 0;
+
+    /// Collects the parts of `text` found by the overload above
+    std::vector<std::variant<EmotePtr, QStringView>> parse(
+        QStringView text) const;
+
     virtual const std::vector<EmojiPtr> &getEmojis() const = 0;
     virtual const std::vector<QString> &getShortCodes() const = 0;
     virtual QString replaceShortCodes(const QString &text) const = 0;
@@ -65,8 +79,10 @@ class Emojis : public IEmojis
 {
 public:
     void load();
-    std::vector<std::variant<EmotePtr, QStringView>> parse(
-        QStringView text) const override;
+
+    using IEmojis::parse;
+    void parse(QStringView text, FunctionRef<void(QStringView)> onText,
+               FunctionRef<void(const EmotePtr &)> onEmoji) const override;
 
     std::vector<QString> shortCodes;
     QString replaceShortCodes(const QString &text) const override;
@@ -78,6 +94,9 @@ private:
     void loadEmojis();
     void sortEmojis();
     void loadEmojiSet();
+    void buildTrie();
+    /// Returns the child of `node` for `codeUnit`, 0 if there's none
+    uint32_t trieChild(uint32_t node, char16_t codeUnit) const;
 
     std::vector<EmojiPtr> emojis;
 
@@ -87,9 +106,31 @@ private:
     // shortCodeToEmoji maps strings like "sunglasses" to its emoji
     QMap<QString, std::shared_ptr<EmojiData>> emojiShortCodeToEmoji_;
 
-    // Maps the first character of the emoji unicode string to a vector of
-    // possible emojis
-    QMap<QChar, QVector<std::shared_ptr<EmojiData>>> emojiFirstByte_;
+    /// @brief The qualified and non-qualified strings of all emojis as a
+    ///        trie over UTF-16 code units.
+    ///
+    /// Where several strings match, the one of the emoji with the longest
+    /// qualified string wins, preferring its qualified string.
+    struct TrieNode {
+        /// Range of the children in trieEdges_, sorted by code unit
+        uint32_t firstEdge = 0;
+        uint32_t edgeCount = 0;
+        /// The emoji whose string ends here or nullptr
+        const EmojiData *emoji = nullptr;
+        /// Priority of `emoji` (lower wins) among strings starting with the
+        /// same code unit
+        uint32_t rank = UINT32_MAX;
+    };
+    struct TrieEdge {
+        char16_t codeUnit;
+        uint32_t target;
+    };
+    std::vector<TrieNode> trieNodes_;
+    std::vector<TrieEdge> trieEdges_;
+    /// Children of the root for ASCII code units, 0 if there's none. Only a
+    /// few ASCII characters start emojis (keycaps, '#', '*'), so most text
+    /// is skipped using this table.
+    std::array<uint32_t, 128> asciiRoots_{};
 
     bool loaded_ = false;
 };
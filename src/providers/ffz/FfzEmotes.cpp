@@ -223,6 +223,11 @@ std::shared_ptr<const EmoteMap> FfzEmotes::emotes() const
     return this->global_.get();
 }
 
+uint64_t FfzEmotes::emotesVersion() const
+{
+    return this->global_.version();
+}
+
 std::optional<EmotePtr> FfzEmotes::emote(const EmoteName &name) const
 {
     auto emotes = this->global_.get();
@@ -44,6 +44,8 @@ public:
     FfzEmotes();
 
     std::shared_ptr<const EmoteMap> emotes() const;
+    /// Changes whenever the emotes are replaced
+    uint64_t emotesVersion() const;
     std::optional<EmotePtr> emote(const EmoteName &name) const;
     void loadEmotes();
     void setEmotes(std::shared_ptr<const EmoteMap> emotes);
@@ -5,24 +5,58 @@
 #include "providers/links/LinkResolver.hpp"
 
 #include "common/Env.hpp"
+#include "common/Literals.hpp"
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Image.hpp"
 #include "providers/links/LinkInfo.hpp"
 #include "singletons/Settings.hpp"
 
 #include <QStringBuilder>
+#include <QUrl>
+
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+
+size_t queueIndex(ILinkResolver::Priority priority)
+{
+    return static_cast<size_t>(priority);
+}
+
+}  // namespace
 
 namespace chatterino {
 
-void LinkResolver::resolve(LinkInfo *info)
+using namespace literals;
+
+LinkResolver::LinkResolver()
+    : LinkResolver(Env::get().linkResolverUrl)
+{
+}
+
+LinkResolver::LinkResolver(QString resolverUrl)
+    : resolverUrl_(std::move(resolverUrl))
+{
+}
+
+bool LinkResolver::Entry::isLoaded() const
+{
+    return this->status == Status::Resolved || this->status == Status::Errored;
+}
+
+void LinkResolver::resolve(LinkInfo *info, Priority priority)
 {
     using State = LinkInfo::State;
 
     assert(info);
+    assertInGuiThread();
 
-    if (info->state() != State::Created)
+    if (info->isLoaded())
     {
-        // The link is already resolved or is currently loading
         return;
     }
 
@@ -31,46 +65,292 @@ void LinkResolver::resolve(LinkInfo *info)
         return;
     }
 
-    info->setTooltip("Loading...");
-    info->setState(State::Loading);
+    auto key = normalizeUrl(info->originalUrl());
+    auto it = this->entries_.find(key);
+    if (it != this->entries_.end() && it->second.isLoaded() &&
+        it->second.expiresAt <= std::chrono::steady_clock::now())
+    {
+        this->entries_.erase(it);
+        it = this->entries_.end();
+    }
 
-    NetworkRequest(Env::get().linkResolverUrl.arg(QString::fromUtf8(
-                       QUrl::toPercentEncoding(info->originalUrl(), {}, "/:"))))
-        .caller(info)
-        .timeout(30000)
-        .onSuccess([info](const NetworkResult &result) {
-            const auto root = result.parseJson();
-            QString response;
-            QString url;
-            ImagePtr thumbnail = nullptr;
-            if (root["status"].toInt() == 200)
-            {
-                response = root["tooltip"].toString();
+    if (it == this->entries_.end())
+    {
+        this->evict();
+        it = this->entries_.emplace(key, Entry{}).first;
+        it->second.url = info->originalUrl();
+        it->second.priority = priority;
+        this->queues_[queueIndex(priority)].push_back(key);
+        this->nQueued_++;
+    }
+
+    auto &entry = it->second;
+    if (entry.isLoaded())
+    {
+        apply(entry, info);
+        return;
+    }
+
+    // A loading info might come from an entry that was dropped from the queue
+    if (!info->isLoading())
+    {
+        info->setTooltip("Loading...");
+        info->setState(State::Loading);
+    }
+    if (std::ranges::find(entry.waiting, info) == entry.waiting.end())
+    {
+        entry.waiting.emplace_back(info);
+    }
+
+    this->enqueue(key, entry, priority);
+    this->startRequests();
+}
+
+QString LinkResolver::normalizeUrl(const QString &url)
+{
+    QUrl parsed(url);
+    if (!parsed.isValid())
+    {
+        return url;
+    }
+
+    auto scheme = parsed.scheme();
+    if ((scheme == "https"_L1 && parsed.port() == 443) ||
+        (scheme == "http"_L1 && parsed.port() == 80))
+    {
+        parsed.setPort(-1);
+    }
+    if (parsed.path().isEmpty() && !parsed.host().isEmpty())
+    {
+        parsed.setPath(u"/"_s);
+    }
+
+    return parsed.toString(QUrl::NormalizePathSegments | QUrl::FullyEncoded);
+}
+
+void LinkResolver::enqueue(const QString &key, Entry &entry, Priority priority)
+{
+    if (entry.status != Entry::Status::Queued || priority <= entry.priority)
+    {
+        return;
+    }
+
+    // The key in the lower queue is skipped once it's reached
+    entry.priority = priority;
+    this->queues_[queueIndex(priority)].push_back(key);
+}
+
+void LinkResolver::startRequests()
+{
+    while (this->nRunning_ < MAX_CONCURRENT_REQUESTS)
+    {
+        auto priority = Priority::Visible;
+        if (this->queues_[queueIndex(priority)].empty())
+        {
+            priority = Priority::Background;
+        }
+        auto &queue = this->queues_[queueIndex(priority)];
+        if (queue.empty())
+        {
+            return;
+        }
+
+        auto key = std::move(queue.back());
+        queue.pop_back();
+
+        auto it = this->entries_.find(key);
+        if (it == this->entries_.end() ||
+            it->second.status != Entry::Status::Queued ||
+            it->second.priority != priority)
+        {
+            continue;
+        }
 
-                if (root.contains("thumbnail"))
+        auto &entry = it->second;
+        std::erase_if(entry.waiting, [](const auto &info) {
+            return info.isNull();
+        });
+        if (entry.waiting.empty())
+        {
+            // All messages with this link are gone
+            this->entries_.erase(it);
+            this->nQueued_--;
+            continue;
+        }
+
+        this->load(key, entry);
+    }
+}
+
+void LinkResolver::load(const QString &key, Entry &entry)
+{
+    entry.status = Entry::Status::Loading;
+    this->nQueued_--;
+    this->nRunning_++;
+
+    auto request =
+        NetworkRequest(this->resolverUrl_.arg(QString::fromUtf8(
+                           QUrl::toPercentEncoding(entry.url, {}, "/:"))))
+            .caller(&this->lifetimeGuard_)
+            .timeout(30000)
+            .onSuccess([this, key](const NetworkResult &result) {
+                const auto root = result.parseJson();
+                QString response;
+                ImagePtr thumbnail = nullptr;
+                std::optional<QString> link;
+                if (root["status"].toInt() == 200)
                 {
-                    info->setThumbnail(
-                        Image::fromUrl({root["thumbnail"].toString()}));
+                    response = root["tooltip"].toString();
+
+                    if (root.contains("thumbnail"))
+                    {
+                        thumbnail =
+                            Image::fromUrl({root["thumbnail"].toString()});
+                    }
+                    if (root.contains("link"))
+                    {
+                        link = root["link"].toString();
+                    }
                 }
-                if (getSettings()->unshortLinks && root.contains("link"))
+                else
                 {
-                    info->setResolvedUrl(root["link"].toString());
+                    response = root["message"].toString();
                 }
+
+                this->finish(key, Entry::Status::Resolved,
+                             QUrl::fromPercentEncoding(response.toUtf8()),
+                             std::move(thumbnail), std::move(link));
+            })
+            .onError([this, key](const auto &result) {
+                this->finish(key, Entry::Status::Errored,
+                             u"No link info found (" % result.formatError() %
+                                 u')');
+            });
+
+    if (getSettings()->linkInfoDiskCache)
+    {
+        request = std::move(request).cache();
+    }
+
+    request.execute();
+}
+
+void LinkResolver::finish(const QString &key, Entry::Status status,
+                          QString tooltip, ImagePtr thumbnail,
+                          std::optional<QString> link)
+{
+    this->nRunning_--;
+
+    auto it = this->entries_.find(key);
+    if (it != this->entries_.end())
+    {
+        auto &entry = it->second;
+        entry.status = status;
+        entry.tooltip = std::move(tooltip);
+        entry.thumbnail = std::move(thumbnail);
+        entry.link = std::move(link);
+        entry.expiresAt =
+            std::chrono::steady_clock::now() +
+            (status == Entry::Status::Resolved ? RESOLVED_TTL : ERROR_TTL);
+
+        // Updating the infos can emit signals, so don't hold on to the entry
+        auto waiting = std::move(entry.waiting);
+        entry.waiting.clear();
+        const auto resolved = entry;
+
+        for (const auto &info : waiting)
+        {
+            if (info)
+            {
+                apply(resolved, info);
             }
-            else
+        }
+    }
+
+    this->startRequests();
+}
+
+void LinkResolver::evict()
+{
+    // Queued links are never evicted below, so a wave of unique links would
+    // grow the cache until the queue drains
+    while (this->nQueued_ >= MAX_QUEUED_LINKS && this->dropQueued())
+    {
+    }
+
+    if (this->entries_.size() < MAX_CACHED_LINKS)
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::erase_if(this->entries_, [now](const auto &item) {
+        return item.second.isLoaded() && item.second.expiresAt <= now;
+    });
+    if (this->entries_.size() < MAX_CACHED_LINKS)
+    {
+        return;
+    }
+
+    // Links that are still loading are never evicted
+    auto oldest = this->entries_.end();
+    for (auto it = this->entries_.begin(); it != this->entries_.end(); it++)
+    {
+        if (it->second.isLoaded() &&
+            (oldest == this->entries_.end() ||
+             it->second.expiresAt < oldest->second.expiresAt))
+        {
+            oldest = it;
+        }
+    }
+    if (oldest != this->entries_.end())
+    {
+        this->entries_.erase(oldest);
+    }
+}
+
+bool LinkResolver::dropQueued()
+{
+    for (auto priority : {Priority::Background, Priority::Visible})
+    {
+        auto &queue = this->queues_[queueIndex(priority)];
+        while (!queue.empty())
+        {
+            auto key = std::move(queue.front());
+            queue.pop_front();
+
+            auto it = this->entries_.find(key);
+            if (it == this->entries_.end() ||
+                it->second.status != Entry::Status::Queued ||
+                it->second.priority != priority)
             {
-                response = root["message"].toString();
+                continue;
             }
 
-            info->setTooltip(QUrl::fromPercentEncoding(response.toUtf8()));
-            info->setState(State::Resolved);
-        })
-        .onError([info](const auto &result) {
-            info->setTooltip(u"No link info found (" % result.formatError() %
-                             u')');
-            info->setState(State::Errored);
-        })
-        .execute();
+            // The infos stay loading, see resolve()
+            this->entries_.erase(it);
+            this->nQueued_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void LinkResolver::apply(const Entry &entry, LinkInfo *info)
+{
+    using State = LinkInfo::State;
+
+    if (entry.thumbnail)
+    {
+        info->setThumbnail(entry.thumbnail);
+    }
+    if (entry.link && getSettings()->unshortLinks)
+    {
+        info->setResolvedUrl(*entry.link);
+    }
+    info->setTooltip(entry.tooltip);
+    info->setState(entry.status == Entry::Status::Resolved ? State::Resolved
+                                                           : State::Errored);
 }
 
 }  // namespace chatterino
@@ -4,13 +4,35 @@
 
 #pragma once
 
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 namespace chatterino {
 
+class Image;
+using ImagePtr = std::shared_ptr<Image>;
 class LinkInfo;
 
 class ILinkResolver
 {
 public:
+    /// How urgently a link should be resolved
+    enum class Priority : uint8_t {
+        /// The link was added to a message, which might not be visible
+        Background,
+        /// The link is visible in a view or the user is hovering it
+        Visible,
+    };
+
     ILinkResolver() = default;
     virtual ~ILinkResolver() = default;
     ILinkResolver(const ILinkResolver &) = delete;
@@ -18,23 +40,109 @@ public:
     ILinkResolver &operator=(const ILinkResolver &) = delete;
     ILinkResolver &operator=(ILinkResolver &&) = delete;
 
-    virtual void resolve(LinkInfo *info) = 0;
+    virtual void resolve(LinkInfo *info, Priority priority) = 0;
 };
 
 class LinkResolver : public ILinkResolver
 {
 public:
-    LinkResolver() = default;
+    /// How long a resolved link is reused
+    static constexpr std::chrono::minutes RESOLVED_TTL{10};
+    /// How long an error is reused, so a failing resolver isn't asked again
+    /// for every message with the same link
+    static constexpr std::chrono::minutes ERROR_TTL{1};
+    /// At most this many links are requested at once
+    static constexpr size_t MAX_CONCURRENT_REQUESTS = 4;
+    /// Once this many links are cached, the ones expiring first are evicted
+    static constexpr size_t MAX_CACHED_LINKS = 1000;
+    /// At most this many links wait for a request. Beyond that, the oldest
+    /// ones are dropped (background ones first). Their infos keep loading and
+    /// are requested again once they're visible.
+    static constexpr size_t MAX_QUEUED_LINKS = 500;
+
+    /// Resolves links through Env::linkResolverUrl
+    LinkResolver();
+    /// @param resolverUrl The URL of the resolver, `%1` is replaced with the
+    ///                    percent-encoded link
+    explicit LinkResolver(QString resolverUrl);
 
     /// @brief Loads and updates the link info
     ///
-    /// Calling this with an already resolved or currently loading info is a
-    /// no-op. Loading can be blocked by disabling the "linkInfoTooltip"
-    /// setting. URLs will be unshortened if the "unshortLinks" setting is
-    /// enabled. The resolver is set through Env::linkResolverUrl.
+    /// Links are cached by their normalized URL (see #normalizeUrl()). If the
+    /// URL was resolved recently, @a info is updated right away. If it's
+    /// currently being resolved, @a info is updated once that request
+    /// finishes. Otherwise, a request is queued. Visible links are requested
+    /// before background ones.
+    ///
+    /// Calling this with an already resolved info is a no-op. Calling it with
+    /// a loading info can only raise its priority. Loading can be blocked by
+    /// disabling the "linkInfoTooltip" setting. URLs will be unshortened if the
+    /// "unshortLinks" setting is enabled. Responses are cached on disk if the
+    /// "linkInfoDiskCache" setting is enabled.
     ///
     /// @pre @a info must not be nullptr
-    void resolve(LinkInfo *info) override;
+    void resolve(LinkInfo *info, Priority priority) override;
+
+    /// @brief Returns the URL under which a link is cached
+    ///
+    /// The scheme and host are lowercased, default ports are removed, `.` and
+    /// `..` segments are resolved, and an empty path becomes `/`.
+    static QString normalizeUrl(const QString &url);
+
+private:
+    struct Entry {
+        enum class Status : uint8_t {
+            Queued,
+            Loading,
+            Resolved,
+            Errored,
+        };
+
+        Status status = Status::Queued;
+        Priority priority = Priority::Background;
+        /// The URL sent to the resolver
+        QString url;
+
+        QString tooltip;
+        ImagePtr thumbnail;
+        /// The unshortened link (if the resolver sent one)
+        std::optional<QString> link;
+        /// Set once the link is resolved or errored
+        std::chrono::steady_clock::time_point expiresAt;
+
+        /// Infos waiting for this link to be resolved
+        std::vector<QPointer<LinkInfo>> waiting;
+
+        bool isLoaded() const;
+    };
+
+    void enqueue(const QString &key, Entry &entry, Priority priority);
+    /// Starts queued requests until MAX_CONCURRENT_REQUESTS are running
+    void startRequests();
+    void load(const QString &key, Entry &entry);
+    void finish(const QString &key, Entry::Status status, QString tooltip,
+                ImagePtr thumbnail = nullptr,
+                std::optional<QString> link = std::nullopt);
+    /// Makes room for a new entry
+    void evict();
+    /// Drops the oldest queued entry, preferring background ones.
+    /// Returns false if nothing is queued.
+    bool dropQueued();
+
+    static void apply(const Entry &entry, LinkInfo *info);
+
+    std::unordered_map<QString, Entry> entries_;
+    /// Keys of queued links for each priority. The most recent links are at
+    /// the back and are requested first, as they're the ones at the bottom of
+    /// the views. Keys can be outdated, the entry is the source of truth.
+    std::deque<QString> queues_[2];
+    /// Number of entries with Entry::Status::Queued
+    size_t nQueued_ = 0;
+    size_t nRunning_ = 0;
+
+    const QString resolverUrl_;
+
+    QObject lifetimeGuard_;
 };
 
 }  // namespace chatterino
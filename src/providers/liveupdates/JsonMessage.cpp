@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/liveupdates/JsonMessage.hpp"
+
+#include <QJsonArray>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// NOLINTNEXTLINE(cert-err58-cpp) -- this doesn't allocate
+const rapidjson::Value NULL_VALUE;
+
+}  // namespace
+
+namespace chatterino::liveupdates {
+
+JsonMessage::JsonMessage(const QByteArray &data)
+    : buffer_(data)
+{
+    // data() detaches, so the text can be modified while parsing. It's always
+    // null terminated.
+    this->document_.ParseInsitu(this->buffer_.data());
+}
+
+bool JsonMessage::isValid() const
+{
+    return !this->document_.HasParseError();
+}
+
+const rapidjson::Value &JsonMessage::root() const
+{
+    return this->document_;
+}
+
+const rapidjson::Value &jsonMember(const rapidjson::Value &value,
+                                   const char *key)
+{
+    if (!value.IsObject())
+    {
+        return NULL_VALUE;
+    }
+
+    auto it = value.FindMember(key);
+    if (it == value.MemberEnd())
+    {
+        return NULL_VALUE;
+    }
+    return it->value;
+}
+
+std::span<const rapidjson::Value> jsonArray(const rapidjson::Value &value)
+{
+    if (!value.IsArray())
+    {
+        return {};
+    }
+    return {value.Begin(), value.Size()};
+}
+
+QString jsonString(const rapidjson::Value &value)
+{
+    if (!value.IsString())
+    {
+        return {};
+    }
+    return QString::fromUtf8(value.GetString(),
+                             static_cast<qsizetype>(value.GetStringLength()));
+}
+
+int jsonInt(const rapidjson::Value &value)
+{
+    if (value.IsInt())
+    {
+        return value.GetInt();
+    }
+    if (value.IsDouble())
+    {
+        auto number = value.GetDouble();
+        if (std::trunc(number) == number &&
+            number >= std::numeric_limits<int>::min() &&
+            number <= std::numeric_limits<int>::max())
+        {
+            return static_cast<int>(number);
+        }
+    }
+    return 0;
+}
+
+QJsonValue toQJsonValue(const rapidjson::Value &value)
+{
+    switch (value.GetType())
+    {
+        case rapidjson::kNullType:
+            return QJsonValue::Null;
+        case rapidjson::kFalseType:
+            return false;
+        case rapidjson::kTrueType:
+            return true;
+        case rapidjson::kStringType:
+            return jsonString(value);
+        case rapidjson::kNumberType:
+            if (value.IsInt64())
+            {
+                return static_cast<qint64>(value.GetInt64());
+            }
+            return value.GetDouble();
+        case rapidjson::kArrayType: {
+            QJsonArray array;
+            for (const auto &element : value.GetArray())
+            {
+                array.append(toQJsonValue(element));
+            }
+            return array;
+        }
+        case rapidjson::kObjectType:
+            return toQJsonObject(value);
+    }
+    return {};
+}
+
+QJsonObject toQJsonObject(const rapidjson::Value &value)
+{
+    QJsonObject object;
+    if (!value.IsObject())
+    {
+        return object;
+    }
+
+    for (const auto &member : value.GetObject())
+    {
+        object.insert(jsonString(member.name), toQJsonValue(member.value));
+    }
+    return object;
+}
+
+}  // namespace chatterino::liveupdates
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <rapidjson/document.h>
+
+#include <span>
+
+namespace chatterino::liveupdates {
+
+/// @brief A JSON message received from a live update websocket.
+///
+/// The message is parsed in place with RapidJSON: strings point into the
+/// message's own copy of the text instead of being allocated one by one, and
+/// no QJsonObject tree is built. Messages are decoded with the helpers below
+/// while the JsonMessage is alive.
+class JsonMessage
+{
+public:
+    explicit JsonMessage(const QByteArray &data);
+
+    JsonMessage(const JsonMessage &) = delete;
+    JsonMessage(JsonMessage &&) = delete;
+    JsonMessage &operator=(const JsonMessage &) = delete;
+    JsonMessage &operator=(JsonMessage &&) = delete;
+    ~JsonMessage() = default;
+
+    /// Returns false if the message isn't valid JSON
+    bool isValid() const;
+
+    const rapidjson::Value &root() const;
+
+private:
+    QByteArray buffer_;
+    rapidjson::Document document_;
+};
+
+/// Returns the member `key` of `value`, or null if `value` isn't an object or
+/// doesn't have the member (like `QJsonValue::operator[]`)
+const rapidjson::Value &jsonMember(const rapidjson::Value &value,
+                                   const char *key);
+
+/// Returns the elements of `value`, or nothing if it isn't an array
+std::span<const rapidjson::Value> jsonArray(const rapidjson::Value &value);
+
+/// Returns `value` if it's a string and an empty string otherwise (like
+/// `QJsonValue::toString`)
+QString jsonString(const rapidjson::Value &value);
+
+/// Returns `value` if it's an integer in the range of int and 0 otherwise
+/// (like `QJsonValue::toInt`)
+int jsonInt(const rapidjson::Value &value);
+
+/// Converts `value` for code that works with Qt's JSON types. Only use this
+/// for the parts of a message that need to be kept.
+QJsonValue toQJsonValue(const rapidjson::Value &value);
+
+/// Converts `value` if it's an object and returns an empty object otherwise
+/// (like `QJsonValue::toObject`)
+QJsonObject toQJsonObject(const rapidjson::Value &value);
+
+}  // namespace chatterino::liveupdates
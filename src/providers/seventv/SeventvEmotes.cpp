@@ -205,6 +205,11 @@ std::shared_ptr<const EmoteMap> SeventvEmotes::globalEmotes() const
     return this->global_.get();
 }
 
+uint64_t SeventvEmotes::globalEmotesVersion() const
+{
+    return this->global_.version();
+}
+
 std::optional<EmotePtr> SeventvEmotes::globalEmote(const EmoteName &name) const
 {
     auto emotes = this->global_.get();
@@ -364,7 +369,6 @@ std::optional<EmotePtr> SeventvEmotes::addEmote(
         return std::nullopt;
     }
 
-    // This copies the map.
     EmoteMap updatedMap = *map.get();
     auto result = createEmote(dispatch.emoteJson, emoteData, false);
     if (!result.hasImages)
@@ -392,7 +396,6 @@ std::optional<EmotePtr> SeventvEmotes::updateEmote(
         return std::nullopt;
     }
 
-    // This copies the map.
     EmoteMap updatedMap = *map.get();
     updatedMap.erase(oldEmote->second->name);
 
@@ -407,13 +410,10 @@ std::optional<EmotePtr> SeventvEmotes::removeEmote(
     Atomic<std::shared_ptr<const EmoteMap>> &map,
     const EmoteRemoveDispatch &dispatch)
 {
-    // This copies the map.
     EmoteMap updatedMap = *map.get();
     auto it = updatedMap.findEmote(dispatch.emoteName, dispatch.emoteID);
     if (it == updatedMap.end())
     {
-        // We already copied the map at this point and are now discarding the copy.
-        // This is fine, because this case should be really rare.
         return std::nullopt;
     }
     auto emote = it->second;
@@ -106,6 +106,8 @@ public:
     SeventvEmotes();
 
     std::shared_ptr<const EmoteMap> globalEmotes() const;
+    /// Changes whenever the emotes are replaced
+    uint64_t globalEmotesVersion() const;
     std::optional<EmotePtr> globalEmote(const EmoteName &name) const;
     void loadGlobalEmotes();
     void setGlobalEmotes(std::shared_ptr<const EmoteMap> emotes);
@@ -5,17 +5,19 @@
 #include "providers/seventv/eventapi/Client.hpp"
 
 #include "Application.hpp"
+#include "providers/liveupdates/JsonMessage.hpp"
 #include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/eventapi/Message.hpp"
 #include "providers/seventv/eventapi/Subscription.hpp"
 #include "providers/seventv/SeventvBadges.hpp"
 #include "providers/seventv/SeventvEventAPI.hpp"
 #include "util/QMagicEnum.hpp"
-
-#include <QJsonArray>
+#include "util/RapidjsonHelpers.hpp"
 
 namespace chatterino::seventv::eventapi {
 
+using namespace liveupdates;
+
 Client::Client(SeventvEventAPI &manager,
                std::chrono::milliseconds heartbeatInterval)
     : BasicPubSubClient(100)
@@ -34,7 +36,8 @@ void Client::onOpen()
 
 void Client::onMessage(const QByteArray &msg)
 {
-    auto pMessage = parseBaseMessage(msg);
+    JsonMessage json(msg);
+    auto pMessage = parseBaseMessage(json);
 
     if (!pMessage)
     {
@@ -42,13 +45,13 @@ void Client::onMessage(const QByteArray &msg)
             << "Unable to parse incoming event-api message: " << msg;
         return;
     }
-    auto message = *pMessage;
+    const auto &message = *pMessage;
     switch (message.op)
     {
         case Opcode::Hello: {
             this->heartbeatInterval_.store(
                 std::chrono::milliseconds{
-                    message.data["heartbeat_interval"].toInt()},
+                    jsonInt(jsonMember(message.data, "heartbeat_interval"))},
                 std::memory_order::relaxed);
         }
         break;
@@ -120,7 +123,8 @@ void Client::handleDispatch(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid cosmetic dispatch" << dispatch.body;
+                    << "Invalid cosmetic dispatch"
+                    << rj::stringify(dispatch.body);
             }
         }
         break;
@@ -133,7 +137,8 @@ void Client::handleDispatch(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid entitlement create dispatch" << dispatch.body;
+                    << "Invalid entitlement create dispatch"
+                    << rj::stringify(dispatch.body);
             }
         }
         break;
@@ -146,7 +151,8 @@ void Client::handleDispatch(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid entitlement delete dispatch" << dispatch.body;
+                    << "Invalid entitlement delete dispatch"
+                    << rj::stringify(dispatch.body);
             }
         }
         break;
@@ -163,7 +169,7 @@ void Client::handleDispatch(const Dispatch &dispatch)
             qCDebug(chatterinoSeventvEventAPI)
                 << "Unknown subscription type:"
                 << qmagicenum::enumName(dispatch.type)
-                << "body:" << dispatch.body;
+                << "body:" << rj::stringify(dispatch.body);
         }
         break;
     }
@@ -176,15 +182,14 @@ void Client::onEmoteSetUpdate(const Dispatch &dispatch)
     //   pulled:  Array<{ key,        old_value }>,
     //   updated: Array<{ key, value, old_value }>,
     // }
-    for (const auto pushedRef : dispatch.body["pushed"].toArray())
+    for (const auto &pushed : jsonArray(jsonMember(dispatch.body, "pushed")))
     {
-        auto pushed = pushedRef.toObject();
-        if (pushed["key"].toString() != "emotes")
+        if (jsonMember(pushed, "key") != "emotes")
         {
             continue;
         }
 
-        const EmoteAddDispatch added(dispatch, pushed["value"].toObject());
+        const EmoteAddDispatch added(dispatch, jsonMember(pushed, "value"));
 
         if (added.validate())
         {
@@ -193,20 +198,19 @@ void Client::onEmoteSetUpdate(const Dispatch &dispatch)
         else
         {
             qCDebug(chatterinoSeventvEventAPI)
-                << "Invalid dispatch" << dispatch.body;
+                << "Invalid dispatch" << rj::stringify(dispatch.body);
         }
     }
-    for (const auto updatedRef : dispatch.body["updated"].toArray())
+    for (const auto &updated : jsonArray(jsonMember(dispatch.body, "updated")))
     {
-        auto updated = updatedRef.toObject();
-        if (updated["key"].toString() != "emotes")
+        if (jsonMember(updated, "key") != "emotes")
         {
             continue;
         }
 
         const EmoteUpdateDispatch update(dispatch,
-                                         updated["old_value"].toObject(),
-                                         updated["value"].toObject());
+                                         jsonMember(updated, "old_value"),
+                                         jsonMember(updated, "value"));
 
         if (update.validate())
         {
@@ -215,19 +219,18 @@ void Client::onEmoteSetUpdate(const Dispatch &dispatch)
         else
         {
             qCDebug(chatterinoSeventvEventAPI)
-                << "Invalid dispatch" << dispatch.body;
+                << "Invalid dispatch" << rj::stringify(dispatch.body);
         }
     }
-    for (const auto pulledRef : dispatch.body["pulled"].toArray())
+    for (const auto &pulled : jsonArray(jsonMember(dispatch.body, "pulled")))
     {
-        auto pulled = pulledRef.toObject();
-        if (pulled["key"].toString() != "emotes")
+        if (jsonMember(pulled, "key") != "emotes")
         {
             continue;
         }
 
         const EmoteRemoveDispatch removed(dispatch,
-                                          pulled["old_value"].toObject());
+                                          jsonMember(pulled, "old_value"));
 
         if (removed.validate())
         {
@@ -236,7 +239,7 @@ void Client::onEmoteSetUpdate(const Dispatch &dispatch)
         else
         {
             qCDebug(chatterinoSeventvEventAPI)
-                << "Invalid dispatch" << dispatch.body;
+                << "Invalid dispatch" << rj::stringify(dispatch.body);
         }
     }
 }
@@ -246,23 +249,21 @@ void Client::onUserUpdate(const Dispatch &dispatch)
     // dispatchBody: {
     //   updated: Array<{ key, value: Array<{key, value}> }>
     // }
-    for (const auto updatedRef : dispatch.body["updated"].toArray())
+    for (const auto &updated : jsonArray(jsonMember(dispatch.body, "updated")))
     {
-        auto updated = updatedRef.toObject();
-        if (updated["key"].toString() != "connections")
+        if (jsonMember(updated, "key") != "connections")
         {
             continue;
         }
-        for (const auto valueRef : updated["value"].toArray())
+        for (const auto &value : jsonArray(jsonMember(updated, "value")))
         {
-            auto value = valueRef.toObject();
-            if (value["key"].toString() != "emote_set")
+            if (jsonMember(value, "key") != "emote_set")
             {
                 continue;
             }
 
             const UserConnectionUpdateDispatch update(
-                dispatch, value, (size_t)updated["index"].toInt());
+                dispatch, value, (size_t)jsonInt(jsonMember(updated, "index")));
 
             if (update.validate())
             {
@@ -271,7 +272,7 @@ void Client::onUserUpdate(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid dispatch" << dispatch.body;
+                    << "Invalid dispatch" << rj::stringify(dispatch.body);
             }
         }
     }
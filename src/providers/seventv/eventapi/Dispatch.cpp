@@ -4,27 +4,29 @@
 
 #include "providers/seventv/eventapi/Dispatch.hpp"
 
+#include "providers/liveupdates/JsonMessage.hpp"
 #include "util/QMagicEnum.hpp"
 
-#include <QJsonArray>
-
-#include <utility>
-
 namespace chatterino::seventv::eventapi {
 
-Dispatch::Dispatch(QJsonObject obj)
-    : type(qmagicenum::enumCast<SubscriptionType>(obj["type"].toString())
+using namespace liveupdates;
+
+Dispatch::Dispatch(const rapidjson::Value &obj)
+    : type(qmagicenum::enumCast<SubscriptionType>(
+               jsonString(jsonMember(obj, "type")))
                .value_or(SubscriptionType::INVALID))
-    , body(obj["body"].toObject())
-    , id(this->body["id"].toString())
-    , actorName(this->body["actor"].toObject()["display_name"].toString())
+    , body(jsonMember(obj, "body"))
+    , id(jsonString(jsonMember(this->body, "id")))
+    , actorName(jsonString(
+          jsonMember(jsonMember(this->body, "actor"), "display_name")))
 {
 }
 
-EmoteAddDispatch::EmoteAddDispatch(const Dispatch &dispatch, QJsonObject emote)
+EmoteAddDispatch::EmoteAddDispatch(const Dispatch &dispatch,
+                                   const rapidjson::Value &emote)
     : emoteSetID(dispatch.id)
     , actorName(dispatch.actorName)
-    , emoteJson(std::move(emote))
+    , emoteJson(toQJsonObject(emote))
     , emoteID(this->emoteJson["id"].toString())
 {
 }
@@ -50,11 +52,11 @@ bool EmoteAddDispatch::validate() const
 }
 
 EmoteRemoveDispatch::EmoteRemoveDispatch(const Dispatch &dispatch,
-                                         QJsonObject emote)
+                                         const rapidjson::Value &emote)
     : emoteSetID(dispatch.id)
     , actorName(dispatch.actorName)
-    , emoteName(emote["name"].toString())
-    , emoteID(emote["id"].toString())
+    , emoteName(jsonString(jsonMember(emote, "name")))
+    , emoteID(jsonString(jsonMember(emote, "id")))
 {
 }
 
@@ -65,13 +67,13 @@ bool EmoteRemoveDispatch::validate() const
 }
 
 EmoteUpdateDispatch::EmoteUpdateDispatch(const Dispatch &dispatch,
-                                         QJsonObject oldValue,
-                                         QJsonObject value)
+                                         const rapidjson::Value &oldValue,
+                                         const rapidjson::Value &value)
     : emoteSetID(dispatch.id)
     , actorName(dispatch.actorName)
-    , emoteID(value["id"].toString())
-    , oldEmoteName(oldValue["name"].toString())
-    , emoteName(value["name"].toString())
+    , emoteID(jsonString(jsonMember(value, "id")))
+    , oldEmoteName(jsonString(jsonMember(oldValue, "name")))
+    , emoteName(jsonString(jsonMember(value, "name")))
 {
 }
 
@@ -83,11 +85,13 @@ bool EmoteUpdateDispatch::validate() const
 }
 
 UserConnectionUpdateDispatch::UserConnectionUpdateDispatch(
-    const Dispatch &dispatch, const QJsonObject &update, size_t connectionIndex)
+    const Dispatch &dispatch, const rapidjson::Value &update,
+    size_t connectionIndex)
     : userID(dispatch.id)
     , actorName(dispatch.actorName)
-    , oldEmoteSetID(update["old_value"].toObject()["id"].toString())
-    , emoteSetID(update["value"].toObject()["id"].toString())
+    , oldEmoteSetID(
+          jsonString(jsonMember(jsonMember(update, "old_value"), "id")))
+    , emoteSetID(jsonString(jsonMember(jsonMember(update, "value"), "id")))
     , connectionIndex(connectionIndex)
 {
 }
@@ -99,9 +103,11 @@ bool UserConnectionUpdateDispatch::validate() const
 }
 
 CosmeticCreateDispatch::CosmeticCreateDispatch(const Dispatch &dispatch)
-    : data(dispatch.body["object"]["data"].toObject())
+    : data(toQJsonObject(
+          jsonMember(jsonMember(dispatch.body, "object"), "data")))
     , kind(qmagicenum::enumCast<CosmeticKind>(
-               dispatch.body["object"]["kind"].toString())
+               jsonString(
+                   jsonMember(jsonMember(dispatch.body, "object"), "kind")))
                .value_or(CosmeticKind::INVALID))
 {
 }
@@ -114,19 +120,20 @@ bool CosmeticCreateDispatch::validate() const
 EntitlementCreateDeleteDispatch::EntitlementCreateDeleteDispatch(
     const Dispatch &dispatch)
 {
-    const auto obj = dispatch.body["object"].toObject();
-    this->refID = obj["ref_id"].toString();
-    this->kind = qmagicenum::enumCast<CosmeticKind>(obj["kind"].toString())
-                     .value_or(CosmeticKind::INVALID);
-
-    const auto userConnections = obj["user"]["connections"].toArray();
-    for (const auto &connectionJson : userConnections)
+    const auto &obj = jsonMember(dispatch.body, "object");
+    this->refID = jsonString(jsonMember(obj, "ref_id"));
+    this->kind =
+        qmagicenum::enumCast<CosmeticKind>(jsonString(jsonMember(obj, "kind")))
+            .value_or(CosmeticKind::INVALID);
+
+    const auto &userConnections =
+        jsonMember(jsonMember(obj, "user"), "connections");
+    for (const auto &connection : jsonArray(userConnections))
     {
-        const auto connection = connectionJson.toObject();
-        if (connection["platform"].toString() == "TWITCH")
+        if (jsonMember(connection, "platform") == "TWITCH")
         {
-            this->userID = connection["id"].toString();
-            this->userName = connection["username"].toString();
+            this->userID = jsonString(jsonMember(connection, "id"));
+            this->userName = jsonString(jsonMember(connection, "username"));
             break;
         }
     }
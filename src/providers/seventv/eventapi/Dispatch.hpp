@@ -9,18 +9,20 @@
 
 #include <QJsonObject>
 #include <QString>
+#include <rapidjson/document.h>
 
 namespace chatterino::seventv::eventapi {
 
 // https://github.com/SevenTV/EventAPI/tree/ca4ff15cc42b89560fa661a76c5849047763d334#message-payload
 struct Dispatch {
     SubscriptionType type;
-    QJsonObject body;
+    /// Valid while the parsed message is alive
+    const rapidjson::Value &body;
     QString id;
     // it's okay for this to be empty
     QString actorName;
 
-    Dispatch(QJsonObject obj);
+    Dispatch(const rapidjson::Value &obj);
 };
 
 struct EmoteAddDispatch {
@@ -29,7 +31,7 @@ struct EmoteAddDispatch {
     QJsonObject emoteJson;
     QString emoteID;
 
-    EmoteAddDispatch(const Dispatch &dispatch, QJsonObject emote);
+    EmoteAddDispatch(const Dispatch &dispatch, const rapidjson::Value &emote);
 
     bool validate() const;
 };
@@ -40,7 +42,8 @@ struct EmoteRemoveDispatch {
     QString emoteName;
     QString emoteID;
 
-    EmoteRemoveDispatch(const Dispatch &dispatch, QJsonObject emote);
+    EmoteRemoveDispatch(const Dispatch &dispatch,
+                        const rapidjson::Value &emote);
 
     bool validate() const;
 };
@@ -52,8 +55,9 @@ struct EmoteUpdateDispatch {
     QString oldEmoteName;
     QString emoteName;
 
-    EmoteUpdateDispatch(const Dispatch &dispatch, QJsonObject oldValue,
-                        QJsonObject value);
+    EmoteUpdateDispatch(const Dispatch &dispatch,
+                        const rapidjson::Value &oldValue,
+                        const rapidjson::Value &value);
 
     bool validate() const;
 };
@@ -66,7 +70,7 @@ struct UserConnectionUpdateDispatch {
     size_t connectionIndex;
 
     UserConnectionUpdateDispatch(const Dispatch &dispatch,
-                                 const QJsonObject &update,
+                                 const rapidjson::Value &update,
                                  size_t connectionIndex);
 
     bool validate() const;
@@ -4,24 +4,26 @@
 
 #include "providers/seventv/eventapi/Message.hpp"
 
+#include "providers/liveupdates/JsonMessage.hpp"
+
 namespace chatterino::seventv::eventapi {
 
-Message::Message(QJsonObject _json)
-    : data(_json["d"].toObject())
-    , op(Opcode(_json["op"].toInt()))
+using namespace liveupdates;
+
+Message::Message(const rapidjson::Value &json)
+    : data(jsonMember(json, "d"))
+    , op(Opcode(jsonInt(jsonMember(json, "op"))))
 {
 }
 
-std::optional<Message> parseBaseMessage(const QByteArray &blob)
+std::optional<Message> parseBaseMessage(const liveupdates::JsonMessage &json)
 {
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(blob));
-
-    if (jsonDoc.isNull())
+    if (!json.isValid())
     {
         return std::nullopt;
     }
 
-    return Message(jsonDoc.object());
+    return Message(json.root());
 }
 
 }  // namespace chatterino::seventv::eventapi
@@ -6,32 +6,34 @@
 
 #include "providers/seventv/eventapi/Subscription.hpp"
 
-#include <magic_enum/magic_enum.hpp>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QString>
+#include <rapidjson/document.h>
 
 #include <optional>
 
+namespace chatterino::liveupdates {
+class JsonMessage;
+}  // namespace chatterino::liveupdates
+
 namespace chatterino::seventv::eventapi {
 
 struct Message {
-    QJsonObject data;
+    /// The data of the message, valid while the parsed message is alive
+    const rapidjson::Value &data;
 
     Opcode op;
 
-    Message(QJsonObject _json);
+    Message(const rapidjson::Value &json);
 
     template <class InnerClass>
-    std::optional<InnerClass> toInner();
+    std::optional<InnerClass> toInner() const;
 };
 
 template <class InnerClass>
-std::optional<InnerClass> Message::toInner()
+std::optional<InnerClass> Message::toInner() const
 {
     return InnerClass{this->data};
 }
 
-std::optional<Message> parseBaseMessage(const QByteArray &blob);
+std::optional<Message> parseBaseMessage(const liveupdates::JsonMessage &json);
 
 }  // namespace chatterino::seventv::eventapi
@@ -19,6 +19,7 @@
 #include "messages/MessageElement.hpp"
 #include "messages/MessageSink.hpp"
 #include "messages/MessageThread.hpp"
+#include "providers/twitch/IrcMessagePipeline.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchAccountManager.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
@@ -192,6 +193,81 @@ struct ReplyContext {
     MessagePtr parent;
 };
 
+QString parseRewardID(const QVariantMap &tags)
+{
+    if (const auto it = tags.find("custom-reward-id"); it != tags.end())
+    {
+        return it.value().toString();
+    }
+    if (const auto typeIt = tags.find("msg-id"); typeIt != tags.end())
+    {
+        // slight hack to treat bits power-ups as channel point redemptions
+        const auto msgId = typeIt.value().toString();
+        if (msgId == "animated-message" || msgId == "gigantified-emote-message")
+        {
+            return msgId;
+        }
+    }
+    return {};
+}
+
+/// Updates the state of the current user in `channel` if they sent `message`
+void updateOwnChannelState(Communi::IrcPrivateMessage *message,
+                           TwitchChannel *channel)
+{
+    auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
+    if (message->tag("user-id") != currentUser->getUserId())
+    {
+        return;
+    }
+
+    auto badgesTag = message->tag("badges");
+    if (badgesTag.isValid())
+    {
+        auto parsedBadges = parseBadges(badgesTag.toString());
+        channel->setMod(parsedBadges.contains("moderator") ||
+                        parsedBadges.contains("lead_moderator"));
+        channel->setVIP(parsedBadges.contains("vip"));
+        channel->setStaff(parsedBadges.contains("staff"));
+    }
+
+    if (!channel->isLoadingRecentMessages())
+    {
+        // Clear the send wait timer when we are able to send a message
+        channel->setSendWait(0);
+
+        // Update send wait timer with slow mode timeout if this user is not a mod or vip.
+        if (!channel->hasHighRateLimit())
+        {
+            auto roomModes = *channel->accessRoomModes();
+            if (roomModes.slowMode > 0)
+            {
+                channel->setSendWait(roomModes.slowMode);
+            }
+        }
+    }
+}
+
+/// Returns true if building the message needs state that can only be
+/// accessed from the GUI thread (see MessageBuilder::makeIrcMessage)
+bool needsGuiThread(const QVariantMap &tags, const TwitchChannel &channel)
+{
+    // The thread and parent are looked up in the channel
+    if (tags.contains("reply-thread-parent-msg-id"))
+    {
+        return true;
+    }
+
+    // The source channel and user are looked up for shared chat messages
+    if (const auto it = tags.find("source-room-id");
+        it != tags.end() && it.value().toString() != channel.roomId())
+    {
+        return true;
+    }
+
+    return channel.roomId().isEmpty();
+}
+
 std::optional<ClearChatMessage> parseClearChatMessage(
     Communi::IrcMessage *message)
 {
@@ -392,39 +468,111 @@ void IrcMessageHandler::handlePrivMessage(Communi::IrcPrivateMessage *message,
     parsePrivMessageInto(message, *twitchChannel, twitchChannel);
 }
 
-void IrcMessageHandler::parsePrivMessageInto(
-    Communi::IrcPrivateMessage *message, MessageSink &sink,
-    TwitchChannel *channel)
+void IrcMessageHandler::enqueuePrivMessage(Communi::IrcPrivateMessage *message,
+                                           ITwitchIrcServer &twitchServer,
+                                           IrcMessagePipeline &pipeline)
 {
-    auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
-    if (message->tag("user-id") == currentUser->getUserId())
+    auto chan = channelOrEmptyByTarget(message->target(), twitchServer);
+    if (chan->isEmpty())
     {
-        auto badgesTag = message->tag("badges");
-        if (badgesTag.isValid())
+        return;
+    }
+
+    auto twitchChannel = std::dynamic_pointer_cast<TwitchChannel>(chan);
+    if (!twitchChannel)
+    {
+        return;
+    }
+
+    const auto &key = message->target();
+    const auto &tags = message->tags();
+
+    if (needsGuiThread(tags, *twitchChannel))
+    {
+        if (!pipeline.isPending(key))
         {
-            auto parsedBadges = parseBadges(badgesTag.toString());
-            channel->setMod(parsedBadges.contains("moderator") ||
-                            parsedBadges.contains("lead_moderator"));
-            channel->setVIP(parsedBadges.contains("vip"));
-            channel->setStaff(parsedBadges.contains("staff"));
+            this->handlePrivMessage(message, twitchServer);
+            return;
         }
 
-        if (!channel->isLoadingRecentMessages())
-        {
-            // Clear the send wait timer when we are able to send a message
-            channel->setSendWait(0);
+        // Communi deletes the message once it's been handled, so we need a
+        // copy to handle it once the earlier messages are added
+        std::shared_ptr<Communi::IrcPrivateMessage> copy(
+            static_cast<Communi::IrcPrivateMessage *>(message->clone()));
+        pipeline.post(key, [this, copy, &twitchServer] {
+            this->handlePrivMessage(copy.get(), twitchServer);
+        });
+        return;
+    }
 
-            // Update send wait timer with slow mode timeout if this user is not a mod or vip.
-            if (!channel->hasHighRateLimit())
+    // Everything that changes the channel happens here, in the order the
+    // messages were received
+    updateOwnChannelState(message, twitchChannel.get());
+
+    MessageParseArgs args;
+    args.isStaffOrBroadcaster = twitchChannel->isBroadcaster();
+    args.isAction = message->isAction();
+    args.allowIgnore = true;
+    args.channelPointRewardId = parseRewardID(tags);
+    if (!args.channelPointRewardId.isEmpty() &&
+        !twitchChannel->isChannelPointRewardKnown(args.channelPointRewardId))
+    {
+        // Need to wait for pubsub reward notification
+        qCDebug(chatterinoTwitch) << "TwitchChannel reward added ADD "
+                                     "callback since reward is not known:"
+                                  << args.channelPointRewardId;
+        twitchChannel->addQueuedRedemption(
+            args.channelPointRewardId,
+            unescapeZeroWidthJoiner(message->content()), message);
+    }
+
+    auto *channel = twitchChannel.get();
+    pipeline.submit(
+        key,
+        [data = message->toData(), channel, args,
+         &twitchServer]() -> IrcMessagePipeline::Commit {
+            std::unique_ptr<Communi::IrcMessage> parsed(
+                Communi::IrcMessage::fromData(data, nullptr));
+            auto *privMsg =
+                dynamic_cast<Communi::IrcPrivateMessage *>(parsed.get());
+            if (!privMsg)
             {
-                auto roomModes = *channel->accessRoomModes();
-                if (roomModes.slowMode > 0)
+                return {};
+            }
+
+            auto content = unescapeZeroWidthJoiner(privMsg->content());
+            auto messageOffset =
+                stripLeadingReplyMention(privMsg->tags(), content);
+            auto [msg, alert] = MessageBuilder::makeIrcMessage(
+                channel, privMsg, args, content, messageOffset);
+
+            MessagePtr hypeChat;
+            if (privMsg->tags().contains(u"pinned-chat-paid-amount"_s))
+            {
+                hypeChat = MessageBuilder::buildHypeChatMessage(privMsg);
+            }
+
+            return [channel, msg, alert, hypeChat, &twitchServer] {
+                if (msg)
                 {
-                    channel->setSendWait(roomModes.slowMode);
+                    MessageBuilder::resolveLinks(*msg);
+                    IrcMessageHandler::commitMessage(msg, alert, *channel,
+                                                     channel, twitchServer);
                 }
-            }
-        }
-    }
+                if (hypeChat)
+                {
+                    channel->addMessage(hypeChat, MessageContext::Original);
+                }
+            };
+        },
+        std::move(twitchChannel));
+}
+
+void IrcMessageHandler::parsePrivMessageInto(
+    Communi::IrcPrivateMessage *message, MessageSink &sink,
+    TwitchChannel *channel)
+{
+    updateOwnChannelState(message, channel);
 
     IrcMessageHandler::addMessage(
         message, sink, channel, unescapeZeroWidthJoiner(message->content()),
@@ -1187,20 +1335,7 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
     args.isAction = isAction;
 
     const auto &tags = message->tags();
-    QString rewardId;
-    if (const auto it = tags.find("custom-reward-id"); it != tags.end())
-    {
-        rewardId = it.value().toString();
-    }
-    else if (const auto typeIt = tags.find("msg-id"); typeIt != tags.end())
-    {
-        // slight hack to treat bits power-ups as channel point redemptions
-        const auto msgId = typeIt.value().toString();
-        if (msgId == "animated-message" || msgId == "gigantified-emote-message")
-        {
-            rewardId = msgId;
-        }
-    }
+    QString rewardId = parseRewardID(tags);
     if (!rewardId.isEmpty() &&
         sink.sinkTraits().has(
             MessageSinkTrait::RequiresKnownChannelPointReward) &&
@@ -1310,28 +1445,35 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
             }
         }
 
-        sink.applySimilarityFilters(msg);
+        IrcMessageHandler::commitMessage(msg, alert, sink, chan, twitch);
+    }
+}
 
-        if (!msg->flags.has(MessageFlag::Similar) ||
-            (!getSettings()->hideSimilar &&
-             getSettings()->shownSimilarTriggerHighlights))
-        {
-            MessageBuilder::triggerHighlights(chan, alert);
-        }
+void IrcMessageHandler::commitMessage(const MessagePtrMut &msg,
+                                      const HighlightAlert &alert,
+                                      MessageSink &sink, TwitchChannel *chan,
+                                      ITwitchIrcServer &twitch)
+{
+    sink.applySimilarityFilters(msg);
 
-        const auto highlighted = msg->flags.has(MessageFlag::Highlighted);
-        const auto showInMentions = msg->flags.has(MessageFlag::ShowInMentions);
+    if (!msg->flags.has(MessageFlag::Similar) ||
+        (!getSettings()->hideSimilar &&
+         getSettings()->shownSimilarTriggerHighlights))
+    {
+        MessageBuilder::triggerHighlights(chan, alert);
+    }
 
-        if (highlighted && showInMentions &&
-            sink.sinkTraits().has(MessageSinkTrait::AddMentionsToGlobalChannel))
-        {
-            twitch.getMentionsChannel()->addMessage(msg,
-                                                    MessageContext::Original);
-        }
+    const auto highlighted = msg->flags.has(MessageFlag::Highlighted);
+    const auto showInMentions = msg->flags.has(MessageFlag::ShowInMentions);
 
-        sink.addMessage(msg, MessageContext::Original);
-        chan->addRecentChatter(msg->displayName);
+    if (highlighted && showInMentions &&
+        sink.sinkTraits().has(MessageSinkTrait::AddMentionsToGlobalChannel))
+    {
+        twitch.getMentionsChannel()->addMessage(msg, MessageContext::Original);
     }
+
+    sink.addMessage(msg, MessageContext::Original);
+    chan->addRecentChatter(msg->displayName);
 }
 
 }  // namespace chatterino
@@ -16,6 +16,9 @@ class Channel;
 using ChannelPtr = std::shared_ptr<Channel>;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
+using MessagePtrMut = std::shared_ptr<Message>;
+struct HighlightAlert;
+class IrcMessagePipeline;
 class TwitchChannel;
 class TwitchMessageBuilder;
 class MessageSink;
@@ -42,6 +45,13 @@ public:
 
     void handlePrivMessage(Communi::IrcPrivateMessage *message,
                            ITwitchIrcServer &twitchServer);
+    /// Like handlePrivMessage, but the message is built on a worker thread
+    /// of `pipeline` and added to its channel once it's done. Messages that
+    /// can't be built outside the GUI thread (e.g. replies) are handled on
+    /// the GUI thread, but still in order.
+    void enqueuePrivMessage(Communi::IrcPrivateMessage *message,
+                            ITwitchIrcServer &twitchServer,
+                            IrcMessagePipeline &pipeline);
     static void parsePrivMessageInto(Communi::IrcPrivateMessage *message,
                                      MessageSink &sink, TwitchChannel *channel);
 
@@ -68,6 +78,11 @@ public:
                            const QString &msgType = "");
 
 private:
+    /// Adds a built message to `sink` and triggers its highlights
+    static void commitMessage(const MessagePtrMut &msg,
+                              const HighlightAlert &alert, MessageSink &sink,
+                              TwitchChannel *chan, ITwitchIrcServer &twitch);
+
     static float similarity(const MessagePtr &msg,
                             const std::vector<MessagePtr> &messages);
     static void setSimilarityFlags(const MessagePtr &message,
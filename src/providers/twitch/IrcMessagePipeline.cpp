@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/twitch/IrcMessagePipeline.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+namespace chatterino {
+
+IrcMessagePipeline::IrcMessagePipeline()
+    : state_(std::make_shared<State>())
+{
+    // Leave some cores for the GUI thread and image decoding
+    this->pool_.setMaxThreadCount(
+        std::clamp(QThread::idealThreadCount() / 2, 1, 4));
+}
+
+IrcMessagePipeline::~IrcMessagePipeline()
+{
+    this->pool_.clear();
+    this->pool_.waitForDone();
+}
+
+void IrcMessagePipeline::submit(const QString &key, Build build,
+                                std::shared_ptr<void> context)
+{
+    assertInGuiThread();
+
+    auto job = std::make_shared<Job>();
+    job->context = std::move(context);
+    {
+        std::lock_guard lock(this->state_->mutex);
+        this->state_->queues[key].push_back(job);
+    }
+
+    this->pool_.start([this, job = std::move(job), build = std::move(build)] {
+        auto commit = build();
+
+        std::lock_guard lock(this->state_->mutex);
+        job->commit = std::move(commit);
+        job->built = true;
+        this->postDrain();
+    });
+}
+
+void IrcMessagePipeline::post(const QString &key, Commit commit)
+{
+    assertInGuiThread();
+
+    {
+        std::lock_guard lock(this->state_->mutex);
+        auto it = this->state_->queues.find(key);
+        if (it != this->state_->queues.end())
+        {
+            it->second.push_back(std::make_shared<Job>(Job{
+                .commit = std::move(commit),
+                .context = {},
+                .built = true,
+            }));
+            // The queue might only be waiting for a drain to remove it
+            this->postDrain();
+            return;
+        }
+    }
+
+    commit();
+}
+
+bool IrcMessagePipeline::isPending(const QString &key) const
+{
+    std::lock_guard lock(this->state_->mutex);
+    return this->state_->queues.contains(key);
+}
+
+void IrcMessagePipeline::postDrain()
+{
+    if (this->state_->drainPosted)
+    {
+        return;
+    }
+    this->state_->drainPosted = true;
+
+    postToThread([weakState = std::weak_ptr(this->state_)] {
+        if (auto state = weakState.lock())
+        {
+            IrcMessagePipeline::drain(*state);
+        }
+    });
+}
+
+void IrcMessagePipeline::drain(State &state)
+{
+    assertInGuiThread();
+
+    std::vector<std::shared_ptr<Job>> ready;
+    {
+        std::lock_guard lock(state.mutex);
+        state.drainPosted = false;
+
+        for (auto &[key, queue] : state.queues)
+        {
+            while (!queue.empty() && queue.front()->built)
+            {
+                ready.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+    }
+
+    // Empty queues are kept until their jobs are committed, so jobs posted
+    // by a commit are queued behind the remaining ones
+    for (const auto &job : ready)
+    {
+        if (job->commit)
+        {
+            job->commit();
+        }
+    }
+
+    std::lock_guard lock(state.mutex);
+    std::erase_if(state.queues, [](const auto &entry) {
+        return entry.second.empty();
+    });
+}
+
+}  // namespace chatterino
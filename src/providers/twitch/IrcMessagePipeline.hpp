@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+#include <QThreadPool>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+/// @brief Builds messages on a worker pool and commits them on the GUI thread.
+///
+/// Jobs are grouped by a key (the IRC channel). Jobs with the same key are
+/// committed in the order they were submitted, even if a later job finished
+/// building first. Jobs with different keys don't wait for each other.
+///
+/// Finished jobs are handed to the GUI thread in batches, so a burst of
+/// messages doesn't post an event per message.
+///
+/// submit(), post(), and isPending() must be called from the GUI thread.
+class IrcMessagePipeline
+{
+public:
+    /// Runs on the GUI thread
+    using Commit = std::function<void()>;
+    /// Runs on a worker thread and returns what to do on the GUI thread.
+    /// May return an empty function if there's nothing to commit.
+    using Build = std::function<Commit()>;
+
+    IrcMessagePipeline();
+    /// Waits for running builds. Jobs that weren't committed yet are dropped.
+    ~IrcMessagePipeline();
+
+    IrcMessagePipeline(const IrcMessagePipeline &) = delete;
+    IrcMessagePipeline &operator=(const IrcMessagePipeline &) = delete;
+    IrcMessagePipeline(IrcMessagePipeline &&) = delete;
+    IrcMessagePipeline &operator=(IrcMessagePipeline &&) = delete;
+
+    /// Runs `build` on a worker thread. Its result is committed after all
+    /// earlier jobs of `key`.
+    ///
+    /// @param context Kept alive until the job is committed and released on
+    ///                the GUI thread (e.g. the channel the job refers to).
+    void submit(const QString &key, Build build,
+                std::shared_ptr<void> context = {});
+
+    /// Runs `commit` after all earlier jobs of `key`. If there are none, it's
+    /// run right away.
+    void post(const QString &key, Commit commit);
+
+    /// Returns true if there are jobs of `key` that weren't committed yet
+    bool isPending(const QString &key) const;
+
+private:
+    struct Job {
+        Commit commit;
+        std::shared_ptr<void> context;
+        bool built = false;
+    };
+
+    struct State {
+        std::mutex mutex;
+        std::unordered_map<QString, std::deque<std::shared_ptr<Job>>> queues;
+        bool drainPosted = false;
+    };
+
+    /// Posts a drain() to the GUI thread unless one is already pending.
+    /// `state.mutex` must be held.
+    void postDrain();
+
+    /// Commits the finished jobs at the front of each queue
+    static void drain(State &state);
+
+    std::shared_ptr<State> state_;
+    QThreadPool pool_;
+};
+
+}  // namespace chatterino
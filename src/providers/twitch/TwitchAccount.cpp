@@ -113,15 +113,19 @@ void TwitchAccount::loadBlocks()
 
     auto token = CancellationToken(false);
     this->blockToken_ = token;
-    this->ignores_.clear();
-    this->ignoresUserIds_.clear();
-    this->ignoresUserLogins_.clear();
+    {
+        std::unique_lock lock(this->blocksMutex_);
+        this->ignores_.clear();
+        this->ignoresUserIds_.clear();
+        this->ignoresUserLogins_.clear();
+    }
 
     getHelix()->loadBlocks(
         getApp()->getAccounts()->twitch.getCurrent()->userId_,
         [this](const std::vector<HelixBlock> &blocks) {
             assertInGuiThread();
 
+            std::unique_lock lock(this->blocksMutex_);
             for (const HelixBlock &block : blocks)
             {
                 TwitchUser blockedUser;
@@ -151,9 +155,12 @@ void TwitchAccount::blockUser(const QString &userId, const QString &userLogin,
             TwitchUser blockedUser;
             blockedUser.id = userId;
             blockedUser.name = userLogin;
-            this->ignores_.insert(blockedUser);
-            this->ignoresUserIds_.insert(blockedUser.id);
-            this->ignoresUserLogins_.insert(blockedUser.name);
+            {
+                std::unique_lock lock(this->blocksMutex_);
+                this->ignores_.insert(blockedUser);
+                this->ignoresUserIds_.insert(blockedUser.id);
+                this->ignoresUserLogins_.insert(blockedUser.name);
+            }
             onSuccess();
         },
         std::move(onFailure));
@@ -172,9 +179,12 @@ void TwitchAccount::unblockUser(const QString &userId, const QString &userLogin,
             TwitchUser ignoredUser;
             ignoredUser.id = userId;
             ignoredUser.name = userLogin;
-            this->ignores_.erase(ignoredUser);
-            this->ignoresUserIds_.erase(ignoredUser.id);
-            this->ignoresUserLogins_.erase(ignoredUser.name);
+            {
+                std::unique_lock lock(this->blocksMutex_);
+                this->ignores_.erase(ignoredUser);
+                this->ignoresUserIds_.erase(ignoredUser.id);
+                this->ignoresUserLogins_.erase(ignoredUser.name);
+            }
             onSuccess();
         },
         std::move(onFailure));
@@ -189,6 +199,8 @@ void TwitchAccount::blockUserLocally(const QString &userID,
     TwitchUser blockedUser;
     blockedUser.id = userID;
     blockedUser.name = userLogin;
+
+    std::unique_lock lock(this->blocksMutex_);
     this->ignores_.insert(blockedUser);
     this->ignoresUserIds_.insert(blockedUser.id);
     this->ignoresUserLogins_.insert(blockedUser.name);
@@ -222,6 +234,18 @@ const std::unordered_set<QString> &TwitchAccount::blockedUserLogins() const
     return this->ignoresUserLogins_;
 }
 
+bool TwitchAccount::isBlockedUserId(const QString &userID) const
+{
+    std::shared_lock lock(this->blocksMutex_);
+    return this->ignoresUserIds_.contains(userID);
+}
+
+bool TwitchAccount::isBlockedUserLogin(const QString &userLogin) const
+{
+    std::shared_lock lock(this->blocksMutex_);
+    return this->ignoresUserLogins_.contains(userLogin);
+}
+
 // AutoModActions
 void TwitchAccount::autoModAllow(const QString &msgID, ChannelPtr channel) const
 {
@@ -23,6 +23,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <shared_mutex>
 #include <unordered_set>
 
 namespace chatterino {
@@ -85,6 +86,11 @@ public:
     [[nodiscard]] const std::unordered_set<QString> &blockedUserIds() const;
     [[nodiscard]] const std::unordered_set<QString> &blockedUserLogins() const;
 
+    /// Returns true if the user is blocked. Unlike blockedUserIds() and
+    /// blockedUserLogins(), these can be called from any thread.
+    [[nodiscard]] bool isBlockedUserId(const QString &userID) const;
+    [[nodiscard]] bool isBlockedUserLogin(const QString &userLogin) const;
+
     // Automod actions
     void autoModAllow(const QString &msgID, ChannelPtr channel) const;
     void autoModDeny(const QString &msgID, ChannelPtr channel) const;
@@ -127,6 +133,8 @@ private:
     QStringList userstateEmoteSets_;
 
     ScopedCancellationToken blockToken_;
+    /// Guards the blocked users. They're only written from the GUI thread.
+    mutable std::shared_mutex blocksMutex_;
     std::unordered_set<TwitchUser> ignores_;
     std::unordered_set<QString> ignoresUserIds_;
     std::unordered_set<QString> ignoresUserLogins_;
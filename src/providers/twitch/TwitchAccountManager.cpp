@@ -249,6 +249,8 @@ TwitchAccountManager::TwitchAccountManager()
 
 std::shared_ptr<TwitchAccount> TwitchAccountManager::getCurrent()
 {
+    std::lock_guard<std::mutex> lock(this->currentUserMutex_);
+
     if (!this->currentUser_)
     {
         return this->anonymousUser_;
@@ -381,11 +383,13 @@ void TwitchAccountManager::load()
             qCDebug(chatterinoTwitch)
                 << "Twitch user updated to" << newUsername;
             getHelix()->update(user->getOAuthClient(), user->getOAuthToken());
+            std::lock_guard<std::mutex> lock(this->currentUserMutex_);
             this->currentUser_ = user;
         }
         else
         {
             qCDebug(chatterinoTwitch) << "Twitch user updated to anonymous";
+            std::lock_guard<std::mutex> lock(this->currentUserMutex_);
             this->currentUser_ = this->anonymousUser_;
         }
 
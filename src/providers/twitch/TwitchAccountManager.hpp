@@ -43,7 +43,7 @@ public:
     };
 
     // Returns the current twitchUsers, or the anonymous user if we're not
-    // currently logged in
+    // currently logged in. Can be called from any thread.
     std::shared_ptr<TwitchAccount> getCurrent();
 
     std::vector<QString> getUsernames() const;
@@ -87,7 +87,10 @@ private:
     AddUserResponse addUser(const UserData &data);
     bool removeUser(TwitchAccount *account);
 
+    /// Only written from the GUI thread, read from any thread through
+    /// getCurrent()
     std::shared_ptr<TwitchAccount> currentUser_;
+    mutable std::mutex currentUserMutex_;
 
     std::shared_ptr<TwitchAccount> anonymousUser_;
     mutable std::mutex mutex_;
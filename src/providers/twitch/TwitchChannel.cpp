@@ -432,8 +432,7 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
         [this, weak = weakOf<Channel>(this)](auto &&channelBadges) {
             if (auto shared = weak.lock())
             {
-                this->tgFfzChannelBadges_.guard();
-                this->ffzChannelBadges_ =
+                *this->ffzChannelBadges_.access() =
                     std::forward<decltype(channelBadges)>(channelBadges);
             }
         },
@@ -1077,6 +1076,39 @@ std::optional<EmotePtr> TwitchChannel::seventvEmote(const EmoteName &name) const
     return it->second;
 }
 
+EmotePtr TwitchChannel::thirdPartyEmote(QStringView name) const
+{
+    auto *app = getApp();
+    const auto *ffzGlobal = app->getFfzEmotes();
+    const auto *bttvGlobal = app->getBttvEmotes();
+    const auto *seventvGlobal = app->getSeventvEmotes();
+
+    // The versions are read before the maps. If a map changes in between,
+    // the next lookup sees a new version and updates the index again.
+    EmoteIndex::Versions versions{
+        this->ffzEmotes_.version(),
+        this->bttvEmotes_.version(),
+        this->seventvEmotes_.version(),
+        ffzGlobal->emotesVersion(),
+        bttvGlobal->emotesVersion(),
+        seventvGlobal->globalEmotesVersion(),
+    };
+    if (this->emoteIndex_.isOutdated(versions))
+    {
+        EmoteIndex::Maps maps{
+            this->ffzEmotes_.get(),
+            this->bttvEmotes_.get(),
+            this->seventvEmotes_.get(),
+            ffzGlobal->emotes(),
+            bttvGlobal->emotes(),
+            seventvGlobal->globalEmotes(),
+        };
+        this->emoteIndex_.update(versions, maps);
+    }
+
+    return this->emoteIndex_.find(name);
+}
+
 std::shared_ptr<const EmoteMap> TwitchChannel::localTwitchEmotes() const
 {
     return this->localTwitchEmotes_.get();
@@ -2197,10 +2229,10 @@ std::optional<EmotePtr> TwitchChannel::twitchBadge(const QString &set,
 std::vector<FfzBadges::Badge> TwitchChannel::ffzChannelBadges(
     const QString &userID) const
 {
-    this->tgFfzChannelBadges_.guard();
+    auto channelBadges = this->ffzChannelBadges_.accessConst();
 
-    auto it = this->ffzChannelBadges_.find(userID);
-    if (it == this->ffzChannelBadges_.end())
+    auto it = channelBadges->find(userID);
+    if (it == channelBadges->end())
     {
         return {};
     }
@@ -2223,8 +2255,7 @@ std::vector<FfzBadges::Badge> TwitchChannel::ffzChannelBadges(
 
 void TwitchChannel::setFfzChannelBadges(FfzChannelBadgeMap map)
 {
-    this->tgFfzChannelBadges_.guard();
-    this->ffzChannelBadges_ = std::move(map);
+    *this->ffzChannelBadges_.access() = std::move(map);
 }
 
 std::optional<EmotePtr> TwitchChannel::ffzCustomModBadge() const
@@ -10,12 +10,12 @@
 #include "common/ChannelChatters.hpp"
 #include "common/Common.hpp"
 #include "common/UniqueAccess.hpp"
+#include "messages/EmoteIndex.hpp"
 #include "providers/ffz/FfzBadges.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/twitch/eventsub/SubscriptionHandle.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "util/QStringHash.hpp"
-#include "util/ThreadGuard.hpp"
 
 #include <boost/circular_buffer/space_optimized.hpp>
 #include <boost/signals2.hpp>
@@ -221,6 +221,17 @@ public:
     std::optional<EmotePtr> ffzEmote(const EmoteName &name) const;
     std::optional<EmotePtr> seventvEmote(const EmoteName &name) const;
 
+    /**
+     * Finds a FrankerFaceZ, BetterTTV or 7TV emote that can be used in this
+     * channel. Channel emotes take precedence over global emotes.
+     *
+     * Order: FFZ channel, BTTV channel, 7TV channel, FFZ global,
+     * BTTV global, 7TV global
+     *
+     * @returns nullptr if there's no emote with this name
+     */
+    EmotePtr thirdPartyEmote(QStringView name) const;
+
     std::shared_ptr<const EmoteMap> localTwitchEmotes() const;
     std::shared_ptr<const EmoteMap> bttvEmotes() const;
     std::shared_ptr<const EmoteMap> ffzEmotes() const;
@@ -510,11 +521,12 @@ protected:
     Atomic<std::shared_ptr<const EmoteMap>> bttvEmotes_;
     Atomic<std::shared_ptr<const EmoteMap>> ffzEmotes_;
     Atomic<std::shared_ptr<const EmoteMap>> seventvEmotes_;
+    /// All third party emotes (see thirdPartyEmote), updated on lookup
+    mutable EmoteIndex emoteIndex_;
     Atomic<std::optional<EmotePtr>> ffzCustomModBadge_;
     Atomic<std::optional<EmotePtr>> ffzCustomVipBadge_;
 
-    FfzChannelBadgeMap ffzChannelBadges_;
-    ThreadGuard tgFfzChannelBadges_;
+    UniqueAccess<FfzChannelBadgeMap> ffzChannelBadges_;
 
 private:
     // Badges
@@ -525,9 +537,10 @@ private:
     boost::circular_buffer_space_optimized<QueuedRedemption>
         waitingRedemptions_{MAX_QUEUED_REDEMPTIONS};
 
-    bool mod_ = false;
-    bool vip_ = false;
-    bool staff_ = false;
+    // Read when building messages, which can happen outside the GUI thread
+    std::atomic<bool> mod_ = false;
+    std::atomic<bool> vip_ = false;
+    std::atomic<bool> staff_ = false;
     UniqueAccess<QString> roomID_;
 
     // --
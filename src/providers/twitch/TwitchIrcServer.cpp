@@ -346,6 +346,14 @@ std::shared_ptr<Channel> TwitchIrcServer::createChannel(
 void TwitchIrcServer::privateMessageReceived(
     Communi::IrcPrivateMessage *message)
 {
+    if (getSettings()->buildMessagesInBackground ||
+        this->messagePipeline_.isPending(message->target()))
+    {
+        IrcMessageHandler::instance().enqueuePrivMessage(
+            message, *this, this->messagePipeline_);
+        return;
+    }
+
     IrcMessageHandler::instance().handlePrivMessage(message, *this);
 }
 
@@ -358,6 +366,26 @@ void TwitchIrcServer::readConnectionMessageReceived(
         return;
     }
 
+    // Messages to a channel (e.g. CLEARMSG) must not overtake the messages
+    // that are still being built for it
+    if (!message->parameters().isEmpty())
+    {
+        auto target = message->parameter(0);
+        if (this->messagePipeline_.isPending(target))
+        {
+            std::shared_ptr<Communi::IrcMessage> copy(message->clone());
+            this->messagePipeline_.post(target, [this, copy] {
+                this->handleReadConnectionMessage(copy.get());
+            });
+            return;
+        }
+    }
+
+    this->handleReadConnectionMessage(message);
+}
+
+void TwitchIrcServer::handleReadConnectionMessage(Communi::IrcMessage *message)
+{
     const QString &command = message->command();
 
     auto &handler = IrcMessageHandler::instance();
@@ -74,8 +74,9 @@ void Connection::onNotification(const lib::messages::Metadata &metadata,
                                 const boost::json::value &jv)
 {
     (void)metadata;
-    auto jsonString = boost::json::serialize(jv);
-    qCDebug(LOG) << "on notification: " << jsonString.c_str();
+    // only serialize the notification if it's actually logged
+    qCDebug(LOG) << "on notification: "
+                 << boost::json::serialize(jv).c_str();
 }
 
 void Connection::onClose(std::unique_ptr<lib::Listener> self,
@@ -182,6 +182,65 @@ QString fontFamily(FontStyle style)
 
 namespace chatterino {
 
+TextMeasure::TextMeasure(const QFontMetricsF &metrics)
+    : metrics_(metrics)
+{
+    this->ascii_.fill(-1);
+}
+
+qreal TextMeasure::horizontalAdvance(const QString &text)
+{
+    if (text.size() == 1 && text[0].unicode() < this->ascii_.size())
+    {
+        return this->horizontalAdvance(text[0]);
+    }
+    if (text.size() > MAX_CACHED_TEXT_LENGTH)
+    {
+        return this->metrics_.horizontalAdvance(text);
+    }
+
+    auto it = this->words_.find(text);
+    if (it != this->words_.end())
+    {
+        return it->second;
+    }
+
+    qreal advance{};
+    auto prev = this->previousWords_.find(text);
+    if (prev != this->previousWords_.end())
+    {
+        advance = prev->second;
+    }
+    else
+    {
+        advance = this->metrics_.horizontalAdvance(text);
+    }
+
+    if (this->words_.size() >= MAX_CACHED_TEXTS)
+    {
+        this->previousWords_ = std::move(this->words_);
+        this->words_.clear();
+    }
+    // Copy the characters, `text` might be a QString::fromRawData
+    this->words_.emplace(QString(text.constData(), text.size()), advance);
+    return advance;
+}
+
+qreal TextMeasure::horizontalAdvance(QChar c)
+{
+    if (c.unicode() >= this->ascii_.size())
+    {
+        return this->metrics_.horizontalAdvance(c);
+    }
+
+    auto &advance = this->ascii_[c.unicode()];
+    if (advance < 0)
+    {
+        advance = this->metrics_.horizontalAdvance(c);
+    }
+    return advance;
+}
+
 Fonts::Fonts(Settings &settings)
 {
     this->fontsByType_.resize(size_t(FontStyle::EndType));
@@ -211,6 +270,11 @@ QFontMetricsF Fonts::getFontMetrics(FontStyle type, float scale)
     return this->getOrCreateFontData(type, scale).metrics;
 }
 
+TextMeasure &Fonts::getTextMeasure(FontStyle type, float scale)
+{
+    return this->getOrCreateFontData(type, scale).measure;
+}
+
 Fonts::FontData &Fonts::getOrCreateFontData(FontStyle type, float scale)
 {
     assertInGuiThread();
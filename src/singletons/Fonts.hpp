@@ -9,7 +9,12 @@
 #include <pajlada/signals/signal.hpp>
 #include <QFont>
 #include <QFontMetrics>
+#include <QHashFunctions>
+#include <QString>
+#include <QStringView>
 
+#include <array>
+#include <functional>
 #include <unordered_map>
 #include <vector>
 
@@ -43,6 +48,53 @@ enum class FontStyle : uint8_t {
     ChatEnd = ChatVeryLarge,
 };
 
+/// @brief Measures text in one font and caches the results.
+///
+/// Advances of ASCII characters are kept in a table. Short texts (words) are
+/// cached in two generations: when the current one is full, it replaces the
+/// previous one, so words that weren't used recently are dropped.
+///
+/// Owned by Fonts, see Fonts::getTextMeasure.
+class TextMeasure
+{
+public:
+    /// Longer texts are rarely repeated (and would make the cache big)
+    static constexpr qsizetype MAX_CACHED_TEXT_LENGTH = 32;
+    /// Texts per generation
+    static constexpr size_t MAX_CACHED_TEXTS = 4096;
+
+    explicit TextMeasure(const QFontMetricsF &metrics);
+
+    const QFontMetricsF &metrics() const
+    {
+        return this->metrics_;
+    }
+
+    /// Same as QFontMetricsF::horizontalAdvance(text)
+    qreal horizontalAdvance(const QString &text);
+
+    /// Same as QFontMetricsF::horizontalAdvance(c)
+    qreal horizontalAdvance(QChar c);
+
+private:
+    struct TextHash {
+        using is_transparent = void;
+
+        size_t operator()(QStringView text) const noexcept
+        {
+            return qHash(text);
+        }
+    };
+    using WordMap =
+        std::unordered_map<QString, qreal, TextHash, std::equal_to<>>;
+
+    QFontMetricsF metrics_;
+    /// Negative for characters that weren't measured yet
+    std::array<qreal, 128> ascii_;
+    WordMap words_;
+    WordMap previousWords_;
+};
+
 class Fonts final
 {
 public:
@@ -53,6 +105,10 @@ public:
     QFont getFont(FontStyle type, float scale);
     QFontMetricsF getFontMetrics(FontStyle type, float scale);
 
+    /// Returns the (cached) measurements of a font. The reference is valid
+    /// until the fonts change (see #fontChanged).
+    TextMeasure &getTextMeasure(FontStyle type, float scale);
+
     pajlada::Signals::NoArgSignal fontChanged;
 
 private:
@@ -60,11 +116,13 @@ private:
         FontData(const QFont &_font)
             : font(_font)
             , metrics(_font)
+            , measure(this->metrics)
         {
         }
 
         const QFont font;
         const QFontMetricsF metrics;
+        TextMeasure measure;
     };
 
     struct ChatFontData {
@@ -4,13 +4,16 @@
 
 #include "singletons/Logging.hpp"
 
+#include "Application.hpp"
 #include "messages/Message.hpp"
 #include "singletons/helper/LoggingChannel.hpp"
+#include "singletons/helper/LoggingWriter.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 
-#include <QDir>
-#include <QStandardPaths>
+#include <QDateTime>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -33,8 +36,24 @@ Logging::Logging(Settings &settings)
                 this->onlyLogListedChannels.insert(loggedChannel.channelName());
             }
         });
+
+    this->optionsListener_.addSetting(settings.logPath);
+    this->optionsListener_.addSetting(settings.logTimestampFormat);
+    this->optionsListener_.addSetting(settings.tryUseTwitchTimestamps);
+    this->optionsListener_.addSetting(settings.separatelyStoreStreamLogs);
+    this->optionsListener_.addSetting(settings.stripReplyMention);
+    this->optionsListener_.addSetting(settings.hideReplyContext);
+    this->optionsListener_.addSetting(settings.logFlushInterval);
+    this->optionsListener_.addSetting(settings.logFlushThreshold);
+    this->optionsListener_.setCB([this, &settings] {
+        this->updateOptions(settings);
+    });
+
+    this->updateOptions(settings);
 }
 
+Logging::~Logging() = default;
+
 void Logging::addMessage(const QString &channelName, MessagePtr message,
                          const QString &platformName, const QString &streamID)
 {
@@ -58,28 +77,15 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
         }
     }
 
-    auto platIt = this->loggingChannels_.find(platformName);
-    if (platIt == this->loggingChannels_.end())
-    {
-        auto *channel = new LoggingChannel(channelName, platformName);
-        channel->addMessage(message, streamID);
-        auto map = std::map<QString, std::unique_ptr<LoggingChannel>>();
-        this->loggingChannels_[platformName] = std::move(map);
-        auto &ref = this->loggingChannels_.at(platformName);
-        ref.emplace(channelName, channel);
-        return;
-    }
-    auto chanIt = platIt->second.find(channelName);
-    if (chanIt == platIt->second.end())
-    {
-        auto *channel = new LoggingChannel(channelName, platformName);
-        channel->addMessage(message, streamID);
-        platIt->second.emplace(channelName, channel);
-    }
-    else
-    {
-        chanIt->second->addMessage(message, streamID);
-    }
+    bool isReply = message->flags.has(MessageFlag::ReplyMessage);
+    this->writer_->addMessage(
+        channelName, platformName,
+        LoggedMessage{
+            .message = std::move(message),
+            .streamID = streamID,
+            .receivedAt = QDateTime::currentMSecsSinceEpoch(),
+            .isReply = isReply,
+        });
 }
 
 void Logging::closeChannel(const QString &channelName,
@@ -90,12 +96,39 @@ void Logging::closeChannel(const QString &channelName,
         return;
     }
 
-    auto platIt = this->loggingChannels_.find(platformName);
-    if (platIt == this->loggingChannels_.end())
+    this->writer_->closeChannel(channelName, platformName);
+}
+
+void Logging::flush()
+{
+    this->writer_->flush();
+}
+
+void Logging::updateOptions(Settings &settings)
+{
+    QString logPath = settings.logPath;
+
+    LoggingOptions options{
+        .baseDirectory = logPath.isEmpty()
+                             ? getApp()->getPaths().messageLogDirectory
+                             : logPath,
+        .timestampFormat = settings.logTimestampFormat,
+        .tryUseTwitchTimestamps = settings.tryUseTwitchTimestamps,
+        .stripReplyMention = settings.stripReplyMention,
+        .hideReplyContext = settings.hideReplyContext,
+        .separatelyStoreStreamLogs = settings.separatelyStoreStreamLogs,
+        .flushInterval = std::chrono::milliseconds{
+            std::max(settings.logFlushInterval.getValue(), 0)},
+        .flushThreshold = std::max(settings.logFlushThreshold.getValue(), 0),
+    };
+
+    if (!this->writer_)
     {
+        this->writer_ = std::make_unique<LoggingWriter>(std::move(options));
         return;
     }
-    platIt->second.erase(channelName);
+
+    this->writer_->setOptions(std::move(options));
 }
 
 }  // namespace chatterino
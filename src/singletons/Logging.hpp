@@ -7,9 +7,9 @@
 #include "util/QStringHash.hpp"
 #include "util/ThreadGuard.hpp"
 
+#include <pajlada/settings/settinglistener.hpp>
 #include <QString>
 
-#include <map>
 #include <memory>
 #include <unordered_set>
 
@@ -18,7 +18,7 @@ namespace chatterino {
 class Settings;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
-class LoggingChannel;
+class LoggingWriter;
 
 class ILogging
 {
@@ -33,10 +33,20 @@ public:
                               const QString &platformName) = 0;
 };
 
+/// Writes chat logs.
+///
+/// Messages are only queued on the calling (GUI) thread. Formatting and
+/// writing happens on the LoggingWriter thread.
 class Logging : public ILogging
 {
 public:
     Logging(Settings &settings);
+    ~Logging() override;
+
+    Logging(const Logging &) = delete;
+    Logging &operator=(const Logging &) = delete;
+    Logging(Logging &&) = delete;
+    Logging &operator=(Logging &&) = delete;
 
     void addMessage(const QString &channelName, MessagePtr message,
                     const QString &platformName,
@@ -45,16 +55,20 @@ public:
     void closeChannel(const QString &channelName,
                       const QString &platformName) override;
 
+    /// Asks the writer thread to write out all buffered lines
+    void flush();
+
 private:
-    using PlatformName = QString;
+    void updateOptions(Settings &settings);
+
     using ChannelName = QString;
-    std::map<PlatformName,
-             std::map<ChannelName, std::unique_ptr<LoggingChannel>>>
-        loggingChannels_;
 
     // Keeps the value of the `loggedChannels` settings
     std::unordered_set<ChannelName> onlyLogListedChannels;
     ThreadGuard threadGuard;
+
+    std::unique_ptr<LoggingWriter> writer_;
+    pajlada::SettingListener optionsListener_;
 };
 
 }  // namespace chatterino
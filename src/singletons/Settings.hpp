@@ -5,6 +5,7 @@
 #pragma once
 
 #include "common/ChatterinoSetting.hpp"
+#include "common/enums/AnimatedFrameMode.hpp"
 #include "common/enums/MessageOverflow.hpp"
 #include "common/LastMessageLineStyle.hpp"
 #include "common/Modes.hpp"
@@ -419,6 +420,13 @@ public:
     };
 
     BoolSetting stackBits = {"/emotes/stackBits", false};
+    /// Maximum amount of decoded image frames kept in memory (in MiB).
+    /// 0 disables the limit (images are only unloaded when they're unused).
+    IntSetting imageMemoryBudget = {"/emotes/imageMemoryBudget", 0};
+    EnumSetting<AnimatedFrameMode> animatedFrameMode = {
+        "/emotes/animatedFrameMode",
+        AnimatedFrameMode::FullyResident,
+    };
     BoolSetting removeSpacesBetweenEmotes = {
         "/emotes/removeSpacesBetweenEmotes", false};
 
@@ -444,6 +452,7 @@ public:
     /// Links
     BoolSetting linksDoubleClickOnly = {"/links/doubleClickToOpen", false};
     BoolSetting linkInfoTooltip = {"/links/linkInfoTooltip", false};
+    BoolSetting linkInfoDiskCache = {"/links/linkInfoDiskCache", false};
     IntSetting thumbnailSize = {"/appearance/thumbnailSize", 0};
     IntSetting thumbnailSizeStream = {"/appearance/thumbnailSizeStream", 2};
     BoolSetting unshortLinks = {"/links/unshortLinks", false};
@@ -641,6 +650,11 @@ public:
         false,
     };
     QStringSetting logPath = {"/logging/path", ""};
+    /// How often (in milliseconds) buffered log lines are written to disk
+    IntSetting logFlushInterval = {"/logging/flushInterval", 1000};
+    /// How many bytes may be buffered per log file before they're written
+    /// to disk (0 writes every line immediately)
+    IntSetting logFlushThreshold = {"/logging/flushThreshold", 64 * 1024};
 
     QStringSetting pathHighlightSound = {"/highlighting/highlightSoundPath",
                                          ""};
@@ -814,12 +828,17 @@ public:
         ThumbnailPreviewMode::AlwaysShow,
     };
     QStringSetting cachePath = {"/cache/path", ""};
+    /// The size of the HTTP cache in MiB (0 = unlimited)
+    IntSetting cacheMaxSize = {"/cache/maxSize", 1024};
     BoolSetting attachExtensionToAnyProcess = {
         "/misc/attachExtensionToAnyProcess", false};
     BoolSetting askOnImageUpload = {"/misc/askOnImageUpload", true};
     BoolSetting informOnTabVisibilityToggle = {"/misc/askOnTabVisibilityToggle",
                                                true};
     BoolSetting lockNotebookLayout = {"/misc/lockNotebookLayout", false};
+    /// Build incoming chat messages on worker threads
+    BoolSetting buildMessagesInBackground = {
+        "/misc/buildMessagesInBackground", true};
     BoolSetting showPronouns = {"/misc/showPronouns", false};
     BoolSetting showTitleInLiveMessage = {
         "/extraChannels/live/showTitle",
@@ -4,28 +4,17 @@
 
 #include "singletons/helper/LoggingChannel.hpp"
 
-#include "Application.hpp"
 #include "common/QLogging.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageThread.hpp"
-#include "singletons/Paths.hpp"
-#include "singletons/Settings.hpp"
 
-#include <QDateTime>
 #include <QDir>
 
 namespace {
 
-const QByteArray ENDLINE("\n");
-
-void appendLine(QFile &fileHandle, const QString &line)
-{
-    assert(fileHandle.isOpen());
-    assert(fileHandle.isWritable());
+using namespace chatterino;
 
-    fileHandle.write(line.toUtf8());
-    fileHandle.flush();
-}
+const QByteArray ENDLINE("\n");
 
 QString generateOpeningString(
     const QDateTime &now = QDateTime::currentDateTime())
@@ -56,13 +45,121 @@ QString generateDateString(const QDateTime &now)
     return now.toString("yyyy-MM-dd");
 }
 
+QString formatMessage(const LoggedMessage &logged, const QDateTime &timestamp,
+                      const QString &channelName,
+                      const LoggingOptions &options)
+{
+    const auto &message = logged.message;
+
+    QString str;
+    if (channelName.startsWith("/mentions") ||
+        channelName.startsWith("/automod"))
+    {
+        str.append("#" + message->channelName + " ");
+    }
+
+    if (options.timestampFormat != "Disable")
+    {
+        str.append('[');
+        str.append(timestamp.toString(options.timestampFormat));
+        str.append("] ");
+    }
+
+    QString messageText;
+    if (message->loginName.isEmpty())
+    {
+        // This accounts for any messages not explicitly sent by a user, like
+        // system messages, parts of announcements, subs etc.
+        messageText = message->messageText;
+    }
+    else
+    {
+        if (message->localizedName.isEmpty())
+        {
+            messageText = message->loginName + ": " + message->messageText;
+        }
+        else
+        {
+            messageText = message->localizedName + " " + message->loginName +
+                          ": " + message->messageText;
+        }
+    }
+
+    if ((logged.isReply && options.stripReplyMention) &&
+        !options.hideReplyContext)
+    {
+        qsizetype colonIndex = messageText.indexOf(':');
+        if (colonIndex != -1)
+        {
+            QString rootMessageChatter;
+            if (message->replyParent)
+            {
+                rootMessageChatter = message->replyParent->loginName;
+            }
+            else
+            {
+                // we actually want to use 'reply-parent-user-login' tag here,
+                // but it's not worth storing just for this edge case
+                rootMessageChatter = message->replyThread->root()->loginName;
+            }
+            messageText.insert(colonIndex + 1, " @" + rootMessageChatter);
+        }
+    }
+    str.append(messageText);
+    str.append(ENDLINE);
+
+    return str;
+}
+
 }  // namespace
 
 namespace chatterino {
 
-LoggingChannel::LoggingChannel(QString _channelName, QString _platform)
+void LoggingChannel::LogFile::append(const QString &line,
+                                     qsizetype flushThreshold)
+{
+    if (!this->handle.isOpen())
+    {
+        return;
+    }
+
+    this->buffer.append(line.toUtf8());
+    if (this->buffer.size() >= flushThreshold)
+    {
+        this->flush();
+    }
+}
+
+void LoggingChannel::LogFile::flush()
+{
+    if (this->buffer.isEmpty() || !this->handle.isOpen())
+    {
+        return;
+    }
+
+    assert(this->handle.isWritable());
+
+    this->handle.write(this->buffer);
+    this->handle.flush();
+    // clear() would release the allocation - we want to reuse it
+    this->buffer.resize(0);
+}
+
+void LoggingChannel::LogFile::close()
+{
+    if (this->handle.isOpen())
+    {
+        this->flush();
+        this->handle.close();
+    }
+    this->buffer.resize(0);
+}
+
+LoggingChannel::LoggingChannel(QString _channelName, QString _platform,
+                               QString _baseDirectory)
     : channelName(std::move(_channelName))
     , platform(std::move(_platform))
+    , baseDirectory(std::move(_baseDirectory))
 {
     if (this->channelName.startsWith("/whispers"))
     {
@@ -91,31 +188,52 @@ LoggingChannel::LoggingChannel(QString _channelName, QString _platform)
                          this->platform.mid(1).toLower() + QDir::separator() +
                          this->subDirectory;
 
-    getSettings()->logPath.connect([this](const QString &logPath, auto) {
-        this->baseDirectory = logPath.isEmpty()
-                                  ? getApp()->getPaths().messageLogDirectory
-                                  : logPath;
-        this->openLogFile();
-    });
+    this->openLogFile(QDateTime::currentDateTime());
 }
 
 LoggingChannel::~LoggingChannel()
 {
-    appendLine(this->fileHandle, generateClosingString());
-    this->fileHandle.close();
-    this->currentStreamFileHandle.close();
+    // the closing string is always written directly, regardless of the
+    // flush threshold
+    this->logFile.append(generateClosingString(), 0);
+    this->logFile.close();
+    this->currentStreamLogFile.close();
 }
 
-void LoggingChannel::openLogFile()
+void LoggingChannel::setBaseDirectory(const QString &newBaseDirectory)
 {
-    QDateTime now = QDateTime::currentDateTime();
-    this->dateString = generateDateString(now);
+    if (newBaseDirectory == this->baseDirectory)
+    {
+        return;
+    }
 
-    if (this->fileHandle.isOpen())
+    this->baseDirectory = newBaseDirectory;
+    this->openLogFile(QDateTime::currentDateTime());
+
+    if (this->currentStreamLogFile.handle.isOpen())
     {
-        this->fileHandle.flush();
-        this->fileHandle.close();
+        this->openStreamLogFile(this->currentStreamID);
     }
+}
+
+void LoggingChannel::flush()
+{
+    this->logFile.flush();
+    this->currentStreamLogFile.flush();
+}
+
+qsizetype LoggingChannel::pendingBytes() const
+{
+    return this->logFile.buffer.size() +
+           this->currentStreamLogFile.buffer.size();
+}
+
+void LoggingChannel::openLogFile(const QDateTime &date)
+{
+    QDateTime now = QDateTime::currentDateTime();
+    this->dateString = generateDateString(date);
+
+    this->logFile.close();
 
     QString baseFileName = this->channelName + "-" + this->dateString + ".log";
 
@@ -128,19 +246,19 @@ void LoggingChannel::openLogFile()
         return;
     }
 
-    // Open file handle to log file of current date
+    // Open file handle to log file of that date
     QString fileName = directory + QDir::separator() + baseFileName;
     qCDebug(chatterinoHelper) << "Logging to" << fileName;
-    this->fileHandle.setFileName(fileName);
+    this->logFile.handle.setFileName(fileName);
 
-    if (!this->fileHandle.open(QIODevice::Append))
+    if (!this->logFile.handle.open(QIODevice::Append))
     {
         qCDebug(chatterinoHelper)
-            << "Failed to open file" << this->fileHandle.errorString();
+            << "Failed to open file" << this->logFile.handle.errorString();
         return;
     }
 
-    appendLine(this->fileHandle, generateOpeningString(now));
+    this->logFile.append(generateOpeningString(now), 0);
 }
 
 void LoggingChannel::openStreamLogFile(const QString &streamID)
@@ -148,11 +266,7 @@ void LoggingChannel::openStreamLogFile(const QString &streamID)
     QDateTime now = QDateTime::currentDateTime();
     this->currentStreamID = streamID;
 
-    if (this->currentStreamFileHandle.isOpen())
-    {
-        this->currentStreamFileHandle.flush();
-        this->currentStreamFileHandle.close();
-    }
+    this->currentStreamLogFile.close();
 
     QString baseFileName = this->channelName + "-" + streamID + ".log";
 
@@ -167,108 +281,55 @@ void LoggingChannel::openStreamLogFile(const QString &streamID)
 
     QString fileName = directory + QDir::separator() + baseFileName;
     qCDebug(chatterinoHelper) << "Logging stream to" << fileName;
-    this->currentStreamFileHandle.setFileName(fileName);
+    this->currentStreamLogFile.handle.setFileName(fileName);
 
-    if (!this->currentStreamFileHandle.open(QIODevice::Append))
+    if (!this->currentStreamLogFile.handle.open(QIODevice::Append))
     {
         qCDebug(chatterinoHelper)
             << "Failed to open file"
-            << this->currentStreamFileHandle.errorString();
+            << this->currentStreamLogFile.handle.errorString();
         return;
     }
-    appendLine(this->currentStreamFileHandle, generateOpeningString(now));
+    this->currentStreamLogFile.append(generateOpeningString(now), 0);
 }
 
-void LoggingChannel::addMessage(const MessagePtr &message,
-                                const QString &streamID)
+void LoggingChannel::addMessage(const LoggedMessage &logged,
+                                const LoggingOptions &options)
 {
+    const auto &message = logged.message;
+
     QDateTime messageTimestamp;
-    if (getSettings()->tryUseTwitchTimestamps &&
+    if (options.tryUseTwitchTimestamps &&
         !message->serverReceivedTime.isNull())
     {
         messageTimestamp = message->serverReceivedTime;
     }
     else
     {
-        messageTimestamp = QDateTime::currentDateTime();
+        messageTimestamp = QDateTime::fromMSecsSinceEpoch(logged.receivedAt);
     }
 
     QString messageDateString = generateDateString(messageTimestamp);
     if (messageDateString != this->dateString)
     {
-        this->dateString = messageDateString;
-        this->openLogFile();
+        // Messages are written after they were received, so this uses the
+        // day of the message rather than the current one
+        this->openLogFile(messageTimestamp);
     }
 
-    QString str;
-    if (this->channelName.startsWith("/mentions") ||
-        this->channelName.startsWith("/automod"))
-    {
-        str.append("#" + message->channelName + " ");
-    }
-
-    QString logTimestampFormat = getSettings()->logTimestampFormat;
-    if (logTimestampFormat != "Disable")
-    {
-        str.append('[');
-        str.append(messageTimestamp.toString(logTimestampFormat));
-        str.append("] ");
-    }
-
-    QString messageText;
-    if (message->loginName.isEmpty())
-    {
-        // This accounts for any messages not explicitly sent by a user, like
-        // system messages, parts of announcements, subs etc.
-        messageText = message->messageText;
-    }
-    else
-    {
-        if (message->localizedName.isEmpty())
-        {
-            messageText = message->loginName + ": " + message->messageText;
-        }
-        else
-        {
-            messageText = message->localizedName + " " + message->loginName +
-                          ": " + message->messageText;
-        }
-    }
-
-    if ((message->flags.has(MessageFlag::ReplyMessage) &&
-         getSettings()->stripReplyMention) &&
-        !getSettings()->hideReplyContext)
-    {
-        qsizetype colonIndex = messageText.indexOf(':');
-        if (colonIndex != -1)
-        {
-            QString rootMessageChatter;
-            if (message->replyParent)
-            {
-                rootMessageChatter = message->replyParent->loginName;
-            }
-            else
-            {
-                // we actually want to use 'reply-parent-user-login' tag here,
-                // but it's not worth storing just for this edge case
-                rootMessageChatter = message->replyThread->root()->loginName;
-            }
-            messageText.insert(colonIndex + 1, " @" + rootMessageChatter);
-        }
-    }
-    str.append(messageText);
-    str.append(ENDLINE);
+    auto str = formatMessage(logged, messageTimestamp, this->channelName,
+                             options);
 
-    appendLine(this->fileHandle, str);
+    this->logFile.append(str, options.flushThreshold);
 
-    if (!streamID.isEmpty() && getSettings()->separatelyStoreStreamLogs)
+    if (!logged.streamID.isEmpty() && options.separatelyStoreStreamLogs)
     {
-        if (this->currentStreamID != streamID)
+        if (this->currentStreamID != logged.streamID)
         {
-            this->openStreamLogFile(streamID);
+            this->openStreamLogFile(logged.streamID);
         }
 
-        appendLine(this->currentStreamFileHandle, str);
+        this->currentStreamLogFile.append(str, options.flushThreshold);
     }
 }
 
@@ -4,22 +4,57 @@
 
 #pragma once
 
+#include <QByteArray>
+#include <QDateTime>
 #include <QFile>
 #include <QString>
 
+#include <chrono>
 #include <memory>
 
 namespace chatterino {
 
-class Logging;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 
+/// A snapshot of the logging settings.
+///
+/// Settings must only be read from the GUI thread, so the values the log
+/// writer needs are copied into this struct and sent along with the messages.
+struct LoggingOptions {
+    QString baseDirectory;
+    QString timestampFormat;
+    bool tryUseTwitchTimestamps = false;
+    bool stripReplyMention = false;
+    bool hideReplyContext = false;
+    bool separatelyStoreStreamLogs = false;
+
+    /// Buffered lines are written out at least this often
+    std::chrono::milliseconds flushInterval{1000};
+    /// Once a file has this many bytes buffered, they're written immediately.
+    /// 0 writes (and flushes) every line as it comes in.
+    qsizetype flushThreshold = 64 * 1024;
+};
+
+/// A message that's queued to be written to a log file
+struct LoggedMessage {
+    MessagePtr message;
+    QString streamID;
+    /// The local time (in ms since epoch) the message was added at
+    qint64 receivedAt = 0;
+    /// `message->flags` may be modified on the GUI thread while the writer
+    /// reads it, so the one flag the formatter needs is copied here.
+    bool isReply = false;
+};
+
+/// Writes the messages of one channel to its log files.
+///
+/// A LoggingChannel is owned and used by the log writer thread only.
 class LoggingChannel
 {
-    explicit LoggingChannel(QString _channelName, QString _platform);
-
 public:
+    LoggingChannel(QString _channelName, QString _platform,
+                   QString _baseDirectory);
     ~LoggingChannel();
 
     LoggingChannel(const LoggingChannel &) = delete;
@@ -28,10 +63,30 @@ public:
     LoggingChannel(LoggingChannel &&) = delete;
     LoggingChannel &operator=(LoggingChannel &&) = delete;
 
-    void addMessage(const MessagePtr &message, const QString &streamID);
+    void addMessage(const LoggedMessage &logged,
+                    const LoggingOptions &options);
+
+    /// Reopens the log files in a new base directory
+    void setBaseDirectory(const QString &newBaseDirectory);
+
+    /// Writes all buffered lines to their files
+    void flush();
+
+    /// The number of bytes that are buffered but not written yet
+    qsizetype pendingBytes() const;
 
 private:
-    void openLogFile();
+    struct LogFile {
+        QFile handle;
+        QByteArray buffer;
+
+        void append(const QString &line, qsizetype flushThreshold);
+        void flush();
+        void close();
+    };
+
+    /// Opens the log file for the day of @a date
+    void openLogFile(const QDateTime &date);
     void openStreamLogFile(const QString &streamID);
 
     const QString channelName;
@@ -39,13 +94,11 @@ private:
     QString baseDirectory;
     QString subDirectory;
 
-    QFile fileHandle;
-    QFile currentStreamFileHandle;
+    LogFile logFile;
+    LogFile currentStreamLogFile;
     QString currentStreamID;
 
     QString dateString;
-
-    friend class Logging;
 };
 
 }  // namespace chatterino
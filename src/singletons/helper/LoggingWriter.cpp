@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "singletons/helper/LoggingWriter.hpp"
+
+#include "util/RenameThread.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+namespace chatterino {
+
+LoggingWriter::LoggingWriter(LoggingOptions options)
+    : options_(std::move(options))
+{
+    this->thread_ = std::make_unique<std::thread>([this] {
+        this->run();
+    });
+    renameThread(*this->thread_, "C2LogWriter");
+}
+
+LoggingWriter::~LoggingWriter()
+{
+    this->push(StopJob{});
+    this->thread_->join();
+}
+
+void LoggingWriter::addMessage(const QString &channelName,
+                               const QString &platformName,
+                               LoggedMessage message)
+{
+    this->push(AddMessageJob{
+        .channelName = channelName,
+        .platformName = platformName,
+        .message = std::move(message),
+    });
+}
+
+void LoggingWriter::closeChannel(const QString &channelName,
+                                 const QString &platformName)
+{
+    this->push(CloseChannelJob{
+        .channelName = channelName,
+        .platformName = platformName,
+    });
+}
+
+void LoggingWriter::setOptions(LoggingOptions options)
+{
+    this->push(SetOptionsJob{.options = std::move(options)});
+}
+
+void LoggingWriter::flush()
+{
+    this->push(FlushJob{});
+}
+
+void LoggingWriter::push(Job job)
+{
+    this->queue_.push(std::move(job));
+
+    // Only pay for the lock if the writer is waiting. This pairs with the
+    // store to `sleeping_` and the `empty()` check in `run`.
+    if (this->sleeping_.load())
+    {
+        std::lock_guard lock(this->wakeMutex_);
+        this->wakeCondition_.notify_one();
+    }
+}
+
+void LoggingWriter::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Set while any channel has buffered lines that aren't written yet
+    std::optional<Clock::time_point> flushDeadline;
+
+    while (true)
+    {
+        while (auto job = this->queue_.tryPop())
+        {
+            if (!this->handle(*job))
+            {
+                // Closes all files and writes their closing markers
+                this->channels_.clear();
+                return;
+            }
+        }
+
+        bool hasPending = std::ranges::any_of(this->channels_, [](auto &it) {
+            return it.second->pendingBytes() > 0;
+        });
+        auto now = Clock::now();
+        if (!hasPending)
+        {
+            flushDeadline.reset();
+        }
+        else if (!flushDeadline)
+        {
+            flushDeadline = now + this->options_.flushInterval;
+        }
+        else if (now >= *flushDeadline)
+        {
+            this->flushAll();
+            flushDeadline.reset();
+        }
+
+        std::unique_lock lock(this->wakeMutex_);
+        this->sleeping_.store(true);
+        auto hasJob = [this] {
+            return !this->queue_.empty();
+        };
+        if (flushDeadline)
+        {
+            this->wakeCondition_.wait_until(lock, *flushDeadline, hasJob);
+        }
+        else
+        {
+            this->wakeCondition_.wait(lock, hasJob);
+        }
+        this->sleeping_.store(false);
+    }
+}
+
+bool LoggingWriter::handle(Job &job)
+{
+    return std::visit(
+        [this](auto &item) {
+            using T = std::decay_t<decltype(item)>;
+
+            if constexpr (std::is_same_v<T, AddMessageJob>)
+            {
+                auto key =
+                    std::make_pair(item.platformName, item.channelName);
+                auto it = this->channels_.find(key);
+                if (it == this->channels_.end())
+                {
+                    it = this->channels_
+                             .emplace(std::move(key),
+                                      std::make_unique<LoggingChannel>(
+                                          item.channelName, item.platformName,
+                                          this->options_.baseDirectory))
+                             .first;
+                }
+                it->second->addMessage(item.message, this->options_);
+            }
+            else if constexpr (std::is_same_v<T, CloseChannelJob>)
+            {
+                this->channels_.erase(
+                    std::make_pair(item.platformName, item.channelName));
+            }
+            else if constexpr (std::is_same_v<T, SetOptionsJob>)
+            {
+                this->options_ = std::move(item.options);
+                for (auto &[key, channel] : this->channels_)
+                {
+                    channel->setBaseDirectory(this->options_.baseDirectory);
+                    if (channel->pendingBytes() >=
+                        this->options_.flushThreshold)
+                    {
+                        channel->flush();
+                    }
+                }
+            }
+            else if constexpr (std::is_same_v<T, FlushJob>)
+            {
+                this->flushAll();
+            }
+            else if constexpr (std::is_same_v<T, StopJob>)
+            {
+                return false;
+            }
+
+            return true;
+        },
+        job);
+}
+
+void LoggingWriter::flushAll()
+{
+    for (auto &[key, channel] : this->channels_)
+    {
+        channel->flush();
+    }
+}
+
+}  // namespace chatterino
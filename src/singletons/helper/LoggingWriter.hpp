@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "singletons/helper/LoggingChannel.hpp"
+#include "util/MpscQueue.hpp"
+
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <variant>
+
+namespace chatterino {
+
+/// Formats and writes chat logs on a dedicated thread.
+///
+/// Producers only push jobs onto a lock-free queue. The writer thread drains
+/// the queue, formats the lines, and buffers them per file. Buffers are
+/// written once they exceed `LoggingOptions::flushThreshold` bytes or every
+/// `LoggingOptions::flushInterval`, whichever comes first.
+class LoggingWriter
+{
+public:
+    LoggingWriter(LoggingOptions options);
+    /// Writes all pending messages and closing markers, then joins the thread
+    ~LoggingWriter();
+
+    LoggingWriter(const LoggingWriter &) = delete;
+    LoggingWriter &operator=(const LoggingWriter &) = delete;
+    LoggingWriter(LoggingWriter &&) = delete;
+    LoggingWriter &operator=(LoggingWriter &&) = delete;
+
+    void addMessage(const QString &channelName, const QString &platformName,
+                    LoggedMessage message);
+
+    /// Flushes the channel and writes its closing marker
+    void closeChannel(const QString &channelName, const QString &platformName);
+
+    /// Applies new options to all messages added after this call
+    void setOptions(LoggingOptions options);
+
+    /// Writes all buffered lines as soon as possible
+    void flush();
+
+private:
+    struct AddMessageJob {
+        QString channelName;
+        QString platformName;
+        LoggedMessage message;
+    };
+    struct CloseChannelJob {
+        QString channelName;
+        QString platformName;
+    };
+    struct SetOptionsJob {
+        LoggingOptions options;
+    };
+    struct FlushJob {
+    };
+    struct StopJob {
+    };
+    using Job = std::variant<AddMessageJob, CloseChannelJob, SetOptionsJob,
+                             FlushJob, StopJob>;
+
+    void push(Job job);
+    void run();
+
+    /// Handles one job, returns false if the writer should stop
+    bool handle(Job &job);
+    void flushAll();
+
+    MpscQueue<Job> queue_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    /// Set while the writer thread is (about to start) waiting for jobs
+    std::atomic<bool> sleeping_ = false;
+
+    // Only accessed from the writer thread
+    LoggingOptions options_;
+    std::map<std::pair<QString, QString>, std::unique_ptr<LoggingChannel>>
+        channels_;
+
+    std::unique_ptr<std::thread> thread_;
+};
+
+}  // namespace chatterino
@@ -34,6 +34,10 @@ constexpr bool isBytes(DebugObject target)
         case DebugObject::BytesImageCurrent:
         case DebugObject::BytesImageLoaded:
         case DebugObject::BytesImageUnloaded:
+        case DebugObject::BytesImagePeak:
+        case DebugObject::BytesImageBudgetEvicted:
+        case DebugObject::BytesProcessPeak:
+        case DebugObject::BytesMessageDrawingBuffer:
             return true;
     }
 }
@@ -66,6 +70,13 @@ void DebugCount::decrease(DebugObject target, int64_t amount)
     it.value -= amount;
 }
 
+int64_t DebugCount::get(DebugObject target)
+{
+    auto counts = COUNTS.access();
+
+    return counts->at(static_cast<size_t>(target)).value;
+}
+
 QString DebugCount::getDebugText()
 {
     static const QLocale locale(QLocale::English);
@@ -26,6 +26,8 @@ enum class DebugObject : size_t {
     // http/other networking
     HTTPRequestStarted,
     HTTPRequestSuccess,
+    HTTPRequestCoalesced,
+    HTTPRequestShared,
     NetworkData,
 
     // images
@@ -40,14 +42,24 @@ enum class DebugObject : size_t {
     LastImageGcEligible,
     LastImageGcLeft,
 
+    BytesImagePeak,
+    ImageBudgetEvicted,
+    BytesImageBudgetEvicted,
+    BytesProcessPeak,
+
     // Lua
     LuaHTTPResponse,
     LuaHTTPRequest,
 
     // Messages
     MessageDrawingBuffer,
+    BytesMessageDrawingBuffer,
+    MessageDrawingBufferShared,
     MessageElement,
     MessageLayout,
+    SharedMessageLayout,
+    MessageLayoutShared,
+    MessageLayoutTime,
     MessageLayoutElement,
     MessageThread,
     Message,
@@ -72,6 +84,9 @@ public:
         DebugCount::decrease(target, 1);
     }
 
+    /// Returns the current value of `target`
+    static int64_t get(DebugObject target);
+
     static QString getDebugText();
 };
 
@@ -91,6 +106,7 @@ constexpr magic_enum::customize::customize_t
         case chatterino::DebugObject::NetworkData:
         case chatterino::DebugObject::MessageElement:
         case chatterino::DebugObject::MessageLayout:
+        case chatterino::DebugObject::SharedMessageLayout:
         case chatterino::DebugObject::MessageLayoutElement:
         case chatterino::DebugObject::MessageThread:
         case chatterino::DebugObject::Message:
@@ -109,6 +125,10 @@ constexpr magic_enum::customize::customize_t
             return "http requests started";
         case chatterino::DebugObject::HTTPRequestSuccess:
             return "http requests succeeded";
+        case chatterino::DebugObject::HTTPRequestCoalesced:
+            return "http requests coalesced";
+        case chatterino::DebugObject::HTTPRequestShared:
+            return "http requests shared by coalesced requests";
         case chatterino::DebugObject::Image:
             return "images";
         case chatterino::DebugObject::LoadedImage:
@@ -125,11 +145,27 @@ constexpr magic_enum::customize::customize_t
             return "last image gc: eligible";
         case chatterino::DebugObject::LastImageGcLeft:
             return "last image gc: left after gc";
+        case chatterino::DebugObject::BytesImagePeak:
+            return "image bytes (peak)";
+        case chatterino::DebugObject::ImageBudgetEvicted:
+            return "images evicted by memory budget";
+        case chatterino::DebugObject::BytesImageBudgetEvicted:
+            return "image bytes evicted by memory budget";
+        case chatterino::DebugObject::BytesProcessPeak:
+            return "peak resident memory";
         case chatterino::DebugObject::LuaHTTPResponse:
             return "lua::api::HTTPResponse";
         case chatterino::DebugObject::LuaHTTPRequest:
             return "lua::api::HTTPRequest";
         case chatterino::DebugObject::MessageDrawingBuffer:
             return "message drawing buffers";
+        case chatterino::DebugObject::BytesMessageDrawingBuffer:
+            return "message drawing buffer bytes";
+        case chatterino::DebugObject::MessageDrawingBufferShared:
+            return "message drawing buffers reused from other views";
+        case chatterino::DebugObject::MessageLayoutShared:
+            return "message layouts reused from other views";
+        case chatterino::DebugObject::MessageLayoutTime:
+            return "message layout time (us, total)";
     }
 }
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace chatterino {
+
+/// @brief An unbounded, lock-free multi-producer single-consumer queue
+///
+/// This is Dmitry Vyukov's node based MPSC queue. Producers never block each
+/// other (a push is one allocation and one atomic exchange) and the consumer
+/// never takes a lock.
+///
+/// `push` may be called from any thread. `tryPop` and `empty` must only ever
+/// be called from one (the consumer) thread at a time.
+template <typename T>
+class MpscQueue
+{
+    struct Node {
+        std::atomic<Node *> next = nullptr;
+        std::optional<T> value;
+    };
+
+public:
+    MpscQueue()
+        : head_(new Node)
+        , tail_(this->head_.load())
+    {
+    }
+
+    ~MpscQueue()
+    {
+        while (this->tryPop())
+        {
+        }
+        delete this->tail_;
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+    MpscQueue(MpscQueue &&) = delete;
+    MpscQueue &operator=(MpscQueue &&) = delete;
+
+    /// Appends `value` to the queue. Safe to call from any thread.
+    void push(T value)
+    {
+        auto *node = new Node;
+        node->value.emplace(std::move(value));
+
+        Node *prev = this->head_.exchange(node, std::memory_order_acq_rel);
+        // Between the exchange and this store, the consumer sees the queue
+        // as empty. This is sequentially consistent so waiters can pair it
+        // with their own "I'm going to sleep" flag (see `empty`).
+        prev->next.store(node, std::memory_order_seq_cst);
+    }
+
+    /// Removes the oldest item from the queue. Consumer thread only.
+    std::optional<T> tryPop()
+    {
+        Node *tail = this->tail_;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<T> value = std::move(next->value);
+        next->value.reset();
+        this->tail_ = next;
+        delete tail;
+
+        return value;
+    }
+
+    /// Returns true if there's no item ready to be popped. Consumer thread only.
+    bool empty() const
+    {
+        return this->tail_->next.load(std::memory_order_seq_cst) == nullptr;
+    }
+
+private:
+    /// The most recently pushed node (written by producers)
+    std::atomic<Node *> head_;
+    /// The last consumed node (its value is already moved out)
+    Node *tail_;
+};
+
+}  // namespace chatterino
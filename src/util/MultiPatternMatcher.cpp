@@ -0,0 +1,534 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/MultiPatternMatcher.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace {
+
+using namespace chatterino;
+
+void toCodePoints(QStringView text, bool fold, std::vector<char32_t> &out)
+{
+    out.clear();
+    out.reserve(static_cast<size_t>(text.size()));
+    for (qsizetype i = 0; i < text.size(); i++)
+    {
+        char32_t codePoint = text[i].unicode();
+        if (text[i].isHighSurrogate() && i + 1 < text.size() &&
+            text[i + 1].isLowSurrogate())
+        {
+            codePoint = QChar::surrogateToUcs4(text[i], text[i + 1]);
+            i++;
+        }
+        if (fold)
+        {
+            codePoint = QChar::toCaseFolded(codePoint);
+        }
+        out.push_back(codePoint);
+    }
+}
+
+/// Returns the index after the character class starting at `start`, or -1 if
+/// it isn't terminated
+qsizetype skipClass(QStringView pattern, qsizetype start)
+{
+    auto i = start + 1;
+    if (i < pattern.size() && pattern[i] == u'^')
+    {
+        i++;
+    }
+    // a ']' at the start is part of the class
+    if (i < pattern.size() && pattern[i] == u']')
+    {
+        i++;
+    }
+
+    while (i < pattern.size())
+    {
+        auto c = pattern[i];
+        if (c == u'\\')
+        {
+            i += 2;
+            continue;
+        }
+        if (c == u'[' && i + 1 < pattern.size() &&
+            (pattern[i + 1] == u':' || pattern[i + 1] == u'.' ||
+             pattern[i + 1] == u'='))
+        {
+            // POSIX class like [:alpha:]
+            auto end = pattern.indexOf(u']', i + 2);
+            if (end < 0)
+            {
+                return -1;
+            }
+            i = end + 1;
+            continue;
+        }
+        if (c == u']')
+        {
+            return i + 1;
+        }
+        i++;
+    }
+
+    return -1;
+}
+
+/// Returns the index after the group starting at `start`, or -1 if it isn't
+/// terminated
+qsizetype skipGroup(QStringView pattern, qsizetype start)
+{
+    int depth = 0;
+    auto i = start;
+    while (i < pattern.size())
+    {
+        auto c = pattern[i];
+        if (c == u'\\')
+        {
+            i += 2;
+            continue;
+        }
+        if (c == u'[')
+        {
+            i = skipClass(pattern, i);
+            if (i < 0)
+            {
+                return -1;
+            }
+            continue;
+        }
+        if (c == u'(')
+        {
+            depth++;
+        }
+        else if (c == u')')
+        {
+            depth--;
+            if (depth == 0)
+            {
+                return i + 1;
+            }
+        }
+        i++;
+    }
+
+    return -1;
+}
+
+/// Returns true if the group at `start` sets options for the rest of the
+/// pattern, like (?i) or (?-x)
+bool isOptionSetting(QStringView pattern, qsizetype start)
+{
+    if (start + 1 >= pattern.size() || pattern[start + 1] != u'?')
+    {
+        return false;
+    }
+
+    auto i = start + 2;
+    while (i < pattern.size() &&
+           ((pattern[i].unicode() < 128 && pattern[i].isLetter()) ||
+            pattern[i] == u'-' || pattern[i] == u'^'))
+    {
+        i++;
+    }
+    return i > start + 2 && i < pattern.size() && pattern[i] == u')';
+}
+
+/// Escapes matching something other than a literal that take no arguments
+constexpr QStringView SIMPLE_ESCAPES = u"AbBCdDGhHKRsSvVwWXzZaefnrt";
+
+/// @brief Collects runs of literal characters every match of `pattern`
+///        contains.
+///
+/// Groups and character classes are skipped, and a character followed by a
+/// quantifier that allows zero repetitions isn't part of a run. Returns false
+/// if nothing is known to be required or the pattern uses syntax where this
+/// could be wrong.
+bool collectRegexLiterals(QStringView pattern, std::vector<QString> &literals)
+{
+    // \Q...\E quotes anything, and verbs like (*ACCEPT) can end a match early
+    if (pattern.contains(u"\\Q") || pattern.contains(u"(*"))
+    {
+        return false;
+    }
+
+    QString current;
+    auto commit = [&] {
+        if (!current.isEmpty())
+        {
+            literals.push_back(current);
+            current.clear();
+        }
+    };
+    auto dropLast = [&] {
+        if (current.isEmpty())
+        {
+            return;
+        }
+        if (current.size() > 1 && current.back().isLowSurrogate())
+        {
+            current.chop(2);
+        }
+        else
+        {
+            current.chop(1);
+        }
+    };
+
+    qsizetype i = 0;
+    while (i < pattern.size())
+    {
+        auto c = pattern[i];
+        switch (c.unicode())
+        {
+            case u'|':
+            case u')':
+                // with an alternation, no part of the pattern is required
+                return false;
+
+            case u'(': {
+                if (isOptionSetting(pattern, i))
+                {
+                    return false;
+                }
+                commit();
+                i = skipGroup(pattern, i);
+                if (i < 0)
+                {
+                    return false;
+                }
+            }
+            break;
+
+            case u'[': {
+                commit();
+                i = skipClass(pattern, i);
+                if (i < 0)
+                {
+                    return false;
+                }
+            }
+            break;
+
+            case u'\\': {
+                if (i + 1 >= pattern.size())
+                {
+                    return false;
+                }
+                auto escaped = pattern[i + 1];
+                if (escaped.unicode() < 128 && escaped.isLetterOrNumber())
+                {
+                    if (!SIMPLE_ESCAPES.contains(escaped))
+                    {
+                        // back references, \x{...}, \p{...}, ...
+                        return false;
+                    }
+                    commit();
+                }
+                else
+                {
+                    current.append(escaped);
+                }
+                i += 2;
+            }
+            break;
+
+            case u'.':
+            case u'^':
+            case u'$':
+                commit();
+                i++;
+                break;
+
+            case u'*':
+            case u'?':
+                dropLast();
+                commit();
+                i++;
+                break;
+
+            case u'+':
+                commit();
+                i++;
+                break;
+
+            case u'{': {
+                dropLast();
+                commit();
+                auto end = pattern.indexOf(u'}', i);
+                if (end < 0)
+                {
+                    return false;
+                }
+                i = end + 1;
+            }
+            break;
+
+            default:
+                current.append(c);
+                i++;
+                break;
+        }
+    }
+
+    commit();
+    return true;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+MultiPatternMatcher::MultiPatternMatcher(const std::vector<Pattern> &patterns)
+    : size_(patterns.size())
+{
+    std::vector<char32_t> codePoints;
+    for (size_t i = 0; i < patterns.size(); i++)
+    {
+        const auto &pattern = patterns[i];
+        if (pattern.literal.isEmpty())
+        {
+            this->alwaysFound_.push_back(static_cast<uint32_t>(i));
+            continue;
+        }
+
+        bool fold = pattern.caseSensitivity == Qt::CaseInsensitive;
+        toCodePoints(pattern.literal, fold, codePoints);
+        auto &automaton =
+            fold ? this->caseInsensitive_ : this->caseSensitive_;
+        automaton.insert(codePoints, static_cast<uint32_t>(i));
+    }
+
+    this->caseSensitive_.build();
+    this->caseInsensitive_.build();
+}
+
+std::vector<bool> MultiPatternMatcher::find(QStringView subject) const
+{
+    std::vector<bool> found(this->size_);
+    for (auto i : this->alwaysFound_)
+    {
+        found[i] = true;
+    }
+
+    std::vector<char32_t> codePoints;
+    if (!this->caseSensitive_.empty())
+    {
+        toCodePoints(subject, false, codePoints);
+        this->caseSensitive_.find(codePoints, found);
+    }
+    if (!this->caseInsensitive_.empty())
+    {
+        toCodePoints(subject, true, codePoints);
+        this->caseInsensitive_.find(codePoints, found);
+    }
+
+    return found;
+}
+
+size_t MultiPatternMatcher::size() const
+{
+    return this->size_;
+}
+
+void MultiPatternMatcher::Automaton::insert(
+    const std::vector<char32_t> &codePoints, uint32_t pattern)
+{
+    if (this->pendingEdges_.empty())
+    {
+        // the root
+        this->pendingEdges_.emplace_back();
+        this->pendingPatterns_.emplace_back();
+    }
+
+    uint32_t node = 0;
+    for (auto codePoint : codePoints)
+    {
+        const auto &edges = this->pendingEdges_[node];
+        auto it = std::ranges::find(edges, codePoint, &Edge::codePoint);
+        if (it != edges.end())
+        {
+            node = it->target;
+            continue;
+        }
+
+        auto target = static_cast<uint32_t>(this->pendingEdges_.size());
+        this->pendingEdges_[node].push_back({codePoint, target});
+        this->pendingEdges_.emplace_back();
+        this->pendingPatterns_.emplace_back();
+        node = target;
+    }
+    this->pendingPatterns_[node].push_back(pattern);
+}
+
+void MultiPatternMatcher::Automaton::build()
+{
+    if (this->pendingEdges_.empty())
+    {
+        return;
+    }
+
+    this->nodes_.resize(this->pendingEdges_.size());
+    for (size_t i = 0; i < this->nodes_.size(); i++)
+    {
+        auto &edges = this->pendingEdges_[i];
+        std::ranges::sort(edges, {}, &Edge::codePoint);
+
+        auto &node = this->nodes_[i];
+        node.firstEdge = static_cast<uint32_t>(this->edges_.size());
+        node.edgeCount = static_cast<uint32_t>(edges.size());
+        this->edges_.insert(this->edges_.end(), edges.begin(), edges.end());
+
+        const auto &patterns = this->pendingPatterns_[i];
+        node.firstPattern = static_cast<uint32_t>(this->patterns_.size());
+        node.patternCount = static_cast<uint32_t>(patterns.size());
+        this->patterns_.insert(this->patterns_.end(), patterns.begin(),
+                               patterns.end());
+    }
+
+    // staying at the root is the default
+    this->rootEdges_.assign(DIRECT_EDGES, 0);
+    for (const auto &edge : this->pendingEdges_[0])
+    {
+        if (edge.codePoint < DIRECT_EDGES)
+        {
+            this->rootEdges_[edge.codePoint] = edge.target;
+        }
+    }
+
+    // Breadth-first, so the failure links of shorter prefixes are known
+    std::deque<uint32_t> queue;
+    for (const auto &edge : this->pendingEdges_[0])
+    {
+        queue.push_back(edge.target);
+    }
+    while (!queue.empty())
+    {
+        auto parent = queue.front();
+        queue.pop_front();
+
+        for (const auto &edge : this->pendingEdges_[parent])
+        {
+            auto &node = this->nodes_[edge.target];
+            node.fail = parent == 0
+                            ? 0
+                            : this->next(this->nodes_[parent].fail,
+                                         edge.codePoint);
+
+            const auto &fail = this->nodes_[node.fail];
+            node.output =
+                fail.patternCount > 0 ? node.fail : fail.output;
+            queue.push_back(edge.target);
+        }
+    }
+
+    this->pendingEdges_ = {};
+    this->pendingPatterns_ = {};
+}
+
+bool MultiPatternMatcher::Automaton::empty() const
+{
+    return this->nodes_.empty();
+}
+
+void MultiPatternMatcher::Automaton::find(const std::vector<char32_t> &subject,
+                                          std::vector<bool> &found) const
+{
+    uint32_t state = 0;
+    for (auto codePoint : subject)
+    {
+        state = this->next(state, codePoint);
+
+        auto match = this->nodes_[state].patternCount > 0
+                         ? state
+                         : this->nodes_[state].output;
+        while (match != NONE)
+        {
+            const auto &node = this->nodes_[match];
+            for (auto i = node.firstPattern;
+                 i < node.firstPattern + node.patternCount; i++)
+            {
+                found[this->patterns_[i]] = true;
+            }
+            match = node.output;
+        }
+    }
+}
+
+uint32_t MultiPatternMatcher::Automaton::next(uint32_t node,
+                                              char32_t codePoint) const
+{
+    while (true)
+    {
+        if (node == 0 && codePoint < DIRECT_EDGES)
+        {
+            return this->rootEdges_[codePoint];
+        }
+
+        const auto &current = this->nodes_[node];
+        auto begin = this->edges_.begin() + current.firstEdge;
+        auto end = begin + current.edgeCount;
+        auto it = std::ranges::lower_bound(begin, end, codePoint, {},
+                                           &Edge::codePoint);
+        if (it != end && it->codePoint == codePoint)
+        {
+            return it->target;
+        }
+        if (node == 0)
+        {
+            return 0;
+        }
+        node = current.fail;
+    }
+}
+
+QString requiredLiteral(QStringView pattern, bool isRegex,
+                        Qt::CaseSensitivity caseSensitivity)
+{
+    std::vector<QString> literals;
+    if (!isRegex)
+    {
+        literals.push_back(pattern.toString());
+    }
+    else if (!collectRegexLiterals(pattern, literals))
+    {
+        return {};
+    }
+
+    QStringView best;
+    auto consider = [&](QStringView candidate) {
+        if (candidate.size() > best.size())
+        {
+            best = candidate;
+        }
+    };
+
+    for (const auto &literal : literals)
+    {
+        if (caseSensitivity == Qt::CaseSensitive)
+        {
+            consider(literal);
+            continue;
+        }
+
+        // Only use the ASCII parts, other characters might fold differently
+        // in PCRE2
+        qsizetype start = 0;
+        for (qsizetype i = 0; i <= literal.size(); i++)
+        {
+            if (i == literal.size() || literal[i].unicode() >= 128)
+            {
+                consider(QStringView{literal}.mid(start, i - start));
+                start = i + 1;
+            }
+        }
+    }
+
+    return best.toString();
+}
+
+}  // namespace chatterino
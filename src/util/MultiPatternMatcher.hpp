@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+
+/// @brief Finds which of many literals occur in a text in a single pass.
+///
+/// This is an Aho-Corasick automaton over code points. Case-insensitive
+/// literals are compared after case folding each code point, like
+/// QString::contains(..., Qt::CaseInsensitive) does.
+///
+/// An empty literal occurs in every text. The matcher is immutable once
+/// built, so it can be used from multiple threads.
+class MultiPatternMatcher
+{
+public:
+    struct Pattern {
+        QString literal;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive;
+    };
+
+    MultiPatternMatcher() = default;
+    explicit MultiPatternMatcher(const std::vector<Pattern> &patterns);
+
+    /// Returns whether the pattern at each index occurs in `subject`
+    std::vector<bool> find(QStringView subject) const;
+
+    size_t size() const;
+
+private:
+    /// A trie with failure links over either the original or the case
+    /// folded code points
+    class Automaton
+    {
+    public:
+        void insert(const std::vector<char32_t> &codePoints, uint32_t pattern);
+        void build();
+
+        bool empty() const;
+        void find(const std::vector<char32_t> &subject,
+                  std::vector<bool> &found) const;
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX;
+        static constexpr char32_t DIRECT_EDGES = 128;
+
+        struct Edge {
+            char32_t codePoint;
+            uint32_t target;
+        };
+
+        struct Node {
+            /// Range of the outgoing edges in edges_, sorted by code point
+            uint32_t firstEdge = 0;
+            uint32_t edgeCount = 0;
+            uint32_t fail = 0;
+            /// Closest node on the failure chain that ends a pattern
+            uint32_t output = NONE;
+            /// Range of the patterns ending here in patterns_
+            uint32_t firstPattern = 0;
+            uint32_t patternCount = 0;
+        };
+
+        uint32_t next(uint32_t node, char32_t codePoint) const;
+
+        std::vector<std::vector<Edge>> pendingEdges_;
+        std::vector<std::vector<uint32_t>> pendingPatterns_;
+
+        std::vector<Node> nodes_;
+        std::vector<Edge> edges_;
+        std::vector<uint32_t> patterns_;
+        /// Transitions from the root for ASCII, which most text starts with
+        std::vector<uint32_t> rootEdges_;
+    };
+
+    size_t size_ = 0;
+    /// Patterns with an empty literal
+    std::vector<uint32_t> alwaysFound_;
+    Automaton caseSensitive_;
+    Automaton caseInsensitive_;
+};
+
+/// @brief Returns a literal all matches of a highlight or ignore phrase
+///        contain, so the phrase can be skipped for texts without it.
+///
+/// For regex patterns, this is the longest literal outside of groups that
+/// isn't optional. An empty string is returned if there's no such literal
+/// or the pattern uses syntax this doesn't understand (e.g. alternations or
+/// inline options). Case-insensitive literals only contain ASCII characters,
+/// where case folding is the same for Qt and PCRE2.
+QString requiredLiteral(QStringView pattern, bool isRegex,
+                        Qt::CaseSensitivity caseSensitivity);
+
+}  // namespace chatterino
@@ -0,0 +1,714 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// @brief A persistent hash map (a hash array mapped trie).
+///
+/// Copying a map is O(1), the copy shares all nodes with the original.
+/// Modifying a map only copies the nodes on the path to the modified entry
+/// (O(log n)) if they're shared with another map. Nodes that aren't shared
+/// are modified in place, so building a map from scratch doesn't copy
+/// anything.
+///
+/// This makes it cheap to copy a published (immutable) map, modify the copy
+/// and publish that. Readers of the old map aren't affected.
+///
+/// The interface follows std::unordered_map. Differences:
+///  - Only const iteration is supported. Values can be modified through
+///    operator[].
+///  - The value_type is std::pair<Key, T> (without a const key).
+///  - Any modification invalidates all iterators and references of this map
+///    (but not of its copies).
+///
+/// Like standard containers, a map can be read from multiple threads as long
+/// as no thread modifies it. Copies of a map can be modified independently.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class PersistentHashMap
+{
+    static constexpr size_t BITS = 5;
+    static constexpr size_t HASH_BITS = std::numeric_limits<size_t>::digits;
+    /// Levels with a bitmap plus one level for collisions
+    static constexpr size_t MAX_DEPTH = (HASH_BITS + BITS - 1) / BITS + 1;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+private:
+    struct Entry {
+        size_t hash;
+        value_type value;
+    };
+
+    /// In nodes at a shift below HASH_BITS, `entries` and `children` are
+    /// ordered by their bit in `dataMap` and `nodeMap`. Below that, all
+    /// entries have the same hash and are unordered (there are no children).
+    struct Node {
+        uint32_t dataMap = 0;
+        uint32_t nodeMap = 0;
+        std::vector<Entry> entries;
+        std::vector<std::shared_ptr<Node>> children;
+    };
+    using NodePtr = std::shared_ptr<Node>;
+
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PersistentHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        const_iterator() = default;
+
+        reference operator*() const
+        {
+            return this->current().node->entries[this->entry_].value;
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        const_iterator &operator++()
+        {
+            this->entry_++;
+            this->settle();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            if (this->depth_ == 0 || other.depth_ == 0)
+            {
+                return this->depth_ == other.depth_;
+            }
+            return this->current().node == other.current().node &&
+                   this->entry_ == other.entry_;
+        }
+
+    private:
+        friend class PersistentHashMap;
+
+        struct Frame {
+            const Node *node = nullptr;
+            /// The next child to visit
+            size_t child = 0;
+        };
+
+        const Frame &current() const
+        {
+            assert(this->depth_ > 0);
+            return this->stack_[this->depth_ - 1];
+        }
+
+        void push(const Node *node, size_t child)
+        {
+            assert(this->depth_ < MAX_DEPTH);
+            this->stack_[this->depth_++] = {.node = node, .child = child};
+        }
+
+        /// Moves to the next entry if the current one is past the entries
+        /// of its node. Entries of a node are visited before its children.
+        void settle()
+        {
+            while (this->depth_ > 0)
+            {
+                auto &top = this->stack_[this->depth_ - 1];
+                if (this->entry_ < top.node->entries.size())
+                {
+                    return;
+                }
+                if (top.child < top.node->children.size())
+                {
+                    const auto *child = top.node->children[top.child++].get();
+                    this->push(child, 0);
+                    this->entry_ = 0;
+                    continue;
+                }
+
+                this->depth_--;
+                if (this->depth_ > 0)
+                {
+                    this->entry_ = this->current().node->entries.size();
+                }
+            }
+        }
+
+        // A fixed array, so lookups don't allocate
+        std::array<Frame, MAX_DEPTH> stack_{};
+        size_t depth_ = 0;
+        size_t entry_ = 0;
+    };
+    using iterator = const_iterator;
+
+    PersistentHashMap() = default;
+
+    PersistentHashMap(std::initializer_list<value_type> values)
+    {
+        for (const auto &value : values)
+        {
+            this->insert(value);
+        }
+    }
+
+    const_iterator begin() const
+    {
+        const_iterator it;
+        if (this->root_)
+        {
+            it.push(this->root_.get(), 0);
+            it.settle();
+        }
+        return it;
+    }
+
+    const_iterator end() const
+    {
+        return {};
+    }
+
+    const_iterator cbegin() const
+    {
+        return this->begin();
+    }
+
+    const_iterator cend() const
+    {
+        return this->end();
+    }
+
+    size_t size() const
+    {
+        return this->size_;
+    }
+
+    bool empty() const
+    {
+        return this->size_ == 0;
+    }
+
+    /// Does nothing. Exists for compatibility with std::unordered_map.
+    void reserve(size_t /* count */)
+    {
+    }
+
+    const_iterator find(const Key &key) const
+    {
+        const_iterator it;
+        const auto hash = Hash{}(key);
+        const Node *node = this->root_.get();
+        for (size_t shift = 0; node != nullptr; shift += BITS)
+        {
+            if (shift >= HASH_BITS)
+            {
+                for (size_t i = 0; i < node->entries.size(); i++)
+                {
+                    if (KeyEqual{}(node->entries[i].value.first, key))
+                    {
+                        it.push(node, 0);
+                        it.entry_ = i;
+                        return it;
+                    }
+                }
+                return {};
+            }
+
+            const auto bit = bitOf(hash, shift);
+            if ((node->dataMap & bit) != 0)
+            {
+                auto index = indexOf(node->dataMap, bit);
+                const auto &entry = node->entries[index];
+                if (entry.hash != hash || !KeyEqual{}(entry.value.first, key))
+                {
+                    return {};
+                }
+                it.push(node, 0);
+                it.entry_ = index;
+                return it;
+            }
+            if ((node->nodeMap & bit) == 0)
+            {
+                return {};
+            }
+
+            auto child = indexOf(node->nodeMap, bit);
+            it.push(node, child + 1);
+            node = node->children[child].get();
+        }
+        return {};
+    }
+
+    bool contains(const Key &key) const
+    {
+        return this->find(key) != this->end();
+    }
+
+    size_t count(const Key &key) const
+    {
+        return this->contains(key) ? 1 : 0;
+    }
+
+    const T &at(const Key &key) const
+    {
+        auto it = this->find(key);
+        if (it == this->end())
+        {
+            throw std::out_of_range("PersistentHashMap::at");
+        }
+        return it->second;
+    }
+
+    /// Returns a reference to the value of `key`, inserting a
+    /// default-constructed one if there's none. The reference is valid until
+    /// the next modification of this map.
+    T &operator[](const Key &key)
+    {
+        bool inserted = false;
+        return this->editableSlot(key, inserted);
+    }
+
+    std::pair<const_iterator, bool> insert(const value_type &value)
+    {
+        return this->try_emplace(value.first, value.second);
+    }
+
+    std::pair<const_iterator, bool> insert(value_type &&value)
+    {
+        return this->try_emplace(std::move(value.first),
+                                 std::move(value.second));
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args &&...args)
+    {
+        return this->insert(value_type(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> try_emplace(const Key &key,
+                                                Args &&...args)
+    {
+        auto it = this->find(key);
+        if (it != this->end())
+        {
+            return {it, false};
+        }
+
+        bool inserted = false;
+        this->editableSlot(key, inserted) = T(std::forward<Args>(args)...);
+        return {this->find(key), true};
+    }
+
+    template <typename M>
+    std::pair<const_iterator, bool> insert_or_assign(const Key &key, M &&value)
+    {
+        bool inserted = false;
+        this->editableSlot(key, inserted) = std::forward<M>(value);
+        return {this->find(key), inserted};
+    }
+
+    size_t erase(const Key &key)
+    {
+        if (!this->contains(key))
+        {
+            // don't copy any shared nodes
+            return 0;
+        }
+
+        eraseIn(this->root_, 0, Hash{}(key), key);
+        this->size_--;
+        if (this->root_->entries.empty() && this->root_->children.empty())
+        {
+            this->root_.reset();
+        }
+        return 1;
+    }
+
+    /// Erases the entry at `it`. Unlike std::unordered_map, this doesn't
+    /// return an iterator to the next entry.
+    void erase(const_iterator it)
+    {
+        // copy the key, `it` points into a node that might be modified
+        auto key = it->first;
+        this->erase(key);
+    }
+
+    void clear()
+    {
+        this->root_.reset();
+        this->size_ = 0;
+    }
+
+    /// Calls `onChanged(key)` for each key that's only in one of the maps or
+    /// has a different value (compared with `!=`) in them.
+    ///
+    /// Nodes that are shared by the maps are skipped, so comparing a map to a
+    /// modified copy of it only looks at the modified paths.
+    template <typename F>
+    void diff(const PersistentHashMap &other, F &&onChanged) const
+    {
+        diffNodes(this->root_.get(), other.root_.get(), 0, onChanged);
+    }
+
+private:
+    static uint32_t bitOf(size_t hash, size_t shift)
+    {
+        return uint32_t{1} << ((hash >> shift) & ((1U << BITS) - 1));
+    }
+
+    static size_t indexOf(uint32_t bitmap, uint32_t bit)
+    {
+        return static_cast<size_t>(std::popcount(bitmap & (bit - 1)));
+    }
+
+    /// Makes sure `ptr` is only owned by this map (copying it if needed)
+    static Node &editable(NodePtr &ptr)
+    {
+        if (!ptr)
+        {
+            ptr = std::make_shared<Node>();
+        }
+        else if (ptr.use_count() != 1)
+        {
+            ptr = std::make_shared<Node>(*ptr);
+        }
+        return *ptr;
+    }
+
+    /// Adds `entry` to the (new) `node` at `shift`
+    static void place(Node &node, size_t shift, Entry &&entry)
+    {
+        if (shift < HASH_BITS)
+        {
+            node.dataMap |= bitOf(entry.hash, shift);
+        }
+        node.entries.emplace_back(std::move(entry));
+    }
+
+    /// Returns the value of `key` with all nodes on its path being editable.
+    /// Inserts a default-constructed value if there's none.
+    T &editableSlot(const Key &key, bool &inserted)
+    {
+        const auto hash = Hash{}(key);
+        Node *node = &editable(this->root_);
+        for (size_t shift = 0;; shift += BITS)
+        {
+            if (shift >= HASH_BITS)
+            {
+                for (auto &entry : node->entries)
+                {
+                    if (KeyEqual{}(entry.value.first, key))
+                    {
+                        return entry.value.second;
+                    }
+                }
+                inserted = true;
+                this->size_++;
+                return node->entries.emplace_back(Entry{hash, {key, T{}}})
+                    .value.second;
+            }
+
+            const auto bit = bitOf(hash, shift);
+            if ((node->dataMap & bit) != 0)
+            {
+                auto index = indexOf(node->dataMap, bit);
+                auto &entry = node->entries[index];
+                if (entry.hash == hash && KeyEqual{}(entry.value.first, key))
+                {
+                    return entry.value.second;
+                }
+
+                // Move the existing entry to a new child. The loop then
+                // inserts the new entry into that child.
+                auto child = std::make_shared<Node>();
+                place(*child, shift + BITS, std::move(entry));
+                node->entries.erase(node->entries.begin() +
+                                    static_cast<ptrdiff_t>(index));
+                node->dataMap &= ~bit;
+
+                node->children.insert(
+                    node->children.begin() +
+                        static_cast<ptrdiff_t>(indexOf(node->nodeMap, bit)),
+                    child);
+                node->nodeMap |= bit;
+                node = child.get();
+                continue;
+            }
+            if ((node->nodeMap & bit) != 0)
+            {
+                node = &editable(node->children[indexOf(node->nodeMap, bit)]);
+                continue;
+            }
+
+            inserted = true;
+            this->size_++;
+            auto it = node->entries.insert(
+                node->entries.begin() +
+                    static_cast<ptrdiff_t>(indexOf(node->dataMap, bit)),
+                Entry{hash, {key, T{}}});
+            node->dataMap |= bit;
+            return it->value.second;
+        }
+    }
+
+    /// Erases `key` (which must exist) from the subtree at `ptr`
+    static void eraseIn(NodePtr &ptr, size_t shift, size_t hash,
+                        const Key &key)
+    {
+        auto &node = editable(ptr);
+        if (shift >= HASH_BITS)
+        {
+            for (auto it = node.entries.begin(); it != node.entries.end(); ++it)
+            {
+                if (KeyEqual{}(it->value.first, key))
+                {
+                    node.entries.erase(it);
+                    return;
+                }
+            }
+            assert(false && "key must exist");
+            return;
+        }
+
+        const auto bit = bitOf(hash, shift);
+        if ((node.dataMap & bit) != 0)
+        {
+            node.entries.erase(node.entries.begin() +
+                               static_cast<ptrdiff_t>(
+                                   indexOf(node.dataMap, bit)));
+            node.dataMap &= ~bit;
+            return;
+        }
+
+        auto childIndex = indexOf(node.nodeMap, bit);
+        auto &child = node.children[childIndex];
+        eraseIn(child, shift + BITS, hash, key);
+
+        // Keep the trie compact: a child with a single entry is merged into
+        // this node.
+        if (child->children.empty() && child->entries.size() <= 1)
+        {
+            std::optional<Entry> last;
+            if (!child->entries.empty())
+            {
+                last = std::move(child->entries.front());
+            }
+            node.children.erase(node.children.begin() +
+                                static_cast<ptrdiff_t>(childIndex));
+            node.nodeMap &= ~bit;
+
+            if (last)
+            {
+                node.entries.insert(
+                    node.entries.begin() +
+                        static_cast<ptrdiff_t>(indexOf(node.dataMap, bit)),
+                    std::move(*last));
+                node.dataMap |= bit;
+            }
+        }
+    }
+
+    template <typename F>
+    static void forEachKey(const Node *node, F &onKey)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+        for (const auto &entry : node->entries)
+        {
+            onKey(entry.value.first);
+        }
+        for (const auto &child : node->children)
+        {
+            forEachKey(child.get(), onKey);
+        }
+    }
+
+    /// Diffs a subtree against a single entry at the same position
+    template <typename F>
+    static void diffEntry(const Node *node, const Entry &entry, F &onChanged)
+    {
+        bool found = false;
+        auto visit = [&](const Node *current, auto &self) -> void {
+            for (const auto &other : current->entries)
+            {
+                if (other.hash == entry.hash &&
+                    KeyEqual{}(other.value.first, entry.value.first))
+                {
+                    found = true;
+                    if (other.value.second != entry.value.second)
+                    {
+                        onChanged(entry.value.first);
+                    }
+                }
+                else
+                {
+                    onChanged(other.value.first);
+                }
+            }
+            for (const auto &child : current->children)
+            {
+                self(child.get(), self);
+            }
+        };
+        visit(node, visit);
+
+        if (!found)
+        {
+            onChanged(entry.value.first);
+        }
+    }
+
+    template <typename F>
+    static void diffNodes(const Node *a, const Node *b, size_t shift,
+                          F &onChanged)
+    {
+        if (a == b)
+        {
+            return;
+        }
+        if (a == nullptr || b == nullptr)
+        {
+            forEachKey(a != nullptr ? a : b, onChanged);
+            return;
+        }
+
+        if (shift >= HASH_BITS)
+        {
+            // Collisions: these are tiny
+            auto findIn = [](const Node *node,
+                             const Key &key) -> const Entry * {
+                for (const auto &entry : node->entries)
+                {
+                    if (KeyEqual{}(entry.value.first, key))
+                    {
+                        return &entry;
+                    }
+                }
+                return nullptr;
+            };
+            for (const auto &entry : a->entries)
+            {
+                const auto *other = findIn(b, entry.value.first);
+                if (!other || other->value.second != entry.value.second)
+                {
+                    onChanged(entry.value.first);
+                }
+            }
+            for (const auto &entry : b->entries)
+            {
+                if (!findIn(a, entry.value.first))
+                {
+                    onChanged(entry.value.first);
+                }
+            }
+            return;
+        }
+
+        auto bits = a->dataMap | a->nodeMap | b->dataMap | b->nodeMap;
+        while (bits != 0)
+        {
+            const uint32_t bit = bits & (~bits + 1);
+            bits &= ~bit;
+
+            const Entry *entryA = (a->dataMap & bit) != 0
+                                      ? &a->entries[indexOf(a->dataMap, bit)]
+                                      : nullptr;
+            const Entry *entryB = (b->dataMap & bit) != 0
+                                      ? &b->entries[indexOf(b->dataMap, bit)]
+                                      : nullptr;
+            const Node *childA =
+                (a->nodeMap & bit) != 0
+                    ? a->children[indexOf(a->nodeMap, bit)].get()
+                    : nullptr;
+            const Node *childB =
+                (b->nodeMap & bit) != 0
+                    ? b->children[indexOf(b->nodeMap, bit)].get()
+                    : nullptr;
+
+            if (entryA && entryB)
+            {
+                if (entryA->hash == entryB->hash &&
+                    KeyEqual{}(entryA->value.first, entryB->value.first))
+                {
+                    if (entryA->value.second != entryB->value.second)
+                    {
+                        onChanged(entryA->value.first);
+                    }
+                }
+                else
+                {
+                    onChanged(entryA->value.first);
+                    onChanged(entryB->value.first);
+                }
+            }
+            else if (entryA)
+            {
+                if (childB)
+                {
+                    diffEntry(childB, *entryA, onChanged);
+                }
+                else
+                {
+                    onChanged(entryA->value.first);
+                }
+            }
+            else if (entryB)
+            {
+                if (childA)
+                {
+                    diffEntry(childA, *entryB, onChanged);
+                }
+                else
+                {
+                    onChanged(entryB->value.first);
+                }
+            }
+            else
+            {
+                diffNodes(childA, childB, shift + BITS, onChanged);
+            }
+        }
+    }
+
+    NodePtr root_;
+    size_t size_ = 0;
+};
+
+}  // namespace chatterino
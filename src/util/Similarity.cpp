@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/Similarity.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+using namespace chatterino::similarity;
+
+size_t bucketOf(char16_t c)
+{
+    return static_cast<size_t>(c ^ (c >> 4) ^ (c >> 8)) %
+           Fingerprint::BUCKETS;
+}
+
+/// The text length used to compute the relative similarity
+qsizetype divisor(qsizetype a, qsizetype b)
+{
+    return std::max<qsizetype>({1, a, b});
+}
+
+}  // namespace
+
+namespace chatterino::similarity {
+
+Fingerprint Fingerprint::of(QStringView text)
+{
+    Fingerprint fp;
+    fp.length = text.size();
+    for (auto c : text)
+    {
+        auto &count = fp.counts[bucketOf(c.unicode())];
+        if (count < std::numeric_limits<uint16_t>::max())
+        {
+            count++;
+        }
+    }
+    return fp;
+}
+
+qsizetype Fingerprint::commonUpperBound(const Fingerprint &other) const
+{
+    auto shorter = std::min(this->length, other.length);
+    if (std::max(this->length, other.length) >=
+        std::numeric_limits<uint16_t>::max())
+    {
+        // The counts might be saturated
+        return shorter;
+    }
+
+    // Every character of a common substring is counted in both fingerprints
+    qsizetype common = 0;
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        common += std::min(this->counts[i], other.counts[i]);
+    }
+    return std::min(common, shorter);
+}
+
+qsizetype longestCommonSubstring(QStringView a, QStringView b,
+                                 qsizetype enough)
+{
+    auto n = a.size();
+    auto m = b.size();
+    if (enough < 0)
+    {
+        enough = std::min(n, m);
+    }
+
+    // Each common substring lies on a diagonal of the n×m match matrix
+    // (a[i + k] == b[j + k]). Walking the diagonals only needs the current
+    // run length. Diagonals shorter than the best run are skipped.
+    qsizetype best = 0;
+    for (qsizetype d = -(n - 1); d < m; d++)
+    {
+        qsizetype i = std::max<qsizetype>(0, -d);
+        qsizetype j = i + d;
+        qsizetype len = std::min(n - i, m - j);
+        if (len <= best)
+        {
+            continue;
+        }
+
+        const auto *pa = a.data() + i;
+        const auto *pb = b.data() + j;
+        qsizetype run = 0;
+        for (qsizetype k = 0; k < len; k++)
+        {
+            if (pa[k] == pb[k])
+            {
+                run++;
+                if (run > best)
+                {
+                    best = run;
+                    if (best >= enough)
+                    {
+                        return best;
+                    }
+                }
+            }
+            else
+            {
+                run = 0;
+                if (len - k - 1 <= best)
+                {
+                    // the rest of this diagonal can't beat the best run
+                    break;
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+float relativeSimilarity(QStringView a, QStringView b)
+{
+    auto z = longestCommonSubstring(a, b);
+    if (z == 0)
+    {
+        return 0.F;
+    }
+
+    return float(z) / float(divisor(a.size(), b.size()));
+}
+
+bool isSimilar(QStringView a, const Fingerprint &fa, QStringView b,
+               const Fingerprint &fb, float threshold)
+{
+    auto div = float(divisor(a.size(), b.size()));
+    auto isAbove = [&](qsizetype z) {
+        return z != 0 && float(z) / div > threshold;
+    };
+
+    auto bound = fa.commonUpperBound(fb);
+    if (!isAbove(bound))
+    {
+        return false;
+    }
+
+    // The shortest common substring that's similar enough
+    auto enough = std::max<qsizetype>(1, qsizetype(threshold * div));
+    while (enough > 1 && isAbove(enough - 1))
+    {
+        enough--;
+    }
+    while (!isAbove(enough))
+    {
+        enough++;
+    }
+
+    return isAbove(longestCommonSubstring(a, b, enough));
+}
+
+}  // namespace chatterino::similarity
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QStringView>
+
+#include <array>
+#include <cstdint>
+
+namespace chatterino::similarity {
+
+/// @brief A small summary of a text used to reject dissimilar texts early.
+///
+/// It counts the characters of the text in a few buckets. The common
+/// characters of two fingerprints are an upper bound for the longest common
+/// substring of the texts.
+struct Fingerprint {
+    static constexpr size_t BUCKETS = 16;
+
+    std::array<uint16_t, BUCKETS> counts{};
+    qsizetype length = 0;
+
+    static Fingerprint of(QStringView text);
+
+    /// Returns an upper bound for the length of the longest common substring
+    /// of the texts of this and `other`.
+    qsizetype commonUpperBound(const Fingerprint &other) const;
+};
+
+/// Returns the length of the longest common substring of `a` and `b`.
+///
+/// This doesn't allocate. It stops early once a substring of length
+/// `enough` is found.
+qsizetype longestCommonSubstring(QStringView a, QStringView b,
+                                 qsizetype enough = -1);
+
+/// Returns the length of the longest common substring relative to the
+/// length of the longer text (0 if there's none).
+float relativeSimilarity(QStringView a, QStringView b);
+
+/// Returns true if relativeSimilarity(a, b) is greater than `threshold`.
+///
+/// This is cheaper than comparing the result of relativeSimilarity(), as the
+/// fingerprints are checked first and the search stops as soon as a long
+/// enough substring is found.
+bool isSimilar(QStringView a, const Fingerprint &fa, QStringView b,
+               const Fingerprint &fb, float threshold);
+
+}  // namespace chatterino::similarity
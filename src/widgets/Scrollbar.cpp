@@ -4,6 +4,7 @@
 
 #include "widgets/Scrollbar.hpp"
 
+#include "Application.hpp"
 #include "common/QLogging.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
@@ -59,6 +60,12 @@ Scrollbar::Scrollbar(size_t messagesLimit, ChannelView *parent)
             this->update();
         },
         this->signalHolder);
+
+    // Highlight colors are changed in place, layouts are requested afterwards
+    this->signalHolder.managedConnect(getApp()->getWindows()->layoutRequested,
+                                      [this](Channel * /*channel*/) {
+                                          this->minimap_.invalidate();
+                                      });
 }
 
 boost::circular_buffer<ScrollbarHighlight> Scrollbar::getHighlights() const
@@ -69,6 +76,7 @@ boost::circular_buffer<ScrollbarHighlight> Scrollbar::getHighlights() const
 void Scrollbar::addHighlight(ScrollbarHighlight highlight)
 {
     this->highlights_.push_back(std::move(highlight));
+    this->minimap_.invalidate();
 }
 
 void Scrollbar::addHighlightsAtStart(
@@ -86,6 +94,7 @@ void Scrollbar::addHighlightsAtStart(
     {
         this->highlights_.push_front(highlights[highlights.size() - 1 - i]);
     }
+    this->minimap_.invalidate();
 }
 
 void Scrollbar::replaceHighlight(size_t index, ScrollbarHighlight replacement)
@@ -96,11 +105,13 @@ void Scrollbar::replaceHighlight(size_t index, ScrollbarHighlight replacement)
     }
 
     this->highlights_[index] = std::move(replacement);
+    this->minimap_.updateHighlight(this->highlights_, index);
 }
 
 void Scrollbar::clearHighlights()
 {
     this->highlights_.clear();
+    this->minimap_.invalidate();
 }
 
 void Scrollbar::scrollToBottom(bool animate)
@@ -297,12 +308,6 @@ void Scrollbar::paintEvent(QPaintEvent * /*event*/)
     QPainter painter(this);
     painter.fillRect(this->rect(), this->theme->scrollbars.background);
 
-    bool enableRedeemedHighlights = getSettings()->enableRedeemedHighlight;
-    bool enableFirstMessageHighlights =
-        getSettings()->enableFirstMessageHighlight;
-    bool enableElevatedMessageHighlights =
-        getSettings()->enableElevatedMessageHighlight;
-
     if (this->shouldShowThumb())
     {
         this->thumbRect_.setX(xOffset);
@@ -322,59 +327,14 @@ void Scrollbar::paintEvent(QPaintEvent * /*event*/)
 
     if (this->shouldShowHighlights() && !this->highlights_.empty())
     {
-        size_t nHighlights = this->highlights_.size();
-        int w = this->width();
-        float dY = static_cast<float>(this->height()) /
-                   static_cast<float>(nHighlights);
-        int highlightHeight =
-            static_cast<int>(std::ceil(std::max(this->scale() * 2.0F, dY)));
-
-        for (size_t i = 0; i < nHighlights; i++)
-        {
-            const auto &highlight = this->highlights_[i];
-
-            if (highlight.isNull())
-            {
-                continue;
-            }
-
-            if (highlight.isRedeemedHighlight() && !enableRedeemedHighlights)
-            {
-                continue;
-            }
-
-            if (highlight.isFirstMessageHighlight() &&
-                !enableFirstMessageHighlights)
-            {
-                continue;
-            }
-
-            if (highlight.isElevatedMessageHighlight() &&
-                !enableElevatedMessageHighlights)
-            {
-                continue;
-            }
-
-            QColor color = highlight.getColor();
-            color.setAlpha(255);
-
-            int y = static_cast<int>(dY * static_cast<float>(i));
-            switch (highlight.getStyle())
-            {
-                case ScrollbarHighlight::Default: {
-                    painter.fillRect(w / 8 * 3, y, w / 4, highlightHeight,
-                                     color);
-                }
-                break;
-
-                case ScrollbarHighlight::Line: {
-                    painter.fillRect(0, y, w, 1, color);
-                }
-                break;
-
-                case ScrollbarHighlight::None:;
-            }
-        }
+        ScrollbarMinimap::Filter filter{
+            .redeemed = getSettings()->enableRedeemedHighlight,
+            .firstMessage = getSettings()->enableFirstMessageHighlight,
+            .elevated = getSettings()->enableElevatedMessageHighlight,
+        };
+        painter.drawImage(0, 0,
+                          this->minimap_.image(this->highlights_, this->size(),
+                                               this->scale(), filter));
     }
 }
 
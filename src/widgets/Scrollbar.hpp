@@ -6,6 +6,7 @@
 
 #include "widgets/BaseWidget.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
+#include "widgets/helper/ScrollbarMinimap.hpp"
 
 #include <boost/circular_buffer.hpp>
 #include <pajlada/signals/signal.hpp>
@@ -187,6 +188,7 @@ private:
     QPropertyAnimation currentValueAnimation_;
 
     boost::circular_buffer<ScrollbarHighlight> highlights_;
+    ScrollbarMinimap minimap_;
 
     bool atBottom_{true};
     /// This takes precedence over `settingHideThumb`
@@ -117,7 +117,7 @@ bool checkMessageUserName(const QString &userName, MessagePtr message)
 
 ChannelPtr filterMessages(const QString &userName, ChannelPtr channel)
 {
-    std::vector<MessagePtr> snapshot = channel->getMessageSnapshot();
+    auto candidates = channel->getMessagesByUsers({userName});
 
     ChannelPtr channelPtr;
     if (channel->isTwitchChannel())
@@ -130,13 +130,15 @@ ChannelPtr filterMessages(const QString &userName, ChannelPtr channel)
             std::make_shared<Channel>(channel->getName(), Channel::Type::None);
     }
 
-    for (const auto &message : snapshot)
+    std::vector<AppendedMessage> filtered;
+    for (const auto &message : candidates)
     {
         if (checkMessageUserName(userName, message))
         {
-            channelPtr->addMessage(message, MessageContext::Repost);
+            filtered.push_back({.message = message, .overridingFlags = {}});
         }
     }
+    channelPtr->addMessages(filtered, MessageContext::Repost);
 
     return channelPtr;
 };
@@ -1064,8 +1066,9 @@ void UserInfoPopup::updateHeaderBadges()
 
     if (this->underlyingChannel_ != nullptr && !this->userName_.isEmpty())
     {
-        const auto snapshot = this->underlyingChannel_->getMessageSnapshot();
-        for (auto it = snapshot.rbegin(); it != snapshot.rend(); ++it)
+        const auto messages =
+            this->underlyingChannel_->getMessagesByUsers({this->userName_});
+        for (auto it = messages.rbegin(); it != messages.rend(); ++it)
         {
             const auto &message = *it;
             if (message == nullptr)
@@ -1125,8 +1128,9 @@ void UserInfoPopup::updateAvatarModelSummary()
 
     if (this->underlyingChannel_ != nullptr && !this->userName_.isEmpty())
     {
-        const auto snapshot = this->underlyingChannel_->getMessageSnapshot();
-        for (auto it = snapshot.rbegin(); it != snapshot.rend(); ++it)
+        const auto messages =
+            this->underlyingChannel_->getMessagesByUsers({this->userName_});
+        for (auto it = messages.rbegin(); it != messages.rend(); ++it)
         {
             const auto &message = *it;
             if (message == nullptr)
@@ -64,6 +64,7 @@
 #include <QDebug>
 #include <QDesktopServices>
 #include <QEasingCurve>
+#include <QElapsedTimer>
 #include <QGestureEvent>
 #include <QGraphicsBlurEffect>
 #include <QInputDialog>
@@ -493,6 +494,21 @@ float getTooltipScale(EmoteTooltipScale emoteTooltipScale)
     }
 }
 
+/// Moves the links of a visible message that are still waiting to be resolved
+/// ahead of the ones in the background
+void prioritizeLinks(MessageLayout &layout)
+{
+    for (const auto &element : layout.getMessage()->elements)
+    {
+        auto *link = dynamic_cast<LinkElement *>(element.get());
+        if (link != nullptr && link->linkInfo()->isLoading())
+        {
+            getApp()->getLinkResolver()->resolve(
+                link->linkInfo(), ILinkResolver::Priority::Visible);
+        }
+    }
+}
+
 }  // namespace
 
 namespace chatterino {
@@ -559,6 +575,13 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
         this->scrollUpdateRequested();
     });
 
+    this->offscreenLayoutTimer_.setSingleShot(true);
+    this->offscreenLayoutTimer_.setInterval(0);
+    QObject::connect(&this->offscreenLayoutTimer_, &QTimer::timeout, this,
+                     [this] {
+                         this->layoutOffscreenMessages();
+                     });
+
     this->grabGesture(Qt::PanGesture);
 
     // TODO: Figure out if we need this, and if so, why
@@ -900,6 +923,10 @@ void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
     this->goToBottom_->setVisible(this->enableScrollingToBottom_ &&
                                   this->scrollBar_->isVisible() &&
                                   !this->scrollBar_->isAtBottom());
+
+    // Lay out the surrounding messages once we're idle, so scrolling to them
+    // doesn't have to
+    this->offscreenLayoutTimer_.start();
 }
 
 void ChannelView::layoutVisibleMessages(
@@ -908,6 +935,7 @@ void ChannelView::layoutVisibleMessages(
     const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
     const auto layoutWidth = this->getLayoutWidth();
     const auto flags = this->getFlags();
+    const bool resolveLinks = getSettings()->linkInfoTooltip;
     auto redrawRequired = false;
 
     if (messages.size() > start)
@@ -929,6 +957,10 @@ void ChannelView::layoutVisibleMessages(
                                   static_cast<float>(this->devicePixelRatio()),
                 },
                 this->bufferInvalidationQueued_);
+            if (resolveLinks)
+            {
+                prioritizeLinks(*message);
+            }
 
             y += message->getHeight();
         }
@@ -1005,6 +1037,63 @@ void ChannelView::updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
     }
 }
 
+void ChannelView::layoutOffscreenMessages()
+{
+    if (!this->isVisible())
+    {
+        return;
+    }
+
+    const auto &messages = this->getMessagesSnapshot();
+    if (messages.empty())
+    {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const MessageLayoutContext ctx{
+        .messageColors = this->messageColors_,
+        .flags = this->getFlags(),
+        .width = this->getLayoutWidth(),
+        .scale = this->scale(),
+        .imageScale =
+            this->scale() * static_cast<float>(this->devicePixelRatio()),
+    };
+
+    // about one page in each direction
+    const auto pageSize =
+        static_cast<size_t>(std::ceil(this->scrollBar_->getPageSize())) + 1;
+    const auto distance = std::min(pageSize, OFFSCREEN_LAYOUT_LIMIT);
+    const auto start =
+        std::min(static_cast<size_t>(std::max(
+                     this->scrollBar_->getRelativeCurrentValue(), 0.0)),
+                 messages.size() - 1);
+    const auto end = std::min(start + pageSize, messages.size());
+
+    // messages that are already laid out are skipped quickly, so this starts
+    // at the viewport every time
+    for (size_t i = 1; i <= distance; i++)
+    {
+        if (i <= start)
+        {
+            messages[start - i]->layout(ctx, false);
+        }
+        if (end - 1 + i < messages.size())
+        {
+            messages[end - 1 + i]->layout(ctx, false);
+        }
+
+        if (timer.elapsed() >= OFFSCREEN_LAYOUT_BUDGET_MS)
+        {
+            // let the event loop run before continuing
+            this->offscreenLayoutTimer_.start();
+            return;
+        }
+    }
+}
+
 void ChannelView::clearMessages()
 {
     // Clear all stored messages in this chat widget
@@ -1111,7 +1200,14 @@ std::vector<MessageLayoutPtr> &ChannelView::getMessagesSnapshot()
     this->snapshotGuard_.guard();
     if (!this->paused() /*|| this->scrollBar_->isVisible()*/)
     {
-        this->snapshot_ = this->messages_.getSnapshot();
+        // This is called for every paint and mouse event, so only copy the
+        // layouts if they changed since the last snapshot
+        auto epoch = this->messages_.epoch();
+        if (epoch != this->snapshotEpoch_)
+        {
+            this->snapshot_ = this->messages_.getSnapshot();
+            this->snapshotEpoch_ = epoch;
+        }
     }
 
     return this->snapshot_;
@@ -1139,6 +1235,10 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     /// Clear connections from the last channel
     this->channelConnections_.clear();
 
+    // Messages that are still pending would be appended again after we copy
+    // the snapshot below
+    underlyingChannel->flushAppendedMessages();
+
     this->clearMessages();
     this->scrollBar_->clearHighlights();
 
@@ -1152,11 +1252,17 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     //
 
     this->channelConnections_.managedConnect(
-        underlyingChannel->messageAppended,
-        [this](MessagePtr &message,
-               std::optional<MessageFlags> overridingFlags) {
-            if (this->shouldIncludeMessage(message))
+        underlyingChannel->messagesAppended,
+        [this](std::span<const AppendedMessage> messages) {
+            std::vector<AppendedMessage> filtered;
+            filtered.reserve(messages.size());
+            for (const auto &appended : messages)
             {
+                if (!this->shouldIncludeMessage(appended.message))
+                {
+                    continue;
+                }
+
                 if (this->channel_->lastDate_ != QDate::currentDate())
                 {
                     // Day change message
@@ -1166,11 +1272,20 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
                                            QLocale::LongFormat),
                         QTime(0, 0));
                     msg->flags.set(MessageFlag::DoNotLog);
-                    this->channel_->addMessage(msg, MessageContext::Original);
+                    filtered.push_back({.message = msg, .overridingFlags = {}});
                 }
-                this->channel_->addMessage(message, MessageContext::Repost,
-                                           overridingFlags);
-                this->messageAddedToChannel(message);
+                filtered.push_back(appended);
+            }
+
+            if (filtered.empty())
+            {
+                return;
+            }
+
+            this->channel_->addMessages(filtered, MessageContext::Repost);
+            for (auto &appended : filtered)
+            {
+                this->messageAddedToChannel(appended.message);
             }
         });
 
@@ -1218,7 +1333,8 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     // and the ui.
     auto snapshot = underlyingChannel->getMessageSnapshot();
 
-    size_t nMessagesAdded = 0;
+    std::vector<AppendedMessage> copied;
+    copied.reserve(snapshot.size());
     for (const auto &msg : snapshot)
     {
         if (!this->shouldIncludeMessage(msg))
@@ -1242,14 +1358,17 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
 
         this->messages_.pushBack(messageLayout);
 
-        this->channel_->addMessage(msg, MessageContext::Repost);
+        copied.push_back({.message = msg, .overridingFlags = {}});
 
-        nMessagesAdded++;
         if (this->showScrollbarHighlights())
         {
             this->scrollBar_->addHighlight(msg->getScrollBarHighlight());
         }
     }
+    // We're not connected to the proxy channel yet, so this doesn't create
+    // layouts a second time
+    this->channel_->addMessages(copied, MessageContext::Repost);
+    size_t nMessagesAdded = copied.size();
 
     this->scrollBar_->setMaximum(
         static_cast<qreal>(std::min(nMessagesAdded, this->messages_.limit())));
@@ -1258,12 +1377,11 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     // Standard channel connections
     //
 
-    // on new message
+    // on new messages
     this->channelConnections_.managedConnect(
-        this->channel_->messageAppended,
-        [this](MessagePtr &message,
-               std::optional<MessageFlags> overridingFlags) {
-            this->messageAppended(message, overridingFlags);
+        this->channel_->messagesAppended,
+        [this](std::span<const AppendedMessage> messages) {
+            this->messagesAppended(messages);
         });
 
     this->channelConnections_.managedConnect(
@@ -1366,77 +1484,95 @@ bool ChannelView::hasSourceChannel() const
     return this->sourceChannel_ != nullptr;
 }
 
-void ChannelView::messageAppended(MessagePtr &message,
-                                  std::optional<MessageFlags> overridingFlags)
+void ChannelView::messagesAppended(std::span<const AppendedMessage> messages)
 {
-    auto *messageFlags = &message->flags;
-    if (overridingFlags)
+    if (messages.empty())
     {
-        messageFlags = &*overridingFlags;
+        return;
     }
 
-    auto messageRef = std::make_shared<MessageLayout>(message);
+    auto highlightState = HighlightState::None;
+    size_t nRemoved = 0;
 
-    if (this->lastMessageHasAlternateBackground_)
+    for (const auto &[message, overridingFlags] : messages)
     {
-        messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
-    }
-    if (this->channel_->shouldIgnoreHighlights())
-    {
-        messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        const auto &messageFlags =
+            overridingFlags ? *overridingFlags : message->flags;
+
+        auto messageRef = std::make_shared<MessageLayout>(message);
+
+        if (this->lastMessageHasAlternateBackground_)
+        {
+            messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
+        }
+        if (this->channel_->shouldIgnoreHighlights())
+        {
+            messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        }
+        this->lastMessageHasAlternateBackground_ =
+            !this->lastMessageHasAlternateBackground_;
+
+        if (this->messages_.pushBack(messageRef))
+        {
+            nRemoved++;
+        }
+
+        if (!messageFlags.has(MessageFlag::DoNotTriggerNotification))
+        {
+            if ((messageFlags.has(MessageFlag::Highlighted) &&
+                 messageFlags.has(MessageFlag::ShowInMentions) &&
+                 !messageFlags.has(MessageFlag::Subscription) &&
+                 (getSettings()->highlightMentions ||
+                  this->channel_->getType() !=
+                      Channel::Type::TwitchMentions)) ||
+                (this->channel_->getType() == Channel::Type::TwitchAutomod &&
+                 getSettings()->enableAutomodHighlight))
+            {
+                highlightState = HighlightState::Highlighted;
+            }
+            else if (highlightState == HighlightState::None)
+            {
+                highlightState = HighlightState::NewMessage;
+            }
+        }
+
+        if (this->showScrollbarHighlights())
+        {
+            this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        }
     }
-    this->lastMessageHasAlternateBackground_ =
-        !this->lastMessageHasAlternateBackground_;
 
     if (this->paused())
     {
-        this->pauseScrollMaximumOffset_++;
+        this->pauseScrollMaximumOffset_ += static_cast<int>(messages.size());
     }
     else
     {
-        this->scrollBar_->offsetMaximum(1);
+        this->scrollBar_->offsetMaximum(static_cast<qreal>(messages.size()));
     }
 
-    if (this->messages_.pushBack(messageRef))
+    if (nRemoved > 0)
     {
         if (this->paused())
         {
-            this->pauseScrollMinimumOffset_++;
-            this->pauseSelectionOffset_++;
+            this->pauseScrollMinimumOffset_ += static_cast<int>(nRemoved);
+            this->pauseSelectionOffset_ += static_cast<uint32_t>(nRemoved);
         }
         else
         {
-            this->scrollBar_->offsetMinimum(1);
+            this->scrollBar_->offsetMinimum(static_cast<qreal>(nRemoved));
             if (this->showingLatestMessages_ && !this->isVisible())
             {
                 this->scrollBar_->scrollToBottom(false);
             }
-            this->selection_.shiftMessageIndex(1);
-            this->doubleClickSelection_.shiftMessageIndex(1);
+            this->selection_.shiftMessageIndex(nRemoved);
+            this->doubleClickSelection_.shiftMessageIndex(nRemoved);
         }
     }
 
-    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
+    if (highlightState != HighlightState::None)
     {
-        if ((messageFlags->has(MessageFlag::Highlighted) &&
-             messageFlags->has(MessageFlag::ShowInMentions) &&
-             !messageFlags->has(MessageFlag::Subscription) &&
-             (getSettings()->highlightMentions ||
-              this->channel_->getType() != Channel::Type::TwitchMentions)) ||
-            (this->channel_->getType() == Channel::Type::TwitchAutomod &&
-             getSettings()->enableAutomodHighlight))
-        {
-            this->tabHighlightRequested.invoke(HighlightState::Highlighted);
-        }
-        else
-        {
-            this->tabHighlightRequested.invoke(HighlightState::NewMessage);
-        }
-    }
-
-    if (this->showScrollbarHighlights())
-    {
-        this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        this->tabHighlightRequested.invoke(highlightState);
     }
 
     this->queueLayout();
@@ -2358,7 +2494,8 @@ void ChannelView::mouseMoveEvent(QMouseEvent *event)
                 if (linkElement->linkInfo()->isPending())
                 {
                     getApp()->getLinkResolver()->resolve(
-                        linkElement->linkInfo());
+                        linkElement->linkInfo(),
+                        ILinkResolver::Priority::Visible);
                 }
                 this->setLinkInfoTooltip(linkElement->linkInfo());
             }
@@ -3350,6 +3487,10 @@ void ChannelView::mouseDoubleClickEvent(QMouseEvent *event)
 
 void ChannelView::hideEvent(QHideEvent * /*event*/)
 {
+    this->offscreenLayoutTimer_.stop();
+
+    // Buffers are shared with other views showing the same messages. Only the
+    // ones no visible view uses are freed.
     for (const auto &layout : this->messagesOnScreen_)
     {
         layout->deleteBuffer();
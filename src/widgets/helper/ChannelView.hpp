@@ -24,6 +24,7 @@
 #include <QWheelEvent>
 #include <QWidget>
 
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -34,6 +35,7 @@ class Channel;
 using ChannelPtr = std::shared_ptr<Channel>;
 
 struct Message;
+struct AppendedMessage;
 using MessagePtr = std::shared_ptr<const Message>;
 
 class MessageLayout;
@@ -81,6 +83,12 @@ public:
         Search,
     };
 
+    /// How many messages above and below the viewport are laid out in the
+    /// background (at most)
+    static constexpr size_t OFFSCREEN_LAYOUT_LIMIT = 64;
+    /// How long a batch of background layout may block the GUI thread
+    static constexpr qint64 OFFSCREEN_LAYOUT_BUDGET_MS = 4;
+
     /// Creates a channel view without a split.
     /// In such a view, usercards and reply-threads can't be opened.
     ///
@@ -279,8 +287,8 @@ private:
     void initializeScrollbar();
     void initializeSignals();
 
-    void messageAppended(MessagePtr &message,
-                         std::optional<MessageFlags> overridingFlags);
+    /// Adds layouts for `messages` and does a single layout pass
+    void messagesAppended(std::span<const AppendedMessage> messages);
     void messageAddedAtStart(std::vector<MessagePtr> &messages);
     void messageRemoveFromStart(MessagePtr &message);
     void messageReplaced(size_t hint, const MessagePtr &prev,
@@ -292,6 +300,9 @@ private:
     void layoutVisibleMessages(const std::vector<MessageLayoutPtr> &messages);
     void updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
                          bool causedByScrollbar, bool causedByShow);
+    /// Lays out a batch of the messages around the viewport and reschedules
+    /// itself until they're all laid out or the view is hidden.
+    void layoutOffscreenMessages();
 
     void drawMessages(QPainter &painter, const QRect &area);
     void setSelection(const SelectionItem &start, const SelectionItem &end);
@@ -357,6 +368,8 @@ private:
 
     ThreadGuard snapshotGuard_;
     std::vector<MessageLayoutPtr> snapshot_;
+    /// The LimitedQueue::epoch() of #messages_ when #snapshot_ was taken
+    uint64_t snapshotEpoch_ = UINT64_MAX;
 
     /// @brief The backing (internal) channel
     ///
@@ -422,6 +435,9 @@ private:
     QPointF currentMousePosition_;
     QTimer scrollTimer_;
 
+    /// Runs layoutOffscreenMessages() when the event loop is idle
+    QTimer offscreenLayoutTimer_;
+
     // We're only interested in the pointer, not the contents
     MessageLayout *highlightedMessage_ = nullptr;
     QVariantAnimation highlightAnimation_;
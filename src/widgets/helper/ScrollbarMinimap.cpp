@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "widgets/helper/ScrollbarMinimap.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace chatterino {
+
+void ScrollbarMinimap::invalidate()
+{
+    this->valid_ = false;
+}
+
+void ScrollbarMinimap::updateHighlight(
+    const boost::circular_buffer<ScrollbarHighlight> &highlights, size_t index)
+{
+    if (!this->valid_ || index >= highlights.size())
+    {
+        return;
+    }
+    if (highlights.size() != this->nHighlights_)
+    {
+        this->valid_ = false;
+        return;
+    }
+
+    // Line highlights only cover the first of these rows
+    int rowBegin = this->rowOf(index);
+    int rowEnd =
+        std::min(rowBegin + this->highlightHeight_, this->size_.height());
+    if (rowBegin >= rowEnd)
+    {
+        return;
+    }
+
+    std::fill(this->rows_.begin() + rowBegin, this->rows_.begin() + rowEnd,
+              Row{});
+
+    // Rows only ever grow with the index, so the highlights that might cover
+    // these rows are right next to this one
+    size_t first = index;
+    while (first > 0 &&
+           this->rowOf(first - 1) + this->highlightHeight_ > rowBegin)
+    {
+        first--;
+    }
+    for (size_t i = first;
+         i < highlights.size() && this->rowOf(i) < rowEnd; i++)
+    {
+        this->apply(highlights[i], i, rowBegin, rowEnd);
+    }
+
+    this->drawRows(rowBegin, rowEnd);
+}
+
+const QImage &ScrollbarMinimap::image(
+    const boost::circular_buffer<ScrollbarHighlight> &highlights, QSize size,
+    float scale, Filter filter)
+{
+    if (!this->valid_ || size != this->size_ || scale != this->scale_ ||
+        filter != this->filter_ || highlights.size() != this->nHighlights_)
+    {
+        this->size_ = size;
+        this->scale_ = scale;
+        this->filter_ = filter;
+        this->build(highlights);
+    }
+
+    return this->image_;
+}
+
+void ScrollbarMinimap::build(
+    const boost::circular_buffer<ScrollbarHighlight> &highlights)
+{
+    int height = std::max(this->size_.height(), 0);
+
+    this->nHighlights_ = highlights.size();
+    this->dY_ = this->nHighlights_ == 0
+                    ? 0
+                    : static_cast<float>(height) /
+                          static_cast<float>(this->nHighlights_);
+    this->highlightHeight_ = std::max(
+        static_cast<int>(std::ceil(std::max(this->scale_ * 2.0F, this->dY_))),
+        1);
+
+    this->rows_.assign(static_cast<size_t>(height), Row{});
+    for (size_t i = 0; i < highlights.size(); i++)
+    {
+        this->apply(highlights[i], i, 0, height);
+    }
+
+    if (this->image_.size() != this->size_)
+    {
+        this->image_ = this->size_.isEmpty()
+                           ? QImage()
+                           : QImage(this->size_,
+                                    QImage::Format_ARGB32_Premultiplied);
+    }
+    this->drawRows(0, height);
+
+    this->valid_ = true;
+}
+
+int ScrollbarMinimap::rowOf(size_t index) const
+{
+    return static_cast<int>(this->dY_ * static_cast<float>(index));
+}
+
+void ScrollbarMinimap::apply(const ScrollbarHighlight &highlight, size_t index,
+                             int rowBegin, int rowEnd)
+{
+    if (highlight.isNull())
+    {
+        return;
+    }
+
+    if (highlight.isRedeemedHighlight() && !this->filter_.redeemed)
+    {
+        return;
+    }
+
+    if (highlight.isFirstMessageHighlight() && !this->filter_.firstMessage)
+    {
+        return;
+    }
+
+    if (highlight.isElevatedMessageHighlight() && !this->filter_.elevated)
+    {
+        return;
+    }
+
+    QColor color = highlight.getColor();
+    color.setAlpha(255);
+    // opaque, so this is already premultiplied
+    QRgb rgb = color.rgba();
+
+    int y = this->rowOf(index);
+    switch (highlight.getStyle())
+    {
+        case ScrollbarHighlight::Default: {
+            int end = std::min(y + this->highlightHeight_, rowEnd);
+            for (int row = std::max(y, rowBegin); row < end; row++)
+            {
+                this->rows_[row].center = rgb;
+            }
+        }
+        break;
+
+        case ScrollbarHighlight::Line: {
+            if (y >= rowBegin && y < rowEnd)
+            {
+                this->rows_[y] = {.line = rgb, .center = rgb};
+            }
+        }
+        break;
+
+        case ScrollbarHighlight::None:;
+    }
+}
+
+void ScrollbarMinimap::drawRows(int rowBegin, int rowEnd)
+{
+    if (this->image_.isNull())
+    {
+        return;
+    }
+
+    int width = this->image_.width();
+    int centerX = width / 8 * 3;
+    int centerWidth = width / 4;
+
+    for (int row = rowBegin; row < rowEnd; row++)
+    {
+        auto *pixels = reinterpret_cast<QRgb *>(this->image_.scanLine(row));
+        const auto &colors = this->rows_[row];
+
+        std::fill_n(pixels, width, colors.line);
+        if (colors.center != 0)
+        {
+            std::fill_n(pixels + centerX, centerWidth, colors.center);
+        }
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "widgets/helper/ScrollbarHighlight.hpp"
+
+#include <boost/circular_buffer.hpp>
+#include <QImage>
+#include <QRgb>
+#include <QSize>
+
+#include <cstddef>
+#include <vector>
+
+namespace chatterino {
+
+/// @brief The highlights of a Scrollbar, drawn into an image
+///
+/// Every pixel row of the scrollbar keeps the colors of the highlights drawn
+/// there. If highlights overlap, the newest one (the one with the highest
+/// index) wins, just like when painting them one after another.
+///
+/// Adding a highlight moves every other highlight (either because the buffer
+/// is full or because the spacing between highlights changes), so additions
+/// only mark the minimap as outdated. It's then redrawn at most once when it's
+/// painted the next time. Replacing a highlight only redraws the rows it
+/// covers. Everything else (scrolling, hovering) just draws the cached image.
+class ScrollbarMinimap
+{
+public:
+    /// Which kinds of highlights are shown
+    struct Filter {
+        bool redeemed = true;
+        bool firstMessage = true;
+        bool elevated = true;
+
+        bool operator==(const Filter &other) const = default;
+    };
+
+    /// Marks the minimap as outdated, it will be redrawn on the next call to
+    /// image()
+    void invalidate();
+
+    /// Redraws the rows covered by the highlight at `index` after it was
+    /// replaced
+    void updateHighlight(
+        const boost::circular_buffer<ScrollbarHighlight> &highlights,
+        size_t index);
+
+    /// Returns the highlights drawn into an image of `size`, redrawing them if
+    /// anything changed since the last call
+    const QImage &image(
+        const boost::circular_buffer<ScrollbarHighlight> &highlights,
+        QSize size, float scale, Filter filter);
+
+private:
+    struct Row {
+        /// Color across the whole width (Line highlights)
+        QRgb line = 0;
+        /// Color in the middle of the row (Default and Line highlights)
+        QRgb center = 0;
+    };
+
+    void build(const boost::circular_buffer<ScrollbarHighlight> &highlights);
+
+    /// First row of the highlight at `index`
+    int rowOf(size_t index) const;
+
+    /// Writes the highlight at `index` to the rows in [rowBegin, rowEnd)
+    void apply(const ScrollbarHighlight &highlight, size_t index, int rowBegin,
+               int rowEnd);
+
+    /// Draws the rows in [rowBegin, rowEnd) into the image
+    void drawRows(int rowBegin, int rowEnd);
+
+    bool valid_ = false;
+    QSize size_;
+    float scale_ = 1;
+    Filter filter_;
+    size_t nHighlights_ = 0;
+
+    /// Distance between two highlights
+    float dY_ = 0;
+    /// Height of Default highlights
+    int highlightHeight_ = 0;
+
+    std::vector<Row> rows_;
+    QImage image_;
+};
+
+}  // namespace chatterino
@@ -30,18 +30,39 @@
 namespace chatterino {
 
 ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const std::vector<MessagePtr> &snapshot)
+                               const std::vector<MessagePtr> &snapshot,
+                               const Channel *source)
 {
     ChannelPtr channel(new Channel(channelName, Channel::Type::None));
 
     // Parse predicates from tags in "text"
     auto predicates = parsePredicates(text);
 
+    // With "from:", only the messages of these users can match, so there's no
+    // need to check every message
+    std::vector<MessagePtr> candidates;
+    const auto *messages = &snapshot;
+    if (source)
+    {
+        for (const auto &pred : predicates)
+        {
+            const auto *author =
+                dynamic_cast<const AuthorPredicate *>(pred.get());
+            if (author && !author->isNegated())
+            {
+                candidates = source->getMessagesByUsers(author->authors());
+                messages = &candidates;
+                break;
+            }
+        }
+    }
+
+    std::vector<AppendedMessage> accepted;
+
     // Check for every message whether it fulfills all predicates that have
     // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
+    for (const auto &message : *messages)
     {
-        MessagePtr message = snapshot[i];
 
         bool accept = true;
         for (const auto &pred : predicates)
@@ -60,10 +81,15 @@ ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
             auto overrideFlags = std::optional<MessageFlags>(message->flags);
             overrideFlags->set(MessageFlag::DoNotLog);
 
-            channel->addMessage(message, MessageContext::Repost, overrideFlags);
+            accepted.push_back({
+                .message = message,
+                .overridingFlags = overrideFlags,
+            });
         }
     }
 
+    channel->addMessages(accepted, MessageContext::Repost);
+
     return channel;
 }
 
@@ -233,8 +259,16 @@ void SearchPopup::search()
         this->snapshot_ = this->buildSnapshot();
     }
 
+    // The user index only covers a single channel
+    const Channel *source = nullptr;
+    if (this->searchChannels_.length() == 1)
+    {
+        source = this->searchChannels_.at(0).get().channel().get();
+    }
+
     this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
+                                          this->channelName_, this->snapshot_,
+                                          source));
 }
 
 std::vector<MessagePtr> SearchPopup::buildSnapshot()
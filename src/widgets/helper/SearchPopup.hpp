@@ -50,13 +50,16 @@ private:
      * @param text          the search query -- will be parsed for MessagePredicates
      * @param channelName   name of the channel to be returned
      * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
+     * @param source        if set, the channel "snapshot" was taken from.
+     *                      Queries with "from:" look up the candidates in its
+     *                      user index instead of scanning "snapshot".
      *
      * @return a ChannelPtr with "channelName" and the filtered messages from
      *         "snapshot"
      */
     static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const std::vector<MessagePtr> &snapshot);
+                             const std::vector<MessagePtr> &snapshot,
+                             const Channel *source = nullptr);
 
     /**
      * @brief Checks the input for tags and registers their corresponding
@@ -6,6 +6,7 @@
 
 #include "Application.hpp"
 #include "common/Literals.hpp"  // IWYU pragma: keep
+#include "common/network/NetworkCache.hpp"
 #include "common/Version.hpp"
 #include "controllers/hotkeys/HotkeyCategory.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
@@ -745,6 +746,27 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         ->addKeywords({"seventv"})
         ->addTo(layout);
 
+    SettingWidget::intInput("Image memory budget in MiB (0 = unlimited)",
+                            s.imageMemoryBudget,
+                            SettingWidget::IntInputParams{
+                                .min = 0,
+                                .max = 16384,
+                                .singleStep = 64,
+                            })
+        ->setTooltip("When emotes and badges take up more memory than this, "
+                     "the ones that haven't been shown for the longest time "
+                     "are unloaded. They're loaded again once they're shown.")
+        ->addKeywords({"ram", "memory", "cache"})
+        ->addTo(layout);
+
+    SettingWidget::dropdown("Animated emote frames", s.animatedFrameMode)
+        ->setTooltip("Keeping all frames in memory uses the least CPU. "
+                     "Decoding frames as needed only keeps a few frames of "
+                     "each animated emote in memory, which helps a lot with "
+                     "large animated 7TV emotes.")
+        ->addKeywords({"ram", "memory", "gif", "animation"})
+        ->addTo(layout);
+
     layout.addTitle("Streamer Mode");
     layout.addDescription(
         "Chatterino can automatically change behavior if it detects that any "
@@ -819,6 +841,11 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         "privacy-policy\">Privacy Policy</a>.");
 
     SettingWidget::checkbox("Enable", s.linkInfoTooltip)->addTo(layout);
+    SettingWidget::checkbox("Cache link previews on disk", s.linkInfoDiskCache)
+        ->setTooltip("When enabled, link previews are stored in the cache "
+                     "directory and reused for up to a week, even after a "
+                     "restart.")
+        ->addTo(layout);
 
     layout.addDropdown<int>(
         "Also show thumbnails if available",
@@ -1030,6 +1057,7 @@ void GeneralPage::initLayout(GeneralPageView &layout)
 
             if (reply == QMessageBox::Yes)
             {
+                NetworkCache::closeGlobal();
                 auto cacheDir = QDir(getApp()->getPaths().cacheDirectory());
                 cacheDir.removeRecursively();
                 cacheDir.mkdir(getApp()->getPaths().cacheDirectory());
@@ -1040,6 +1068,18 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         layout.addLayout(box);
     }
 
+    SettingWidget::intInput("Maximum cache size in MiB (0 = unlimited)",
+                            s.cacheMaxSize,
+                            SettingWidget::IntInputParams{
+                                .min = 0,
+                                .max = 65536,
+                                .singleStep = 256,
+                            })
+        ->setTooltip("When the cache grows larger than this, the files that "
+                     "haven't been used for the longest time are removed.")
+        ->addKeywords({"disk", "storage"})
+        ->addTo(layout);
+
     layout.addTitle("Advanced");
 
     layout.addSubtitle("Chat title");
@@ -1691,6 +1731,14 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                 .arg(CrashHandler::crashUploadUrl()))
         ->addTo(layout);
 
+    SettingWidget::checkbox("Build chat messages in the background",
+                            s.buildMessagesInBackground)
+        ->setTooltip("Parse emotes, badges, and highlights of incoming "
+                     "messages on worker threads, so busy chats don't slow "
+                     "down the interface.")
+        ->addKeywords({"performance", "threads"})
+        ->addTo(layout);
+
 #if defined(Q_OS_LINUX) && !defined(NO_QTKEYCHAIN)
     if (!getApp()->getPaths().isPortable())
     {
@@ -17,9 +17,12 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Settings.hpp"
 
+#include <QTextBlock>
 #include <QTextCharFormat>
 #include <QTextDocument>
 
+#include <algorithm>
+
 namespace {
 
 using namespace chatterino;
@@ -117,6 +120,12 @@ InputHighlighter::InputHighlighter(SpellChecker &spellChecker, QObject *parent)
 {
     this->spellFmt.setUnderlineStyle(QTextCharFormat::SpellCheckUnderline);
     this->spellFmt.setUnderlineColor(Qt::red);
+
+    this->signalHolder.managedConnect(
+        this->spellChecker.wordsChecked,
+        [this](const std::vector<QString> &words) {
+            this->onWordsChecked(words);
+        });
 }
 InputHighlighter::~InputHighlighter() = default;
 
@@ -129,11 +138,17 @@ void InputHighlighter::setChannel(const std::shared_ptr<Channel> &channel)
 
 std::vector<QString> InputHighlighter::getSpellCheckedWords(const QString &text)
 {
+    auto channel = this->channel.lock();
+
     std::vector<QString> words;
-    this->visitWords(text, [&](const QString &word, qsizetype /*start*/,
-                               qsizetype /*count*/) {
-        words.emplace_back(word);
-    });
+    this->visitWords(channel.get(), text,
+                     [&](const QString &word, qsizetype /*start*/,
+                         qsizetype /*count*/) {
+                         if (!isIgnoredWord(channel.get(), word))
+                         {
+                             words.emplace_back(word);
+                         }
+                     });
     return words;
 }
 
@@ -143,22 +158,80 @@ void InputHighlighter::highlightBlock(const QString &text)
     {
         return;
     }
+
+    auto channel = this->channel.lock();
+    auto blockNumber = this->currentBlock().blockNumber();
+
     this->visitWords(
-        text, [&](const QString &word, qsizetype start, qsizetype count) {
-            if (!this->spellChecker.check(word))
+        channel.get(), text,
+        [&](const QString &word, qsizetype start, qsizetype count) {
+            auto correct = this->spellChecker.cachedCheck(word);
+            // Most words are spelled correctly, these don't need to be looked
+            // up in the emotes and chatters
+            if (correct == true || isIgnoredWord(channel.get(), word))
+            {
+                return;
+            }
+
+            if (!correct)
             {
-                this->setFormat(static_cast<int>(start),
-                                static_cast<int>(count), this->spellFmt);
+                auto &blocks = this->pendingBlocks[word];
+                if (std::ranges::find(blocks, blockNumber) == blocks.end())
+                {
+                    blocks.emplace_back(blockNumber);
+                }
+                this->spellChecker.checkAsync(word);
+                return;
             }
+
+            this->setFormat(static_cast<int>(start), static_cast<int>(count),
+                            this->spellFmt);
         });
 }
 
+void InputHighlighter::onWordsChecked(const std::vector<QString> &words)
+{
+    std::vector<int> blockNumbers;
+    for (const auto &word : words)
+    {
+        auto it = this->pendingBlocks.find(word);
+        if (it == this->pendingBlocks.end())
+        {
+            continue;
+        }
+        for (int blockNumber : it->second)
+        {
+            if (std::ranges::find(blockNumbers, blockNumber) ==
+                blockNumbers.end())
+            {
+                blockNumbers.emplace_back(blockNumber);
+            }
+        }
+        this->pendingBlocks.erase(it);
+    }
+
+    auto *document = this->document();
+    if (!document)
+    {
+        return;
+    }
+
+    // The blocks might have changed in the meantime. In that case, they were
+    // already highlighted again and this only repeats that.
+    for (int blockNumber : blockNumbers)
+    {
+        auto block = document->findBlockByNumber(blockNumber);
+        if (block.isValid())
+        {
+            this->rehighlightBlock(block);
+        }
+    }
+}
+
 void InputHighlighter::visitWords(
-    const QString &text,
+    TwitchChannel *channel, const QString &text,
     std::invocable<const QString &, qsizetype, qsizetype> auto &&cb)
 {
-    auto *channel = this->channel.lock().get();
-
     QStringView textView = text;
 
     // skip leading command trigger
@@ -184,13 +257,10 @@ void InputHighlighter::visitWords(
             auto wordMatch = wordIt.next();
             auto word = wordMatch.captured();
 
-            if (!isIgnoredWord(channel, word))
-            {
-                cb(word,
-                   static_cast<int>(cmdTriggerLen + tokenMatch.capturedStart() +
-                                    wordMatch.capturedStart()),
-                   static_cast<int>(word.size()));
-            }
+            cb(word,
+               static_cast<int>(cmdTriggerLen + tokenMatch.capturedStart() +
+                                wordMatch.capturedStart()),
+               static_cast<int>(word.size()));
         }
     }
 }
@@ -4,12 +4,17 @@
 
 #pragma once
 
+#include "util/QStringHash.hpp"
+
+#include <pajlada/signals/signalholder.hpp>
 #include <QRegularExpression>
 #include <QString>
 #include <QSyntaxHighlighter>
 
 #include <concepts>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 class QTextDocument;
 
@@ -27,6 +32,10 @@ QRegularExpression wordRegex();
 
 /// This highlights the text in the split input.
 /// Currently, it only does spell checking.
+///
+/// Words are looked up in the spell checker's cache. Words that aren't cached
+/// yet are checked in the background, and the blocks containing them are
+/// highlighted again once their results arrive.
 class InputHighlighter : public QSyntaxHighlighter
 {
 public:
@@ -47,15 +56,22 @@ protected:
     void highlightBlock(const QString &text) override;
 
 private:
-    /// Visit all words that are not ignored
+    /// Visit all words that are not part of an ignored token (emotes and
+    /// links). Words can still be emotes or chatters (see isIgnoredWord).
     void visitWords(
-        const QString &text,
+        TwitchChannel *channel, const QString &text,
         std::invocable</*word=*/const QString &, /*start=*/qsizetype,
                        /*count=*/qsizetype> auto &&cb);
 
+    void onWordsChecked(const std::vector<QString> &words);
+
     SpellChecker &spellChecker;
     QTextCharFormat spellFmt;
 
+    /// Words that are being checked -> numbers of the blocks containing them
+    std::unordered_map<QString, std::vector<int>> pendingBlocks;
+    pajlada::Signals::SignalHolder signalHolder;
+
     std::weak_ptr<TwitchChannel> channel;
 
     QRegularExpression wordRegex;
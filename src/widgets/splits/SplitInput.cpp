@@ -1075,18 +1075,28 @@ void SplitInput::installTextEditEvents()
             auto cursor = this->ui_.textEdit->cursorForPosition(pos);
             cursor.select(QTextCursor::WordUnderCursor);
             auto word = cursor.selectedText();
-            if (!word.isEmpty())
+            auto *spellChecker = getApp()->getSpellChecker();
+            if (!word.isEmpty() && spellChecker->isLoaded() &&
+                spellChecker->cachedCheck(word) != true)
             {
-                auto suggestions =
-                    getApp()->getSpellChecker()->suggestions(word);
-                for (const auto &sugg : suggestions)
-                {
-                    auto qSugg = QString::fromStdString(sugg);
-                    menu->addAction(qSugg, [this, qSugg, cursor]() mutable {
-                        cursor.insertText(qSugg);
-                        this->ui_.textEdit->setTextCursor(cursor);
+                // The suggestions are added while the menu is already open
+                auto *loadingAction = menu->addAction("Loading suggestions...");
+                loadingAction->setEnabled(false);
+                spellChecker->suggestionsAsync(
+                    word, menu,
+                    [this, menu, loadingAction,
+                     cursor](const std::vector<QString> &suggestions) {
+                        menu->removeAction(loadingAction);
+                        loadingAction->deleteLater();
+                        for (const auto &sugg : suggestions)
+                        {
+                            menu->addAction(
+                                sugg, [this, sugg, cursor]() mutable {
+                                    cursor.insertText(sugg);
+                                    this->ui_.textEdit->setTextCursor(cursor);
+                                });
+                        }
                     });
-                }
             }
 #else
             (void)menu;
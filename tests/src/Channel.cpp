@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/Channel.hpp"
+
+#include "messages/Message.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "mocks/Channel.hpp"
+#include "mocks/Logging.hpp"
+#include "Test.hpp"
+
+#include <pajlada/signals/scoped-connection.hpp>
+#include <QCoreApplication>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace chatterino;
+using chatterino::mock::MockChannel;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication() = default;
+
+    ILogging *getChatLogger() override
+    {
+        return &this->logging;
+    }
+
+    mock::EmptyLogging logging;
+};
+
+MessagePtr makeMessage()
+{
+    return std::make_shared<Message>();
+}
+
+/// Records the batches of Channel::messagesAppended
+struct BatchRecorder {
+    explicit BatchRecorder(Channel &channel)
+        : connection(channel.messagesAppended.connect(
+              [this](std::span<const AppendedMessage> messages) {
+                  auto &batch = this->batches.emplace_back();
+                  for (const auto &appended : messages)
+                  {
+                      batch.push_back(appended.message);
+                  }
+              }))
+    {
+    }
+
+    std::vector<std::vector<MessagePtr>> batches;
+    pajlada::Signals::ScopedConnection connection;
+};
+
+}  // namespace
+
+TEST(Channel, CoalescesAppends)
+{
+    MockApplication app;
+    MockChannel channel("test");
+    BatchRecorder recorder(channel);
+
+    size_t nAppended = 0;
+    std::ignore = channel.messageAppended.connect([&](auto &&...) {
+        nAppended++;
+    });
+
+    auto a = makeMessage();
+    auto b = makeMessage();
+    auto c = makeMessage();
+    channel.addMessage(a, MessageContext::Repost);
+    channel.addMessage(b, MessageContext::Repost);
+    channel.addMessage(c, MessageContext::Repost);
+
+    // messageAppended is still invoked right away
+    ASSERT_EQ(nAppended, 3);
+    ASSERT_EQ(channel.countMessages(), 3);
+    ASSERT_TRUE(recorder.batches.empty());
+
+    QCoreApplication::processEvents();
+
+    ASSERT_EQ(recorder.batches.size(), 1);
+    ASSERT_EQ(recorder.batches[0], (std::vector<MessagePtr>{a, b, c}));
+
+    QCoreApplication::processEvents();
+    ASSERT_EQ(recorder.batches.size(), 1);
+}
+
+TEST(Channel, AddMessagesIsImmediate)
+{
+    MockApplication app;
+    MockChannel channel("test");
+    BatchRecorder recorder(channel);
+
+    auto a = makeMessage();
+    auto b = makeMessage();
+    auto c = makeMessage();
+    channel.addMessage(a, MessageContext::Repost);
+
+    std::vector<AppendedMessage> batch{
+        {.message = b, .overridingFlags = {}},
+        {.message = c, .overridingFlags = {}},
+    };
+    channel.addMessages(batch, MessageContext::Repost);
+
+    // the pending message is flushed before the batch
+    ASSERT_EQ(recorder.batches.size(), 2);
+    ASSERT_EQ(recorder.batches[0], std::vector<MessagePtr>{a});
+    ASSERT_EQ(recorder.batches[1], (std::vector<MessagePtr>{b, c}));
+    ASSERT_EQ(channel.getMessageSnapshot(), (std::vector<MessagePtr>{a, b, c}));
+}
+
+TEST(Channel, FlushesBeforeReplace)
+{
+    MockApplication app;
+    MockChannel channel("test");
+    BatchRecorder recorder(channel);
+
+    bool flushedBeforeReplace = false;
+    std::ignore = channel.messageReplaced.connect([&](auto &&...) {
+        flushedBeforeReplace = recorder.batches.size() == 1;
+    });
+
+    auto a = makeMessage();
+    channel.addMessage(a, MessageContext::Repost);
+    channel.replaceMessage(a, makeMessage());
+
+    ASSERT_TRUE(flushedBeforeReplace);
+}
+
+TEST(Channel, ClearDropsPending)
+{
+    MockApplication app;
+    MockChannel channel("test");
+    BatchRecorder recorder(channel);
+
+    channel.addMessage(makeMessage(), MessageContext::Repost);
+    channel.clearMessages();
+
+    QCoreApplication::processEvents();
+    ASSERT_TRUE(recorder.batches.empty());
+    ASSERT_FALSE(channel.hasMessages());
+}
@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "widgets/helper/ChannelView.hpp"
+
+#include "common/Channel.hpp"
+#include "common/Literals.hpp"
+#include "controllers/accounts/AccountController.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageElement.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "singletons/Fonts.hpp"
+#include "singletons/Settings.hpp"
+#include "singletons/Theme.hpp"
+#include "singletons/WindowManager.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication()
+        : windowManager(this->args, this->paths_, this->settings, this->theme,
+                        this->fonts)
+    {
+    }
+
+    WindowManager *getWindows() override
+    {
+        return &this->windowManager;
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    WindowManager windowManager;
+    AccountController accounts;
+};
+
+MessagePtr makeMessage()
+{
+    return std::make_shared<Message>();
+}
+
+MessagePtr makeTextMessage(size_t i)
+{
+    auto message = std::make_shared<Message>();
+    message->messageText = u"message "_s + QString::number(i);
+    message->elements.emplace_back(std::make_unique<TextElement>(
+        message->messageText, MessageElementFlag::Text));
+    return message;
+}
+
+std::shared_ptr<Channel> makeTextChannel(size_t count)
+{
+    auto channel = std::make_shared<Channel>("test", Channel::Type::None);
+    for (size_t i = 0; i < count; i++)
+    {
+        channel->addMessage(makeTextMessage(i), MessageContext::Repost);
+    }
+    return channel;
+}
+
+/// Processes events until `done` returns true (or 5s passed)
+bool waitFor(const std::function<bool()> &done)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return done();
+}
+
+/// Waits until the background layout reached the message
+/// OFFSCREEN_LAYOUT_LIMIT above the viewport and returns its index.
+size_t waitForOffscreenLayout(ChannelView &view,
+                              const std::vector<MessageLayoutPtr> &messages)
+{
+    size_t first = 0;
+    bool done = waitFor([&] {
+        auto start =
+            static_cast<size_t>(view.getScrollBar().getRelativeCurrentValue());
+        if (start <= ChannelView::OFFSCREEN_LAYOUT_LIMIT)
+        {
+            return false;
+        }
+        first = start - ChannelView::OFFSCREEN_LAYOUT_LIMIT;
+        return messages.back()->getWidth() > 0 &&
+               messages[first]->getWidth() == messages.back()->getWidth();
+    });
+    EXPECT_TRUE(done);
+
+    // Give the pass a chance to (wrongly) continue
+    for (int i = 0; i < 10; i++)
+    {
+        QCoreApplication::processEvents();
+    }
+    return first;
+}
+
+}  // namespace
+
+TEST(ChannelView, SetChannelCopiesSnapshotOnce)
+{
+    MockApplication app;
+    auto channel = std::make_shared<Channel>("test", Channel::Type::None);
+    channel->addMessage(makeMessage(), MessageContext::Repost);
+    channel->addMessage(makeMessage(), MessageContext::Repost);
+    channel->addMessage(makeMessage(), MessageContext::Repost);
+
+    ChannelView view(nullptr);
+    view.setChannel(channel);
+    ASSERT_EQ(view.getMessagesSnapshot().size(), 3);
+    ASSERT_EQ(view.channel()->countMessages(), 3);
+
+    // Nothing may be appended again once the queued batches are delivered
+    QCoreApplication::processEvents();
+    ASSERT_EQ(view.getMessagesSnapshot().size(), 3);
+    ASSERT_EQ(view.channel()->countMessages(), 3);
+
+    // New messages still show up exactly once
+    channel->addMessage(makeMessage(), MessageContext::Repost);
+    QCoreApplication::processEvents();
+    ASSERT_EQ(view.getMessagesSnapshot().size(), 4);
+    ASSERT_EQ(view.channel()->countMessages(), 4);
+}
+
+TEST(ChannelView, OffscreenLayoutWithinLimit)
+{
+    MockApplication app;
+    auto channel = makeTextChannel(500);
+
+    ChannelView view(nullptr);
+    // A page holds more than OFFSCREEN_LAYOUT_LIMIT messages
+    view.resize(400, 4000);
+    view.setChannel(channel);
+    view.show();
+
+    auto messages = view.getMessagesSnapshot();
+    ASSERT_EQ(messages.size(), 500);
+    auto first = waitForOffscreenLayout(view, messages);
+
+    auto width = messages.back()->getWidth();
+    for (size_t i = first; i < messages.size(); i++)
+    {
+        ASSERT_EQ(messages[i]->getWidth(), width) << i;
+    }
+    // The viewport might start in the middle of a message
+    for (size_t i = 0; i + 1 < first; i++)
+    {
+        ASSERT_EQ(messages[i]->getWidth(), 0) << i;
+    }
+}
+
+TEST(ChannelView, OffscreenLayoutFollowsWidth)
+{
+    MockApplication app;
+    auto channel = makeTextChannel(500);
+
+    ChannelView view(nullptr);
+    view.resize(400, 4000);
+    view.setChannel(channel);
+    view.show();
+
+    auto messages = view.getMessagesSnapshot();
+    waitForOffscreenLayout(view, messages);
+    auto oldWidth = messages.back()->getWidth();
+
+    view.resize(600, 4000);
+    auto first = waitForOffscreenLayout(view, messages);
+    auto newWidth = messages.back()->getWidth();
+    ASSERT_NE(newWidth, oldWidth);
+
+    // Nothing is laid out at the old width anymore, and the pass doesn't go
+    // further than before
+    for (size_t i = first; i < messages.size(); i++)
+    {
+        ASSERT_EQ(messages[i]->getWidth(), newWidth) << i;
+    }
+    for (size_t i = 0; i + 1 < first; i++)
+    {
+        ASSERT_EQ(messages[i]->getWidth(), 0) << i;
+    }
+}
+
+TEST(ChannelView, OffscreenLayoutStopsOnChannelChange)
+{
+    MockApplication app;
+    auto firstChannel = makeTextChannel(500);
+    auto secondChannel = makeTextChannel(500);
+
+    ChannelView view(nullptr);
+    view.resize(400, 4000);
+    view.show();
+
+    view.setChannel(firstChannel);
+    auto firstMessages = view.getMessagesSnapshot();
+    // Switch before the background pass for the first channel ran
+    view.setChannel(secondChannel);
+    auto secondMessages = view.getMessagesSnapshot();
+    auto first = waitForOffscreenLayout(view, secondMessages);
+
+    ASSERT_EQ(firstMessages.size(), secondMessages.size());
+    for (size_t i = 0; i + 1 < first; i++)
+    {
+        ASSERT_EQ(secondMessages[i]->getWidth(), 0) << i;
+    }
+    // Only the messages that were visible got laid out
+    for (size_t i = 0; i + 1 < first + ChannelView::OFFSCREEN_LAYOUT_LIMIT;
+         i++)
+    {
+        ASSERT_EQ(firstMessages[i]->getWidth(), 0) << i;
+    }
+}
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/completion/sources/CompletionIndex.hpp"
+
+#include "common/Literals.hpp"
+#include "Test.hpp"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::completion;
+using namespace literals;
+
+namespace {
+
+std::vector<uint32_t> find(const CompletionIndex &index, QStringView query)
+{
+    auto found = index.find(query);
+    EXPECT_TRUE(found.has_value()) << query;
+    return found.value_or(std::vector<uint32_t>{});
+}
+
+}  // namespace
+
+TEST(CompletionIndex, Prefix)
+{
+    CompletionIndex index(
+        {
+            u"pajlada"_s,
+            u"forsen"_s,
+            u"pajbot"_s,
+            u"Pajlada2"_s,
+            u"xpaj"_s,
+        },
+        CompletionIndex::Mode::Prefix);
+    ASSERT_EQ(index.size(), 5U);
+
+    EXPECT_EQ(find(index, u"paj"), (std::vector<uint32_t>{0, 2, 3}));
+    EXPECT_EQ(find(index, u"PAJL"), (std::vector<uint32_t>{0, 3}));
+    EXPECT_EQ(find(index, u"pajlada2"), (std::vector<uint32_t>{3}));
+    EXPECT_EQ(find(index, u"pajlada22"), (std::vector<uint32_t>{}));
+    EXPECT_EQ(find(index, u"x"), (std::vector<uint32_t>{4}));
+    EXPECT_EQ(find(index, u"aj"), (std::vector<uint32_t>{}));
+}
+
+TEST(CompletionIndex, Substring)
+{
+    CompletionIndex index(
+        {
+            u"FeelsGoodMan"_s,
+            u"FeelsBadMan"_s,
+            u"ManChicken"_s,
+            u":)"_s,
+            u"Clap"_s,
+            u"Kappa"_s,
+        },
+        CompletionIndex::Mode::Substring);
+
+    EXPECT_EQ(find(index, u"man"), (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_EQ(find(index, u"MAN"), (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_EQ(find(index, u"a"), (std::vector<uint32_t>{0, 1, 2, 4, 5}));
+    EXPECT_EQ(find(index, u")"), (std::vector<uint32_t>{3}));
+    EXPECT_EQ(find(index, u"ck"), (std::vector<uint32_t>{2}));
+    // U+212A (Kelvin sign) folds to 'k'
+    EXPECT_EQ(find(index, u"\u212Aap"), (std::vector<uint32_t>{5}));
+    EXPECT_EQ(find(index, u"feelsgoodman!"), (std::vector<uint32_t>{}));
+}
+
+TEST(CompletionIndex, EveryNameIsCandidate)
+{
+    CompletionIndex index({u"abc"_s, u"\U0001F600"_s},
+                          CompletionIndex::Mode::Substring);
+
+    EXPECT_FALSE(index.find(u"").has_value());
+    EXPECT_FALSE(index.find(u"\U0001F600").has_value());
+    EXPECT_FALSE(CompletionIndex().find(u"").has_value());
+    EXPECT_EQ(find(CompletionIndex(), u"abc"), (std::vector<uint32_t>{}));
+}
+
+TEST(CompletionIndex, NeverMissesMatches)
+{
+    const QStringList names{
+        u"pajaW"_s,  u"PAJAW"_s, u":tf:"_s,     u"B-)"_s,    u"~zw"_s,
+        u"Aware"_s,  u"aware"_s, u"LULW"_s,     u"forsenE"_s, u"ÄÖÜ"_s,
+        u"äöü"_s,    u""_s,      u"Clap2"_s,    u"clap"_s,   u"STRASSE"_s,
+    };
+    const QStringList queries{
+        u"a"_s,  u"A"_s,  u"aw"_s,  u"AW"_s,  u"t"_s,   u":"_s,
+        u"-)"_s, u"~"_s,  u"zw"_s,  u"ö"_s,   u"Ö"_s,   u"clap"_s,
+        u"2"_s,  u"e"_s,  u"ss"_s,  u"xyz"_s, u"forse"_s,
+    };
+
+    std::vector<QString> nameVector(names.begin(), names.end());
+    CompletionIndex prefixes(nameVector, CompletionIndex::Mode::Prefix);
+    CompletionIndex substrings(nameVector, CompletionIndex::Mode::Substring);
+
+    for (const auto &query : queries)
+    {
+        auto prefixCandidates = find(prefixes, query);
+        auto substringCandidates = find(substrings, query);
+        for (uint32_t i = 0; i < names.size(); i++)
+        {
+            auto isCandidate = [i](const std::vector<uint32_t> &candidates) {
+                return std::ranges::find(candidates, i) != candidates.end();
+            };
+
+            EXPECT_EQ(names[i].startsWith(query, Qt::CaseInsensitive),
+                      isCandidate(prefixCandidates))
+                << names[i] << " " << query;
+            EXPECT_EQ(names[i].contains(query, Qt::CaseInsensitive),
+                      isCandidate(substringCandidates))
+                << names[i] << " " << query;
+        }
+    }
+}
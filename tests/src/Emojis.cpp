@@ -173,3 +173,35 @@ TEST(Emojis, Parse)
         }
     }
 }
+
+TEST(Emojis, ParseCallbacks)
+{
+    Emojis emojis;
+
+    emojis.load();
+
+    auto countParts = [&](QStringView input) {
+        std::pair<int, int> counts;
+        emojis.parse(
+            input,
+            [&](QStringView text) {
+                // text parts always point into the input
+                EXPECT_GE(text.data(), input.data());
+                EXPECT_LE(text.data() + text.size(),
+                          input.data() + input.size());
+                counts.first++;
+            },
+            [&](const EmotePtr &emote) {
+                EXPECT_NE(emote, nullptr);
+                counts.second++;
+            });
+        return counts;
+    };
+
+    EXPECT_EQ(countParts(u""), std::make_pair(0, 0));
+    EXPECT_EQ(countParts(u"forsen123 #hashtag *"), std::make_pair(1, 0));
+    // keycap digit one
+    EXPECT_EQ(countParts(u"1️⃣ 2"), std::make_pair(1, 1));
+    EXPECT_EQ(countParts(u"a🐧b🐧"), std::make_pair(2, 2));
+    EXPECT_EQ(countParts(u"©"), std::make_pair(0, 1));
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/EmoteIndex.hpp"
+
+#include "common/Literals.hpp"
+#include "messages/Emote.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+EmotePtr makeEmote(const QString &name, const QString &id)
+{
+    return std::make_shared<const Emote>(Emote{
+        .name = {name},
+        .id = {id},
+    });
+}
+
+std::shared_ptr<const EmoteMap> makeMap(std::vector<EmotePtr> emotes)
+{
+    auto map = std::make_shared<EmoteMap>();
+    for (auto &emote : emotes)
+    {
+        map->emplace(emote->name, std::move(emote));
+    }
+    return map;
+}
+
+}  // namespace
+
+TEST(EmoteIndex, Precedence)
+{
+    auto channelKappa = makeEmote(u"Kappa"_s, u"channel"_s);
+    auto globalKappa = makeEmote(u"Kappa"_s, u"global"_s);
+    auto globalPog = makeEmote(u"Pog"_s, u"global"_s);
+
+    EmoteIndex index;
+    EmoteIndex::Versions versions{1, 1, 1, 1, 1, 1};
+    ASSERT_TRUE(index.isOutdated(versions));
+
+    index.update(versions, {
+                               nullptr,
+                               makeMap({channelKappa}),
+                               nullptr,
+                               makeMap({globalKappa, globalPog}),
+                               nullptr,
+                               nullptr,
+                           });
+    ASSERT_FALSE(index.isOutdated(versions));
+    ASSERT_EQ(index.size(), 2U);
+
+    ASSERT_EQ(index.find(u"Kappa"), channelKappa);
+    ASSERT_EQ(index.find(u"Pog"), globalPog);
+    ASSERT_EQ(index.find(u"pog"), nullptr);
+
+    // lookups with a view into a larger string
+    QString text = u"xd Pog xd"_s;
+    ASSERT_EQ(index.find(QStringView(text).mid(3, 3)), globalPog);
+}
+
+TEST(EmoteIndex, IncrementalUpdates)
+{
+    auto channelKappa = makeEmote(u"Kappa"_s, u"channel"_s);
+    auto globalKappa = makeEmote(u"Kappa"_s, u"global"_s);
+    auto liveKappa = makeEmote(u"Kappa"_s, u"live"_s);
+    auto seventvPls = makeEmote(u"catPls"_s, u"7tv"_s);
+
+    auto channel = makeMap({channelKappa});
+    auto global = makeMap({globalKappa});
+
+    EmoteIndex index;
+    index.update({0, 0, 0, 0, 0, 0},
+                 {channel, nullptr, nullptr, global, nullptr, nullptr});
+    ASSERT_EQ(index.find(u"Kappa"), channelKappa);
+
+    // the channel emote is removed, the global one shows through
+    index.update({1, 0, 0, 0, 0, 0},
+                 {makeMap({}), nullptr, nullptr, global, nullptr, nullptr});
+    ASSERT_EQ(index.find(u"Kappa"), globalKappa);
+
+    // a live update adds an emote to the 7TV channel set
+    auto seventv = makeMap({liveKappa, seventvPls});
+    index.update({1, 0, 1, 0, 0, 0},
+                 {makeMap({}), nullptr, seventv, global, nullptr, nullptr});
+    ASSERT_EQ(index.find(u"Kappa"), liveKappa);
+    ASSERT_EQ(index.find(u"catPls"), seventvPls);
+
+    // the same versions don't update the index again
+    index.update({1, 0, 1, 0, 0, 0},
+                 {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
+    ASSERT_EQ(index.find(u"Kappa"), liveKappa);
+
+    // all emotes are gone
+    index.update({2, 0, 2, 1, 0, 0},
+                 {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
+    ASSERT_EQ(index.find(u"Kappa"), nullptr);
+    ASSERT_EQ(index.size(), 0U);
+}
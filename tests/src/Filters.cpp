@@ -5,6 +5,8 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/filters/lang/expressions/UnaryOperation.hpp"
 #include "controllers/filters/lang/Filter.hpp"
+#include "controllers/filters/lang/FilterParser.hpp"
+#include "controllers/filters/lang/Program.hpp"
 #include "controllers/filters/lang/Types.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -282,6 +284,42 @@ TEST(Filters, Evaluation)
     }
 }
 
+TEST(Filters, Compilation)
+{
+    struct TestCase {
+        QString input;
+        size_t instructions;
+    };
+
+    // clang-format off
+    std::vector<TestCase> tests{
+        // constant expressions are evaluated when compiling
+        {R".(1 + 2 * 3).", 0},
+        {R".({"abc", 123} contains 123).", 0},
+        {R".(1 == 2 && author.subbed).", 0},
+        {R".(author.name).", 0},
+        {R".(!author.subbed).", 1},
+        {R".(message.content match {r"(\d\d)", 1}).", 1},
+        {R".({author.name, "abc"} contains "abc").", 2},
+        // skip, right side, and
+        {R".(author.subbed && author.sub_length > 3).", 3},
+        {R".(author.subbed || author.sub_length > 3).", 2},
+    };
+    // clang-format on
+
+    for (const auto &[input, expected] : tests)
+    {
+        FilterParser parser(input);
+        ASSERT_TRUE(parser.valid()) << input;
+
+        auto expression = parser.release();
+        auto program = Program::compile(*expression);
+        EXPECT_EQ(program.size(), expected)
+            << "Filter{ " << input << " } was compiled to " << program.size()
+            << " instructions instead of " << expected;
+    }
+}
+
 TEST_F(FiltersF, TypingContextChecks)
 {
     MockChannel channel("pajlada");
@@ -18,11 +18,23 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchBadges.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
+#include "singletons/Settings.hpp"
 #include "Test.hpp"
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QString>
 #include <QStringBuilder>
+#include <QTemporaryDir>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextLayout>
+
+#include <algorithm>
+#include <functional>
 
 using namespace chatterino;
 using namespace Qt::Literals;
@@ -139,6 +151,61 @@ std::shared_ptr<TwitchChannel> makeMockTwitchChannel(const QString &name)
     return chan;
 }
 
+#ifdef CHATTERINO_WITH_SPELLCHECK
+/// Processes events until `done` returns true (or 5s passed)
+bool waitFor(const std::function<bool()> &done)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return done();
+}
+
+/// Writes a tiny dictionary to @a dir and returns its path (without suffix)
+QString writeDictionary(const QTemporaryDir &dir)
+{
+    auto path = QDir(dir.path()).absoluteFilePath(u"test"_s);
+
+    QFile aff(path + u".aff");
+    aff.open(QFile::WriteOnly);
+    aff.write("SET UTF-8\nTRY esianrtolcdugmphbyfvkwz\n");
+
+    QFile dic(path + u".dic");
+    dic.open(QFile::WriteOnly);
+    dic.write("3\nhello\nthere\nworld\n");
+
+    return path;
+}
+
+std::vector<int> uniqueSorted(std::vector<int> values)
+{
+    std::ranges::sort(values);
+    auto [first, last] = std::ranges::unique(values);
+    values.erase(first, last);
+    return values;
+}
+
+/// Records the numbers of the blocks that were highlighted
+class RecordingHighlighter : public InputHighlighter
+{
+public:
+    using InputHighlighter::InputHighlighter;
+
+    std::vector<int> highlightedBlocks;
+
+protected:
+    void highlightBlock(const QString &text) override
+    {
+        this->highlightedBlocks.emplace_back(
+            this->currentBlock().blockNumber());
+        InputHighlighter::highlightBlock(text);
+    }
+};
+#endif
+
 }  // namespace
 
 class InputHighlighterTest : public ::testing::Test
@@ -287,3 +354,54 @@ TEST(InputHighlight, wordRegex)
         ASSERT_EQ(got, c.words) << "index=" << i;
     }
 }
+
+#ifdef CHATTERINO_WITH_SPELLCHECK
+TEST_F(InputHighlighterTest, rehighlightsPendingBlocks)
+{
+    QTemporaryDir dictionaryDir;
+    ASSERT_TRUE(dictionaryDir.isValid());
+    getSettings()->spellCheckingDefaultDictionary =
+        writeDictionary(dictionaryDir);
+
+    SpellChecker checker;
+    ASSERT_TRUE(checker.isLoaded());
+
+    // Blocks with only cached words don't wait for any result
+    checker.checkAsync(u"hello"_s);
+    checker.checkAsync(u"world"_s);
+    ASSERT_TRUE(waitFor([&] {
+        return checker.cachedCheck(u"hello"_s).has_value() &&
+               checker.cachedCheck(u"world"_s).has_value();
+    }));
+
+    QTextDocument document;
+    RecordingHighlighter highlighter(checker, nullptr);
+    highlighter.setDocument(&document);
+    // setDocument highlights the (empty) document on the next iteration
+    QCoreApplication::processEvents();
+
+    // Changes are highlighted right away
+    document.setPlainText(u"hello\nhelo there\nworld\nhelo"_s);
+    ASSERT_EQ(uniqueSorted(highlighter.highlightedBlocks),
+              (std::vector<int>{0, 1, 2, 3}));
+    highlighter.highlightedBlocks.clear();
+
+    ASSERT_TRUE(waitFor([&] {
+        return checker.cachedCheck(u"helo"_s).has_value() &&
+               checker.cachedCheck(u"there"_s).has_value();
+    }));
+    QCoreApplication::processEvents();
+
+    ASSERT_EQ(uniqueSorted(highlighter.highlightedBlocks),
+              (std::vector<int>{1, 3}));
+
+    // The misspelled word is now underlined
+    auto formats = document.findBlockByNumber(1).layout()->formats();
+    ASSERT_EQ(formats.size(), 1);
+    ASSERT_EQ(formats[0].start, 0);
+    ASSERT_EQ(formats[0].length, 4);
+    ASSERT_EQ(formats[0].format.underlineStyle(),
+              QTextCharFormat::SpellCheckUnderline);
+    ASSERT_TRUE(document.findBlockByNumber(0).layout()->formats().isEmpty());
+}
+#endif
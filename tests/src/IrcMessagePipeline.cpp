@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/twitch/IrcMessagePipeline.hpp"
+
+#include "common/Literals.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+/// Processes events until `done` returns true (or 5s passed)
+bool waitFor(const std::function<bool()> &done)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return done();
+}
+
+IrcMessagePipeline::Build delayedBuild(std::vector<int> &order, int id,
+                                       std::chrono::milliseconds delay)
+{
+    return [&order, id, delay] {
+        std::this_thread::sleep_for(delay);
+        return [&order, id] {
+            order.push_back(id);
+        };
+    };
+}
+
+}  // namespace
+
+TEST(IrcMessagePipeline, PostWhenIdle)
+{
+    IrcMessagePipeline pipeline;
+
+    bool ran = false;
+    pipeline.post(u"#a"_s, [&] {
+        ran = true;
+    });
+    ASSERT_TRUE(ran);
+    ASSERT_FALSE(pipeline.isPending(u"#a"_s));
+}
+
+TEST(IrcMessagePipeline, KeepsOrder)
+{
+    using namespace std::chrono_literals;
+
+    IrcMessagePipeline pipeline;
+    std::vector<int> order;
+
+    // the first job takes the longest to build
+    pipeline.submit(u"#a"_s, delayedBuild(order, 0, 50ms));
+    pipeline.submit(u"#a"_s, delayedBuild(order, 1, 0ms));
+    pipeline.post(u"#a"_s, [&] {
+        order.push_back(2);
+    });
+    pipeline.submit(u"#a"_s, delayedBuild(order, 3, 10ms));
+    ASSERT_TRUE(pipeline.isPending(u"#a"_s));
+    ASSERT_TRUE(order.empty());
+
+    ASSERT_TRUE(waitFor([&] {
+        return order.size() == 4;
+    }));
+    ASSERT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+    ASSERT_FALSE(pipeline.isPending(u"#a"_s));
+}
+
+TEST(IrcMessagePipeline, EmptyCommit)
+{
+    IrcMessagePipeline pipeline;
+    std::vector<int> order;
+
+    pipeline.submit(u"#a"_s, [] {
+        return IrcMessagePipeline::Commit{};
+    });
+    pipeline.post(u"#a"_s, [&] {
+        order.push_back(1);
+    });
+
+    ASSERT_TRUE(waitFor([&] {
+        return !order.empty();
+    }));
+    ASSERT_EQ(order, std::vector<int>{1});
+}
+
+TEST(IrcMessagePipeline, ReleasesContext)
+{
+    IrcMessagePipeline pipeline;
+    auto context = std::make_shared<int>(42);
+    std::weak_ptr<int> weakContext = context;
+
+    bool committed = false;
+    pipeline.submit(
+        u"#a"_s,
+        [&committed] {
+            return [&committed] {
+                committed = true;
+            };
+        },
+        std::move(context));
+    ASSERT_FALSE(weakContext.expired());
+
+    ASSERT_TRUE(waitFor([&] {
+        return committed;
+    }));
+    ASSERT_TRUE(weakContext.expired());
+}
+
+TEST(IrcMessagePipeline, PostFromCommit)
+{
+    using namespace std::chrono_literals;
+
+    IrcMessagePipeline pipeline;
+    std::vector<int> order;
+
+    // Both jobs are committed in the same drain
+    pipeline.submit(u"#a"_s, [&] {
+        std::this_thread::sleep_for(50ms);
+        return [&] {
+            order.push_back(0);
+            pipeline.post(u"#a"_s, [&] {
+                order.push_back(2);
+            });
+        };
+    });
+    pipeline.submit(u"#a"_s, delayedBuild(order, 1, 0ms));
+
+    ASSERT_TRUE(waitFor([&] {
+        return order.size() == 3;
+    }));
+    ASSERT_EQ(order, (std::vector<int>{0, 1, 2}));
+    ASSERT_FALSE(pipeline.isPending(u"#a"_s));
+}
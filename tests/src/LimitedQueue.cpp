@@ -4,11 +4,57 @@
 
 #include "messages/LimitedQueue.hpp"
 
+#include "common/Literals.hpp"
 #include "Test.hpp"
 
+#include <QHashFunctions>
+#include <QString>
+#include <QStringView>
+
+#include <ranges>
+#include <tuple>
 #include <vector>
 
 using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+/// Indexes strings by themselves
+struct StringIndexer {
+    using Key = QString;
+
+    struct Hash {
+        using is_transparent = void;
+
+        size_t operator()(QStringView s) const noexcept
+        {
+            return qHash(s);
+        }
+    };
+
+    static const QString &key(const QString &s)
+    {
+        return s;
+    }
+};
+
+using IndexedQueue = LimitedQueue<QString, StringIndexer>;
+
+/// Checks that every key in the queue resolves to the item with the key
+void expectIndexConsistent(const IndexedQueue &queue)
+{
+    for (const auto &item : queue.getSnapshot())
+    {
+        if (item.isEmpty())
+        {
+            continue;
+        }
+        EXPECT_EQ(queue.findByKey(item), item);
+    }
+}
+
+}  // namespace
 
 template <typename T>
 inline void SNAPSHOT_EQUALS(const std::vector<T> &snapshot,
@@ -273,3 +319,188 @@ TEST(LimitedQueue, FirstN)
     SNAPSHOT_EQUALS(empty.firstN(2), {}, "empty");
     SNAPSHOT_EQUALS(empty.firstN(6), {}, "empty");
 }
+
+TEST(LimitedQueue, IndexPushBack)
+{
+    IndexedQueue queue(3);
+    queue.pushBack(u"a"_s);
+    queue.pushBack(u""_s);
+    queue.pushBack(u"b"_s);
+
+    EXPECT_EQ(queue.findByKey(u"a"_s), u"a"_s);
+    EXPECT_EQ(queue.findByKey(QStringView(u"b")), u"b"_s);
+    EXPECT_FALSE(queue.findByKey(u"c"_s).has_value());
+
+    // "a" is evicted
+    QString deleted;
+    EXPECT_TRUE(queue.pushBack(u"c"_s, deleted));
+    EXPECT_EQ(deleted, u"a"_s);
+    EXPECT_FALSE(queue.findByKey(u"a"_s).has_value());
+    expectIndexConsistent(queue);
+
+    // wrap around the buffer a few times
+    for (int i = 0; i < 10; i++)
+    {
+        queue.pushBack(QString::number(i));
+        expectIndexConsistent(queue);
+    }
+    EXPECT_FALSE(queue.findByKey(u"c"_s).has_value());
+    EXPECT_EQ(queue.findByKey(u"9"_s), u"9"_s);
+
+    queue.clear();
+    EXPECT_FALSE(queue.findByKey(u"9"_s).has_value());
+    queue.pushBack(u"d"_s);
+    expectIndexConsistent(queue);
+}
+
+TEST(LimitedQueue, IndexPushFront)
+{
+    IndexedQueue queue(4);
+    queue.pushBack(u"c"_s);
+    queue.pushFront({u"a"_s, u"b"_s});
+
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {u"a"_s, u"b"_s, u"c"_s},
+                    "pushed to front");
+    expectIndexConsistent(queue);
+
+    queue.pushBack(u"d"_s);
+    queue.pushBack(u"e"_s);
+    EXPECT_FALSE(queue.findByKey(u"a"_s).has_value());
+    expectIndexConsistent(queue);
+}
+
+TEST(LimitedQueue, IndexInsert)
+{
+    IndexedQueue queue(5);
+    queue.pushBack(u"a"_s);
+    queue.pushBack(u"c"_s);
+    queue.pushBack(u"e"_s);
+
+    EXPECT_TRUE(queue.insertBefore(u"c"_s, u"b"_s));
+    EXPECT_TRUE(queue.insertAfter(u"c"_s, u"d"_s));
+    EXPECT_FALSE(queue.insertAfter(u"x"_s, u"y"_s));
+    SNAPSHOT_EQUALS(queue.getSnapshot(),
+                    {u"a"_s, u"b"_s, u"c"_s, u"d"_s, u"e"_s}, "not full");
+    expectIndexConsistent(queue);
+
+    // the queue is full, so "a" is dropped
+    EXPECT_TRUE(queue.insertBefore(u"e"_s, u"d2"_s));
+    SNAPSHOT_EQUALS(queue.getSnapshot(),
+                    {u"b"_s, u"c"_s, u"d"_s, u"d2"_s, u"e"_s}, "full");
+    EXPECT_FALSE(queue.findByKey(u"a"_s).has_value());
+    expectIndexConsistent(queue);
+
+    // inserting at the front of a full queue doesn't do anything
+    EXPECT_TRUE(queue.insertBefore(u"b"_s, u"a"_s));
+    SNAPSHOT_EQUALS(queue.getSnapshot(),
+                    {u"b"_s, u"c"_s, u"d"_s, u"d2"_s, u"e"_s},
+                    "full, at front");
+    EXPECT_FALSE(queue.findByKey(u"a"_s).has_value());
+    expectIndexConsistent(queue);
+}
+
+TEST(LimitedQueue, IndexReplace)
+{
+    IndexedQueue queue(5);
+    queue.pushBack(u"a"_s);
+    queue.pushBack(u"b"_s);
+    queue.pushBack(u"c"_s);
+
+    EXPECT_EQ(queue.replaceItem(u"b"_s, u"x"_s), 1);
+    EXPECT_FALSE(queue.findByKey(u"b"_s).has_value());
+    EXPECT_EQ(queue.findByKey(u"x"_s), u"x"_s);
+
+    QString prev;
+    EXPECT_TRUE(queue.replaceItem(std::size_t(0), u"y"_s, &prev));
+    EXPECT_EQ(prev, u"a"_s);
+    EXPECT_EQ(queue.replaceItem(2, u"c"_s, u"z"_s), 2);
+
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {u"y"_s, u"x"_s, u"z"_s}, "replaced");
+    EXPECT_FALSE(queue.findByKey(u"a"_s).has_value());
+    EXPECT_FALSE(queue.findByKey(u"c"_s).has_value());
+    expectIndexConsistent(queue);
+}
+
+TEST(LimitedQueue, IndexDuplicateKeys)
+{
+    IndexedQueue queue(5);
+    queue.pushBack(u"a"_s);
+    queue.pushBack(u"b"_s);
+    queue.pushBack(u"a"_s);
+
+    // the last item is used as the reference
+    EXPECT_TRUE(queue.insertAfter(u"a"_s, u"e"_s));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {u"a"_s, u"b"_s, u"a"_s, u"e"_s},
+                    "inserted after last");
+
+    // replacing the last one falls back to the first one
+    queue.replaceItem(std::size_t(2), u"c"_s);
+    EXPECT_TRUE(queue.insertAfter(u"a"_s, u"f"_s));
+    SNAPSHOT_EQUALS(queue.getSnapshot(),
+                    {u"a"_s, u"f"_s, u"b"_s, u"c"_s, u"e"_s},
+                    "inserted after first");
+
+    queue.replaceItem(std::size_t(0), u"d"_s);
+    EXPECT_FALSE(queue.findByKey(u"a"_s).has_value());
+    expectIndexConsistent(queue);
+}
+
+TEST(LimitedQueue, Read)
+{
+    LimitedQueue<int> queue(4);
+    EXPECT_TRUE(queue.read().empty());
+
+    // wrap around, so the buffer is split in two parts
+    for (int i = 1; i <= 6; i++)
+    {
+        queue.pushBack(i);
+    }
+
+    {
+        auto view = queue.read();
+        EXPECT_EQ(view.size(), 4);
+        EXPECT_EQ(view[0], 3);
+        EXPECT_EQ(view[3], 6);
+        EXPECT_EQ(std::vector<int>(view.begin(), view.end()),
+                  queue.getSnapshot());
+
+        std::vector<int> reversed;
+        for (int i : view | std::views::reverse)
+        {
+            reversed.push_back(i);
+        }
+        EXPECT_EQ(reversed, (std::vector<int>{6, 5, 4, 3}));
+    }
+
+    // the view must be released before modifying the queue
+    queue.pushBack(7);
+    EXPECT_EQ(queue.read()[3], 7);
+}
+
+TEST(LimitedQueue, Epoch)
+{
+    LimitedQueue<int> queue(3);
+    auto epoch = queue.epoch();
+
+    auto expectChanged = [&](const char *what) {
+        EXPECT_NE(queue.epoch(), epoch) << what;
+        epoch = queue.epoch();
+    };
+
+    queue.pushBack(1);
+    expectChanged("pushBack");
+    queue.pushFront({0});
+    expectChanged("pushFront");
+    queue.replaceItem(1, 2);
+    expectChanged("replaceItem");
+    queue.insertAfter(0, 5);
+    expectChanged("insertAfter");
+
+    // nothing happened
+    queue.replaceItem(42, 43);
+    std::ignore = queue.getSnapshot();
+    EXPECT_EQ(queue.epoch(), epoch);
+
+    queue.clear();
+    expectChanged("clear");
+}
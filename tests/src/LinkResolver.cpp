@@ -0,0 +1,466 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/links/LinkResolver.hpp"
+
+#include "common/Literals.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "providers/links/LinkInfo.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QStringBuilder>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrl>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+using Priority = ILinkResolver::Priority;
+
+namespace {
+
+/// Processes events until `done` returns true (or 5s passed)
+bool waitFor(const std::function<bool()> &done)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return done();
+}
+
+/// A local link resolver that answers with the requested path as the tooltip.
+/// Links containing "error" fail. While #hold is set, requests are only
+/// answered once they're released.
+class MockResolverServer
+{
+public:
+    MockResolverServer()
+    {
+        QObject::connect(&this->server_, &QTcpServer::newConnection, [this] {
+            while (auto *socket = this->server_.nextPendingConnection())
+            {
+                QObject::connect(socket, &QTcpSocket::readyRead,
+                                 [this, socket] {
+                                     this->onReadyRead(socket);
+                                 });
+                QObject::connect(socket, &QTcpSocket::disconnected, socket,
+                                 &QObject::deleteLater);
+            }
+        });
+        this->server_.listen(QHostAddress::LocalHost);
+    }
+
+    /// The URL to pass to LinkResolver
+    QString url() const
+    {
+        return u"http://127.0.0.1:" %
+               QString::number(this->server_.serverPort()) % u"/%1";
+    }
+
+    /// Answers the oldest held request
+    void releaseOne()
+    {
+        ASSERT_FALSE(this->held_.empty());
+        auto [socket, path] = this->held_.front();
+        this->held_.pop_front();
+        if (socket)
+        {
+            respond(socket, path);
+        }
+    }
+
+    void releaseAll()
+    {
+        while (!this->held_.empty())
+        {
+            this->releaseOne();
+        }
+    }
+
+    bool hold = false;
+    /// The paths of all received requests in order
+    std::vector<QString> requests;
+
+private:
+    void onReadyRead(QTcpSocket *socket)
+    {
+        auto &buffer = this->buffers_[socket];
+        buffer += socket->readAll();
+        auto end = buffer.indexOf("\r\n\r\n");
+        if (end < 0)
+        {
+            return;
+        }
+
+        // "GET <path> HTTP/1.1"
+        auto requestLine = buffer.left(buffer.indexOf("\r\n")).split(' ');
+        this->buffers_.erase(socket);
+        auto path = QUrl::fromPercentEncoding(requestLine.value(1));
+        this->requests.emplace_back(path);
+
+        if (this->hold)
+        {
+            this->held_.emplace_back(socket, path);
+        }
+        else
+        {
+            respond(socket, path);
+        }
+    }
+
+    static void respond(QTcpSocket *socket, const QString &path)
+    {
+        QByteArray status = "200 OK";
+        QByteArray body = "{}";
+        if (path.contains(u"error"_s))
+        {
+            status = "500 Internal Server Error";
+        }
+        else
+        {
+            body = QJsonDocument(QJsonObject{
+                                     {u"status"_s, 200},
+                                     {u"tooltip"_s, path},
+                                 })
+                       .toJson(QJsonDocument::Compact);
+        }
+
+        socket->write("HTTP/1.1 " + status +
+                      "\r\nContent-Type: application/json\r\nContent-Length: " +
+                      QByteArray::number(body.size()) +
+                      "\r\nConnection: close\r\n\r\n" + body);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer server_;
+    std::map<QTcpSocket *, QByteArray> buffers_;
+    std::deque<std::pair<QPointer<QTcpSocket>, QString>> held_;
+};
+
+class LinkResolverTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        getSettings()->linkInfoTooltip = true;
+        getSettings()->linkInfoDiskCache = false;
+        getSettings()->unshortLinks = false;
+    }
+
+    /// Resolves @a url with a new info
+    LinkInfo *resolve(const QString &url,
+                      Priority priority = Priority::Background)
+    {
+        auto &info = this->infos.emplace_back(std::make_unique<LinkInfo>(url));
+        this->resolver.resolve(info.get(), priority);
+        return info.get();
+    }
+
+    mock::BaseApplication app;
+    MockResolverServer server;
+    LinkResolver resolver{this->server.url()};
+    std::vector<std::unique_ptr<LinkInfo>> infos;
+};
+
+}  // namespace
+
+TEST(LinkResolver, normalizeUrl)
+{
+    struct Case {
+        QString input;
+        QString expected;
+    };
+
+    const Case cases[] = {
+        {u"https://chatterino.com/"_s, u"https://chatterino.com/"_s},
+        {u"https://chatterino.com"_s, u"https://chatterino.com/"_s},
+        {u"HTTPS://Chatterino.COM/Path"_s, u"https://chatterino.com/Path"_s},
+        {u"https://chatterino.com:443/a"_s, u"https://chatterino.com/a"_s},
+        {u"http://chatterino.com:80/a"_s, u"http://chatterino.com/a"_s},
+        {u"https://chatterino.com:80/a"_s, u"https://chatterino.com:80/a"_s},
+        {u"https://chatterino.com/a/./b/../c"_s,
+         u"https://chatterino.com/a/c"_s},
+        {u"https://chatterino.com/ä?q=ö#x"_s,
+         u"https://chatterino.com/%C3%A4?q=%C3%B6#x"_s},
+        {u"https://chatterino.com/%C3%A4"_s, u"https://chatterino.com/%C3%A4"_s},
+        {u"https://chatterino.com/?b=1&a=2"_s,
+         u"https://chatterino.com/?b=1&a=2"_s},
+    };
+
+    for (const auto &[input, expected] : cases)
+    {
+        EXPECT_EQ(LinkResolver::normalizeUrl(input), expected) << input;
+    }
+}
+
+TEST_F(LinkResolverTest, DeduplicatesInFlight)
+{
+    auto *a = this->resolve(u"https://chatterino.com/a"_s);
+    auto *b = this->resolve(u"HTTPS://Chatterino.com:443/a"_s);
+    ASSERT_TRUE(a->isLoading());
+    ASSERT_TRUE(b->isLoading());
+
+    ASSERT_TRUE(waitFor([&] {
+        return a->isLoaded() && b->isLoaded();
+    }));
+    ASSERT_EQ(this->server.requests.size(), 1);
+    ASSERT_TRUE(a->isResolved());
+    ASSERT_TRUE(b->isResolved());
+    ASSERT_EQ(a->tooltip(), u"/https://chatterino.com/a"_s);
+    ASSERT_EQ(b->tooltip(), a->tooltip());
+}
+
+TEST_F(LinkResolverTest, ReusesResolved)
+{
+    auto *a = this->resolve(u"https://chatterino.com/a"_s);
+    ASSERT_TRUE(waitFor([&] {
+        return a->isLoaded();
+    }));
+    ASSERT_EQ(this->server.requests.size(), 1);
+
+    // Within RESOLVED_TTL, the info is updated right away
+    auto *b = this->resolve(u"https://chatterino.com/a"_s);
+    ASSERT_TRUE(b->isResolved());
+    ASSERT_EQ(b->tooltip(), a->tooltip());
+    ASSERT_EQ(this->server.requests.size(), 1);
+}
+
+TEST_F(LinkResolverTest, ReusesErrors)
+{
+    auto *a = this->resolve(u"https://chatterino.com/error"_s);
+    ASSERT_TRUE(waitFor([&] {
+        return a->isLoaded();
+    }));
+    ASSERT_TRUE(a->hasError());
+    ASSERT_EQ(this->server.requests.size(), 1);
+
+    // Within ERROR_TTL, the resolver isn't asked again
+    auto *b = this->resolve(u"https://chatterino.com/error"_s);
+    ASSERT_TRUE(b->hasError());
+    ASSERT_EQ(b->tooltip(), a->tooltip());
+    ASSERT_EQ(this->server.requests.size(), 1);
+}
+
+TEST_F(LinkResolverTest, LimitsConcurrentRequests)
+{
+    this->server.hold = true;
+
+    std::vector<LinkInfo *> infos;
+    for (size_t i = 0; i < LinkResolver::MAX_CONCURRENT_REQUESTS + 2; i++)
+    {
+        infos.emplace_back(this->resolve(u"https://chatterino.com/" %
+                                         QString::number(i)));
+    }
+
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS;
+    }));
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    ASSERT_EQ(this->server.requests.size(),
+              LinkResolver::MAX_CONCURRENT_REQUESTS);
+
+    // Each finished request starts the next one
+    this->server.releaseOne();
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS + 1;
+    }));
+
+    this->server.hold = false;
+    this->server.releaseAll();
+    ASSERT_TRUE(waitFor([&] {
+        return std::ranges::all_of(infos, [](auto *info) {
+            return info->isResolved();
+        });
+    }));
+    ASSERT_EQ(this->server.requests.size(), infos.size());
+}
+
+TEST_F(LinkResolverTest, VisibleBeforeBackground)
+{
+    this->server.hold = true;
+
+    for (size_t i = 0; i < LinkResolver::MAX_CONCURRENT_REQUESTS; i++)
+    {
+        this->resolve(u"https://chatterino.com/running/" % QString::number(i));
+    }
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS;
+    }));
+
+    this->resolve(u"https://chatterino.com/background/1"_s);
+    this->resolve(u"https://chatterino.com/background/2"_s);
+    auto *raised = this->resolve(u"https://chatterino.com/raised"_s);
+    this->resolve(u"https://chatterino.com/visible"_s, Priority::Visible);
+    // An info that's already loading can be raised
+    this->resolver.resolve(raised, Priority::Visible);
+
+    // Visible links are requested first, the most recent ones first
+    std::vector<QString> expected{
+        u"/https://chatterino.com/raised"_s,
+        u"/https://chatterino.com/visible"_s,
+        u"/https://chatterino.com/background/2"_s,
+        u"/https://chatterino.com/background/1"_s,
+    };
+    for (const auto &path : expected)
+    {
+        auto nRequests = this->server.requests.size();
+        this->server.releaseOne();
+        ASSERT_TRUE(waitFor([&] {
+            return this->server.requests.size() == nRequests + 1;
+        }));
+        ASSERT_EQ(this->server.requests.back(), path);
+    }
+
+    this->server.hold = false;
+    this->server.releaseAll();
+}
+
+TEST_F(LinkResolverTest, SkipsDeadWaiters)
+{
+    this->server.hold = true;
+
+    for (size_t i = 0; i < LinkResolver::MAX_CONCURRENT_REQUESTS; i++)
+    {
+        this->resolve(u"https://chatterino.com/running/" % QString::number(i));
+    }
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS;
+    }));
+
+    auto *alive = this->resolve(u"https://chatterino.com/alive"_s);
+    this->resolve(u"https://chatterino.com/gone"_s);
+    // The message with this link was removed
+    this->infos.pop_back();
+
+    this->server.hold = false;
+    this->server.releaseAll();
+    ASSERT_TRUE(waitFor([&] {
+        return alive->isLoaded();
+    }));
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+
+    ASSERT_EQ(this->server.requests.size(),
+              LinkResolver::MAX_CONCURRENT_REQUESTS + 1);
+    ASSERT_EQ(this->server.requests.back(), u"/https://chatterino.com/alive"_s);
+}
+
+TEST_F(LinkResolverTest, CapsQueuedLinks)
+{
+    this->server.hold = true;
+
+    for (size_t i = 0; i < LinkResolver::MAX_CONCURRENT_REQUESTS; i++)
+    {
+        this->resolve(u"https://chatterino.com/running/" % QString::number(i));
+    }
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS;
+    }));
+
+    // A wave of unique links only keeps the most recent ones queued
+    auto *oldest = this->resolve(u"https://chatterino.com/queued/first"_s);
+    for (size_t i = 0; i < LinkResolver::MAX_QUEUED_LINKS; i++)
+    {
+        this->resolve(u"https://chatterino.com/queued/" % QString::number(i));
+    }
+    ASSERT_TRUE(oldest->isLoading());
+
+    // The dropped link is requested again once it's visible
+    this->resolver.resolve(oldest, Priority::Visible);
+    this->server.releaseOne();
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS + 1;
+    }));
+    ASSERT_EQ(this->server.requests.back(),
+              u"/https://chatterino.com/queued/first"_s);
+
+    this->server.hold = false;
+    this->server.releaseAll();
+    ASSERT_TRUE(waitFor([&] {
+        return oldest->isResolved();
+    }));
+}
+
+TEST_F(LinkResolverTest, ReResolvesRecreatedLinks)
+{
+    this->server.hold = true;
+
+    for (size_t i = 0; i < LinkResolver::MAX_CONCURRENT_REQUESTS; i++)
+    {
+        this->resolve(u"https://chatterino.com/running/" % QString::number(i));
+    }
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS;
+    }));
+
+    auto *first = this->resolve(u"https://chatterino.com/queued/first"_s);
+    auto *second = this->resolve(u"https://chatterino.com/queued/second"_s);
+    for (size_t i = 0; i < LinkResolver::MAX_QUEUED_LINKS; i++)
+    {
+        this->resolve(u"https://chatterino.com/queued/" % QString::number(i));
+    }
+    ASSERT_TRUE(first->isLoading());
+    ASSERT_TRUE(second->isLoading());
+
+    // Other infos recreate the dropped entries
+    auto *firstAgain =
+        this->resolve(u"https://chatterino.com/queued/first"_s,
+                      Priority::Visible);
+    auto *secondAgain =
+        this->resolve(u"https://chatterino.com/queued/second"_s,
+                      Priority::Visible);
+
+    // The original info waits for the recreated entry
+    this->resolver.resolve(first, Priority::Visible);
+
+    this->server.releaseOne();
+    this->server.releaseOne();
+    ASSERT_TRUE(waitFor([&] {
+        return this->server.requests.size() ==
+               LinkResolver::MAX_CONCURRENT_REQUESTS + 2;
+    }));
+    this->server.releaseAll();
+    ASSERT_TRUE(waitFor([&] {
+        return first->isResolved() && firstAgain->isResolved() &&
+               secondAgain->isResolved();
+    }));
+    ASSERT_EQ(first->tooltip(), firstAgain->tooltip());
+
+    // The recreated entry is already resolved
+    ASSERT_TRUE(second->isLoading());
+    this->resolver.resolve(second, Priority::Visible);
+    ASSERT_TRUE(second->isResolved());
+    ASSERT_EQ(second->tooltip(), secondAgain->tooltip());
+
+    ASSERT_EQ(std::ranges::count(this->server.requests,
+                                 u"/https://chatterino.com/queued/first"_s),
+              1);
+    ASSERT_EQ(std::ranges::count(this->server.requests,
+                                 u"/https://chatterino.com/queued/second"_s),
+              1);
+}
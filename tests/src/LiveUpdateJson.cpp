@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/liveupdates/JsonMessage.hpp"
+
+#include "common/Literals.hpp"
+#include "providers/seventv/eventapi/Dispatch.hpp"
+#include "providers/seventv/eventapi/Message.hpp"
+#include "Test.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+using namespace chatterino;
+using namespace chatterino::liveupdates;
+using namespace literals;
+
+TEST(LiveUpdateJson, MatchesQJson)
+{
+    const QByteArray inputs[] = {
+        R"({})",
+        R"({"a":1,"b":-2,"c":1.5,"d":1e300,"e":9007199254740993})",
+        R"({"s":"with \"escapes\" ä 😀","n":null})",
+        R"({"t":true,"f":false,"a":[1,"2",[3],{"4":4}],"o":{"x":{}}})",
+    };
+
+    for (const auto &input : inputs)
+    {
+        JsonMessage message(input);
+        ASSERT_TRUE(message.isValid()) << input;
+        EXPECT_EQ(toQJsonObject(message.root()),
+                  QJsonDocument::fromJson(input).object())
+            << input;
+    }
+}
+
+TEST(LiveUpdateJson, Accessors)
+{
+    const QByteArray input =
+        R"({"int":42,"double":4.0,"fraction":4.5,"big":4294967296,)"
+        R"("str":"forsen","arr":[1,2,3],"obj":{"a":"b"}})";
+    JsonMessage message(input);
+    ASSERT_TRUE(message.isValid());
+    const auto &root = message.root();
+    auto object = QJsonDocument::fromJson(input).object();
+
+    for (const char *key :
+         {"int", "double", "fraction", "big", "str", "arr", "obj", "missing"})
+    {
+        const auto &value = jsonMember(root, key);
+        auto qvalue = object[QString::fromLatin1(key)];
+        EXPECT_EQ(jsonInt(value), qvalue.toInt()) << key;
+        EXPECT_EQ(jsonString(value), qvalue.toString()) << key;
+        EXPECT_EQ(static_cast<qsizetype>(jsonArray(value).size()),
+                  qvalue.toArray().size())
+            << key;
+        EXPECT_EQ(toQJsonObject(value), qvalue.toObject()) << key;
+        EXPECT_EQ(toQJsonValue(value), qvalue) << key;
+    }
+
+    EXPECT_TRUE(jsonMember(jsonMember(root, "str"), "a").IsNull());
+    EXPECT_TRUE(jsonMember(jsonMember(root, "missing"), "a").IsNull());
+    EXPECT_EQ(jsonString(jsonMember(jsonMember(root, "obj"), "a")), u"b"_s);
+}
+
+TEST(LiveUpdateJson, Invalid)
+{
+    const QByteArray inputs[] = {
+        "",
+        "{",
+        R"({"a":})",
+        R"({"a":1}})",
+    };
+
+    for (const auto &input : inputs)
+    {
+        JsonMessage message(input);
+        EXPECT_FALSE(message.isValid()) << input;
+        EXPECT_FALSE(seventv::eventapi::parseBaseMessage(message).has_value())
+            << input;
+    }
+}
+
+TEST(LiveUpdateJson, DoesNotModifyInput)
+{
+    const QByteArray input = R"({"a":"b\nc"})";
+    auto copy = input;
+
+    JsonMessage message(copy);
+    ASSERT_TRUE(message.isValid());
+    EXPECT_EQ(jsonString(jsonMember(message.root(), "a")), u"b\nc"_s);
+    EXPECT_EQ(copy, input);
+}
+
+TEST(LiveUpdateJson, SeventvDispatch)
+{
+    using namespace chatterino::seventv::eventapi;
+
+    JsonMessage json(R"({
+        "op": 0,
+        "d": {
+            "type": "emote_set.update",
+            "body": {
+                "id": "60b39e943e203cc169dfc106",
+                "actor": {"display_name": "nerixyz"},
+                "pushed": [{
+                    "key": "emotes",
+                    "index": 0,
+                    "value": {
+                        "id": "621d13967cc2d4e1953838ed",
+                        "name": "Chatting",
+                        "data": {
+                            "name": "Chatting",
+                            "host": {"url": "//cdn.7tv.app/emote/1"},
+                            "owner": {"id": "1"}
+                        }
+                    }
+                }]
+            }
+        }
+    })");
+
+    auto message = parseBaseMessage(json);
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->op, Opcode::Dispatch);
+
+    auto dispatch = message->toInner<Dispatch>();
+    ASSERT_TRUE(dispatch.has_value());
+    EXPECT_EQ(dispatch->type, SubscriptionType::UpdateEmoteSet);
+    EXPECT_EQ(dispatch->id, u"60b39e943e203cc169dfc106"_s);
+    EXPECT_EQ(dispatch->actorName, u"nerixyz"_s);
+
+    auto pushed = jsonArray(jsonMember(dispatch->body, "pushed"));
+    ASSERT_EQ(pushed.size(), 1U);
+
+    EmoteAddDispatch add(*dispatch, jsonMember(pushed[0], "value"));
+    ASSERT_TRUE(add.validate());
+    EXPECT_EQ(add.emoteSetID, u"60b39e943e203cc169dfc106"_s);
+    EXPECT_EQ(add.actorName, u"nerixyz"_s);
+    EXPECT_EQ(add.emoteID, u"621d13967cc2d4e1953838ed"_s);
+    auto host = add.emoteJson["data"_L1].toObject()["host"_L1].toObject();
+    EXPECT_EQ(host["url"_L1].toString(), u"//cdn.7tv.app/emote/1"_s);
+}
@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "singletons/helper/LoggingWriter.hpp"
+
+#include "common/Literals.hpp"
+#include "messages/Message.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "singletons/Logging.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+
+#include <QDate>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QStringBuilder>
+#include <QTemporaryDir>
+#include <QTime>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+using namespace chatterino;
+using namespace literals;
+using namespace std::chrono_literals;
+
+namespace {
+
+const QDateTime DAY_ONE(QDate(2024, 1, 1), QTime(12, 0));
+const QDateTime DAY_TWO(QDate(2024, 1, 2), QTime(0, 0, 1));
+
+LoggingOptions makeOptions(const QTemporaryDir &dir)
+{
+    return {
+        .baseDirectory = dir.path(),
+        .timestampFormat = u"Disable"_s,
+        // only the threshold flushes in these tests
+        .flushInterval = 1h,
+        .flushThreshold = 64,
+    };
+}
+
+LoggedMessage makeMessage(const QString &text,
+                          const QDateTime &receivedAt = DAY_ONE)
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = u"forsen"_s;
+    message->messageText = text;
+    return {
+        .message = message,
+        .streamID = {},
+        .receivedAt = receivedAt.toMSecsSinceEpoch(),
+        .isReply = false,
+    };
+}
+
+QString logPath(const QTemporaryDir &dir, const QDateTime &day)
+{
+    return QDir(dir.path())
+        .filePath(QString(u"Twitch/Channels/forsen/forsen-"_s %
+                          day.toString(u"yyyy-MM-dd"_s) % u".log"));
+}
+
+QString readLog(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+    {
+        return {};
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+/// Waits until `done` returns true for the contents of the file (or 5s passed)
+bool waitForLog(const QString &path,
+                const std::function<bool(const QString &)> &done)
+{
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!done(readLog(path)) && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+    return done(readLog(path));
+}
+
+}  // namespace
+
+TEST(LoggingWriter, FlushesAtThreshold)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = logPath(dir, DAY_ONE);
+
+    LoggingWriter writer(makeOptions(dir));
+    writer.addMessage(u"forsen"_s, u"twitch"_s, makeMessage(u"first"_s));
+
+    // The file is opened right away, but the line stays buffered
+    ASSERT_TRUE(waitForLog(path, [](const auto &log) {
+        return log.startsWith(u"# Start logging at "_s);
+    }));
+    std::this_thread::sleep_for(100ms);
+    ASSERT_FALSE(readLog(path).contains(u"forsen: first"_s));
+
+    // This exceeds flushThreshold
+    writer.addMessage(u"forsen"_s, u"twitch"_s,
+                      makeMessage(QString(64, u'x')));
+    ASSERT_TRUE(waitForLog(path, [](const auto &log) {
+        return log.contains(
+            QString(u"forsen: first\nforsen: " % QString(64, u'x')));
+    }));
+
+    // Explicit flushes write short lines too
+    writer.addMessage(u"forsen"_s, u"twitch"_s, makeMessage(u"last"_s));
+    writer.flush();
+    ASSERT_TRUE(waitForLog(path, [](const auto &log) {
+        return log.endsWith(u"forsen: last\n"_s);
+    }));
+}
+
+TEST(LoggingWriter, DayRollover)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        auto options = makeOptions(dir);
+        options.flushThreshold = 0;
+        LoggingWriter writer(options);
+        writer.addMessage(u"forsen"_s, u"twitch"_s,
+                          makeMessage(u"day one"_s, DAY_ONE));
+        writer.addMessage(u"forsen"_s, u"twitch"_s,
+                          makeMessage(u"day two"_s, DAY_TWO));
+    }
+
+    auto dayOne = readLog(logPath(dir, DAY_ONE));
+    auto dayTwo = readLog(logPath(dir, DAY_TWO));
+    ASSERT_TRUE(dayOne.contains(u"forsen: day one\n"_s)) << dayOne;
+    ASSERT_FALSE(dayOne.contains(u"day two"_s)) << dayOne;
+    ASSERT_TRUE(dayTwo.startsWith(u"# Start logging at "_s)) << dayTwo;
+    ASSERT_TRUE(dayTwo.contains(u"forsen: day two\n"_s)) << dayTwo;
+    ASSERT_FALSE(dayTwo.contains(u"day one"_s)) << dayTwo;
+}
+
+TEST(LoggingWriter, ClosingMarker)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = logPath(dir, DAY_ONE);
+
+    {
+        LoggingWriter writer(makeOptions(dir));
+        writer.addMessage(u"forsen"_s, u"twitch"_s, makeMessage(u"a"_s));
+        writer.addMessage(u"forsen"_s, u"twitch"_s, makeMessage(u"b"_s));
+
+        // Closing a channel writes its buffered lines and the marker
+        writer.closeChannel(u"forsen"_s, u"twitch"_s);
+        ASSERT_TRUE(waitForLog(path, [](const auto &log) {
+            return log.contains(u"forsen: a\nforsen: b\n# Stop logging at "_s);
+        }));
+
+        writer.addMessage(u"forsen"_s, u"twitch"_s, makeMessage(u"c"_s));
+    }
+
+    // Shutting down writes pending lines and closing markers
+    auto log = readLog(path);
+    ASSERT_TRUE(log.contains(u"forsen: c\n# Stop logging at "_s)) << log;
+    ASSERT_TRUE(log.endsWith(u'\n')) << log;
+    ASSERT_EQ(log.count(u"# Start logging at "_s), 2) << log;
+    ASSERT_EQ(log.count(u"# Stop logging at "_s), 2) << log;
+}
+
+TEST(Logging, Flush)
+{
+    mock::BaseApplication app;
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = logPath(dir, QDateTime::currentDateTime());
+
+    app.settings.enableLogging = true;
+    app.settings.logPath = dir.path();
+    // only flush() writes the lines in this test
+    app.settings.logFlushInterval = 60 * 60 * 1000;
+    app.settings.logFlushThreshold = 64 * 1024;
+
+    Logging logging(app.settings);
+    logging.addMessage(u"forsen"_s,
+                       makeMessage(u"first"_s, QDateTime::currentDateTime())
+                           .message,
+                       u"twitch"_s, {});
+    ASSERT_TRUE(waitForLog(path, [](const auto &log) {
+        return log.startsWith(u"# Start logging at "_s);
+    }));
+    std::this_thread::sleep_for(100ms);
+    ASSERT_FALSE(readLog(path).contains(u"forsen: first"_s));
+
+    logging.flush();
+    ASSERT_TRUE(waitForLog(path, [](const auto &log) {
+        return log.endsWith(u"forsen: first\n"_s);
+    }));
+}
@@ -5,7 +5,9 @@
 #include "messages/layouts/MessageLayout.hpp"
 
 #include "Application.hpp"
+#include "common/Literals.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "messages/layouts/MessageLayoutCache.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -23,6 +25,7 @@
 #include <memory>
 
 using namespace chatterino;
+using namespace literals;
 
 namespace {
 
@@ -95,3 +98,56 @@ TEST(TextElement, BasicCase)
     EXPECT_EQ(wordStart, 0);
     EXPECT_EQ(wordEnd, 3);
 }
+
+TEST(MessageLayout, SharedBetweenViews)
+{
+    MockApplication mockApplication;
+
+    MessageBuilder builder;
+    builder.append(std::make_unique<TextElement>(
+        u"aaaaaaaa bbbbbbbb cccccccc"_s, MessageElementFlag::Text));
+    auto message = builder.release();
+
+    MessageColors colors;
+    auto layoutWithWidth = [&](MessageLayout &layout, int width) {
+        return layout.layout(
+            {
+                .messageColors = colors,
+                .flags = MessageElementFlag::Text,
+                .width = width,
+                .scale = 1,
+                .imageScale = 1,
+            },
+            false);
+    };
+
+    auto point = QPoint(WIDTH / 20, 5);
+    {
+        MessageLayout first(message);
+        MessageLayout second(message);
+        ASSERT_TRUE(layoutWithWidth(first, WIDTH));
+        ASSERT_TRUE(layoutWithWidth(second, WIDTH));
+        ASSERT_FALSE(layoutWithWidth(second, WIDTH));
+
+        // the second view uses the elements laid out by the first
+        ASSERT_NE(first.getElementAt(point), nullptr);
+        ASSERT_EQ(first.getElementAt(point), second.getElementAt(point));
+        ASSERT_EQ(MessageLayoutCache::instance().size(), 1);
+
+        ASSERT_TRUE(layoutWithWidth(second, WIDTH / 2));
+        ASSERT_NE(first.getElementAt(point), second.getElementAt(point));
+
+        // a forced layout doesn't reuse the other view's layout
+        const auto *before = second.getElementAt(point);
+        second.flags.set(MessageLayoutFlag::RequiresLayout);
+        ASSERT_TRUE(layoutWithWidth(second, WIDTH / 2));
+        ASSERT_NE(second.getElementAt(point), before);
+
+        second.deleteCache();
+        ASSERT_EQ(second.getElementAt(point), nullptr);
+        ASSERT_EQ(second.getHeight(), 0);
+    }
+
+    // the layouts are removed with the last view using them
+    ASSERT_EQ(MessageLayoutCache::instance().size(), 0);
+}
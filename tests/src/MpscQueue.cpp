@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/MpscQueue.hpp"
+
+#include "Test.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(MpscQueue, FifoOrder)
+{
+    MpscQueue<int> queue;
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.tryPop().has_value());
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    ASSERT_FALSE(queue.empty());
+
+    ASSERT_EQ(queue.tryPop(), 1);
+    ASSERT_EQ(queue.tryPop(), 2);
+    ASSERT_EQ(queue.tryPop(), 3);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(MpscQueue, DestroysRemainingItems)
+{
+    auto item = std::make_shared<int>(42);
+    {
+        MpscQueue<std::shared_ptr<int>> queue;
+        queue.push(item);
+        queue.push(item);
+        ASSERT_EQ(item.use_count(), 3);
+    }
+    ASSERT_EQ(item.use_count(), 1);
+}
+
+TEST(MpscQueue, ManyProducers)
+{
+    constexpr int producerCount = 4;
+    constexpr int itemsPerProducer = 10000;
+
+    MpscQueue<std::pair<int, int>> queue;
+
+    std::vector<std::thread> producers;
+    producers.reserve(producerCount);
+    for (int p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < itemsPerProducer; i++)
+            {
+                queue.push({p, i});
+            }
+        });
+    }
+
+    // every producer's items must arrive in order and exactly once
+    std::vector<int> next(producerCount, 0);
+    int received = 0;
+    while (received < producerCount * itemsPerProducer)
+    {
+        auto item = queue.tryPop();
+        if (!item)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        // EXPECT, as the producers must be joined before returning
+        EXPECT_EQ(item->second, next[item->first]);
+        next[item->first]++;
+        received++;
+    }
+
+    for (auto &t : producers)
+    {
+        t.join();
+    }
+
+    ASSERT_TRUE(queue.empty());
+}
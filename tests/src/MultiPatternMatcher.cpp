@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/MultiPatternMatcher.hpp"
+
+#include "common/Literals.hpp"
+#include "controllers/highlights/HighlightPhrase.hpp"
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "Test.hpp"
+
+#include <QStringList>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+TEST(MultiPatternMatcher, Find)
+{
+    MultiPatternMatcher matcher({
+        {u"he"_s, Qt::CaseSensitive},
+        {u"she"_s, Qt::CaseSensitive},
+        {u"hers"_s, Qt::CaseSensitive},
+        {u"his"_s, Qt::CaseSensitive},
+        {u""_s, Qt::CaseSensitive},
+        {u"FOO"_s, Qt::CaseInsensitive},
+        {u"kiss"_s, Qt::CaseInsensitive},
+    });
+    ASSERT_EQ(matcher.size(), 7U);
+
+    EXPECT_EQ(matcher.find(u"ushers"),
+              (std::vector<bool>{true, true, true, false, true, false, false}));
+    // U+212A (Kelvin sign) and U+017F (long s) fold to ASCII letters
+    EXPECT_EQ(matcher.find(u"xfOo \u212Aiss \u017Fhe"),
+              (std::vector<bool>{true, false, false, false, true, true, true}));
+    EXPECT_EQ(
+        matcher.find(u""),
+        (std::vector<bool>{false, false, false, false, true, false, false}));
+
+    EXPECT_TRUE(MultiPatternMatcher().find(u"abc").empty());
+}
+
+TEST(MultiPatternMatcher, FindOverlapping)
+{
+    MultiPatternMatcher matcher({
+        {u"abcd"_s, Qt::CaseSensitive},
+        {u"bc"_s, Qt::CaseSensitive},
+        {u"c"_s, Qt::CaseSensitive},
+        {u"abx"_s, Qt::CaseSensitive},
+        {u"\U00010400x"_s, Qt::CaseInsensitive},
+    });
+
+    EXPECT_EQ(matcher.find(u"abxabcd"),
+              (std::vector<bool>{true, true, true, true, false}));
+    EXPECT_EQ(matcher.find(u"abcabx"),
+              (std::vector<bool>{false, true, true, true, false}));
+    // U+10428 is the lowercase version of U+10400
+    EXPECT_EQ(matcher.find(u"\U00010428X"),
+              (std::vector<bool>{false, false, false, false, true}));
+}
+
+TEST(MultiPatternMatcher, RequiredLiteral)
+{
+    struct TestCase {
+        QString pattern;
+        bool isRegex;
+        Qt::CaseSensitivity caseSensitivity;
+        QString expected;
+    };
+
+    std::vector<TestCase> tests{
+        {u"forsen"_s, false, Qt::CaseInsensitive, u"forsen"_s},
+        {u"forsén xd"_s, false, Qt::CaseSensitive, u"forsén xd"_s},
+        {u"forsén xdd"_s, false, Qt::CaseInsensitive, u"n xdd"_s},
+        {u"a|b"_s, false, Qt::CaseSensitive, u"a|b"_s},
+
+        {uR"(\bforsen\b)"_s, true, Qt::CaseInsensitive, u"forsen"_s},
+        {uR"(^!\w+)"_s, true, Qt::CaseInsensitive, u"!"_s},
+        {u"ab?cde*f"_s, true, Qt::CaseSensitive, u"cd"_s},
+        {u"abc+de"_s, true, Qt::CaseSensitive, u"abc"_s},
+        {u"ab{2,3}cd"_s, true, Qt::CaseSensitive, u"cd"_s},
+        {uR"(a\.bc\d)"_s, true, Qt::CaseSensitive, u"a.bc"_s},
+        {uR"(a\|bc)"_s, true, Qt::CaseSensitive, u"a|bc"_s},
+        {u"a(bcdefg)?hi"_s, true, Qt::CaseSensitive, u"hi"_s},
+        {u"(abc|def)gh"_s, true, Qt::CaseSensitive, u"gh"_s},
+        {u"(?i:xyzw)abc"_s, true, Qt::CaseSensitive, u"abc"_s},
+        {u"(?=foo)barr"_s, true, Qt::CaseSensitive, u"barr"_s},
+        {uR"(x[abc\]]yz[[:alpha:]]w)"_s, true, Qt::CaseSensitive, u"yz"_s},
+        {u"[]abcdef]gh"_s, true, Qt::CaseSensitive, u"gh"_s},
+
+        // nothing is known to be required
+        {u"abc|def"_s, true, Qt::CaseSensitive, u""_s},
+        {u"(?i)abc"_s, true, Qt::CaseSensitive, u""_s},
+        {uR"(\x41bc)"_s, true, Qt::CaseSensitive, u""_s},
+        {uR"((a)\1bc)"_s, true, Qt::CaseSensitive, u""_s},
+        {uR"(\Qabc\E)"_s, true, Qt::CaseSensitive, u""_s},
+        {u"(a(*ACCEPT))bcd"_s, true, Qt::CaseSensitive, u""_s},
+        {u"abc("_s, true, Qt::CaseSensitive, u""_s},
+        {u".*"_s, true, Qt::CaseSensitive, u""_s},
+    };
+
+    for (const auto &test : tests)
+    {
+        EXPECT_EQ(requiredLiteral(test.pattern, test.isRegex,
+                                  test.caseSensitivity),
+                  test.expected)
+            << test.pattern;
+    }
+}
+
+TEST(MultiPatternMatcher, NeverMissesPhraseMatches)
+{
+    const QStringList patterns{
+        u"forsen"_s,     u"!test"_s,          u"xd"_s,
+        u"Kappa"_s,      uR"(\bpog+ers\b)"_s, uR"(^!\w+)"_s,
+        u"(?i)ABC"_s,    u"a[bc]+d"_s,        u"(foo|bar)baz"_s,
+        u"SPAM{2,}"_s,   u"ünïcödé"_s,        uR"(emote\s*spam)"_s,
+        u"kiss"_s,       u"\U00010400"_s,
+    };
+    const QStringList messages{
+        u"forsen"_s,
+        u"FORSEN xd"_s,
+        u"!test something"_s,
+        u"test! kappa Kappa"_s,
+        u"poggggers poggers"_s,
+        u"!command"_s,
+        u"abc ABC"_s,
+        u"abbcd acd"_s,
+        u"foobaz barbaz"_s,
+        u"SPAMMMM spam"_s,
+        u"ÜNÏCÖDÉ ünïcödé"_s,
+        u"emote    spam emotespam"_s,
+        u"\u212Aiss \u017Fpam"_s,
+        u"\U00010428"_s,
+        u""_s,
+    };
+
+    std::vector<HighlightPhrase> highlights;
+    std::vector<IgnorePhrase> ignores;
+    std::vector<MultiPatternMatcher::Pattern> highlightPatterns;
+    std::vector<MultiPatternMatcher::Pattern> ignorePatterns;
+    for (const auto &pattern : patterns)
+    {
+        for (bool isRegex : {false, true})
+        {
+            for (auto caseSensitivity :
+                 {Qt::CaseSensitive, Qt::CaseInsensitive})
+            {
+                bool isCaseSensitive = caseSensitivity == Qt::CaseSensitive;
+                auto literal =
+                    requiredLiteral(pattern, isRegex, caseSensitivity);
+                highlights.emplace_back(pattern, false, false, false, isRegex,
+                                        isCaseSensitive, QString(), QColor());
+                highlightPatterns.push_back({literal, caseSensitivity});
+                ignores.emplace_back(pattern, isRegex, true, QString(),
+                                     isCaseSensitive);
+                ignorePatterns.push_back({literal, caseSensitivity});
+            }
+        }
+    }
+
+    MultiPatternMatcher highlightMatcher(highlightPatterns);
+    MultiPatternMatcher ignoreMatcher(ignorePatterns);
+    for (const auto &message : messages)
+    {
+        auto highlightCandidates = highlightMatcher.find(message);
+        for (size_t i = 0; i < highlights.size(); i++)
+        {
+            if (highlights[i].isMatch(message))
+            {
+                EXPECT_TRUE(highlightCandidates[i])
+                    << highlights[i].getPattern() << " " << message;
+            }
+        }
+
+        auto ignoreCandidates = ignoreMatcher.find(message);
+        for (size_t i = 0; i < ignores.size(); i++)
+        {
+            if (ignores[i].isMatch(message))
+            {
+                EXPECT_TRUE(ignoreCandidates[i])
+                    << ignores[i].getPattern() << " " << message;
+            }
+        }
+    }
+}
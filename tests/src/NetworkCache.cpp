@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/network/NetworkCache.hpp"
+
+#include "common/Literals.hpp"
+#include "Test.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+QByteArray makeData(qsizetype size, char fill)
+{
+    return QByteArray(size, fill);
+}
+
+/// Makes sure the next access gets a different timestamp
+void tick()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+}
+
+}  // namespace
+
+TEST(NetworkCache, PutGet)
+{
+    QTemporaryDir dir;
+    NetworkCache cache(dir.path(), 0);
+
+    ASSERT_FALSE(cache.get(u"missing"_s).has_value());
+
+    auto small = makeData(100, 'a');
+    auto large = makeData(NetworkCache::MAX_SEGMENT_ENTRY_SIZE + 1, 'b');
+    cache.put(u"small"_s, small, {.etag = "\"abc\""});
+    cache.put(u"large"_s, large, {.lastModified = "Tue, 1 Jan 2030"});
+
+    auto hit = cache.get(u"small"_s);
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->data, small);
+    ASSERT_EQ(hit->validators.etag, "\"abc\"");
+    ASSERT_FALSE(hit->stale);
+
+    hit = cache.get(u"large"_s);
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->data, large);
+    ASSERT_EQ(hit->validators.lastModified, "Tue, 1 Jan 2030");
+
+    // replacing an entry
+    cache.put(u"small"_s, makeData(10, 'c'), {});
+    hit = cache.get(u"small"_s);
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->data, makeData(10, 'c'));
+    ASSERT_TRUE(hit->validators.empty());
+    ASSERT_EQ(cache.size(), 2U);
+
+    cache.remove(u"large"_s);
+    ASSERT_FALSE(cache.get(u"large"_s).has_value());
+    ASSERT_EQ(cache.size(), 1U);
+}
+
+TEST(NetworkCache, PacksSmallEntries)
+{
+    QTemporaryDir dir;
+    NetworkCache cache(dir.path(), 0);
+
+    for (int i = 0; i < 100; i++)
+    {
+        cache.put(QString::number(i), makeData(1000, 'a'), {});
+    }
+    cache.flush();
+
+    // one segment and the index
+    ASSERT_EQ(QDir(dir.path()).entryList(QDir::Files).size(), 2);
+}
+
+TEST(NetworkCache, Persistence)
+{
+    QTemporaryDir dir;
+    auto large = makeData(NetworkCache::MAX_SEGMENT_ENTRY_SIZE * 2, 'b');
+    {
+        NetworkCache cache(dir.path(), 0);
+        cache.put(u"small"_s, makeData(100, 'a'), {.etag = "W/\"1\""});
+        cache.put(u"large"_s, large, {});
+    }
+
+    NetworkCache cache(dir.path(), 0);
+    ASSERT_EQ(cache.size(), 2U);
+
+    auto hit = cache.get(u"small"_s);
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->data, makeData(100, 'a'));
+    ASSERT_EQ(hit->validators.etag, "W/\"1\"");
+
+    hit = cache.get(u"large"_s);
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->data, large);
+}
+
+TEST(NetworkCache, MissingFiles)
+{
+    QTemporaryDir dir;
+    {
+        NetworkCache cache(dir.path(), 0);
+        cache.put(u"large"_s,
+                  makeData(NetworkCache::MAX_SEGMENT_ENTRY_SIZE * 2, 'b'), {});
+    }
+    QFile::remove(dir.filePath(u"large"_s));
+
+    NetworkCache cache(dir.path(), 0);
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_FALSE(cache.get(u"large"_s).has_value());
+}
+
+TEST(NetworkCache, EvictsLeastRecentlyUsed)
+{
+    QTemporaryDir dir;
+    constexpr qint64 entrySize = 30 * 1024;
+    NetworkCache cache(dir.path(), 100 * 1024);
+
+    cache.put(u"a"_s, makeData(entrySize, 'a'), {});
+    tick();
+    cache.put(u"b"_s, makeData(entrySize, 'b'), {});
+    tick();
+    cache.put(u"c"_s, makeData(entrySize, 'c'), {});
+    tick();
+    ASSERT_TRUE(cache.get(u"a"_s).has_value());
+    tick();
+
+    // 120 KiB > 100 KiB, "b" was used the longest time ago
+    cache.put(u"d"_s, makeData(entrySize, 'd'), {});
+    ASSERT_EQ(cache.size(), 3U);
+    ASSERT_FALSE(cache.get(u"b"_s).has_value());
+    ASSERT_TRUE(cache.get(u"a"_s).has_value());
+    ASSERT_TRUE(cache.get(u"c"_s).has_value());
+    ASSERT_TRUE(cache.get(u"d"_s).has_value());
+
+    // the space of "b" is reclaimed
+    ASSERT_LE(cache.diskBytes(), 100 * 1024);
+
+    // the cache stays within its budget
+    for (int i = 0; i < 20; i++)
+    {
+        cache.put(QString::number(i), makeData(entrySize, 'e'), {});
+        ASSERT_LE(cache.diskBytes(), 100 * 1024);
+        tick();
+    }
+    ASSERT_EQ(cache.size(), 3U);
+    ASSERT_EQ(cache.get(u"19"_s)->data, makeData(entrySize, 'e'));
+}
+
+TEST(NetworkCache, SetMaxBytes)
+{
+    QTemporaryDir dir;
+    NetworkCache cache(dir.path(), 0);
+    for (int i = 0; i < 10; i++)
+    {
+        cache.put(QString::number(i), makeData(10 * 1024, 'a'), {});
+        tick();
+    }
+    ASSERT_EQ(cache.size(), 10U);
+
+    cache.setMaxBytes(50 * 1024);
+    ASSERT_LE(cache.diskBytes(), 50 * 1024);
+    ASSERT_TRUE(cache.get(u"9"_s).has_value());
+    ASSERT_FALSE(cache.get(u"0"_s).has_value());
+}
+
+TEST(NetworkCache, ImportsLegacyFiles)
+{
+    QTemporaryDir legacyDir;
+    QFile legacy(legacyDir.filePath(u"deadbeef"_s));
+    ASSERT_TRUE(legacy.open(QFile::WriteOnly));
+    legacy.write("legacy data");
+    legacy.flush();
+    legacy.setFileTime(QDateTime::currentDateTime().addDays(-30),
+                       QFile::FileModificationTime);
+    legacy.close();
+
+    NetworkCache cache(legacyDir.filePath(u"http"_s), 0, legacyDir.path());
+    auto hit = cache.get(u"deadbeef"_s);
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->data, "legacy data");
+    // the old file is too old to be used without revalidation
+    ASSERT_TRUE(hit->stale);
+    ASSERT_FALSE(QFile::exists(legacyDir.filePath(u"deadbeef"_s)));
+
+    hit = cache.get(u"deadbeef"_s);
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->data, "legacy data");
+
+    cache.markRevalidated(u"deadbeef"_s);
+    ASSERT_FALSE(cache.get(u"deadbeef"_s)->stale);
+}
+
+TEST(NetworkCache, ConcurrentAccess)
+{
+    QTemporaryDir dir;
+    // small enough to evict and compact while the readers are running
+    NetworkCache cache(dir.path(), 200 * 1024);
+
+    constexpr int keyCount = 50;
+    auto dataFor = [](int key) {
+        return makeData(5 * 1024 + key, static_cast<char>('a' + key % 26));
+    };
+
+    std::atomic<bool> mismatch = false;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 500; i++)
+            {
+                auto key = (i * 7 + t * 13) % keyCount;
+                if ((i + t) % 3 == 0)
+                {
+                    cache.put(QString::number(key), dataFor(key), {});
+                    continue;
+                }
+                auto hit = cache.get(QString::number(key));
+                if (hit && hit->data != dataFor(key))
+                {
+                    mismatch = true;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_FALSE(mismatch);
+    // compactions are skipped while another one is running
+    cache.setMaxBytes(200 * 1024);
+    ASSERT_LE(cache.diskBytes(), 200 * 1024);
+    for (int key = 0; key < keyCount; key++)
+    {
+        auto hit = cache.get(QString::number(key));
+        if (hit)
+        {
+            ASSERT_EQ(hit->data, dataFor(key)) << key;
+        }
+    }
+}
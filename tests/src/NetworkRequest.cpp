@@ -5,12 +5,19 @@
 #include "common/network/NetworkRequest.hpp"
 
 #include "common/network/NetworkManager.hpp"
+#include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "NetworkHelpers.hpp"
 #include "Test.hpp"
+#include "util/DebugCount.hpp"
 #include "util/QMagicEnum.hpp"
 
 #include <QCoreApplication>
+#include <QUrl>
+
+#include <memory>
+#include <optional>
+#include <vector>
 
 using namespace chatterino;
 
@@ -383,3 +390,165 @@ TEST(NetworkRequest, HttpBodyMultipart)
         ASSERT_TRUE(success) << path;
     }
 }
+
+TEST(NetworkRequest, CoalescedGets)
+{
+    static const auto numRequests = 5;
+
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+
+    for (const auto &[url, expectSuccess] : std::array{
+             std::pair{getDelayURL(1), true},
+             std::pair{getStatusURL(404), false},
+         })
+    {
+        struct RequestState {
+            RequestWaiter waiter;
+            std::optional<int> status;
+            bool succeeded = false;
+        };
+
+        // all requests are started before the first one finishes, so they
+        // share one transfer
+        auto coalescedBefore =
+            DebugCount::get(DebugObject::HTTPRequestCoalesced);
+        std::vector<std::shared_ptr<RequestState>> states;
+        for (auto i = 0; i < numRequests; ++i)
+        {
+            auto state = std::make_shared<RequestState>();
+            NetworkRequest(url)
+                .onSuccess([=](const NetworkResult &result) {
+                    state->status = result.status();
+                    state->succeeded = true;
+                })
+                .onError([=](const NetworkResult &result) {
+                    state->status = result.status();
+                })
+                .finally([=] {
+                    state->waiter.requestDone();
+                })
+                .execute();
+            states.emplace_back(state);
+        }
+        EXPECT_EQ(DebugCount::get(DebugObject::HTTPRequestCoalesced) -
+                      coalescedBefore,
+                  numRequests - 1)
+            << url;
+
+        for (const auto &state : states)
+        {
+            state->waiter.waitForRequest();
+            EXPECT_EQ(state->succeeded, expectSuccess) << url;
+            EXPECT_EQ(state->status, expectSuccess ? 200 : 404) << url;
+        }
+    }
+}
+
+TEST(NetworkRequest, CoalescedTimeout)
+{
+    static const auto numRequests = 3;
+
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+
+    struct RequestState {
+        RequestWaiter waiter;
+        std::optional<NetworkResult::NetworkError> error;
+    };
+
+    std::vector<std::shared_ptr<RequestState>> states;
+    for (auto i = 0; i < numRequests; ++i)
+    {
+        auto state = std::make_shared<RequestState>();
+        NetworkRequest(getDelayURL(5))
+            .timeout(1000)
+            .onError([=](const NetworkResult &result) {
+                state->error = result.error();
+            })
+            .finally([=] {
+                state->waiter.requestDone();
+            })
+            .execute();
+        states.emplace_back(state);
+    }
+
+    // the requests waiting for the one that timed out fail as well
+    for (const auto &state : states)
+    {
+        state->waiter.waitForRequest();
+        EXPECT_EQ(state->error, NetworkResult::NetworkError::TimeoutError);
+    }
+}
+
+TEST(NetworkRequest, CoalescedWithDroppedLeader)
+{
+    auto makeData = [] {
+        auto data = std::make_shared<NetworkData>();
+        data->request.setUrl(QUrl(getStatusURL(200)));
+        return data;
+    };
+
+    auto leader = makeData();
+    ASSERT_FALSE(NetworkData::coalesce(leader));
+
+    RequestWaiter waiter;
+    std::optional<NetworkResult::NetworkError> error;
+    {
+        auto waiting = makeData();
+        waiting->onError = [&](const NetworkResult &result) {
+            error = result.error();
+        };
+        waiting->finally = [&] {
+            waiter.requestDone();
+        };
+        ASSERT_TRUE(NetworkData::coalesce(waiting));
+    }
+
+    // The leader is gone without ever emitting a result (e.g. because its
+    // reply was cancelled)
+    leader.reset();
+    waiter.waitForRequest();
+    EXPECT_EQ(error, NetworkResult::NetworkError::OperationCanceledError);
+
+    // Nothing is in flight anymore
+    auto next = makeData();
+    ASSERT_FALSE(NetworkData::coalesce(next));
+}
+
+TEST(NetworkRequest, CoalescedHeaderValues)
+{
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+
+    struct RequestState {
+        RequestWaiter waiter;
+        QString body;
+    };
+
+    // only the header values differ, so the requests can't share a response
+    auto coalescedBefore = DebugCount::get(DebugObject::HTTPRequestCoalesced);
+    std::vector<std::pair<QString, std::shared_ptr<RequestState>>> states;
+    for (const auto *value : {"forsen", "pajlada"})
+    {
+        auto state = std::make_shared<RequestState>();
+        NetworkRequest(getHttpbinUrl(u"headers"))
+            .timeout(1000)
+            .header("X-Chatterino-Test", value)
+            .onSuccess([=](const NetworkResult &result) {
+                state->body = QString::fromUtf8(result.getData());
+            })
+            .finally([=] {
+                state->waiter.requestDone();
+            })
+            .execute();
+        states.emplace_back(QString::fromLatin1(value), state);
+    }
+    EXPECT_EQ(DebugCount::get(DebugObject::HTTPRequestCoalesced),
+              coalescedBefore);
+
+    for (const auto &[value, state] : states)
+    {
+        state->waiter.waitForRequest();
+        EXPECT_TRUE(state->body.contains(value)) << state->body;
+    }
+    EXPECT_FALSE(states[0].second->body.contains(states[1].first));
+    EXPECT_FALSE(states[1].second->body.contains(states[0].first));
+}
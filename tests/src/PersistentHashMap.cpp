@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/PersistentHashMap.hpp"
+
+#include "Test.hpp"
+
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+using StdMap = std::map<int, int>;
+
+/// Only a few distinct hashes, so most keys collide
+struct CollidingHash {
+    size_t operator()(int key) const
+    {
+        return static_cast<size_t>(key % 7) * 0x9e3779b97f4a7c15U;
+    }
+};
+
+template <typename Map>
+StdMap toStdMap(const Map &map)
+{
+    StdMap out;
+    for (const auto &[key, value] : map)
+    {
+        EXPECT_TRUE(out.emplace(key, value).second) << "duplicate " << key;
+    }
+    return out;
+}
+
+/// Modifies random copies of older versions and compares them with
+/// std::unordered_map
+template <typename Hash>
+void checkAgainstReference(unsigned seed)
+{
+    using Map = PersistentHashMap<int, int, Hash>;
+    using Reference = std::unordered_map<int, int>;
+
+    std::mt19937 rng(seed);
+    std::vector<std::pair<Map, Reference>> versions(1);
+    for (int step = 0; step < 2000; step++)
+    {
+        const auto &base = versions[rng() % versions.size()];
+        auto map = base.first;
+        auto reference = base.second;
+
+        auto ops = rng() % 5 + 1;
+        for (unsigned op = 0; op < ops; op++)
+        {
+            int key = static_cast<int>(rng() % 300);
+            switch (rng() % 3)
+            {
+                case 0:
+                    map[key] = step;
+                    reference[key] = step;
+                    break;
+                case 1:
+                    ASSERT_EQ(map.erase(key), reference.erase(key));
+                    break;
+                default:
+                    ASSERT_EQ(map.try_emplace(key, -step).second,
+                              reference.try_emplace(key, -step).second);
+                    break;
+            }
+        }
+
+        ASSERT_EQ(map.size(), reference.size());
+        ASSERT_EQ(toStdMap(map), StdMap(reference.begin(), reference.end()));
+        for (const auto &[key, value] : reference)
+        {
+            auto it = map.find(key);
+            ASSERT_NE(it, map.end());
+            ASSERT_EQ(it->second, value);
+        }
+
+        std::set<int> changed;
+        map.diff(base.first, [&](int key) {
+            ASSERT_TRUE(changed.insert(key).second) << "duplicate " << key;
+        });
+        std::set<int> expected;
+        for (const auto &[key, value] : reference)
+        {
+            auto it = base.second.find(key);
+            if (it == base.second.end() || it->second != value)
+            {
+                expected.insert(key);
+            }
+        }
+        for (const auto &[key, value] : base.second)
+        {
+            if (!reference.contains(key))
+            {
+                expected.insert(key);
+            }
+        }
+        ASSERT_EQ(changed, expected);
+
+        // the version we copied must not be affected
+        ASSERT_EQ(toStdMap(base.first),
+                  StdMap(base.second.begin(), base.second.end()));
+
+        versions.emplace_back(std::move(map), std::move(reference));
+        if (versions.size() > 32)
+        {
+            versions.erase(versions.begin() +
+                           static_cast<ptrdiff_t>(rng() % versions.size()));
+        }
+    }
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Basic)
+{
+    PersistentHashMap<int, int> map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.begin(), map.end());
+    ASSERT_EQ(map.find(1), map.end());
+
+    map[1] = 10;
+    ASSERT_TRUE(map.emplace(2, 20).second);
+    ASSERT_FALSE(map.emplace(2, 21).second);
+    ASSERT_FALSE(map.insert_or_assign(2, 22).second);
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map.at(2), 22);
+    ASSERT_TRUE(map.contains(1));
+    ASSERT_THROW((void)map.at(3), std::out_of_range);
+
+    map.erase(map.find(1));
+    ASSERT_EQ(map.size(), 1);
+    ASSERT_FALSE(map.contains(1));
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentHashMap, CopiesAreIndependent)
+{
+    PersistentHashMap<int, int> original;
+    for (int i = 0; i < 1000; i++)
+    {
+        original[i] = i;
+    }
+
+    auto copy = original;
+    copy[5] = -5;
+    copy.erase(6);
+    copy[1000] = 1000;
+
+    ASSERT_EQ(original.size(), 1000);
+    ASSERT_EQ(original.at(5), 5);
+    ASSERT_EQ(original.at(6), 6);
+    ASSERT_FALSE(original.contains(1000));
+
+    ASSERT_EQ(copy.size(), 1000);
+    ASSERT_EQ(copy.at(5), -5);
+    ASSERT_FALSE(copy.contains(6));
+
+    std::set<int> changed;
+    original.diff(copy, [&](int key) {
+        changed.insert(key);
+    });
+    ASSERT_EQ(changed, (std::set<int>{5, 6, 1000}));
+}
+
+TEST(PersistentHashMap, Reference)
+{
+    checkAgainstReference<std::hash<int>>(1);
+}
+
+TEST(PersistentHashMap, ReferenceWithCollisions)
+{
+    checkAgainstReference<CollidingHash>(2);
+}
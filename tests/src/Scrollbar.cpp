@@ -12,9 +12,12 @@
 #include "singletons/WindowManager.hpp"
 #include "Test.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
+#include "widgets/helper/ScrollbarMinimap.hpp"
 
+#include <QPainter>
 #include <QString>
 
+#include <cmath>
 #include <memory>
 
 using namespace chatterino;
@@ -38,6 +41,67 @@ public:
     WindowManager windowManager;
 };
 
+/// How the scrollbar used to paint its highlights
+QImage paintHighlights(
+    const boost::circular_buffer<ScrollbarHighlight> &highlights, QSize size,
+    float scale, ScrollbarMinimap::Filter filter)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+
+    int w = size.width();
+    float dY = static_cast<float>(size.height()) /
+               static_cast<float>(highlights.size());
+    int highlightHeight =
+        static_cast<int>(std::ceil(std::max(scale * 2.0F, dY)));
+
+    for (size_t i = 0; i < highlights.size(); i++)
+    {
+        const auto &highlight = highlights[i];
+        if (highlight.isNull() ||
+            (highlight.isRedeemedHighlight() && !filter.redeemed) ||
+            (highlight.isFirstMessageHighlight() && !filter.firstMessage) ||
+            (highlight.isElevatedMessageHighlight() && !filter.elevated))
+        {
+            continue;
+        }
+
+        QColor color = highlight.getColor();
+        color.setAlpha(255);
+
+        int y = static_cast<int>(dY * static_cast<float>(i));
+        switch (highlight.getStyle())
+        {
+            case ScrollbarHighlight::Default:
+                painter.fillRect(w / 8 * 3, y, w / 4, highlightHeight, color);
+                break;
+            case ScrollbarHighlight::Line:
+                painter.fillRect(0, y, w, 1, color);
+                break;
+            case ScrollbarHighlight::None:;
+        }
+    }
+
+    return image;
+}
+
+ScrollbarHighlight makeHighlight(int i)
+{
+    auto color = std::make_shared<QColor>((i * 37) % 256, (i * 11) % 256,
+                                          (i * 5) % 256, 100);
+    auto style = ScrollbarHighlight::Default;
+    if (i % 7 == 0)
+    {
+        style = ScrollbarHighlight::Line;
+    }
+    else if (i % 5 == 0)
+    {
+        style = ScrollbarHighlight::None;
+    }
+    return {color, style, i % 3 == 0, i % 4 == 0, i % 6 == 0};
+}
+
 }  // namespace
 
 TEST(Scrollbar, AddHighlight)
@@ -176,3 +240,85 @@ TEST(Scrollbar, AddHighlightsAtStart)
         EXPECT_EQ(highlights[9].getColor().red(), 1);
     }
 }
+
+TEST(Scrollbar, MinimapMatchesPainting)
+{
+    const QSize sizes[] = {{16, 100}, {16, 500}, {24, 37}, {32, 1}};
+    const ScrollbarMinimap::Filter filters[] = {
+        {},
+        {.redeemed = false},
+        {.redeemed = false, .firstMessage = false, .elevated = false},
+    };
+
+    for (size_t nHighlights : {1, 7, 50, 300})
+    {
+        boost::circular_buffer<ScrollbarHighlight> highlights(nHighlights);
+        for (size_t i = 0; i < nHighlights; i++)
+        {
+            highlights.push_back(makeHighlight(static_cast<int>(i)));
+        }
+
+        for (auto size : sizes)
+        {
+            for (float scale : {1.0F, 2.5F})
+            {
+                for (auto filter : filters)
+                {
+                    ScrollbarMinimap minimap;
+                    EXPECT_EQ(
+                        minimap.image(highlights, size, scale, filter),
+                        paintHighlights(highlights, size, scale, filter))
+                        << nHighlights << " " << size.width() << "x"
+                        << size.height() << " " << scale;
+                }
+            }
+        }
+    }
+}
+
+TEST(Scrollbar, MinimapUpdates)
+{
+    const QSize size(16, 200);
+    const ScrollbarMinimap::Filter filter{.firstMessage = false};
+
+    boost::circular_buffer<ScrollbarHighlight> highlights(60);
+    for (int i = 0; i < 40; i++)
+    {
+        highlights.push_back(makeHighlight(i));
+    }
+
+    ScrollbarMinimap minimap;
+    ASSERT_EQ(minimap.image(highlights, size, 1, filter),
+              paintHighlights(highlights, size, 1, filter));
+
+    // replacements only redraw the affected rows
+    for (size_t index : {0, 1, 13, 20, 21, 38, 39})
+    {
+        for (int replacement : {0, 5, 7, 11, 12})
+        {
+            highlights[index] = replacement == 0 ? ScrollbarHighlight{}
+                                                 : makeHighlight(replacement);
+            minimap.updateHighlight(highlights, index);
+            ASSERT_EQ(minimap.image(highlights, size, 1, filter),
+                      paintHighlights(highlights, size, 1, filter))
+                << index << " " << replacement;
+        }
+    }
+
+    // additions move the other highlights
+    for (int i = 0; i < 40; i++)
+    {
+        if (i % 2 == 0)
+        {
+            highlights.push_back(makeHighlight(i + 100));
+        }
+        else
+        {
+            highlights.push_front(makeHighlight(i + 100));
+        }
+        minimap.invalidate();
+        ASSERT_EQ(minimap.image(highlights, size, 1, filter),
+                  paintHighlights(highlights, size, 1, filter))
+            << i;
+    }
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/Similarity.hpp"
+
+#include "common/Literals.hpp"
+#include "Test.hpp"
+
+#include <QRandomGenerator>
+#include <QString>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+/// The straightforward dynamic programming solution
+qsizetype naiveLongestCommonSubstring(QStringView a, QStringView b)
+{
+    std::vector<std::vector<qsizetype>> table(
+        a.size() + 1, std::vector<qsizetype>(b.size() + 1, 0));
+    qsizetype best = 0;
+    for (qsizetype i = 1; i <= a.size(); i++)
+    {
+        for (qsizetype j = 1; j <= b.size(); j++)
+        {
+            if (a[i - 1] == b[j - 1])
+            {
+                table[i][j] = table[i - 1][j - 1] + 1;
+                best = std::max(best, table[i][j]);
+            }
+        }
+    }
+    return best;
+}
+
+QString randomText(QRandomGenerator &rng, qsizetype maxLength)
+{
+    QString text;
+    auto length = rng.bounded(maxLength + 1);
+    for (qsizetype i = 0; i < length; i++)
+    {
+        // a small alphabet, so there are lots of common substrings
+        text.append(QChar(u'a' + rng.bounded(4)));
+    }
+    return text;
+}
+
+}  // namespace
+
+TEST(Similarity, LongestCommonSubstring)
+{
+    using similarity::longestCommonSubstring;
+
+    EXPECT_EQ(longestCommonSubstring(u"", u""), 0);
+    EXPECT_EQ(longestCommonSubstring(u"abc", u""), 0);
+    EXPECT_EQ(longestCommonSubstring(u"", u"abc"), 0);
+    EXPECT_EQ(longestCommonSubstring(u"abc", u"def"), 0);
+    EXPECT_EQ(longestCommonSubstring(u"abc", u"abc"), 3);
+    EXPECT_EQ(longestCommonSubstring(u"xabcx", u"yyabcyy"), 3);
+    EXPECT_EQ(longestCommonSubstring(u"forsen LUL", u"LUL forsen"), 6);
+
+    // stops early
+    EXPECT_EQ(longestCommonSubstring(u"aaaaaa", u"aaaaaa", 2), 2);
+}
+
+TEST(Similarity, MatchesNaive)
+{
+    QRandomGenerator rng(42);
+    for (int i = 0; i < 500; i++)
+    {
+        auto a = randomText(rng, 40);
+        auto b = randomText(rng, 40);
+        ASSERT_EQ(similarity::longestCommonSubstring(a, b),
+                  naiveLongestCommonSubstring(a, b))
+            << a << ' ' << b;
+    }
+}
+
+TEST(Similarity, FingerprintBound)
+{
+    QRandomGenerator rng(1337);
+    for (int i = 0; i < 500; i++)
+    {
+        auto a = randomText(rng, 40);
+        auto b = randomText(rng, 40);
+        auto bound = similarity::Fingerprint::of(a).commonUpperBound(
+            similarity::Fingerprint::of(b));
+        ASSERT_GE(bound, naiveLongestCommonSubstring(a, b)) << a << ' ' << b;
+    }
+}
+
+TEST(Similarity, IsSimilar)
+{
+    QRandomGenerator rng(7);
+    for (int i = 0; i < 500; i++)
+    {
+        auto a = randomText(rng, 30);
+        auto b = randomText(rng, 30);
+        auto threshold = static_cast<float>(rng.generateDouble());
+
+        auto expected = similarity::relativeSimilarity(a, b) > threshold;
+        ASSERT_EQ(similarity::isSimilar(a, similarity::Fingerprint::of(a), b,
+                                        similarity::Fingerprint::of(b),
+                                        threshold),
+                  expected)
+            << a << ' ' << b << ' ' << threshold;
+    }
+
+    auto a = u"Hey guys, did you know that Vaporeon is the most compatible"_s;
+    auto b = u"Hey guys, did you know that Vaporeon is the most compatible!"_s;
+    auto fa = similarity::Fingerprint::of(a);
+    auto fb = similarity::Fingerprint::of(b);
+    EXPECT_TRUE(similarity::isSimilar(a, fa, b, fb, 0.9F));
+    EXPECT_FALSE(similarity::isSimilar(a, fa, u"LUL"_s,
+                                       similarity::Fingerprint::of(u"LUL"),
+                                       0.9F));
+}
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/spellcheck/SpellChecker.hpp"
+
+#ifdef CHATTERINO_WITH_SPELLCHECK
+#    include "common/Literals.hpp"
+#    include "mocks/BaseApplication.hpp"
+#    include "singletons/Settings.hpp"
+#    include "Test.hpp"
+
+#    include <QCoreApplication>
+#    include <QDir>
+#    include <QElapsedTimer>
+#    include <QFile>
+#    include <QObject>
+#    include <QTemporaryDir>
+
+#    include <functional>
+#    include <memory>
+#    include <optional>
+#    include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+/// Processes events until `done` returns true (or 5s passed)
+bool waitFor(const std::function<bool()> &done)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return done();
+}
+
+/// Writes a tiny dictionary to @a dir and returns its path (without suffix)
+QString writeDictionary(const QTemporaryDir &dir)
+{
+    auto path = QDir(dir.path()).absoluteFilePath(u"test"_s);
+
+    QFile aff(path + u".aff");
+    aff.open(QFile::WriteOnly);
+    aff.write("SET UTF-8\nTRY esianrtolcdugmphbyfvkwz\n");
+
+    QFile dic(path + u".dic");
+    dic.open(QFile::WriteOnly);
+    dic.write("3\nhello\nthere\nworld\n");
+
+    return path;
+}
+
+class SpellCheckerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(this->dictionaryDir.isValid());
+        getSettings()->spellCheckingDefaultDictionary =
+            writeDictionary(this->dictionaryDir);
+    }
+
+    mock::BaseApplication app;
+    QTemporaryDir dictionaryDir;
+};
+
+}  // namespace
+
+TEST_F(SpellCheckerTest, CachedCheck)
+{
+    SpellChecker checker;
+    ASSERT_TRUE(checker.isLoaded());
+
+    std::vector<QString> checked;
+    std::ignore = checker.wordsChecked.connect([&](const auto &words) {
+        checked.insert(checked.end(), words.begin(), words.end());
+    });
+
+    ASSERT_EQ(checker.cachedCheck(u"hello"_s), std::nullopt);
+    ASSERT_EQ(checker.cachedCheck(u"helo"_s), std::nullopt);
+
+    checker.checkAsync(u"hello"_s);
+    checker.checkAsync(u"helo"_s);
+    // already queued
+    checker.checkAsync(u"hello"_s);
+
+    ASSERT_TRUE(waitFor([&] {
+        return checked.size() >= 2;
+    }));
+    ASSERT_EQ(checked.size(), 2);
+
+    ASSERT_EQ(checker.cachedCheck(u"hello"_s), true);
+    ASSERT_EQ(checker.cachedCheck(u"helo"_s), false);
+
+    // cached words aren't checked again
+    checker.checkAsync(u"hello"_s);
+    QCoreApplication::processEvents();
+    ASSERT_EQ(checked.size(), 2);
+}
+
+TEST_F(SpellCheckerTest, Suggestions)
+{
+    SpellChecker checker;
+    ASSERT_TRUE(checker.isLoaded());
+
+    QObject caller;
+    std::optional<std::vector<QString>> suggestions;
+    checker.suggestionsAsync(u"helo"_s, &caller, [&](auto got) {
+        suggestions = std::move(got);
+    });
+
+    ASSERT_TRUE(waitFor([&] {
+        return suggestions.has_value();
+    }));
+    ASSERT_FALSE(suggestions->empty());
+    ASSERT_EQ(suggestions->front(), u"hello"_s);
+}
+
+TEST_F(SpellCheckerTest, SuggestionsForDestroyedCaller)
+{
+    SpellChecker checker;
+    ASSERT_TRUE(checker.isLoaded());
+
+    bool called = false;
+    {
+        QObject caller;
+        checker.suggestionsAsync(u"helo"_s, &caller, [&](auto) {
+            called = true;
+        });
+    }
+
+    // The check is only done after the suggestions
+    std::optional<bool> correct;
+    checker.checkAsync(u"world"_s);
+    ASSERT_TRUE(waitFor([&] {
+        correct = checker.cachedCheck(u"world"_s);
+        return correct.has_value();
+    }));
+    ASSERT_FALSE(called);
+}
+
+TEST_F(SpellCheckerTest, DestroyWithQueuedWork)
+{
+    size_t nChecked = 0;
+    {
+        auto checker = std::make_unique<SpellChecker>();
+        ASSERT_TRUE(checker->isLoaded());
+        std::ignore = checker->wordsChecked.connect([&](const auto &words) {
+            nChecked += words.size();
+        });
+
+        QObject caller;
+        for (int i = 0; i < 1000; i++)
+        {
+            checker->checkAsync(u"word" + QString::number(i));
+            checker->suggestionsAsync(u"helo"_s, &caller, [](auto) {});
+        }
+        // joins the spell checking thread
+        checker.reset();
+    }
+
+    // Results that were already posted are dropped
+    QCoreApplication::processEvents();
+    ASSERT_EQ(nChecked, 0);
+}
+
+#endif
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/Literals.hpp"
+#include "singletons/Fonts.hpp"
+#include "Test.hpp"
+
+#include <QFont>
+#include <QFontMetricsF>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+QFontMetricsF makeMetrics()
+{
+    QFont font;
+    font.setPointSize(13);
+    return QFontMetricsF(font);
+}
+
+}  // namespace
+
+TEST(TextMeasure, MatchesMetrics)
+{
+    auto metrics = makeMetrics();
+    TextMeasure measure(metrics);
+
+    const QString texts[] = {
+        u"a"_s,     u"W"_s,   u" "_s,      u"ä"_s,    u"日"_s,
+        u"forsen"_s, u"a b"_s, u"hello,"_s, u"日本語"_s, u"😀"_s,
+    };
+
+    // The second round is answered from the cache
+    for (int round = 0; round < 2; round++)
+    {
+        for (const auto &text : texts)
+        {
+            EXPECT_EQ(measure.horizontalAdvance(text),
+                      metrics.horizontalAdvance(text))
+                << text;
+        }
+    }
+
+    for (QChar c : u"aZ0 ~ä日"_s)
+    {
+        EXPECT_EQ(measure.horizontalAdvance(c), metrics.horizontalAdvance(c));
+    }
+}
+
+TEST(TextMeasure, GenerationRollover)
+{
+    auto metrics = makeMetrics();
+    TextMeasure measure(metrics);
+
+    // Enough words for three generations, so the first ones are dropped
+    std::vector<QString> words;
+    for (size_t i = 0; i < (TextMeasure::MAX_CACHED_TEXTS * 5) / 2; i++)
+    {
+        words.push_back(u"word"_s + QString::number(i));
+    }
+
+    for (const auto &word : words)
+    {
+        ASSERT_EQ(measure.horizontalAdvance(word),
+                  metrics.horizontalAdvance(word))
+            << word;
+    }
+
+    // Words from the current generation, the previous one and dropped ones
+    for (const auto &word : words)
+    {
+        ASSERT_EQ(measure.horizontalAdvance(word),
+                  metrics.horizontalAdvance(word))
+            << word;
+    }
+}
+
+TEST(TextMeasure, LongWords)
+{
+    auto metrics = makeMetrics();
+    TextMeasure measure(metrics);
+
+    const QString texts[] = {
+        QString(TextMeasure::MAX_CACHED_TEXT_LENGTH, u'x'),
+        QString(TextMeasure::MAX_CACHED_TEXT_LENGTH + 1, u'x'),
+        QString(TextMeasure::MAX_CACHED_TEXT_LENGTH + 1, u'W'),
+        u"https://chatterino.com/a/rather/long/link/that/is/never/cached"_s,
+    };
+
+    for (int round = 0; round < 2; round++)
+    {
+        for (const auto &text : texts)
+        {
+            EXPECT_EQ(measure.horizontalAdvance(text),
+                      metrics.horizontalAdvance(text))
+                << text;
+        }
+    }
+}
+
+TEST(TextMeasure, RawData)
+{
+    auto metrics = makeMetrics();
+    TextMeasure measure(metrics);
+
+    // The cache must not keep referencing the characters of `text`
+    std::vector<QChar> buffer{u'a', u'b', u'c'};
+    auto text = QString::fromRawData(buffer.data(),
+                                     static_cast<qsizetype>(buffer.size()));
+    EXPECT_EQ(measure.horizontalAdvance(text), metrics.horizontalAdvance(text));
+
+    buffer = {u'W', u'W', u'W'};
+    EXPECT_EQ(measure.horizontalAdvance(u"abc"_s),
+              metrics.horizontalAdvance(u"abc"_s));
+    EXPECT_EQ(measure.horizontalAdvance(u"WWW"_s),
+              metrics.horizontalAdvance(u"WWW"_s));
+}
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/UserMessageIndex.hpp"
+
+#include "common/Literals.hpp"
+#include "messages/Message.hpp"
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+MessagePtr makeMessage(const QString &loginName, const QString &displayName)
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = loginName;
+    message->displayName = displayName;
+    return message;
+}
+
+}  // namespace
+
+TEST(UserMessageIndex, Keys)
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = u"forsen"_s;
+    message->displayName = u"Forsen"_s;
+    message->timeoutUser = u"nymn"_s;
+    ASSERT_EQ(UserMessageIndex::keysOf(*message),
+              (std::vector<QString>{u"forsen"_s, u"nymn"_s}));
+
+    auto sub = std::make_shared<Message>();
+    sub->flags.set(MessageFlag::Subscription);
+    sub->messageText = u"Pajlada subscribed at Tier 1"_s;
+    ASSERT_EQ(UserMessageIndex::keysOf(*sub),
+              std::vector<QString>{u"pajlada"_s});
+
+    ASSERT_TRUE(UserMessageIndex::keysOf(Message{}).empty());
+}
+
+TEST(UserMessageIndex, PushAndPop)
+{
+    UserMessageIndex index;
+    auto a = makeMessage(u"a"_s, u"A"_s);
+    auto b = makeMessage(u"b"_s, u"B"_s);
+    auto a2 = makeMessage(u"a"_s, u"A"_s);
+
+    index.pushBack(a);
+    index.pushBack(b);
+    index.pushBack(a2);
+    ASSERT_EQ(index.find({u"A"_s}), (std::vector<MessagePtr>{a, a2}));
+    ASSERT_EQ(index.find({u"b"_s}), std::vector<MessagePtr>{b});
+    ASSERT_EQ(index.find({u"b"_s, u"a"_s}),
+              (std::vector<MessagePtr>{a, b, a2}));
+    ASSERT_TRUE(index.find({u"c"_s}).empty());
+
+    index.popFront(a);
+    ASSERT_EQ(index.find({u"a"_s}), std::vector<MessagePtr>{a2});
+
+    auto c = makeMessage(u"c"_s, u"C"_s);
+    auto a0 = makeMessage(u"a"_s, u"A"_s);
+    index.pushFront({a0, c});
+    ASSERT_EQ(index.find({u"a"_s, u"c"_s}),
+              (std::vector<MessagePtr>{a0, c, a2}));
+
+    index.clear();
+    ASSERT_TRUE(index.find({u"a"_s}).empty());
+}
+
+TEST(UserMessageIndex, Replace)
+{
+    UserMessageIndex index;
+    auto a = makeMessage(u"a"_s, u"A"_s);
+    auto b = makeMessage(u"b"_s, u"B"_s);
+    auto c = makeMessage(u"c"_s, u"C"_s);
+    index.pushBack(a);
+    index.pushBack(b);
+    index.pushBack(c);
+    index.popFront(a);
+
+    // b is at index 0 now
+    auto replacement = makeMessage(u"a"_s, u"A"_s);
+    index.replace(0, b, replacement);
+    ASSERT_TRUE(index.find({u"b"_s}).empty());
+    ASSERT_EQ(index.find({u"a"_s, u"c"_s}),
+              (std::vector<MessagePtr>{replacement, c}));
+
+    index.rebuild({c, b});
+    ASSERT_EQ(index.find({u"a"_s, u"b"_s, u"c"_s}),
+              (std::vector<MessagePtr>{c, b}));
+}
+
+TEST(UserMessageIndex, DisplayNameOnlyOnce)
+{
+    UserMessageIndex index;
+    auto message = makeMessage(u"forsen"_s, u"FORSEN"_s);
+    index.pushBack(message);
+
+    // Both names map to the same key, so the message isn't returned twice
+    ASSERT_EQ(index.find({u"forsen"_s, u"Forsen"_s}),
+              std::vector<MessagePtr>{message});
+}